@@ -3,68 +3,41 @@
 import glob
 import os
 import sys
-import re
 
 # This script is run from Build/<target>_default.build/$(PX4_BASE)/Firmware/src/systemcmds/topic_listener
 
 # argv[1] must be the full path of the top Firmware dir
 
+# Topics are looked up by a FNV-1a hash of their name in a table sorted by hash,
+# the fields are printed from the descriptor table generated with each topic.
+
+TOPICS_TOKEN = '# TOPICS '
+
+def fnv1a_hash(name):
+	h = 2166136261
+	for c in name.encode('ascii'):
+		h = ((h ^ c) * 16777619) & 0xffffffff
+	return h
+
 raw_messages = glob.glob(sys.argv[1]+"/msg/*.msg")
 messages = []
-message_elements = []
-
-
-for index,m in enumerate(raw_messages):
-	temp_list_floats = []
-	temp_list_uint64 = []
-	temp_list_bool = []
-	if("pwm_input" not in m and "position_setpoint" not in m):
-		temp_list = []
-		f = open(m,'r')
-		for line in f.readlines():
-			items = re.split('\s+', line.strip())
-
-			if ('float32[' in items[0]):
-				num_floats = int(items[0].split("[")[1].split("]")[0])
-				temp_list.append(("float_array",items[1],num_floats))
-			elif ('float64[' in items[0]):
-				num_floats = int(items[0].split("[")[1].split("]")[0])
-				temp_list.append(("double_array",items[1],num_floats))
-			elif ('uint64[' in items[0]):
-				num_floats = int(items[0].split("[")[1].split("]")[0])
-				temp_list.append(("uint64_array",items[1],num_floats))
-			elif(items[0] == "float32"):
-				temp_list.append(("float",items[1]))
-			elif(items[0] == "float64"):
-				temp_list.append(("double",items[1]))
-			elif(items[0] == "uint64") and len(line.split('=')) == 1:
-				temp_list.append(("uint64",items[1]))
-			elif(items[0] == "uint32") and len(line.split('=')) == 1:
-				temp_list.append(("uint32",items[1]))
-			elif(items[0] == "uint16") and len(line.split('=')) == 1:
-				temp_list.append(("uint16",items[1]))
-			elif(items[0] == "int64") and len(line.split('=')) == 1:
-				temp_list.append(("int64",items[1]))
-			elif(items[0] == "int32") and len(line.split('=')) == 1:
-				temp_list.append(("int32",items[1]))
-			elif(items[0] == "int16") and len(line.split('=')) == 1:
-				temp_list.append(("int16",items[1]))
-			elif (items[0] == "bool") and len(line.split('=')) == 1:
-				temp_list.append(("bool",items[1]))
-			elif (items[0] == "uint8") and len(line.split('=')) == 1:
-				temp_list.append(("uint8",items[1]))
-			elif (items[0] == "int8") and len(line.split('=')) == 1:
-				temp_list.append(("int8",items[1]))
-
-		f.close()
-		(m_head, m_tail) = os.path.split(m)
-		message = m_tail.split('.')[0]
-		if message != "actuator_controls":
-			messages.append(message)
-			message_elements.append(temp_list)
-		#messages.append(m.split('/')[-1].split('.')[0])
-
-num_messages = len(messages);
+topics = []
+
+for m in sorted(raw_messages):
+	(m_head, m_tail) = os.path.split(m)
+	message = m_tail.split('.')[0]
+	messages.append(message)
+	multi_topics = []
+	f = open(m,'r')
+	for line in f.readlines():
+		if line.startswith(TOPICS_TOKEN):
+			multi_topics.extend(line.strip().replace(TOPICS_TOKEN, "").split())
+	f.close()
+	if len(multi_topics) == 0:
+		multi_topics = [message]
+	topics.extend(multi_topics)
+
+topics.sort(key=lambda t: (fnv1a_hash(t), t))
 
 print("""
 
@@ -129,104 +102,125 @@ print("""
 #endif
 
 static bool check_timeout(const hrt_abstime& time) {
-    if (hrt_elapsed_time(&time) > 2*1000*1000) {
+	if (hrt_elapsed_time(&time) > 2*1000*1000) {
 		printf("Waited for 2 seconds without a message. Giving up.\\n");
-        return true;
-    }
-    return false;
+		return true;
+	}
+	return false;
 }
 
 """)
 for m in messages:
 	print("#include <uORB/topics/%s.h>" % m)
 
-
 print("""
+struct listener_topic {
+	uint32_t hash;
+	orb_id_t id;
+};
+
+/* sorted by hash */
+static const listener_topic topics[] = {""")
+for t in topics:
+	print("\t{ 0x%08xu, ORB_ID(%s) }," % (fnv1a_hash(t), t))
+print("""};
+
+static uint32_t topic_hash(const char *name)
+{
+	uint32_t hash = 2166136261u;
+
+	while (*name) {
+		hash = (hash ^ (uint8_t)*name++) * 16777619u;
+	}
+
+	return hash;
+}
+
+static orb_id_t find_topic(const char *name)
+{
+	const uint32_t hash = topic_hash(name);
+	unsigned lo = 0;
+	unsigned hi = sizeof(topics) / sizeof(topics[0]);
+
+	while (lo < hi) {
+		unsigned mid = (lo + hi) / 2;
+
+		if (topics[mid].hash < hash) {
+			lo = mid + 1;
+
+		} else {
+			hi = mid;
+		}
+	}
+
+	for (; lo < sizeof(topics) / sizeof(topics[0]) && topics[lo].hash == hash; lo++) {
+		if (strcmp(topics[lo].id->o_name, name) == 0) {
+			return topics[lo].id;
+		}
+	}
+
+	return nullptr;
+}
+
 extern "C" __EXPORT int listener_main(int argc, char *argv[]);
 
-int listener_main(int argc, char *argv[]) {
-	int sub = -1;
-	orb_id_t ID;
-	if(argc < 2) {
-		printf("need at least two arguments: topic name. [optional number of messages to print]\\n");
+int listener_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		printf("usage: listener <topic> [<number of messages>] [<instance>]\\n");
+		printf("use 'uorb top' for the rates of all topics\\n");
 		return 1;
 	}
-""")
-print("\tunsigned num_msgs = (argc > 2) ? atoi(argv[2]) : 1;")
-print("\tif (strncmp(argv[1],\"%s\",50) == 0) {" % messages[0])
-print("\t\tsub = orb_subscribe(ORB_ID(%s));" % messages[0])
-print("\t\tID = ORB_ID(%s);" % messages[0])
-print("\t\tstruct %s_s container;" % messages[0])
-print("\t\tmemset(&container, 0, sizeof(container));")
-for index,m in enumerate(messages[1:]):
-	print("\t} else if (strncmp(argv[1],\"%s\",50) == 0) {" % m)
-	print("\t\tsub = orb_subscribe(ORB_ID(%s));" % m)
-	print("\t\tID = ORB_ID(%s);" % m)
-	print("\t\tstruct %s_s container;" % m)
-	print("\t\tmemset(&container, 0, sizeof(container));")
-	print("\t\tbool updated;")
-	print("\t\tunsigned i = 0;")
-	print("\t\thrt_abstime start_time = hrt_absolute_time();")
-	print("\t\twhile(i < num_msgs) {")
-	print("\t\t\torb_check(sub,&updated);")
-	print("\t\t\tif (i == 0) { updated = true; } else { usleep(500); }")
-	print("\t\t\tif (updated) {")
-	print("\t\t\tstart_time = hrt_absolute_time();")
-	print("\t\t\ti++;")
-	print("\t\t\tprintf(\"\\nTOPIC: %s #%%d\\n\", i);" % m)
-	print("\t\t\torb_copy(ID,sub,&container);")
-	print("\t\t\tprintf(\"timestamp: %\" PRIu64 \"\\n\", container.timestamp);")
-	for item in message_elements[index+1]:
-		if item[0] == "float":
-			print("\t\t\tprintf(\"%s: %%8.4f\\n\",(double)container.%s);" % (item[1], item[1]))
-		elif item[0] == "float_array":
-			print("\t\t\tprintf(\"%s: \");" % item[1])
-			print("\t\t\tfor (int j = 0; j < %d; j++) {" % item[2])
-			print("\t\t\t\tprintf(\"%%8.4f \",(double)container.%s[j]);" % item[1])
-			print("\t\t\t}")
-			print("\t\t\tprintf(\"\\n\");")
-		elif item[0] == "double":
-			print("\t\t\tprintf(\"%s: %%8.4f\\n\",(double)container.%s);" % (item[1], item[1]))
-		elif item[0] == "double_array":
-			print("\t\t\tprintf(\"%s: \");" % item[1])
-			print("\t\t\tfor (int j = 0; j < %d; j++) {" % item[2])
-			print("\t\t\t\tprintf(\"%%8.4f \",(double)container.%s[j]);" % item[1])
-			print("\t\t\t}")
-			print("\t\t\tprintf(\"\\n\");")
-		elif item[0] == "uint64":
-			print("\t\t\tprintf(\"%s: %%\" PRIu64 \"\\n\",container.%s);" % (item[1], item[1]))
-		elif item[0] == "uint64_array":
-			print("\t\t\tprintf(\"%s: \");" % item[1])
-			print("\t\t\tfor (int j = 0; j < %d; j++) {" % item[2])
-			print("\t\t\t\tprintf(\"%%\" PRIu64 \"\",container.%s[j]);" % item[1])
-			print("\t\t\t}")
-			print("\t\t\tprintf(\"\\n\");")
-		elif item[0] == "int64":
-			print("\t\t\tprintf(\"%s: %%\" PRId64 \"\\n\",container.%s);" % (item[1], item[1]))
-		elif item[0] == "int32":
-			print("\t\t\tprintf(\"%s: %%d\\n\",container.%s);" % (item[1], item[1]))
-		elif item[0] == "uint32":
-			print("\t\t\tprintf(\"%s: %%u\\n\",container.%s);" % (item[1], item[1]))
-		elif item[0] == "int16":
-			print("\t\t\tprintf(\"%s: %%d\\n\",(int)container.%s);" % (item[1], item[1]))
-		elif item[0] == "uint16":
-			print("\t\t\tprintf(\"%s: %%u\\n\",(unsigned)container.%s);" % (item[1], item[1]))
-		elif item[0] == "int8":
-			print("\t\t\tprintf(\"%s: %%d\\n\",(int)container.%s);" % (item[1], item[1]))
-		elif item[0] == "uint8":
-			print("\t\t\tprintf(\"%s: %%u\\n\",(unsigned)container.%s);" % (item[1], item[1]))
-		elif item[0] == "bool":
-			print("\t\t\tprintf(\"%s: %%s\\n\",container.%s ? \"True\" : \"False\");" % (item[1], item[1]))
-	print("\t\t\t} else {")
-	print("\t\t\t\tif (check_timeout(start_time)) {")
-	print("\t\t\t\t\tbreak;")
-	print("\t\t\t\t}")
-	print("\t\t\t}")
-	print("\t\t}")
-print("\t} else {")
-print("\t\t printf(\" Topic did not match any known topics\\n\");")
-print("\t}")
-print("\t\torb_unsubscribe(sub);")
-print("\t return 0;")
-
-print("}")
+
+	orb_id_t ID = find_topic(argv[1]);
+
+	if (ID == nullptr) {
+		printf(" Topic did not match any known topics\\n");
+		return 1;
+	}
+
+	unsigned num_msgs = (argc > 2) ? atoi(argv[2]) : 1;
+	int instance = (argc > 3) ? atoi(argv[3]) : 0;
+
+	uint8_t *container = new uint8_t[ID->o_size];
+
+	if (container == nullptr) {
+		printf("alloc failed\\n");
+		return 1;
+	}
+
+	memset(container, 0, ID->o_size);
+
+	int sub = orb_subscribe_multi(ID, instance);
+	bool updated;
+	unsigned i = 0;
+	hrt_abstime start_time = hrt_absolute_time();
+
+	while (i < num_msgs) {
+		orb_check(sub, &updated);
+
+		if (i == 0) {
+			updated = true;
+
+		} else {
+			usleep(500);
+		}
+
+		if (updated) {
+			start_time = hrt_absolute_time();
+			i++;
+			printf("\\nTOPIC: %s instance %d #%d\\n", ID->o_name, instance, i);
+			orb_copy(ID, sub, container);
+			orb_print_message(ID, container);
+
+		} else {
+			if (check_timeout(start_time)) {
+				break;
+			}
+		}
+	}
+
+	orb_unsubscribe(sub);
+	delete[] container;
+	return 0;
+}""")
@@ -0,0 +1,312 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+"""
+Generate the magnetic field grids used by src/lib/geo_lookup from the
+World Magnetic Model (WMM2015).
+
+Every grid point holds declination and inclination in 0.01 degrees and the
+total intensity in 1e-4 gauss (10 nT) as int16. Latitude runs from -90 to 90
+and longitude from -180 to 180 degrees, both ends included.
+
+  --header  writes the C table compiled into the firmware
+            (src/lib/geo_lookup/geo_magnetic_tables.h, and with
+            --resolution 10 geo_magnetic_tables_10deg.h for boards with
+            little flash)
+  --binary  writes a grid file which is memory mapped on POSIX, e.g. to
+            <rootfs>/fs/microsd/etc/mag_grid.bin
+"""
+
+from __future__ import print_function
+
+import argparse
+import math
+import struct
+import sys
+
+# WMM2015 coefficients: n, m, g, h, secular variation of g and h (nT, nT/year)
+WMM_EPOCH = 2015.0
+WMM_COEFFICIENTS = [
+    (1, 0, -29438.5, 0.0, 10.7, 0.0),
+    (1, 1, -1501.1, 4796.2, 17.9, -26.8),
+    (2, 0, -2445.3, 0.0, -8.6, 0.0),
+    (2, 1, 3012.5, -2845.6, -3.3, -27.1),
+    (2, 2, 1676.6, -642.0, 2.4, -13.3),
+    (3, 0, 1351.1, 0.0, 3.1, 0.0),
+    (3, 1, -2352.3, -115.3, -6.2, 8.4),
+    (3, 2, 1225.6, 245.0, -0.4, -0.4),
+    (3, 3, 581.9, -538.3, -10.4, 2.3),
+    (4, 0, 907.2, 0.0, -0.4, 0.0),
+    (4, 1, 813.7, 283.4, 0.8, -0.6),
+    (4, 2, 120.3, -188.6, -9.2, 5.3),
+    (4, 3, -335.0, 180.9, 4.0, 3.0),
+    (4, 4, 70.3, -329.5, -4.2, -5.3),
+    (5, 0, -232.6, 0.0, -0.2, 0.0),
+    (5, 1, 360.1, 47.4, 0.1, 0.4),
+    (5, 2, 192.4, 196.9, -1.4, 1.6),
+    (5, 3, -141.0, -119.4, 0.0, -1.1),
+    (5, 4, -157.4, 16.1, 1.3, 3.3),
+    (5, 5, 4.3, 100.1, 3.8, 0.1),
+    (6, 0, 69.5, 0.0, -0.5, 0.0),
+    (6, 1, 67.4, -20.7, -0.2, 0.0),
+    (6, 2, 72.8, 33.2, -0.6, -2.2),
+    (6, 3, -129.8, 58.8, 2.4, -0.7),
+    (6, 4, -29.0, -66.5, -1.1, 0.1),
+    (6, 5, 13.2, 7.3, 0.3, 1.0),
+    (6, 6, -70.9, 62.5, 1.5, 1.3),
+    (7, 0, 81.6, 0.0, 0.2, 0.0),
+    (7, 1, -76.1, -54.1, -0.2, 0.7),
+    (7, 2, -6.8, -19.4, -0.4, 0.5),
+    (7, 3, 51.9, 5.6, 1.3, -0.2),
+    (7, 4, 15.0, 24.4, 0.2, -0.1),
+    (7, 5, 9.3, 3.3, -0.4, -0.7),
+    (7, 6, -2.8, -27.5, -0.9, 0.1),
+    (7, 7, 6.7, -2.3, 0.3, 0.1),
+    (8, 0, 24.0, 0.0, 0.0, 0.0),
+    (8, 1, 8.6, 10.2, 0.1, -0.3),
+    (8, 2, -16.9, -18.1, -0.5, 0.3),
+    (8, 3, -3.2, 13.2, 0.5, 0.3),
+    (8, 4, -20.6, -14.6, -0.2, 0.6),
+    (8, 5, 13.3, 16.2, 0.4, -0.1),
+    (8, 6, 11.7, 5.7, 0.2, -0.2),
+    (8, 7, -16.0, -9.1, -0.4, 0.3),
+    (8, 8, -2.0, 2.2, 0.3, 0.0),
+    (9, 0, 5.4, 0.0, 0.0, 0.0),
+    (9, 1, 8.8, -21.6, -0.1, -0.2),
+    (9, 2, 3.1, 10.8, -0.1, -0.1),
+    (9, 3, -3.1, 11.7, 0.4, -0.2),
+    (9, 4, 0.6, -6.8, -0.5, 0.1),
+    (9, 5, -13.3, -6.9, -0.2, 0.1),
+    (9, 6, -0.1, 7.8, 0.1, 0.0),
+    (9, 7, 8.7, 1.0, 0.0, -0.2),
+    (9, 8, -9.1, -3.9, -0.2, 0.4),
+    (9, 9, -10.5, 8.5, -0.1, 0.3),
+    (10, 0, -1.9, 0.0, 0.0, 0.0),
+    (10, 1, -6.5, 3.3, 0.0, 0.0),
+    (10, 2, 0.2, -0.3, -0.1, 0.0),
+    (10, 3, 0.6, 4.6, 0.3, 0.0),
+    (10, 4, -0.6, 4.4, -0.1, 0.0),
+    (10, 5, 1.7, -7.9, -0.1, -0.2),
+    (10, 6, -0.7, -0.6, -0.1, 0.1),
+    (10, 7, 2.1, -4.1, 0.0, -0.1),
+    (10, 8, 2.3, -2.8, -0.2, -0.2),
+    (10, 9, -1.8, -1.1, -0.1, 0.1),
+    (10, 10, -3.6, -8.7, -0.2, -0.1),
+    (11, 0, 3.1, 0.0, 0.0, 0.0),
+    (11, 1, -1.5, -0.1, 0.0, 0.0),
+    (11, 2, -2.3, 2.1, -0.1, 0.1),
+    (11, 3, 2.1, -0.7, 0.1, 0.0),
+    (11, 4, -0.9, -1.1, 0.0, 0.1),
+    (11, 5, 0.6, 0.7, 0.0, 0.0),
+    (11, 6, -0.7, -0.2, 0.0, 0.0),
+    (11, 7, 0.2, -2.1, 0.0, 0.1),
+    (11, 8, 1.7, -1.5, 0.0, 0.0),
+    (11, 9, -0.2, -2.5, 0.0, -0.1),
+    (11, 10, 0.4, -2.0, -0.1, -0.1),
+    (11, 11, 3.5, -2.3, -0.1, -0.1),
+    (12, 0, -2.0, 0.0, 0.1, 0.0),
+    (12, 1, -0.3, -1.0, 0.0, 0.0),
+    (12, 2, 0.4, 0.5, 0.0, 0.0),
+    (12, 3, 1.3, 1.8, 0.1, -0.1),
+    (12, 4, -0.9, -2.2, -0.1, 0.0),
+    (12, 5, 0.9, 0.3, 0.0, 0.0),
+    (12, 6, 0.1, 0.7, 0.1, 0.0),
+    (12, 7, 0.5, -0.1, 0.0, 0.0),
+    (12, 8, -0.4, 0.3, 0.0, 0.0),
+    (12, 9, -0.4, 0.2, 0.0, 0.0),
+    (12, 10, 0.2, -0.9, 0.0, 0.0),
+    (12, 11, -0.9, -0.2, 0.0, 0.0),
+    (12, 12, 0.0, 0.7, 0.0, 0.0),
+]
+
+WMM_DEGREE = 12
+
+GRID_MAGIC = 0x474d5850  # 'PXMG'
+GRID_VERSION = 1
+GRID_HEADER_FORMAT = '<IHHffffHH'
+
+
+def wmm_field(lat, lon, year, alt_km=0.0):
+    """
+    Evaluate the model at a geodetic position, returns declination and
+    inclination in degrees and total intensity in nT.
+    """
+    a = 6378.137
+    f = 1.0 / 298.257223563
+    e2 = f * (2.0 - f)
+    re = 6371.2
+    n_max = WMM_DEGREE
+
+    # north is undefined at the poles, use the limit along the meridian
+    lat = max(-89.9999, min(89.9999, lat))
+
+    # geodetic to geocentric spherical coordinates
+    phi = math.radians(lat)
+    lam = math.radians(lon)
+    rc = a / math.sqrt(1.0 - e2 * math.sin(phi) ** 2)
+    p = (rc + alt_km) * math.cos(phi)
+    z = (rc * (1.0 - e2) + alt_km) * math.sin(phi)
+    r = math.hypot(p, z)
+    phi_c = math.asin(z / r)
+
+    # Schmidt semi-normalized associated Legendre functions of the colatitude
+    ct = math.sin(phi_c)
+    st = math.cos(phi_c)
+    P = [[0.0] * (n_max + 1) for _ in range(n_max + 1)]
+    dP = [[0.0] * (n_max + 1) for _ in range(n_max + 1)]
+    P[0][0] = 1.0
+
+    for n in range(1, n_max + 1):
+        for m in range(n + 1):
+            if n == m:
+                k = 1.0 if n == 1 else math.sqrt((2.0 * n - 1.0) / (2.0 * n))
+                P[n][n] = k * st * P[n - 1][n - 1]
+                dP[n][n] = k * (ct * P[n - 1][n - 1] + st * dP[n - 1][n - 1])
+
+            else:
+                k1 = (2.0 * n - 1.0) / math.sqrt(n * n - m * m)
+                P[n][m] = k1 * ct * P[n - 1][m]
+                dP[n][m] = k1 * (ct * dP[n - 1][m] - st * P[n - 1][m])
+
+                if n > 1:
+                    k2 = math.sqrt(((n - 1.0) ** 2 - m * m) / (n * n - m * m))
+                    P[n][m] -= k2 * P[n - 2][m]
+                    dP[n][m] -= k2 * dP[n - 2][m]
+
+    dt = year - WMM_EPOCH
+    x = y = zz = 0.0
+
+    for n, m, g, h, g_dot, h_dot in WMM_COEFFICIENTS:
+        ar = (re / r) ** (n + 2)
+        g += dt * g_dot
+        h += dt * h_dot
+        cm = math.cos(m * lam)
+        sm = math.sin(m * lam)
+        x += ar * (g * cm + h * sm) * dP[n][m]
+        zz -= (n + 1) * ar * (g * cm + h * sm) * P[n][m]
+
+        if st > 1e-10:
+            y += ar * m * (g * sm - h * cm) * P[n][m] / st
+
+    # rotate back to the geodetic frame
+    psi = phi_c - phi
+    x_g = x * math.cos(psi) - zz * math.sin(psi)
+    z_g = x * math.sin(psi) + zz * math.cos(psi)
+    horizontal = math.hypot(x_g, y)
+
+    return (math.degrees(math.atan2(y, x_g)), math.degrees(math.atan2(z_g, horizontal)),
+            math.hypot(horizontal, z_g))
+
+
+def grid_values(resolution, year):
+    n_lat = int(round(180.0 / resolution)) + 1
+    n_lon = int(round(360.0 / resolution)) + 1
+    values = []
+
+    for i in range(n_lat):
+        for j in range(n_lon):
+            declination, inclination, intensity = wmm_field(-90.0 + i * resolution,
+                                                            -180.0 + j * resolution, year)
+            values.append((int(round(declination * 100.0)), int(round(inclination * 100.0)),
+                           int(round(intensity / 10.0))))
+
+    return n_lat, n_lon, values
+
+
+def write_header(filename, resolution, year):
+    n_lat, n_lon, values = grid_values(resolution, year)
+
+    with open(filename, 'w') as f:
+        f.write('/* Generated by Tools/generate_mag_grid.py from WMM2015 for %.1f, do not edit. */\n\n' % year)
+        f.write('#pragma once\n\n')
+        f.write('#define MAG_GRID_EPOCH\t\t%.1ff\n' % year)
+        f.write('#define MAG_GRID_RES\t\t%.1ff\n' % resolution)
+        f.write('#define MAG_GRID_LAT_MIN\t-90.0f\n')
+        f.write('#define MAG_GRID_LON_MIN\t-180.0f\n')
+        f.write('#define MAG_GRID_NUM_LAT\t%d\n' % n_lat)
+        f.write('#define MAG_GRID_NUM_LON\t%d\n\n' % n_lon)
+        f.write('/* declination [0.01 deg], inclination [0.01 deg], intensity [1e-4 gauss] */\n')
+        f.write('static const int16_t mag_grid_table[MAG_GRID_NUM_LAT * MAG_GRID_NUM_LON * 3] = {\n')
+
+        for i in range(n_lat):
+            f.write('\t/* %.1f */\n' % (-90.0 + i * resolution))
+
+            for j in range(0, n_lon, 4):
+                row = values[i * n_lon + j:i * n_lon + min(j + 4, n_lon)]
+                f.write('\t' + ' '.join('%d, %d, %d,' % v for v in row) + '\n')
+
+        f.write('};\n')
+
+
+def write_binary(filename, resolution, year):
+    n_lat, n_lon, values = grid_values(resolution, year)
+
+    with open(filename, 'wb') as f:
+        f.write(struct.pack(GRID_HEADER_FORMAT, GRID_MAGIC, GRID_VERSION, 0, year,
+                            -90.0, -180.0, resolution, n_lat, n_lon))
+
+        for v in values:
+            f.write(struct.pack('<hhh', *v))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate magnetic field grids from WMM2015')
+    parser.add_argument('--year', type=float, default=2017.0, help='decimal year of the field')
+    parser.add_argument('--resolution', type=float, default=None,
+                        help='grid resolution in degrees (5 for --header, 1 for --binary by default)')
+    parser.add_argument('--header', help='C header to write')
+    parser.add_argument('--binary', help='binary grid file to write')
+    parser.add_argument('--check', nargs=2, type=float, metavar=('LAT', 'LON'),
+                        help='print the field at a position')
+    args = parser.parse_args()
+
+    if args.check:
+        print('declination %.2f deg, inclination %.2f deg, intensity %.0f nT' %
+              wmm_field(args.check[0], args.check[1], args.year))
+
+    if args.header:
+        write_header(args.header, args.resolution or 5.0, args.year)
+
+    if args.binary:
+        write_binary(args.binary, args.resolution or 1.0, args.year)
+
+    if not (args.check or args.header or args.binary):
+        parser.print_help()
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
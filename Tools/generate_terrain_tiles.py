@@ -0,0 +1,131 @@
+#!/usr/bin/env python
+############################################################################
+#
+#   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+############################################################################
+
+"""
+Convert SRTM height files (.hgt) into the tiled terrain files read by
+src/lib/terrain_database.
+
+An output file covers the same 1x1 degree square as the input and keeps its
+name (N47E008.hgt -> N47E008.dat). It starts with a 16 byte header
+
+    uint32 magic 'PXTR', uint16 version, uint16 tile_size,
+    int16 lat_deg, int16 lon_deg, uint16 samples_per_degree, uint16 tiles_per_side
+
+followed by tiles_per_side^2 tiles, row by row from the south west. A tile
+holds (tile_size + 1)^2 little endian int16 heights in meters, row by row
+from the south west, neighbouring tiles share their border samples.
+Samples beyond the square repeat the last row or column.
+
+Copy the output to <rootfs>/fs/microsd/terrain/.
+"""
+
+from __future__ import print_function
+
+import argparse
+import math
+import os
+import re
+import struct
+import sys
+
+TERRAIN_MAGIC = 0x52545850  # 'PXTR'
+TERRAIN_VERSION = 1
+HEADER_FORMAT = '<IHHhhHH'
+
+
+def convert(hgt_file, output_dir, tile_size):
+    name = os.path.splitext(os.path.basename(hgt_file))[0].upper()
+    match = re.match(r'([NS])(\d{2})([EW])(\d{3})$', name)
+
+    if not match:
+        raise ValueError('%s is not named like an SRTM file' % hgt_file)
+
+    lat_deg = int(match.group(2)) * (1 if match.group(1) == 'N' else -1)
+    lon_deg = int(match.group(4)) * (1 if match.group(3) == 'E' else -1)
+
+    with open(hgt_file, 'rb') as f:
+        data = f.read()
+
+    samples = int(round(math.sqrt(len(data) / 2)))
+
+    if samples * samples * 2 != len(data):
+        raise ValueError('%s has an unexpected size' % hgt_file)
+
+    # big endian, rows from north to south
+    heights = struct.unpack('>%dh' % (samples * samples), data)
+    samples_per_degree = samples - 1
+    tiles_per_side = (samples_per_degree + tile_size - 1) // tile_size
+
+    if tiles_per_side > 128:
+        raise ValueError('tile size too small for %d samples per degree' % samples_per_degree)
+
+    def sample(row, col):
+        row = min(row, samples_per_degree)
+        col = min(col, samples_per_degree)
+        return heights[(samples_per_degree - row) * samples + col]
+
+    output = os.path.join(output_dir, name + '.dat')
+
+    with open(output, 'wb') as f:
+        f.write(struct.pack(HEADER_FORMAT, TERRAIN_MAGIC, TERRAIN_VERSION, tile_size, lat_deg, lon_deg,
+                            samples_per_degree, tiles_per_side))
+
+        for tile_row in range(tiles_per_side):
+            for tile_col in range(tiles_per_side):
+                tile = [sample(tile_row * tile_size + i, tile_col * tile_size + j)
+                        for i in range(tile_size + 1) for j in range(tile_size + 1)]
+                f.write(struct.pack('<%dh' % len(tile), *tile))
+
+    return output
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert SRTM .hgt files to PX4 terrain tiles')
+    parser.add_argument('hgt', nargs='+', help='SRTM .hgt files')
+    parser.add_argument('-o', '--output', default='.', help='output directory')
+    parser.add_argument('--tile-size', type=int, default=32, help='cells per tile side (max 64)')
+    args = parser.parse_args()
+
+    if not 0 < args.tile_size <= 64:
+        print('tile size must be between 1 and 64')
+        return 1
+
+    for hgt_file in args.hgt:
+        print(convert(hgt_file, args.output, args.tile_size))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -23,6 +23,21 @@ type_map = {
     'char': 'char',
 }
 
+field_type_enum_map = {
+    'int8': 'ORB_FIELD_INT8',
+    'int16': 'ORB_FIELD_INT16',
+    'int32': 'ORB_FIELD_INT32',
+    'int64': 'ORB_FIELD_INT64',
+    'uint8': 'ORB_FIELD_UINT8',
+    'uint16': 'ORB_FIELD_UINT16',
+    'uint32': 'ORB_FIELD_UINT32',
+    'uint64': 'ORB_FIELD_UINT64',
+    'float32': 'ORB_FIELD_FLOAT',
+    'float64': 'ORB_FIELD_DOUBLE',
+    'bool': 'ORB_FIELD_BOOL',
+    'char': 'ORB_FIELD_CHAR',
+}
+
 msgtype_size_map = {
     'int8': 1,
     'int16': 2,
@@ -135,6 +150,21 @@ def convert_type(spec_type):
     return c_type
 
 
+def get_field_descriptor(field, struct_name):
+    """
+    Get the initializer of the struct orb_field describing a field
+    """
+    count = 1
+    if field.is_array:
+        count = field.array_len
+    offset = 'offsetof(struct %s, %s)' % (struct_name, field.name)
+    if field.is_builtin:
+        return '{"%s", nullptr, %s, %i, %s}' % (field.name, offset, count,
+                field_type_enum_map[bare_name(field.base_type)])
+    return '{"%s", ORB_ID(%s), %s, %i, ORB_FIELD_NESTED}' % (field.name,
+            bare_name(field.base_type), offset, count)
+
+
 def print_field_def(field):
     """
     Print the C type from a field
@@ -90,9 +90,11 @@ set(config_module_list
 	lib/external_lgpl
 	lib/geo
 	lib/geo_lookup
+	lib/geofence
 	lib/conversion
 	lib/launchdetection
 	lib/terrain_estimation
+	lib/terrain_database
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/DriverFramework/framework
@@ -77,6 +77,7 @@ set(config_module_list
 	modules/commander/commander_tests
 	modules/controllib_test
 	modules/mavlink/mavlink_tests
+	modules/fw_pos_control_l1/fw_pos_control_l1_tests
 	modules/mc_pos_control/mc_pos_control_tests
 	modules/unit_test
 	modules/uORB/uORB_tests
@@ -135,9 +136,11 @@ set(config_module_list
 	lib/external_lgpl
 	lib/geo
 	lib/geo_lookup
+	lib/geofence
 	lib/conversion
 	lib/launchdetection
 	lib/terrain_estimation
+	lib/terrain_database
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/DriverFramework/framework
@@ -2,6 +2,9 @@ include(nuttx/px4_impl_nuttx)
 
 set(CMAKE_TOOLCHAIN_FILE ${PX4_SOURCE_DIR}/cmake/toolchains/Toolchain-arm-none-eabi.cmake)
 
+# 10 degree magnetic field grid in lib/geo_lookup to save flash
+set(config_mag_grid_resolution 10)
+
 set(config_module_list
 	#
 	# Board support modules
@@ -111,9 +114,11 @@ set(config_module_list
 	lib/external_lgpl
 	lib/geo
 	lib/geo_lookup
+	lib/geofence
 	lib/conversion
 	lib/launchdetection
 	lib/terrain_estimation
+	lib/terrain_database
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/DriverFramework/framework
@@ -4,6 +4,9 @@ set(CMAKE_TOOLCHAIN_FILE ${PX4_SOURCE_DIR}/cmake/toolchains/Toolchain-arm-none-e
 
 set(config_uavcan_num_ifaces 2)
 
+# 10 degree magnetic field grid in lib/geo_lookup to save flash
+set(config_mag_grid_resolution 10)
+
 set(config_module_list
 	#
 	# Board support modules
@@ -76,6 +79,7 @@ set(config_module_list
 	drivers/test_ppm
 	#lib/rc/rc_tests
 	modules/commander/commander_tests
+	modules/fw_pos_control_l1/fw_pos_control_l1_tests
 	modules/mc_pos_control/mc_pos_control_tests
 	modules/controllib_test
 	modules/mavlink/mavlink_tests
@@ -136,9 +140,11 @@ set(config_module_list
 	lib/external_lgpl
 	lib/geo
 	lib/geo_lookup
+	lib/geofence
 	lib/conversion
 	lib/launchdetection
 	lib/terrain_estimation
+	lib/terrain_database
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/DriverFramework/framework
@@ -66,6 +66,7 @@ set(config_module_list
 	systemcmds/mtd
 	systemcmds/nshterm
 	systemcmds/param
+	systemcmds/latency
 	systemcmds/perf
 	systemcmds/pwm
 	systemcmds/reboot
@@ -83,6 +84,7 @@ set(config_module_list
 	modules/commander/commander_tests
 	modules/controllib_test
 	modules/mavlink/mavlink_tests
+	modules/fw_pos_control_l1/fw_pos_control_l1_tests
 	modules/mc_pos_control/mc_pos_control_tests
 	modules/unit_test
 	modules/uORB/uORB_tests
@@ -141,12 +143,14 @@ set(config_module_list
 	lib/external_lgpl
 	lib/geo
 	lib/geo_lookup
+	lib/geofence
 	lib/launchdetection
 	lib/mathlib
 	lib/mathlib/math/filter
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/terrain_estimation
+	lib/terrain_database
 	platforms/nuttx
 
 	# had to add for cmake, not sure why wasn't in original config
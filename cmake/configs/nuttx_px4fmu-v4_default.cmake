@@ -58,6 +58,7 @@ set(config_module_list
 	systemcmds/bl_update
 	systemcmds/mixer
 	systemcmds/param
+	systemcmds/latency
 	systemcmds/perf
 	systemcmds/pwm
 	systemcmds/esc_calib
@@ -78,6 +79,7 @@ set(config_module_list
 	drivers/sf0x/sf0x_tests
 	drivers/test_ppm
 	modules/commander/commander_tests
+	modules/fw_pos_control_l1/fw_pos_control_l1_tests
 	modules/mc_pos_control/mc_pos_control_tests
 	modules/controllib_test
 	modules/mavlink/mavlink_tests
@@ -140,9 +142,11 @@ set(config_module_list
 	lib/external_lgpl
 	lib/geo
 	lib/geo_lookup
+	lib/geofence
 	lib/conversion
 	lib/launchdetection
 	lib/terrain_estimation
+	lib/terrain_database
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/DriverFramework/framework
@@ -83,10 +83,12 @@ set(config_module_list
 	lib/geo
 	lib/ecl
 	lib/geo_lookup
+	lib/geofence
 	lib/launchdetection
 	lib/external_lgpl
 	lib/conversion
 	lib/terrain_estimation
+	lib/terrain_database
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/DriverFramework/framework
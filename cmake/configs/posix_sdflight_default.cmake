@@ -66,7 +66,9 @@ set(config_module_list
 	lib/ecl
 	lib/geo
 	lib/geo_lookup
+	lib/geofence
 	lib/terrain_estimation
+	lib/terrain_database
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/DriverFramework/framework
@@ -7,6 +7,7 @@ set(config_module_list
 	drivers/device
 	drivers/gps
 	drivers/pwm_out_sim
+	drivers/tap_esc
 	drivers/vmount
 
 	platforms/common
@@ -18,13 +19,16 @@ set(config_module_list
 	platforms/posix/drivers/gyrosim
 	platforms/posix/drivers/ledsim
 	platforms/posix/drivers/rgbledsim
+	platforms/posix/drivers/tapescsim
 	platforms/posix/drivers/tonealrmsim
+	platforms/posix/drivers/ubxsim
 	platforms/posix/px4_layer
 	platforms/posix/work_queue
 
 	systemcmds/esc_calib
 	systemcmds/mixer
 	systemcmds/param
+	systemcmds/latency
 	systemcmds/perf
 	systemcmds/reboot
 	systemcmds/sd_bench
@@ -64,6 +68,7 @@ set(config_module_list
 	lib/external_lgpl
 	lib/geo
 	lib/geo_lookup
+	lib/geofence
 	lib/launchdetection
 	lib/mathlib
 	lib/mathlib/math/filter
@@ -71,6 +76,7 @@ set(config_module_list
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/terrain_estimation
+	lib/terrain_database
 
 	examples/px4_simple_app
 	examples/mc_att_control_multiplatform
@@ -85,6 +91,7 @@ set(config_module_list
 	drivers/sf0x/sf0x_tests
 	lib/rc/rc_tests
 	modules/commander/commander_tests
+	modules/fw_pos_control_l1/fw_pos_control_l1_tests
 	modules/mc_pos_control/mc_pos_control_tests
 	modules/controllib_test
 	#modules/mavlink/mavlink_tests #TODO: fix mavlink_tests
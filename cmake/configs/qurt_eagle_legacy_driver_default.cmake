@@ -90,6 +90,7 @@ set(config_module_list
 	lib/geo_lookup
 	lib/conversion
 	lib/terrain_estimation
+	lib/terrain_database
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/DriverFramework/framework
@@ -73,6 +73,7 @@ set(config_module_list
 	lib/conversion
 	lib/ecl
 	lib/terrain_estimation
+	lib/terrain_database
 	lib/runway_takeoff
 	lib/tailsitter_recovery
 	lib/DriverFramework/framework
@@ -93,4 +93,7 @@
 /** Get the minimum interval at which the topic can be seen to be updated for this subscription */
 #define ORBIOCGETINTERVAL	_ORBIOC(16)
 
+/** Get a pointer to the generation counter of the topic, valid for the lifetime of the system */
+#define ORBIOCGENERATION	_ORBIOC(17)
+
 #endif /* _DRV_UORB_H */
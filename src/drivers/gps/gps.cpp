@@ -45,6 +45,7 @@
 #ifndef __PX4_QURT
 #include <termios.h>
 #include <poll.h>
+#include <sys/ioctl.h>
 #else
 #include <sys/ioctl.h>
 #include <dev_fs_lib_serial.h>
@@ -73,6 +74,7 @@
 #include <systemlib/scheduling_priorities.h>
 #include <systemlib/err.h>
 #include <systemlib/param/param.h>
+#include <systemlib/perf_counter.h>
 #include <drivers/drv_gps.h>
 #include <uORB/uORB.h>
 #include <uORB/topics/vehicle_gps_position.h>
@@ -89,7 +91,9 @@
 
 #define TIMEOUT_5HZ 500
 #define RATE_MEASUREMENT_PERIOD 5000000
-#define GPS_WAIT_BEFORE_READ	20		// ms, wait before reading to save read() calls
+#define GPS_WAIT_BEFORE_READ	20		// ms, longest wait for more data before reading
+#define GPS_READ_BATCH_SIZE	16		// bytes, wait for this many more bytes at a time before reading to save read() calls
+#define GPS_INJECT_BUFFER_SIZE	1024		// bytes, RTCM data collected from the inject topic and written at once
 
 
 /* class for dynamic allocation of satellite info data */
@@ -142,6 +146,13 @@ private:
 	int 				_gps_num;					///< number of GPS connected
 
 	int _orb_inject_data_fd;
+	uint8_t _inject_buf[GPS_INJECT_BUFFER_SIZE];	///< batch of inject data, written to the device with one write()
+
+	unsigned			_serial_baudrate;				///< baudrate the serial port is set to
+	bool				_rx_line_idle;					///< no data received since the last poll timeout
+	hrt_abstime			_rx_burst_start;				///< time the latest burst of data from the device started
+	perf_counter_t			_fix_latency_perf;				///< from the start of a burst to publishing the fix it contained
+	perf_counter_t			_read_perf;					///< read() calls on the serial port
 
 	orb_advert_t _dump_communication_pub;			///< if non-null, dump communication
 	gps_dump_s *_dump_to_device;
@@ -199,6 +210,12 @@ private:
 	 */
 	void handleInjectDataTopic();
 
+	/**
+	 * wait for the device to finish its current burst of data, then read it
+	 * @return: see pollOrRead()
+	 */
+	int readBurst(uint8_t *buf, size_t buf_length);
+
 	/**
 	 * send data to the device, such as an RTCM stream
 	 * @param data
@@ -263,6 +280,11 @@ GPS::GPS(const char *path, gps_driver_mode_t mode, GPSHelper::Interface interfac
 	_fake_gps(fake_gps),
 	_gps_num(gps_num),
 	_orb_inject_data_fd(-1),
+	_serial_baudrate(0),
+	_rx_line_idle(true),
+	_rx_burst_start(0),
+	_fix_latency_perf(perf_alloc(PC_ELAPSED, "gps: fix to publish")),
+	_read_perf(perf_alloc(PC_COUNT, "gps: reads")),
 	_dump_communication_pub(nullptr),
 	_dump_to_device(nullptr),
 	_dump_from_device(nullptr)
@@ -314,6 +336,8 @@ GPS::~GPS()
 		delete(_dump_from_device);
 	}
 
+	perf_free(_fix_latency_perf);
+	perf_free(_read_perf);
 }
 
 int GPS::init()
@@ -387,50 +411,59 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 
 	/* For non QURT, use the usual polling. */
 
-	//Poll only for the serial data. In the same thread we also need to handle orb messages,
-	//so ideally we would poll on both, the serial fd and orb subscription. Unfortunately the
-	//two pollings use different underlying mechanisms (at least under posix), which makes this
-	//impossible. Instead we limit the maximum polling interval and regularly check for new orb
-	//messages.
-	//FIXME: add a unified poll() API
-	const int max_timeout = 50;
-
-	pollfd fds[1];
-	fds[0].fd = _serial_fd;
-	fds[0].events = POLLIN;
-
-	int ret = poll(fds, sizeof(fds) / sizeof(fds[0]), math::min(max_timeout, timeout));
-
-	if (ret > 0) {
-		/* if we have new data from GPS, go handle it */
-		if (fds[0].revents & POLLIN) {
-			/*
-			 * We are here because poll says there is some data, so this
-			 * won't block even on a blocking device. But don't read immediately
-			 * by 1-2 bytes, wait for some more data to save expensive read() calls.
-			 * If we have all requested data available, read it without waiting.
-			 * If more bytes are available, we'll go back to poll() again.
-			 */
-#ifdef __PX4_NUTTX
-			int err = 0, bytesAvailable = 0;
-			err = ioctl(_serial_fd, FIONREAD, (unsigned long)&bytesAvailable);
+	const hrt_abstime poll_start = hrt_absolute_time();
+	int remaining = timeout;
 
-			if ((err != 0) || (bytesAvailable < buf_length)) {
-				usleep(GPS_WAIT_BEFORE_READ * 1000);
-			}
+	do {
+		pollfd fds[2];
+		fds[0].fd = _serial_fd;
+		fds[0].events = POLLIN;
+		unsigned nfds = 1;
+
+#ifdef __PX4_NUTTX
+		/* uORB subscriptions are file descriptors on NuttX, so wait on the serial data and
+		 * the inject data topic together: RTCM data is forwarded as soon as it arrives.
+		 */
+		if (_orb_inject_data_fd >= 0) {
+			fds[1].fd = _orb_inject_data_fd;
+			fds[1].events = POLLIN;
+			nfds = 2;
+		}
 
+		int ret = poll(fds, nfds, remaining);
 #else
-			usleep(GPS_WAIT_BEFORE_READ * 1000);
+		/* On posix the uORB and the serial polling use different underlying mechanisms, so
+		 * we can only poll the serial fd and limit the polling interval to regularly check for
+		 * new orb messages instead.
+		 */
+		const int max_timeout = 50;
+
+		int ret = poll(fds, nfds, math::min(max_timeout, remaining));
 #endif
 
-			ret = ::read(_serial_fd, buf, buf_length);
+		if (ret < 0) {
+			return ret;
+		}
 
-		} else {
-			ret = -1;
+		if (ret > 0) {
+			/* if we have new data from GPS, go handle it */
+			if (fds[0].revents & POLLIN) {
+				return readBurst(buf, buf_length);
+
+			} else if (fds[0].revents != 0) {
+				return -1;
+			}
 		}
-	}
 
-	return ret;
+		handleInjectDataTopic();
+
+		remaining = timeout - (int)(hrt_elapsed_time(&poll_start) / 1000);
+
+	} while (remaining > 0);
+
+	_rx_line_idle = true;
+
+	return 0;
 
 #else
 	/* For QURT, just use read for now, since this doesn't block, we need to slow it down
@@ -440,6 +473,47 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 #endif
 }
 
+#if !defined(__PX4_QURT)
+int GPS::readBurst(uint8_t *buf, size_t buf_length)
+{
+	if (_rx_line_idle) {
+		_rx_burst_start = hrt_absolute_time();
+		_rx_line_idle = false;
+	}
+
+	/*
+	 * We are here because poll says there is some data, so this won't block even
+	 * on a blocking device. But don't read immediately by 1-2 bytes: as long as the
+	 * device keeps sending, wait for a few more bytes to save expensive read() calls.
+	 * Read as soon as all requested data is available or the line went quiet, so the
+	 * end of a message reaches the parser without a fixed delay.
+	 */
+	const unsigned baudrate = (_serial_baudrate > 0) ? _serial_baudrate : 9600;
+	const unsigned byte_time_us = 10 * 1000000 / baudrate;
+	int bytes_available = 0;
+	int bytes_before;
+
+	do {
+		bytes_before = bytes_available;
+
+		if (ioctl(_serial_fd, FIONREAD, (unsigned long)&bytes_available) != 0
+		    || bytes_available >= (int)buf_length) {
+			break;
+		}
+
+		if (bytes_available > bytes_before) {
+			const unsigned batch = math::min((unsigned)buf_length - bytes_available, (unsigned)GPS_READ_BATCH_SIZE);
+			usleep(math::min(batch * byte_time_us, (unsigned)GPS_WAIT_BEFORE_READ * 1000));
+		}
+
+	} while (bytes_available > bytes_before);
+
+	perf_count(_read_perf);
+
+	return ::read(_serial_fd, buf, buf_length);
+}
+#endif
+
 void GPS::handleInjectDataTopic()
 {
 	if (_orb_inject_data_fd == -1) {
@@ -447,6 +521,7 @@ void GPS::handleInjectDataTopic()
 	}
 
 	bool updated = false;
+	size_t batch_len = 0;
 
 	do {
 		orb_check(_orb_inject_data_fd, &updated);
@@ -455,15 +530,27 @@ void GPS::handleInjectDataTopic()
 			struct gps_inject_data_s msg;
 			orb_copy(ORB_ID(gps_inject_data), _orb_inject_data_fd, &msg);
 
-			/* Write the message to the gps device. Note that the message could be fragmented.
-			 * But as we don't write anywhere else to the device during operation, we don't
-			 * need to assemble the message first.
+			/* Collect the queued messages and write them to the gps device at once. Note that
+			 * a message could be fragmented. But as we don't write anywhere else to the device
+			 * during operation, we don't need to assemble the message first.
 			 */
-			injectData(msg.data, msg.len);
+			const size_t len = math::min((size_t)msg.len, sizeof(msg.data));
+
+			if (batch_len + len > sizeof(_inject_buf)) {
+				injectData(_inject_buf, batch_len);
+				batch_len = 0;
+			}
+
+			memcpy(&_inject_buf[batch_len], msg.data, len);
+			batch_len += len;
 
 			++_last_rate_rtcm_injection_count;
 		}
 	} while (updated);
+
+	if (batch_len > 0) {
+		injectData(_inject_buf, batch_len);
+	}
 }
 
 bool GPS::injectData(uint8_t *data, size_t len)
@@ -586,6 +673,7 @@ int GPS::setBaudrate(unsigned baud)
 	}
 
 #endif
+	_serial_baudrate = baud;
 	return 0;
 }
 
@@ -772,6 +860,10 @@ GPS::task_main()
 					if (helper_ret & 1) {
 						publish();
 
+						if (_rx_burst_start != 0) {
+							perf_set_elapsed(_fix_latency_perf, hrt_elapsed_time(&_rx_burst_start));
+						}
+
 						last_rate_count++;
 					}
 
@@ -929,6 +1021,9 @@ GPS::print_info()
 
 	}
 
+	perf_print_counter(_fix_latency_perf);
+	perf_print_counter(_read_perf);
+
 	usleep(100000);
 }
 
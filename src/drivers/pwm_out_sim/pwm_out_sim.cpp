@@ -75,6 +75,7 @@
 
 #include <systemlib/systemlib.h>
 #include <systemlib/mixer/mixer.h>
+#include <systemlib/latency_trace.h>
 
 #include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/actuator_armed.h>
@@ -484,6 +485,8 @@ PWMSim::task_main()
 			num_outputs = _mixers->mix(&outputs.output[0], num_outputs, NULL);
 			outputs.noutputs = num_outputs;
 			outputs.timestamp = hrt_absolute_time();
+			outputs.timestamp_sample = _controls[0].timestamp_sample;
+			outputs.trace_id = _controls[0].trace_id;
 
 			/* disable unused ports by setting their output to NaN */
 			for (size_t i = 0; i < sizeof(outputs.output) / sizeof(outputs.output[0]); i++) {
@@ -515,6 +518,8 @@ PWMSim::task_main()
 
 			/* and publish for anyone that cares to see */
 			orb_publish(ORB_ID(actuator_outputs), _outputs_pub, &outputs);
+
+			latency_trace_hop(latency_trace_s::HOP_OUTPUT, outputs.trace_id);
 		}
 
 		/* how about an arming update? */
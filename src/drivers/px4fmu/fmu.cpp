@@ -71,6 +71,8 @@
 #include <systemlib/board_serial.h>
 #include <systemlib/param/param.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/scheduling_priorities.h>
+#include <systemlib/latency_trace.h>
 #include <drivers/drv_mixer.h>
 #include <drivers/drv_rc_input.h>
 #include <drivers/drv_input_capture.h>
@@ -79,6 +81,7 @@
 #include <lib/rc/dsm.h>
 #include <lib/rc/st24.h>
 #include <lib/rc/sumd.h>
+#include <lib/rc/rc_scan.h>
 
 #include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/actuator_outputs.h>
@@ -95,11 +98,21 @@
 
 #include <systemlib/circuit_breaker.h>
 
-#define SCHEDULE_INTERVAL	2000	/**< The schedule interval in usec (500 Hz) */
+#define SCHEDULE_INTERVAL	2000	/**< Fallback interval in usec (500 Hz) if no actuator controls are published */
 #define NAN_VALUE	(0.0f/0.0f)		/**< NaN value for throttle lock mode */
 #define BUTTON_SAFETY	px4_arch_gpioread(GPIO_BTN_SAFETY)
 #define CYCLE_COUNT 10			/* safety switch must be held for 1 second to activate */
 
+/*
+ * The task runs the cycle that used to run on the HP work queue, so it gets the
+ * work queue stack of the board plus room for the poll() frame.
+ */
+#ifdef CONFIG_SCHED_WORKSTACKSIZE
+#define FMU_TASK_STACK_SIZE	(CONFIG_SCHED_WORKSTACKSIZE + 200)
+#else
+#define FMU_TASK_STACK_SIZE	1800
+#endif
+
 /*
  * Define the various LED flash sequences for each system state.
  */
@@ -145,6 +158,8 @@ public:
 	int		set_pwm_alt_rate(unsigned rate);
 	int		set_pwm_alt_channels(uint32_t channels);
 
+	void		print_info();
+
 	static int	set_i2c_bus_clock(unsigned bus, unsigned clock_hz);
 
 	static void	capture_trampoline(void *context, uint32_t chan_index,
@@ -157,22 +172,19 @@ private:
 	enum RC_SCAN {
 		RC_SCAN_PPM = 0,
 		RC_SCAN_SBUS,
-		RC_SCAN_DSM,
-		RC_SCAN_SUMD,
-		RC_SCAN_ST24
+		RC_SCAN_DSM_ST24_SUMD	///< protocols sharing the 115200 8N1 line, decoded in parallel
 	};
 	enum RC_SCAN _rc_scan_state = RC_SCAN_SBUS;
 
-	char const *RC_SCAN_STRING[5] = {
+	char const *RC_SCAN_STRING[3] = {
 		"PPM",
 		"SBUS",
-		"DSM",
-		"SUMD",
-		"ST24"
+		"DSM/ST24/SUMD"
 	};
 
 	hrt_abstime _rc_scan_begin = 0;
 	bool _rc_scan_locked = false;
+	uint8_t _rc_scan_protocols = RC_SCAN_PROTO_ALL;	///< candidate decoders of RC_SCAN_DSM_ST24_SUMD
 	bool _report_lock = true;
 
 	hrt_abstime _cycle_timestamp = 0;
@@ -186,7 +198,8 @@ private:
 	unsigned	_pwm_alt_rate;
 	uint32_t	_pwm_alt_rate_channels;
 	unsigned	_current_update_rate;
-	struct work_s	_work;
+	volatile int	_task;			///< worker task id
+	volatile bool	_task_should_exit;	///< worker terminate flag
 	int		_vehicle_cmd_sub;
 	int		_armed_sub;
 	int		_param_sub;
@@ -235,16 +248,21 @@ private:
 	float _mot_t_max;	// maximum rise time for motor (slew rate limiting)
 
 	perf_counter_t	_ctl_latency;
+	perf_counter_t	_pwm_latency;	///< actuator_controls_0 publication to PWM write
+
+	static const unsigned _latency_bucket_count = 6;
+	static const uint16_t _latency_buckets[_latency_bucket_count];
+	uint32_t	_latency_counters[_latency_bucket_count + 1];	///< last one counts overflows
 
 	static bool	arm_nothrottle()
 	{
 		return ((_armed.prearmed && !_armed.armed) || _armed.in_esc_calibration_mode);
 	}
 
-	static void	cycle_trampoline(void *arg);
+	static void	task_main_trampoline(int argc, char *argv[]);
+	void		task_main();
 	void		cycle();
-	void		work_start();
-	void		work_stop();
+	int		task_start();
 
 	static int	control_callback(uintptr_t handle,
 					 uint8_t control_group,
@@ -297,6 +315,7 @@ private:
 const PX4FMU::GPIOConfig PX4FMU::_gpio_tab[] =	BOARD_FMU_GPIO_TAB;
 
 const unsigned		PX4FMU::_ngpio = arraySize(PX4FMU::_gpio_tab);
+const uint16_t		PX4FMU::_latency_buckets[PX4FMU::_latency_bucket_count] = { 100, 250, 500, 1000, 2000, 5000 };
 pwm_limit_t		PX4FMU::_pwm_limit;
 actuator_armed_s	PX4FMU::_armed = {};
 
@@ -314,7 +333,8 @@ PX4FMU::PX4FMU() :
 	_pwm_alt_rate(50),
 	_pwm_alt_rate_channels(0),
 	_current_update_rate(0),
-	_work{},
+	_task(-1),
+	_task_should_exit(false),
 	_armed_sub(-1),
 	_param_sub(-1),
 	_adc_sub(-1),
@@ -346,7 +366,9 @@ PX4FMU::PX4FMU() :
 	_to_safety(nullptr),
 	_to_mixer_status(nullptr),
 	_mot_t_max(0.0f),
-	_ctl_latency(perf_alloc(PC_ELAPSED, "ctl_lat"))
+	_ctl_latency(perf_alloc(PC_ELAPSED, "ctl_lat")),
+	_pwm_latency(perf_alloc(PC_ELAPSED, "fmu_pwm_lat")),
+	_latency_counters{}
 {
 	for (unsigned i = 0; i < _max_actuators; i++) {
 		_min_pwm[i] = PWM_DEFAULT_MIN;
@@ -390,24 +412,30 @@ PX4FMU::PX4FMU() :
 
 PX4FMU::~PX4FMU()
 {
-	if (_initialized) {
+	if (_task != -1) {
 		/* tell the task we want it to go away */
-		work_stop();
+		_task_should_exit = true;
 
 		int i = 10;
 
 		do {
-			/* wait 50ms - it should wake every 100ms or so worst-case */
+			/* wait 50ms - it should wake every 2ms or so worst-case */
 			usleep(50000);
 			i--;
 
-		} while (_initialized && i > 0);
+		} while (_task != -1 && i > 0);
+
+		/* well, kill it anyway, though this will probably crash */
+		if (_task != -1) {
+			px4_task_delete(_task);
+		}
 	}
 
 	/* clean up the alternate device node */
 	unregister_class_devname(PWM_OUTPUT_BASE_DEVICE_PATH, _class_instance);
 
 	perf_free(_ctl_latency);
+	perf_free(_pwm_latency);
 
 	g_fmu = nullptr;
 }
@@ -439,9 +467,7 @@ PX4FMU::init()
 
 	_safety_disabled = circuit_breaker_enabled("CBRK_IO_SAFETY", CBRK_IO_SAFETY_KEY);
 
-	work_start();
-
-	return OK;
+	return task_start();
 }
 
 void
@@ -712,6 +738,22 @@ PX4FMU::set_pwm_alt_channels(uint32_t channels)
 	return set_pwm_rate(channels, _pwm_default_rate, _pwm_alt_rate);
 }
 
+void
+PX4FMU::print_info()
+{
+	perf_print_counter(_ctl_latency);
+	perf_print_counter(_pwm_latency);
+
+	printf("publish to PWM latency [us] : events\n");
+
+	for (unsigned i = 0; i < _latency_bucket_count; i++) {
+		printf("  %4i : %lu\n", _latency_buckets[i], (unsigned long)_latency_counters[i]);
+	}
+
+	printf(" >%4i : %lu\n", _latency_buckets[_latency_bucket_count - 1],
+	       (unsigned long)_latency_counters[_latency_bucket_count]);
+}
+
 int
 PX4FMU::set_i2c_bus_clock(unsigned bus, unsigned clock_hz)
 {
@@ -802,6 +844,8 @@ PX4FMU::publish_pwm_outputs(uint16_t *values, size_t numvalues)
 	actuator_outputs_s outputs = {};
 	outputs.noutputs = numvalues;
 	outputs.timestamp = hrt_absolute_time();
+	outputs.timestamp_sample = _controls[0].timestamp_sample;
+	outputs.trace_id = _controls[0].trace_id;
 
 	for (size_t i = 0; i < _max_actuators; ++i) {
 		outputs.output[i] = i < numvalues ? (float)values[i] : 0;
@@ -817,19 +861,62 @@ PX4FMU::publish_pwm_outputs(uint16_t *values, size_t numvalues)
 }
 
 
+int
+PX4FMU::task_start()
+{
+	/*
+	 * Run in an own task instead of the HP work queue: the task blocks on the
+	 * actuator_controls subscriptions, so new controls are mixed and written
+	 * as soon as they are published.
+	 */
+	_task = px4_task_spawn_cmd("fmu",
+				   SCHED_DEFAULT,
+				   SCHED_PRIORITY_ACTUATOR_OUTPUTS,
+				   FMU_TASK_STACK_SIZE,
+				   (px4_main_t)&PX4FMU::task_main_trampoline,
+				   nullptr);
+
+	if (_task < 0) {
+		DEVICE_DEBUG("task start failed: %d", errno);
+		return -errno;
+	}
+
+	return OK;
+}
+
 void
-PX4FMU::work_start()
+PX4FMU::task_main_trampoline(int argc, char *argv[])
 {
-	/* schedule a cycle to start things */
-	work_queue(HPWORK, &_work, (worker_t)&PX4FMU::cycle_trampoline, this, 0);
+	g_fmu->task_main();
 }
 
 void
-PX4FMU::cycle_trampoline(void *arg)
+PX4FMU::task_main()
 {
-	PX4FMU *dev = reinterpret_cast<PX4FMU *>(arg);
+	while (!_task_should_exit) {
+		cycle();
+	}
+
+	for (unsigned i = 0; i < actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS; i++) {
+		if (_control_subs[i] > 0) {
+			::close(_control_subs[i]);
+			_control_subs[i] = -1;
+		}
+	}
 
-	dev->cycle();
+	::close(_armed_sub);
+	::close(_param_sub);
+
+	/* make sure servos are off */
+	up_pwm_servo_deinit();
+
+	DEVICE_LOG("stopping");
+
+	/* note - someone else is responsible for restoring the GPIO config */
+
+	/* tell the dtor that we are exiting */
+	_initialized = false;
+	_task = -1;
 }
 
 void
@@ -1037,8 +1124,20 @@ PX4FMU::cycle()
 		_current_update_rate = max_rate;
 	}
 
-	/* check if anything updated */
-	int ret = ::poll(_poll_fds, _poll_fds_num, 0);
+	/*
+	 * Wait for new controls. The timeout keeps the failsafe, safety and RC
+	 * handling running if no controls are published.
+	 */
+	int ret = 0;
+
+	if (_poll_fds_num > 0) {
+		ret = ::poll(_poll_fds, _poll_fds_num, SCHEDULE_INTERVAL / 1000);
+
+	} else {
+		usleep(SCHEDULE_INTERVAL);
+	}
+
+	bool controls_0_updated = false;
 
 	/* this would be bad... */
 	if (ret < 0) {
@@ -1059,29 +1158,9 @@ PX4FMU::cycle()
 				if (_poll_fds[poll_id].revents & POLLIN) {
 					orb_copy(_control_topics[i], _control_subs[i], &_controls[i]);
 
-#if defined(DEBUG_BUILD)
-
-					static int main_out_latency = 0;
-					static int sum_latency = 0;
-					static uint64_t last_cycle_time = 0;
-
 					if (i == 0) {
-						uint64_t now = hrt_absolute_time();
-						uint64_t latency = now - _controls[i].timestamp;
-
-						if (latency > main_out_latency) { main_out_latency = latency; }
-
-						sum_latency += latency;
-
-						if ((now - last_cycle_time) >= 1000000) {
-							last_cycle_time = now;
-							PX4_DEBUG("pwm max latency: %d, avg: %5.3f", main_out_latency, (double)(sum_latency / 100.0));
-							main_out_latency = latency;
-							sum_latency = 0;
-						}
+						controls_0_updated = true;
 					}
-
-#endif
 				}
 
 				poll_id++;
@@ -1204,6 +1283,22 @@ PX4FMU::cycle()
 				pwm_output_set(i, pwm_limited[i]);
 			}
 
+			/* time from the controls publication until they are on the outputs */
+			if (controls_0_updated && _controls[0].timestamp != 0) {
+				hrt_abstime latency = hrt_absolute_time() - _controls[0].timestamp;
+				perf_set_elapsed(_pwm_latency, latency);
+
+				unsigned bucket = 0;
+
+				while (bucket < _latency_bucket_count && latency > _latency_buckets[bucket]) {
+					bucket++;
+				}
+
+				_latency_counters[bucket]++;
+
+				latency_trace_hop(latency_trace_s::HOP_OUTPUT, _controls[0].trace_id);
+			}
+
 			publish_pwm_outputs(pwm_limited, num_outputs);
 			perf_end(_ctl_latency);
 		}
@@ -1364,7 +1459,6 @@ PX4FMU::cycle()
 	uint16_t raw_rc_values[input_rc_s::RC_INPUT_MAX_CHANNELS];
 	uint16_t raw_rc_count;
 	unsigned frame_drops;
-	bool dsm_11_bit;
 
 
 	if (_report_lock && _rc_scan_locked) {
@@ -1402,113 +1496,50 @@ PX4FMU::cycle()
 
 		} else {
 			// Scan the next protocol
-			set_rc_scan_state(RC_SCAN_DSM);
+			set_rc_scan_state(RC_SCAN_DSM_ST24_SUMD);
 		}
 
 		break;
 
-	case RC_SCAN_DSM:
+	case RC_SCAN_DSM_ST24_SUMD:
 		if (_rc_scan_begin == 0) {
 			_rc_scan_begin = _cycle_timestamp;
-//			// Configure serial port for DSM
+			// Configure serial port for DSM, ST24 and SUMD
 			dsm_config(_rcs_fd);
 			rc_io_invert(false);
+			rc_scan_init();
+			_rc_scan_protocols = RC_SCAN_PROTO_ALL;
 
 		} else if (_rc_scan_locked
 			   || _cycle_timestamp - _rc_scan_begin < rc_scan_max) {
 
 			if (newBytes > 0) {
-				// parse new data
-				rc_updated = dsm_parse(_cycle_timestamp, &_rcs_buf[0], newBytes, &raw_rc_values[0], &raw_rc_count,
-						       &dsm_11_bit, &frame_drops, input_rc_s::RC_INPUT_MAX_CHANNELS);
+				// parse new data with all candidate decoders in one pass
+				struct rc_scan_result scan;
+				uint8_t protocol = rc_scan_parse(_cycle_timestamp, &_rcs_buf[0], newBytes, _rc_scan_protocols,
+								 &raw_rc_values[0], input_rc_s::RC_INPUT_MAX_CHANNELS, &scan);
 
-				if (rc_updated) {
-					// we have a new DSM frame. Publish it.
-					_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_DSM;
-					fill_rc_in(raw_rc_count, raw_rc_values, _cycle_timestamp,
-						   false, false, frame_drops);
-					_rc_scan_locked = true;
-				}
-			}
-
-		} else {
-			// Scan the next protocol
-			set_rc_scan_state(RC_SCAN_ST24);
-		}
-
-		break;
-
-	case RC_SCAN_ST24:
-		if (_rc_scan_begin == 0) {
-			_rc_scan_begin = _cycle_timestamp;
-			// Configure serial port for DSM
-			dsm_config(_rcs_fd);
-			rc_io_invert(false);
-
-		} else if (_rc_scan_locked
-			   || _cycle_timestamp - _rc_scan_begin < rc_scan_max) {
-
-			if (newBytes > 0) {
-				// parse new data
-				uint8_t st24_rssi, lost_count;
-
-				rc_updated = false;
-
-				for (unsigned i = 0; i < (unsigned)newBytes; i++) {
-					/* set updated flag if one complete packet was parsed */
-					st24_rssi = RC_INPUT_RSSI_MAX;
-					rc_updated = (OK == st24_decode(_rcs_buf[i], &st24_rssi, &lost_count,
-									&raw_rc_count, raw_rc_values, input_rc_s::RC_INPUT_MAX_CHANNELS));
-				}
-
-				// The st24 will keep outputting RC channels and RSSI even if RC has been lost.
-				// The only way to detect RC loss is therefore to look at the lost_count.
-
-				if (rc_updated && lost_count == 0) {
-					// we have a new ST24 frame. Publish it.
-					_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_ST24;
-					fill_rc_in(raw_rc_count, raw_rc_values, _cycle_timestamp,
-						   false, false, frame_drops, st24_rssi);
-					_rc_scan_locked = true;
-				}
-			}
-
-		} else {
-			// Scan the next protocol
-			set_rc_scan_state(RC_SCAN_SUMD);
-		}
-
-		break;
-
-	case RC_SCAN_SUMD:
-		if (_rc_scan_begin == 0) {
-			_rc_scan_begin = _cycle_timestamp;
-			// Configure serial port for DSM
-			dsm_config(_rcs_fd);
-			rc_io_invert(false);
-
-		} else if (_rc_scan_locked
-			   || _cycle_timestamp - _rc_scan_begin < rc_scan_max) {
-
-			if (newBytes > 0) {
-				// parse new data
-				uint8_t sumd_rssi, rx_count;
-				bool sumd_failsafe;
-
-				rc_updated = false;
-
-				for (unsigned i = 0; i < (unsigned)newBytes; i++) {
-					/* set updated flag if one complete packet was parsed */
-					sumd_rssi = RC_INPUT_RSSI_MAX;
-					rc_updated = (OK == sumd_decode(_rcs_buf[i], &sumd_rssi, &rx_count,
-									&raw_rc_count, raw_rc_values, input_rc_s::RC_INPUT_MAX_CHANNELS, &sumd_failsafe));
-				}
+				rc_updated = (protocol != 0);
 
 				if (rc_updated) {
-					// we have a new SUMD frame. Publish it.
-					_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_SUMD;
-					fill_rc_in(raw_rc_count, raw_rc_values, _cycle_timestamp,
-						   false, sumd_failsafe, frame_drops, sumd_rssi);
+					// we have a new frame. Publish it and only run its decoder from now on.
+					switch (protocol) {
+					case RC_SCAN_PROTO_DSM:
+						_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_DSM;
+						break;
+
+					case RC_SCAN_PROTO_ST24:
+						_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_ST24;
+						break;
+
+					case RC_SCAN_PROTO_SUMD:
+						_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_SUMD;
+						break;
+					}
+
+					fill_rc_in(scan.num_values, raw_rc_values, _cycle_timestamp,
+						   false, scan.failsafe, scan.frame_drops, scan.rssi);
+					_rc_scan_protocols = protocol;
 					_rc_scan_locked = true;
 				}
 			}
@@ -1589,36 +1620,6 @@ PX4FMU::cycle()
 		_rc_scan_locked = false;
 	}
 
-	/*
-	 * schedule next cycle
-	 */
-	work_queue(HPWORK, &_work, (worker_t)&PX4FMU::cycle_trampoline, this, USEC2TICK(SCHEDULE_INTERVAL));
-//		   USEC2TICK(SCHEDULE_INTERVAL - main_out_latency));
-}
-
-void PX4FMU::work_stop()
-{
-	work_cancel(HPWORK, &_work);
-
-	for (unsigned i = 0; i < actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS; i++) {
-		if (_control_subs[i] > 0) {
-			::close(_control_subs[i]);
-			_control_subs[i] = -1;
-		}
-	}
-
-	::close(_armed_sub);
-	::close(_param_sub);
-
-	/* make sure servos are off */
-	up_pwm_servo_deinit();
-
-	DEVICE_LOG("stopping");
-
-	/* note - someone else is responsible for restoring the GPIO config */
-
-	/* tell the dtor that we are exiting */
-	_initialized = false;
 }
 
 int
@@ -3323,6 +3324,7 @@ fmu_main(int argc, char *argv[])
 #ifdef RC_SERIAL_PORT
 		warnx("frame drops: %u", sbus_dropped_frames());
 #endif
+		g_fmu->print_info();
 		return 0;
 	}
 
@@ -73,6 +73,7 @@
 #include <systemlib/scheduling_priorities.h>
 #include <systemlib/param/param.h>
 #include <systemlib/circuit_breaker.h>
+#include <systemlib/latency_trace.h>
 #include <systemlib/mavlink_log.h>
 #include <systemlib/battery.h>
 
@@ -275,7 +276,7 @@ private:
 
 	perf_counter_t		_perf_update;		///< local performance counter for status updates
 	perf_counter_t		_perf_write;		///< local performance counter for PWM control writes
-	perf_counter_t		_perf_sample_latency;	///< total system latency (based on passed-through timestamp)
+	perf_counter_t		_perf_sample_latency;	///< IMU sample to IO control update latency (actuator_controls.timestamp_sample)
 
 	/* cached IO state */
 	uint16_t		_status;		///< Various IO status flags
@@ -524,7 +525,7 @@ PX4IO::PX4IO(device::Device *interface) :
 	_mavlink_log_pub(nullptr),
 	_perf_update(perf_alloc(PC_ELAPSED, "io update")),
 	_perf_write(perf_alloc(PC_ELAPSED, "io write")),
-	_perf_sample_latency(perf_alloc(PC_ELAPSED, "io latency")),
+	_perf_sample_latency(perf_alloc(PC_ELAPSED, "io sample latency")),
 	_status(0),
 	_alarms(0),
 	_last_written_arming_s(0),
@@ -1421,7 +1422,13 @@ PX4IO::io_set_control_state(unsigned group)
 
 	if (!_test_fmu_fail) {
 		/* copy values to registers in IO */
-		return io_reg_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
+		int ret = io_reg_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
+
+		if (ret == OK && group == 0 && changed) {
+			latency_trace_hop(latency_trace_s::HOP_OUTPUT, controls.trace_id);
+		}
+
+		return ret;
 
 	} else {
 		return OK;
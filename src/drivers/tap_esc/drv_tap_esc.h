@@ -31,6 +31,8 @@
  *
  ****************************************************************************/
 
+#pragma once
+
 #define TAP_ESC_CRC {\
 		0x00, 0xE7, 0x29, 0xCE, 0x52, 0xB5, 0x7B, 0x9C, 0xA4, 0x43, 0x8D, 0x6A,\
 		0xF6, 0x11, 0xDF, 0x38, 0xAF, 0x48, 0x86, 0x61, 0xFD, 0x1A, 0xD4, 0x33,\
@@ -85,6 +87,9 @@
 #define RPMSTOPPED (RPMMIN - 10)
 
 
+/* Sensors reported in the RUN_INFO feedback */
+#define ESC_HAVE_CURRENT_SENSOR
+
 #define MAX_BOOT_TIME_MS		 (500) // Minimum time to wait after Power on before sending commands
 
 #pragma pack(push,1)
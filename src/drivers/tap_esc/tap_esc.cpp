@@ -56,6 +56,7 @@
 #include <systemlib/mixer/mixer.h>
 #include <systemlib/param/param.h>
 #include <systemlib/pwm_limit/pwm_limit.h>
+#include <systemlib/perf_counter.h>
 
 #define NAN_VALUE	(0.0f/0.0f)
 
@@ -63,16 +64,18 @@
 #define B250000 250000
 #endif
 
-#define ESC_HAVE_CURRENT_SENSOR
-
-#include "drv_tap_esc.h"
+#include "tap_esc_common.h"
 
 /*
  * This driver connects to TAP ESCs via serial.
  */
 
 static int _uart_fd = -1; //todo:refactor in to class
+#ifdef __PX4_NUTTX
 class TAP_ESC : public device::CDev
+#else
+class TAP_ESC : public device::VDev
+#endif
 {
 public:
 	enum Mode {
@@ -91,13 +94,13 @@ public:
 	TAP_ESC(int channels_count);
 	virtual ~TAP_ESC();
 	virtual int	init();
-	virtual int	ioctl(file *filp, int cmd, unsigned long arg);
+	virtual int	ioctl(device::file_t *filp, int cmd, unsigned long arg);
 	void cycle();
+	void print_info();
 protected:
 	void select_responder(uint8_t sel);
 private:
 
-	static const uint8_t crcTable[256];
 	static const uint8_t device_mux_map[TAP_ESC_MAX_MOTOR_NUM];
 	static const uint8_t device_dir_map[TAP_ESC_MAX_MOTOR_NUM];
 
@@ -134,24 +137,31 @@ private:
 	unsigned	_pwm_default_rate;
 	unsigned	_current_update_rate;
 	ESC_UART_BUF uartbuf;
+	tap_esc_common::EscParser _parser;
 	EscPacket  		_packet;
+
+	/* RUN frame, reused every cycle: only the payload and crc change */
+	EscPacket		_run_packet;
+	uint8_t			_responding_esc;	///< ESC asked for feedback by the last RUN frame
+	uint32_t		_feedback_count[TAP_ESC_MAX_MOTOR_NUM];
+	hrt_abstime		_feedback_timestamp[TAP_ESC_MAX_MOTOR_NUM];
+
+	perf_counter_t		_perf_output;		///< interval between two RUN frames
+	perf_counter_t		_perf_tx_errors;
+
 	void		subscribe();
 
 	void		work_start();
 	void		work_stop();
 	void send_esc_outputs(const float *pwm, const unsigned num_pwm);
-	uint8_t crc8_esc(uint8_t *p, uint8_t len);
-	uint8_t crc_packet(EscPacket &p);
 	int send_packet(EscPacket &p, int responder);
-	void read_data_from_uart();
-	bool parse_tap_esc_feedback(ESC_UART_BUF *serial_buf, EscPacket *packetdata);
+	void handle_feedback(unsigned esc_count);
 	static int control_callback(uintptr_t handle,
 				    uint8_t control_group,
 				    uint8_t control_index,
 				    float &input);
 };
 
-const uint8_t TAP_ESC::crcTable[256] = TAP_ESC_CRC;
 const uint8_t TAP_ESC::device_mux_map[TAP_ESC_MAX_MOTOR_NUM] = ESC_POS;
 const uint8_t TAP_ESC::device_dir_map[TAP_ESC_MAX_MOTOR_NUM] = ESC_DIR;
 
@@ -165,7 +175,12 @@ TAP_ESC	*tap_esc = nullptr;
 # define TAP_ESC_DEVICE_PATH	"/dev/tap_esc"
 
 TAP_ESC::TAP_ESC(int channels_count):
-	CDev("tap_esc", TAP_ESC_DEVICE_PATH),
+#ifdef __PX4_NUTTX
+	CDev
+#else
+	VDev
+#endif
+	("tap_esc", TAP_ESC_DEVICE_PATH),
 	_is_armed(false),
 	_poll_fds_num(0),
 	_mode(MODE_4PWM), //FIXME: what is this mode used for???
@@ -182,7 +197,12 @@ TAP_ESC::TAP_ESC(int channels_count):
 	_groups_subscribed(0),
 	_initialized(false),
 	_pwm_default_rate(400),
-	_current_update_rate(0)
+	_current_update_rate(0),
+	_responding_esc(0),
+	_feedback_count{},
+	_feedback_timestamp{},
+	_perf_output(perf_alloc(PC_INTERVAL, "tap_esc: output")),
+	_perf_tx_errors(perf_alloc(PC_COUNT, "tap_esc: tx errors"))
 
 {
 	_control_topics[0] = ORB_ID(actuator_controls_0);
@@ -191,11 +211,14 @@ TAP_ESC::TAP_ESC(int channels_count):
 	_control_topics[3] = ORB_ID(actuator_controls_3);
 	memset(_controls, 0, sizeof(_controls));
 	memset(_poll_fds, 0, sizeof(_poll_fds));
-	uartbuf.head = 0;
-	uartbuf.tail = 0;
-	uartbuf.dat_cnt = 0;
+	tap_esc_common::reset(&uartbuf, &_parser);
 	memset(uartbuf.esc_feedback_buf, 0, sizeof(uartbuf.esc_feedback_buf));
 
+	memset(&_run_packet, 0, sizeof(_run_packet));
+	_run_packet.head = 0xfe;
+	_run_packet.len = _channels_count * sizeof(_run_packet.d.reqRun.rpm_flags[0]);
+	_run_packet.msg_id = ESCBUS_MSG_ID_RUN;
+
 	for (size_t i = 0; i < sizeof(_outputs.output) / sizeof(_outputs.output[0]); i++) {
 		_outputs.output[i] = NAN;
 	}
@@ -222,6 +245,9 @@ TAP_ESC::~TAP_ESC()
 	// clean up the alternate device node
 	//unregister_class_devname(PWM_OUTPUT_BASE_DEVICE_PATH, _class_instance);
 
+	perf_free(_perf_output);
+	perf_free(_perf_tx_errors);
+
 	tap_esc = nullptr;
 }
 
@@ -291,9 +317,9 @@ TAP_ESC::init()
 
 		while (retries--) {
 
-			read_data_from_uart();
+			tap_esc_common::read_data_from_uart(_uart_fd, &uartbuf);
 
-			if (parse_tap_esc_feedback(&uartbuf, &_packet)) {
+			if (tap_esc_common::parse_tap_esc_feedback(&uartbuf, &_parser, &_packet)) {
 				valid = (_packet.msg_id == ESCBUS_MSG_ID_CONFIG_INFO_BASIC
 					 && _packet.d.rspConfigInfoBasic.channelID == cid
 					 && 0 == memcmp(&_packet.d.rspConfigInfoBasic.resp, &config, sizeof(ConfigInfoBasicRequest)));
@@ -336,7 +362,11 @@ TAP_ESC::init()
 
 	/* do regular cdev init */
 
+#ifdef __PX4_NUTTX
 	ret = CDev::init();
+#else
+	ret = VDev::init();
+#endif
 
 	return ret;
 }
@@ -352,11 +382,11 @@ int TAP_ESC::send_packet(EscPacket &packet, int responder)
 		select_responder(responder);
 	}
 
-	int packet_len = crc_packet(packet);
+	int packet_len = tap_esc_common::crc_packet(packet);
 	int ret = ::write(_uart_fd, &packet.head, packet_len);
 
 	if (ret != packet_len) {
-		PX4_WARN("TX ERROR: ret: %d, errno: %d", ret, errno);
+		perf_count(_perf_tx_errors);
 	}
 
 	return ret;
@@ -390,23 +420,6 @@ TAP_ESC::subscribe()
 	}
 }
 
-uint8_t TAP_ESC::crc8_esc(uint8_t *p, uint8_t len)
-{
-	uint8_t crc = 0;
-
-	for (uint8_t i = 0; i < len; i++) {
-		crc = crcTable[crc^*p++];
-	}
-
-	return crc;
-}
-
-uint8_t TAP_ESC::crc_packet(EscPacket &p)
-{
-	/* Calculate the crc over Len,ID,data */
-	p.d.bytes[p.len] = crc8_esc(&p.len, p.len + 2);
-	return p.len + offsetof(EscPacket, d) + 1;
-}
 void TAP_ESC::select_responder(uint8_t sel)
 {
 #if defined(GPIO_S0)
@@ -417,151 +430,98 @@ void TAP_ESC::select_responder(uint8_t sel)
 }
 
 
-void TAP_ESC:: send_esc_outputs(const float *pwm, const unsigned num_pwm)
+void TAP_ESC::send_esc_outputs(const float *pwm, const unsigned num_pwm)
 {
+	/*
+	 * The RUN frame doubles as the telemetry request: the feedback flag is set
+	 * for one ESC per frame, round robin, and the mux is switched to that ESC.
+	 * Its answer is collected at the beginning of the next cycle, before the mux
+	 * is switched again, so reading feedback never delays the output frame.
+	 */
+	handle_feedback(num_pwm);
 
-	uint16_t rpm[TAP_ESC_MAX_MOTOR_NUM];
-	memset(rpm, 0, sizeof(rpm));
-	uint8_t motor_cnt = num_pwm;
-	static uint8_t which_to_respone = 0;
-
-	for (uint8_t i = 0; i < motor_cnt; i++) {
-		rpm[i] = pwm[i];
-
-		if (rpm[i] > RPMMAX) {
-			rpm[i] = RPMMAX;
-
-		} else if (rpm[i] < RPMSTOPPED) {
-			rpm[i] = RPMSTOPPED;
-		}
+	if (++_responding_esc >= _channels_count) {
+		_responding_esc = 0;
 	}
 
-	rpm[which_to_respone] |= (RUN_FEEDBACK_ENABLE_MASK | RUN_BLUE_LED_ON_MASK);
-
-
-	EscPacket packet = {0xfe, _channels_count, ESCBUS_MSG_ID_RUN};
-	packet.len *= sizeof(packet.d.reqRun.rpm_flags[0]);
+	RunReq &run = _run_packet.d.reqRun;
 
 	for (uint8_t i = 0; i < _channels_count; i++) {
-		packet.d.reqRun.rpm_flags[i] = rpm[i];
-	}
-
-	int ret = send_packet(packet, which_to_respone);
-
-	if (++which_to_respone == _channels_count) {
-		which_to_respone = 0;
-	}
-
-	if (ret < 1) {
-		PX4_WARN("TX ERROR: ret: %d, errno: %d", ret, errno);
-	}
-}
+		uint16_t rpm = RPMSTOPPED;
 
-void TAP_ESC::read_data_from_uart()
-{
-	uint8_t tmp_serial_buf[UART_BUFFER_SIZE];
-
-	int len =::read(_uart_fd, tmp_serial_buf, arraySize(tmp_serial_buf));
+		if (i < num_pwm) {
+			rpm = pwm[i];
 
-	if (len > 0 && (uartbuf.dat_cnt + len < UART_BUFFER_SIZE)) {
-		for (int i = 0; i < len; i++) {
-			uartbuf.esc_feedback_buf[uartbuf.tail++] = tmp_serial_buf[i];
-			uartbuf.dat_cnt++;
+			if (rpm > RPMMAX) {
+				rpm = RPMMAX;
 
-			if (uartbuf.tail >= UART_BUFFER_SIZE) {
-				uartbuf.tail = 0;
+			} else if (rpm < RPMSTOPPED) {
+				rpm = RPMSTOPPED;
 			}
 		}
-	}
-}
-
-bool TAP_ESC:: parse_tap_esc_feedback(ESC_UART_BUF *serial_buf, EscPacket *packetdata)
-{
-	static PARSR_ESC_STATE state = HEAD;
-	static uint8_t data_index = 0;
-	static uint8_t crc_data_cal;
-
-	if (serial_buf->dat_cnt > 0) {
-		int count = serial_buf->dat_cnt;
-
-		for (int i = 0; i < count; i++) {
-			switch (state) {
-			case HEAD:
-				if (serial_buf->esc_feedback_buf[serial_buf->head] == 0xFE) {
-					packetdata->head = 0xFE; //just_keep the format
-					state = LEN;
-				}
-
-				break;
-
-			case LEN:
-				if (serial_buf->esc_feedback_buf[serial_buf->head] < sizeof(packetdata->d)) {
-					packetdata->len = serial_buf->esc_feedback_buf[serial_buf->head];
-					state = ID;
-
-				} else {
-					state = HEAD;
-				}
-
-				break;
-
-			case ID:
-				if (serial_buf->esc_feedback_buf[serial_buf->head] < ESCBUS_MSG_ID_MAX_NUM) {
-					packetdata->msg_id = serial_buf->esc_feedback_buf[serial_buf->head];
-					data_index = 0;
-					state = DATA;
-
-				} else {
-					state = HEAD;
-				}
 
-				break;
+		run.rpm_flags[i] = rpm;
+	}
 
-			case DATA:
-				packetdata->d.bytes[data_index++] = serial_buf->esc_feedback_buf[serial_buf->head];
+	run.rpm_flags[_responding_esc] |= (RUN_FEEDBACK_ENABLE_MASK | RUN_BLUE_LED_ON_MASK);
 
-				if (data_index >= packetdata->len) {
+	perf_count(_perf_output);
+	send_packet(_run_packet, _responding_esc);
+}
 
-					crc_data_cal = crc8_esc((uint8_t *)(&packetdata->len), packetdata->len + 2);
-					state = CRC;
-				}
+void TAP_ESC::handle_feedback(unsigned esc_count)
+{
+	if (tap_esc_common::read_data_from_uart(_uart_fd, &uartbuf) <= 0 && uartbuf.dat_cnt == 0) {
+		return;
+	}
 
-				break;
+	bool updated = false;
 
-			case CRC:
-				if (crc_data_cal == serial_buf->esc_feedback_buf[serial_buf->head]) {
-					packetdata->crc_data = serial_buf->esc_feedback_buf[serial_buf->head];
+	while (tap_esc_common::parse_tap_esc_feedback(&uartbuf, &_parser, &_packet)) {
+		if (_packet.msg_id != ESCBUS_MSG_ID_RUN_INFO) {
+			continue;
+		}
 
-					if (++serial_buf->head >= UART_BUFFER_SIZE) {
-						serial_buf->head = 0;
-					}
+		const RunInfoRepsonse &feed_back_data = _packet.d.rspRunInfo;
 
-					serial_buf->dat_cnt--;
-					state = HEAD;
-					return true;
-				}
+		if (feed_back_data.channelID < esc_status_s::CONNECTED_ESC_MAX) {
+			_esc_feedback.esc[feed_back_data.channelID].esc_rpm = feed_back_data.speed;
+//			_esc_feedback.esc[feed_back_data.channelID].esc_voltage = feed_back_data.voltage;
+			_esc_feedback.esc[feed_back_data.channelID].esc_state = feed_back_data.ESCStatus;
+			_esc_feedback.esc[feed_back_data.channelID].esc_vendor = esc_status_s::ESC_VENDOR_TAP;
 
-				state = HEAD;
-				break;
+			if (feed_back_data.channelID < TAP_ESC_MAX_MOTOR_NUM) {
+				_feedback_count[feed_back_data.channelID]++;
+				_feedback_timestamp[feed_back_data.channelID] = hrt_absolute_time();
+			}
 
-			default:
-				state = HEAD;
-				break;
+			updated = true;
+		}
+	}
 
-			}
+	if (updated) {
+		_esc_feedback.esc_connectiontype = esc_status_s::ESC_CONNECTION_TYPE_SERIAL;
+		_esc_feedback.counter++;
+		_esc_feedback.esc_count = esc_count;
 
-			if (++serial_buf->head >= UART_BUFFER_SIZE) {
-				serial_buf->head = 0;
-			}
+		_esc_feedback.timestamp = hrt_absolute_time();
 
-			serial_buf->dat_cnt--;
+		orb_publish(ORB_ID(esc_status), _esc_feedback_pub, &_esc_feedback);
+	}
+}
 
-		}
+void TAP_ESC::print_info()
+{
+	perf_print_counter(_perf_output);
+	perf_print_counter(_perf_tx_errors);
+	PX4_INFO("feedback crc errors: %u", (unsigned)_parser.crc_errors);
 
+	const hrt_abstime now = hrt_absolute_time();
 
+	for (uint8_t i = 0; i < _channels_count; i++) {
+		PX4_INFO("esc %u: %u feedback frames, last %.1f ms ago", i, (unsigned)_feedback_count[i],
+			 _feedback_timestamp[i] > 0 ? (double)(now - _feedback_timestamp[i]) / 1e3 : -1.0);
 	}
-
-	return false;
 }
 
 void
@@ -743,30 +703,6 @@ TAP_ESC::cycle()
 		}
 
 		send_esc_outputs(motor_out, esc_count);
-		read_data_from_uart();
-
-		if (parse_tap_esc_feedback(&uartbuf, &_packet) == true) {
-			if (_packet.msg_id == ESCBUS_MSG_ID_RUN_INFO) {
-				RunInfoRepsonse &feed_back_data = _packet.d.rspRunInfo;
-
-				if (feed_back_data.channelID < esc_status_s::CONNECTED_ESC_MAX) {
-					_esc_feedback.esc[feed_back_data.channelID].esc_rpm = feed_back_data.speed;
-//					_esc_feedback.esc[feed_back_data.channelID].esc_voltage = feed_back_data.voltage;
-					_esc_feedback.esc[feed_back_data.channelID].esc_state = feed_back_data.ESCStatus;
-					_esc_feedback.esc[feed_back_data.channelID].esc_vendor = esc_status_s::ESC_VENDOR_TAP;
-					// printf("vol is %d\n",feed_back_data.voltage );
-					// printf("speed is %d\n",feed_back_data.speed );
-
-					_esc_feedback.esc_connectiontype = esc_status_s::ESC_CONNECTION_TYPE_SERIAL;
-					_esc_feedback.counter++;
-					_esc_feedback.esc_count = esc_count;
-
-					_esc_feedback.timestamp = hrt_absolute_time();
-
-					orb_publish(ORB_ID(esc_status), _esc_feedback_pub, &_esc_feedback);
-				}
-			}
-		}
 
 		/* and publish for anyone that cares to see */
 		orb_publish(ORB_ID(actuator_outputs), _outputs_pub, &_outputs);
@@ -857,7 +793,7 @@ TAP_ESC::control_callback(uintptr_t handle,
 }
 
 int
-TAP_ESC::ioctl(file *filp, int cmd, unsigned long arg)
+TAP_ESC::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 {
 	int ret = OK;
 
@@ -1002,9 +938,14 @@ int initialise_uart()
 
 	// set baud rate
 	if (cfsetispeed(&uart_config, speed) < 0 || cfsetospeed(&uart_config, speed) < 0) {
+#ifdef __PX4_POSIX
+		/* the ESC stand-in (tapescsim) is a pseudo terminal, which has no baudrate */
+		PX4_WARN("failed to set baudrate for %s, continuing", _device);
+#else
 		PX4_ERR("failed to set baudrate for %s: %d\n", _device, termios_state);
 		close(_uart_fd);
 		return -1;
+#endif
 	}
 
 	if ((termios_state = tcsetattr(_uart_fd, TCSANOW, &uart_config)) < 0) {
@@ -1191,6 +1132,11 @@ int tap_esc_main(int argc, char *argv[])
 
 	else if (!strcmp(verb, "status")) {
 		PX4_WARN("tap_esc is %s", tap_esc_drv::_is_running ? "running" : "not running");
+
+		if (tap_esc != nullptr) {
+			tap_esc->print_info();
+		}
+
 		return 0;
 
 	} else {
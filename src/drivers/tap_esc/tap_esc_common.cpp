@@ -0,0 +1,264 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file tap_esc_common.cpp
+ *
+ */
+
+#include "tap_esc_common.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace tap_esc_common
+{
+
+static const uint8_t crc_table[256] = TAP_ESC_CRC;
+
+/*
+ * crc_slice[k][x] is the crc of the byte x followed by k + 1 zero bytes.
+ * The crc is linear, so 4 bytes can be folded in with 4 independent lookups:
+ * crc' = slice[2][crc ^ b0] ^ slice[1][b1] ^ slice[0][b2] ^ table[b3]
+ */
+static const uint8_t crc_slice[3][256] = {
+	{
+		0x00, 0x7D, 0xFA, 0x87, 0x13, 0x6E, 0xE9, 0x94, 0x26, 0x5B, 0xDC, 0xA1, 0x35, 0x48, 0xCF, 0xB2,
+		0x4C, 0x31, 0xB6, 0xCB, 0x5F, 0x22, 0xA5, 0xD8, 0x6A, 0x17, 0x90, 0xED, 0x79, 0x04, 0x83, 0xFE,
+		0x98, 0xE5, 0x62, 0x1F, 0x8B, 0xF6, 0x71, 0x0C, 0xBE, 0xC3, 0x44, 0x39, 0xAD, 0xD0, 0x57, 0x2A,
+		0xD4, 0xA9, 0x2E, 0x53, 0xC7, 0xBA, 0x3D, 0x40, 0xF2, 0x8F, 0x08, 0x75, 0xE1, 0x9C, 0x1B, 0x66,
+		0xD7, 0xAA, 0x2D, 0x50, 0xC4, 0xB9, 0x3E, 0x43, 0xF1, 0x8C, 0x0B, 0x76, 0xE2, 0x9F, 0x18, 0x65,
+		0x9B, 0xE6, 0x61, 0x1C, 0x88, 0xF5, 0x72, 0x0F, 0xBD, 0xC0, 0x47, 0x3A, 0xAE, 0xD3, 0x54, 0x29,
+		0x4F, 0x32, 0xB5, 0xC8, 0x5C, 0x21, 0xA6, 0xDB, 0x69, 0x14, 0x93, 0xEE, 0x7A, 0x07, 0x80, 0xFD,
+		0x03, 0x7E, 0xF9, 0x84, 0x10, 0x6D, 0xEA, 0x97, 0x25, 0x58, 0xDF, 0xA2, 0x36, 0x4B, 0xCC, 0xB1,
+		0x49, 0x34, 0xB3, 0xCE, 0x5A, 0x27, 0xA0, 0xDD, 0x6F, 0x12, 0x95, 0xE8, 0x7C, 0x01, 0x86, 0xFB,
+		0x05, 0x78, 0xFF, 0x82, 0x16, 0x6B, 0xEC, 0x91, 0x23, 0x5E, 0xD9, 0xA4, 0x30, 0x4D, 0xCA, 0xB7,
+		0xD1, 0xAC, 0x2B, 0x56, 0xC2, 0xBF, 0x38, 0x45, 0xF7, 0x8A, 0x0D, 0x70, 0xE4, 0x99, 0x1E, 0x63,
+		0x9D, 0xE0, 0x67, 0x1A, 0x8E, 0xF3, 0x74, 0x09, 0xBB, 0xC6, 0x41, 0x3C, 0xA8, 0xD5, 0x52, 0x2F,
+		0x9E, 0xE3, 0x64, 0x19, 0x8D, 0xF0, 0x77, 0x0A, 0xB8, 0xC5, 0x42, 0x3F, 0xAB, 0xD6, 0x51, 0x2C,
+		0xD2, 0xAF, 0x28, 0x55, 0xC1, 0xBC, 0x3B, 0x46, 0xF4, 0x89, 0x0E, 0x73, 0xE7, 0x9A, 0x1D, 0x60,
+		0x06, 0x7B, 0xFC, 0x81, 0x15, 0x68, 0xEF, 0x92, 0x20, 0x5D, 0xDA, 0xA7, 0x33, 0x4E, 0xC9, 0xB4,
+		0x4A, 0x37, 0xB0, 0xCD, 0x59, 0x24, 0xA3, 0xDE, 0x6C, 0x11, 0x96, 0xEB, 0x7F, 0x02, 0x85, 0xF8,
+	},
+	{
+		0x00, 0x92, 0xC3, 0x51, 0x61, 0xF3, 0xA2, 0x30, 0xC2, 0x50, 0x01, 0x93, 0xA3, 0x31, 0x60, 0xF2,
+		0x63, 0xF1, 0xA0, 0x32, 0x02, 0x90, 0xC1, 0x53, 0xA1, 0x33, 0x62, 0xF0, 0xC0, 0x52, 0x03, 0x91,
+		0xC6, 0x54, 0x05, 0x97, 0xA7, 0x35, 0x64, 0xF6, 0x04, 0x96, 0xC7, 0x55, 0x65, 0xF7, 0xA6, 0x34,
+		0xA5, 0x37, 0x66, 0xF4, 0xC4, 0x56, 0x07, 0x95, 0x67, 0xF5, 0xA4, 0x36, 0x06, 0x94, 0xC5, 0x57,
+		0x6B, 0xF9, 0xA8, 0x3A, 0x0A, 0x98, 0xC9, 0x5B, 0xA9, 0x3B, 0x6A, 0xF8, 0xC8, 0x5A, 0x0B, 0x99,
+		0x08, 0x9A, 0xCB, 0x59, 0x69, 0xFB, 0xAA, 0x38, 0xCA, 0x58, 0x09, 0x9B, 0xAB, 0x39, 0x68, 0xFA,
+		0xAD, 0x3F, 0x6E, 0xFC, 0xCC, 0x5E, 0x0F, 0x9D, 0x6F, 0xFD, 0xAC, 0x3E, 0x0E, 0x9C, 0xCD, 0x5F,
+		0xCE, 0x5C, 0x0D, 0x9F, 0xAF, 0x3D, 0x6C, 0xFE, 0x0C, 0x9E, 0xCF, 0x5D, 0x6D, 0xFF, 0xAE, 0x3C,
+		0xD6, 0x44, 0x15, 0x87, 0xB7, 0x25, 0x74, 0xE6, 0x14, 0x86, 0xD7, 0x45, 0x75, 0xE7, 0xB6, 0x24,
+		0xB5, 0x27, 0x76, 0xE4, 0xD4, 0x46, 0x17, 0x85, 0x77, 0xE5, 0xB4, 0x26, 0x16, 0x84, 0xD5, 0x47,
+		0x10, 0x82, 0xD3, 0x41, 0x71, 0xE3, 0xB2, 0x20, 0xD2, 0x40, 0x11, 0x83, 0xB3, 0x21, 0x70, 0xE2,
+		0x73, 0xE1, 0xB0, 0x22, 0x12, 0x80, 0xD1, 0x43, 0xB1, 0x23, 0x72, 0xE0, 0xD0, 0x42, 0x13, 0x81,
+		0xBD, 0x2F, 0x7E, 0xEC, 0xDC, 0x4E, 0x1F, 0x8D, 0x7F, 0xED, 0xBC, 0x2E, 0x1E, 0x8C, 0xDD, 0x4F,
+		0xDE, 0x4C, 0x1D, 0x8F, 0xBF, 0x2D, 0x7C, 0xEE, 0x1C, 0x8E, 0xDF, 0x4D, 0x7D, 0xEF, 0xBE, 0x2C,
+		0x7B, 0xE9, 0xB8, 0x2A, 0x1A, 0x88, 0xD9, 0x4B, 0xB9, 0x2B, 0x7A, 0xE8, 0xD8, 0x4A, 0x1B, 0x89,
+		0x18, 0x8A, 0xDB, 0x49, 0x79, 0xEB, 0xBA, 0x28, 0xDA, 0x48, 0x19, 0x8B, 0xBB, 0x29, 0x78, 0xEA,
+	},
+	{
+		0x00, 0x4B, 0x96, 0xDD, 0xCB, 0x80, 0x5D, 0x16, 0x71, 0x3A, 0xE7, 0xAC, 0xBA, 0xF1, 0x2C, 0x67,
+		0xE2, 0xA9, 0x74, 0x3F, 0x29, 0x62, 0xBF, 0xF4, 0x93, 0xD8, 0x05, 0x4E, 0x58, 0x13, 0xCE, 0x85,
+		0x23, 0x68, 0xB5, 0xFE, 0xE8, 0xA3, 0x7E, 0x35, 0x52, 0x19, 0xC4, 0x8F, 0x99, 0xD2, 0x0F, 0x44,
+		0xC1, 0x8A, 0x57, 0x1C, 0x0A, 0x41, 0x9C, 0xD7, 0xB0, 0xFB, 0x26, 0x6D, 0x7B, 0x30, 0xED, 0xA6,
+		0x46, 0x0D, 0xD0, 0x9B, 0x8D, 0xC6, 0x1B, 0x50, 0x37, 0x7C, 0xA1, 0xEA, 0xFC, 0xB7, 0x6A, 0x21,
+		0xA4, 0xEF, 0x32, 0x79, 0x6F, 0x24, 0xF9, 0xB2, 0xD5, 0x9E, 0x43, 0x08, 0x1E, 0x55, 0x88, 0xC3,
+		0x65, 0x2E, 0xF3, 0xB8, 0xAE, 0xE5, 0x38, 0x73, 0x14, 0x5F, 0x82, 0xC9, 0xDF, 0x94, 0x49, 0x02,
+		0x87, 0xCC, 0x11, 0x5A, 0x4C, 0x07, 0xDA, 0x91, 0xF6, 0xBD, 0x60, 0x2B, 0x3D, 0x76, 0xAB, 0xE0,
+		0x8C, 0xC7, 0x1A, 0x51, 0x47, 0x0C, 0xD1, 0x9A, 0xFD, 0xB6, 0x6B, 0x20, 0x36, 0x7D, 0xA0, 0xEB,
+		0x6E, 0x25, 0xF8, 0xB3, 0xA5, 0xEE, 0x33, 0x78, 0x1F, 0x54, 0x89, 0xC2, 0xD4, 0x9F, 0x42, 0x09,
+		0xAF, 0xE4, 0x39, 0x72, 0x64, 0x2F, 0xF2, 0xB9, 0xDE, 0x95, 0x48, 0x03, 0x15, 0x5E, 0x83, 0xC8,
+		0x4D, 0x06, 0xDB, 0x90, 0x86, 0xCD, 0x10, 0x5B, 0x3C, 0x77, 0xAA, 0xE1, 0xF7, 0xBC, 0x61, 0x2A,
+		0xCA, 0x81, 0x5C, 0x17, 0x01, 0x4A, 0x97, 0xDC, 0xBB, 0xF0, 0x2D, 0x66, 0x70, 0x3B, 0xE6, 0xAD,
+		0x28, 0x63, 0xBE, 0xF5, 0xE3, 0xA8, 0x75, 0x3E, 0x59, 0x12, 0xCF, 0x84, 0x92, 0xD9, 0x04, 0x4F,
+		0xE9, 0xA2, 0x7F, 0x34, 0x22, 0x69, 0xB4, 0xFF, 0x98, 0xD3, 0x0E, 0x45, 0x53, 0x18, 0xC5, 0x8E,
+		0x0B, 0x40, 0x9D, 0xD6, 0xC0, 0x8B, 0x56, 0x1D, 0x7A, 0x31, 0xEC, 0xA7, 0xB1, 0xFA, 0x27, 0x6C,
+	},
+};
+
+void reset(ESC_UART_BUF *serial_buf, EscParser *parser)
+{
+	serial_buf->head = 0;
+	serial_buf->tail = 0;
+	serial_buf->dat_cnt = 0;
+	parser->state = HEAD;
+	parser->data_index = 0;
+	parser->crc_errors = 0;
+}
+
+uint8_t crc8_esc(const uint8_t *p, uint8_t len)
+{
+	uint8_t crc = 0;
+
+	while (len >= 4) {
+		crc = crc_slice[2][crc ^ p[0]] ^ crc_slice[1][p[1]] ^ crc_slice[0][p[2]] ^ crc_table[p[3]];
+		p += 4;
+		len -= 4;
+	}
+
+	while (len--) {
+		crc = crc_table[crc ^ *p++];
+	}
+
+	return crc;
+}
+
+uint8_t crc_packet(EscPacket &p)
+{
+	/* Calculate the crc over Len,ID,data */
+	p.d.bytes[p.len] = crc8_esc(&p.len, p.len + 2);
+	return p.len + offsetof(EscPacket, d) + 1;
+}
+
+int read_data_from_uart(int uart_fd, ESC_UART_BUF *serial_buf)
+{
+	int total = 0;
+
+	/* at most two contiguous free regions: [tail, end) and [0, head) */
+	while (serial_buf->dat_cnt < UART_BUFFER_SIZE) {
+		unsigned space = UART_BUFFER_SIZE - serial_buf->tail;
+
+		if (space > (unsigned)(UART_BUFFER_SIZE - serial_buf->dat_cnt)) {
+			space = UART_BUFFER_SIZE - serial_buf->dat_cnt;
+		}
+
+		int len = ::read(uart_fd, &serial_buf->esc_feedback_buf[serial_buf->tail], space);
+
+		if (len <= 0) {
+			if (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK && total == 0) {
+				return -errno;
+			}
+
+			break;
+		}
+
+		total += len;
+		serial_buf->dat_cnt += len;
+		serial_buf->tail += len;
+
+		if (serial_buf->tail >= UART_BUFFER_SIZE) {
+			serial_buf->tail = 0;
+		}
+
+		if ((unsigned)len < space) {
+			/* drained */
+			break;
+		}
+	}
+
+	return total;
+}
+
+bool parse_tap_esc_feedback(ESC_UART_BUF *serial_buf, EscParser *parser, EscPacket *packetdata)
+{
+	while (serial_buf->dat_cnt > 0) {
+		const uint8_t c = serial_buf->esc_feedback_buf[serial_buf->head];
+		bool complete = false;
+
+		if (++serial_buf->head >= UART_BUFFER_SIZE) {
+			serial_buf->head = 0;
+		}
+
+		serial_buf->dat_cnt--;
+
+		switch (parser->state) {
+		case HEAD:
+			if (c == 0xFE) {
+				packetdata->head = 0xFE; //just_keep the format
+				parser->state = LEN;
+			}
+
+			break;
+
+		case LEN:
+			if (c < sizeof(packetdata->d)) {
+				packetdata->len = c;
+				parser->state = ID;
+
+			} else {
+				parser->state = HEAD;
+			}
+
+			break;
+
+		case ID:
+			if (c < ESCBUS_MSG_ID_MAX_NUM) {
+				packetdata->msg_id = c;
+				parser->data_index = 0;
+				parser->state = packetdata->len > 0 ? DATA : CRC;
+
+			} else {
+				parser->state = HEAD;
+			}
+
+			break;
+
+		case DATA:
+			packetdata->d.bytes[parser->data_index++] = c;
+
+			if (parser->data_index >= packetdata->len) {
+				parser->state = CRC;
+			}
+
+			break;
+
+		case CRC:
+			if (crc8_esc(&packetdata->len, packetdata->len + 2) == c) {
+				packetdata->crc_data = c;
+				complete = true;
+
+			} else {
+				parser->crc_errors++;
+			}
+
+			parser->state = HEAD;
+			break;
+
+		default:
+			parser->state = HEAD;
+			break;
+		}
+
+		if (complete) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+} /* tap_esc_common */
@@ -0,0 +1,93 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file tap_esc_common.h
+ *
+ * Framing, CRC and feedback parsing of the TAP ESC serial protocol, shared by the
+ * tap_esc driver and the POSIX ESC stand-in (tapescsim).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "drv_tap_esc.h"
+
+namespace tap_esc_common
+{
+
+/**
+ * Feedback parser state. Kept outside of the parse function so that several
+ * streams can be decoded independently.
+ */
+struct EscParser {
+	PARSR_ESC_STATE state;
+	uint8_t data_index;
+	uint32_t crc_errors;		///< number of frames dropped because of a CRC mismatch
+};
+
+/**
+ * Reset a receive ring buffer and its parser.
+ */
+void reset(ESC_UART_BUF *serial_buf, EscParser *parser);
+
+/**
+ * CRC8 over a buffer, processing 4 bytes per step (slice-by-4).
+ * @param p buffer
+ * @param len length of the buffer in bytes
+ */
+uint8_t crc8_esc(const uint8_t *p, uint8_t len);
+
+/**
+ * Calculate and append the crc over len, msg_id and data of a packet.
+ * @return length of the whole frame in bytes, starting at the head byte
+ */
+uint8_t crc_packet(EscPacket &p);
+
+/**
+ * Append all pending bytes of a non-blocking file descriptor to the ring buffer.
+ * Data is read straight into the free region(s) of the ring, without an
+ * intermediate copy. Never blocks.
+ * @return number of bytes read, or < 0 on error
+ */
+int read_data_from_uart(int uart_fd, ESC_UART_BUF *serial_buf);
+
+/**
+ * Parse buffered data until a complete, valid packet is found.
+ * Call repeatedly until it returns false to decode all buffered packets.
+ * @return true if a packet has been decoded into packetdata
+ */
+bool parse_tap_esc_feedback(ESC_UART_BUF *serial_buf, EscParser *parser, EscPacket *packetdata);
+
+} /* tap_esc_common */
@@ -172,6 +172,10 @@ int attitude_estimator_ekf_main(int argc, char *argv[])
 		}
 
 		thread_should_exit = false;
+
+		/* load the mag grid file before the estimator loop needs it */
+		geo_mag_grid_init();
+
 		attitude_estimator_ekf_task = px4_task_spawn_cmd("attitude_estimator_ekf",
 					      SCHED_DEFAULT,
 					      SCHED_PRIORITY_MAX - 5,
@@ -1221,6 +1221,9 @@ int AttitudePositionEstimatorEKF::start()
 {
 	ASSERT(_estimator_task == -1);
 
+	/* load the mag grid file before the estimator loop needs it */
+	geo_mag_grid_init();
+
 	/* start the task */
 	_estimator_task = px4_task_spawn_cmd("ekf_att_pos_estimator",
 					     SCHED_DEFAULT,
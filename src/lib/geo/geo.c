@@ -202,6 +202,214 @@ __EXPORT int map_projection_reproject(const struct map_projection_reference_s *r
 	return 0;
 }
 
+/*
+ * Batch variants of the projection and waypoint functions.
+ *
+ * The reference point trig terms come from the map_projection_reference_s, so
+ * only the per point terms are evaluated. The inner loops are kept free of
+ * function calls and branches so they can be auto-vectorized.
+ *
+ * The fast variants work in single precision on the offset to the reference
+ * (which is formed in double precision to avoid cancellation) and replace
+ * sin/cos/acos by truncated series. Inside GEO_FAST_MAX_DELTA_RAD the series
+ * truncation error is below 1e-10 and the result is limited by float rounding
+ * (a few millimeters within 10 km of the reference). Points outside that range
+ * are recomputed with the double precision scalar functions.
+ */
+
+#define GEO_FAST_MAX_DELTA_RAD	0.1f
+
+/* sin(x) for |x| <= GEO_FAST_MAX_DELTA_RAD */
+static inline float geo_sin_small(float x)
+{
+	const float x2 = x * x;
+	return x * (1.0f - x2 * (1.0f / 6.0f - x2 * (1.0f / 120.0f - x2 * (1.0f / 5040.0f))));
+}
+
+/* 1 - cos(x) for |x| <= GEO_FAST_MAX_DELTA_RAD, without the cancellation of the direct form */
+static inline float geo_versin_small(float x)
+{
+	const float x2 = x * x;
+	return x2 * (0.5f - x2 * (1.0f / 24.0f - x2 * (1.0f / 720.0f - x2 * (1.0f / 40320.0f))));
+}
+
+/* asin(s) / s as a function of s^2, for small s */
+static inline float geo_asin_ratio(float s2)
+{
+	return 1.0f + s2 * (1.0f / 6.0f + s2 * (3.0f / 40.0f + s2 * (5.0f / 112.0f + s2 * (35.0f / 1152.0f))));
+}
+
+static inline bool geo_fast_in_range(float d_lat, float d_lon)
+{
+	return (fabsf(d_lat) <= GEO_FAST_MAX_DELTA_RAD) && (fabsf(d_lon) <= GEO_FAST_MAX_DELTA_RAD);
+}
+
+__EXPORT int map_projection_project_n(const struct map_projection_reference_s *ref, const double *lat,
+				      const double *lon, float *x, float *y, unsigned n)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	for (unsigned i = 0; i < n; i++) {
+		map_projection_project(ref, lat[i], lon[i], &x[i], &y[i]);
+	}
+
+	return 0;
+}
+
+__EXPORT int map_projection_project_n_fast(const struct map_projection_reference_s *ref, const double *lat,
+		const double *lon, float *x, float *y, unsigned n)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	const float sin_lat_0 = ref->sin_lat;
+	const float cos_lat_0 = ref->cos_lat;
+	bool out_of_range = false;
+
+	for (unsigned i = 0; i < n; i++) {
+		const float d_lat = (float)(lat[i] * M_DEG_TO_RAD - ref->lat_rad);
+		const float d_lon = (float)(lon[i] * M_DEG_TO_RAD - ref->lon_rad);
+
+		const float sin_d_lat = geo_sin_small(d_lat);
+		const float cos_d_lat = 1.0f - geo_versin_small(d_lat);
+		const float sin_d_lon = geo_sin_small(d_lon);
+		const float versin_d_lon = geo_versin_small(d_lon);
+
+		/* cos(lat) and the north component expanded around the reference latitude */
+		const float cos_lat = cos_lat_0 * cos_d_lat - sin_lat_0 * sin_d_lat;
+		const float n_unit = sin_d_lat * (1.0f - sin_lat_0 * sin_lat_0 * versin_d_lon)
+				     + sin_lat_0 * cos_lat_0 * cos_d_lat * versin_d_lon;
+		const float e_unit = cos_lat * sin_d_lon;
+
+		/* n_unit^2 + e_unit^2 = sin(c)^2, k = c / sin(c) */
+		const float k = geo_asin_ratio(n_unit * n_unit + e_unit * e_unit) * CONSTANTS_RADIUS_OF_EARTH;
+
+		x[i] = k * n_unit;
+		y[i] = k * e_unit;
+
+		out_of_range |= !geo_fast_in_range(d_lat, d_lon);
+	}
+
+	if (out_of_range) {
+		for (unsigned i = 0; i < n; i++) {
+			const float d_lat = (float)(lat[i] * M_DEG_TO_RAD - ref->lat_rad);
+			const float d_lon = (float)(lon[i] * M_DEG_TO_RAD - ref->lon_rad);
+
+			if (!geo_fast_in_range(d_lat, d_lon)) {
+				map_projection_project(ref, lat[i], lon[i], &x[i], &y[i]);
+			}
+		}
+	}
+
+	return 0;
+}
+
+__EXPORT int map_projection_reproject_n(const struct map_projection_reference_s *ref, const float *x,
+					const float *y, double *lat, double *lon, unsigned n)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	for (unsigned i = 0; i < n; i++) {
+		map_projection_reproject(ref, x[i], y[i], &lat[i], &lon[i]);
+	}
+
+	return 0;
+}
+
+__EXPORT int get_distance_to_next_waypoint_n(const struct map_projection_reference_s *ref, const double *lat_next,
+		const double *lon_next, float *dist, unsigned n)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	const float sin_lat_0 = ref->sin_lat;
+	const float cos_lat_0 = ref->cos_lat;
+	bool out_of_range = false;
+
+	for (unsigned i = 0; i < n; i++) {
+		const float d_lat = (float)(lat_next[i] * M_DEG_TO_RAD - ref->lat_rad);
+		const float d_lon = (float)(lon_next[i] * M_DEG_TO_RAD - ref->lon_rad);
+
+		const float cos_lat = cos_lat_0 * (1.0f - geo_versin_small(d_lat)) - sin_lat_0 * geo_sin_small(d_lat);
+
+		/* haversine, sin^2(x / 2) = versin(x) / 2 */
+		const float a = 0.5f * (geo_versin_small(d_lat) + geo_versin_small(d_lon) * cos_lat_0 * cos_lat);
+
+		dist[i] = 2.0f * CONSTANTS_RADIUS_OF_EARTH * sqrtf(a) * geo_asin_ratio(a);
+
+		out_of_range |= !geo_fast_in_range(d_lat, d_lon);
+	}
+
+	if (out_of_range) {
+		const double lat_now = ref->lat_rad * M_RAD_TO_DEG;
+		const double lon_now = ref->lon_rad * M_RAD_TO_DEG;
+
+		for (unsigned i = 0; i < n; i++) {
+			const float d_lat = (float)(lat_next[i] * M_DEG_TO_RAD - ref->lat_rad);
+			const float d_lon = (float)(lon_next[i] * M_DEG_TO_RAD - ref->lon_rad);
+
+			if (!geo_fast_in_range(d_lat, d_lon)) {
+				dist[i] = get_distance_to_next_waypoint(lat_now, lon_now, lat_next[i], lon_next[i]);
+			}
+		}
+	}
+
+	return 0;
+}
+
+__EXPORT int get_bearing_to_next_waypoint_n(const struct map_projection_reference_s *ref, const double *lat_next,
+		const double *lon_next, float *bearing, unsigned n)
+{
+	if (!map_projection_initialized(ref)) {
+		return -1;
+	}
+
+	const float sin_lat_0 = ref->sin_lat;
+	const float cos_lat_0 = ref->cos_lat;
+	bool out_of_range = false;
+
+	for (unsigned i = 0; i < n; i++) {
+		const float d_lat = (float)(lat_next[i] * M_DEG_TO_RAD - ref->lat_rad);
+		const float d_lon = (float)(lon_next[i] * M_DEG_TO_RAD - ref->lon_rad);
+
+		const float sin_d_lat = geo_sin_small(d_lat);
+		const float cos_d_lat = 1.0f - geo_versin_small(d_lat);
+		const float versin_d_lon = geo_versin_small(d_lon);
+
+		/* same north/east terms as the projection, the bearing does not need the scale */
+		const float cos_lat = cos_lat_0 * cos_d_lat - sin_lat_0 * sin_d_lat;
+		const float n_unit = sin_d_lat * (1.0f - sin_lat_0 * sin_lat_0 * versin_d_lon)
+				     + sin_lat_0 * cos_lat_0 * cos_d_lat * versin_d_lon;
+		const float e_unit = cos_lat * geo_sin_small(d_lon);
+
+		bearing[i] = atan2f(e_unit, n_unit);
+
+		out_of_range |= !geo_fast_in_range(d_lat, d_lon);
+	}
+
+	if (out_of_range) {
+		const double lat_now = ref->lat_rad * M_RAD_TO_DEG;
+		const double lon_now = ref->lon_rad * M_RAD_TO_DEG;
+
+		for (unsigned i = 0; i < n; i++) {
+			const float d_lat = (float)(lat_next[i] * M_DEG_TO_RAD - ref->lat_rad);
+			const float d_lon = (float)(lon_next[i] * M_DEG_TO_RAD - ref->lon_rad);
+
+			if (!geo_fast_in_range(d_lat, d_lon)) {
+				bearing[i] = get_bearing_to_next_waypoint(lat_now, lon_now, lat_next[i], lon_next[i]);
+			}
+		}
+	}
+
+	return 0;
+}
+
 __EXPORT int map_projection_global_getref(double *lat_0, double *lon_0)
 {
 	if (!map_projection_global_initialized()) {
@@ -196,6 +196,40 @@ __EXPORT int map_projection_global_reproject(float x, float y, double *lat, doub
 __EXPORT int map_projection_reproject(const struct map_projection_reference_s *ref, float x, float y, double *lat,
 				      double *lon);
 
+/**
+ * Transforms n points in the geographic coordinate system to the local
+ * azimuthal equidistant plane of the projection given by the argument.
+ * Double precision, same results as map_projection_project().
+ *
+ * @param lat array of n latitudes in degrees
+ * @param lon array of n longitudes in degrees
+ * @param x array of n north outputs
+ * @param y array of n east outputs
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_project_n(const struct map_projection_reference_s *ref, const double *lat,
+				      const double *lon, float *x, float *y, unsigned n);
+
+/**
+ * Single precision variant of map_projection_project_n() using series
+ * approximations around the reference. Points within ~600 km of the reference
+ * are accurate to float rounding (a few millimeters within 10 km), points
+ * further away fall back to the double precision path.
+ *
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_project_n_fast(const struct map_projection_reference_s *ref, const double *lat,
+		const double *lon, float *x, float *y, unsigned n);
+
+/**
+ * Transforms n points in the local azimuthal equidistant plane to the
+ * geographic coordinate system using the projection given by the argument
+ *
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int map_projection_reproject_n(const struct map_projection_reference_s *ref, const float *x,
+					const float *y, double *lat, double *lon, unsigned n);
+
 /**
  * Get reference position of the global map projection
  */
@@ -238,6 +272,20 @@ __EXPORT int globallocalconverter_getref(double *lat_0, double *lon_0, float *al
 __EXPORT float get_distance_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next);
 
 
+/**
+ * Returns the distances in meters from the reference point of the projection
+ * given by the argument to n waypoints. Uses the same approximation and
+ * fallback as map_projection_project_n_fast().
+ *
+ * @param ref projection initialized at the current position
+ * @param lat_next array of n latitudes in degrees
+ * @param lon_next array of n longitudes in degrees
+ * @param dist array of n distance outputs
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int get_distance_to_next_waypoint_n(const struct map_projection_reference_s *ref, const double *lat_next,
+		const double *lon_next, float *dist, unsigned n);
+
 /**
  * Creates a new waypoint C on the line of two given waypoints (A, B) at certain distance
  * from waypoint A
@@ -277,6 +325,20 @@ __EXPORT void waypoint_from_heading_and_distance(double lat_start, double lon_st
  */
 __EXPORT float get_bearing_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next);
 
+/**
+ * Returns the bearings in radians from the reference point of the projection
+ * given by the argument to n waypoints. Uses the same approximation and
+ * fallback as map_projection_project_n_fast().
+ *
+ * @param ref projection initialized at the current position
+ * @param lat_next array of n latitudes in degrees
+ * @param lon_next array of n longitudes in degrees
+ * @param bearing array of n bearing outputs in [-pi, pi]
+ * @return 0 if map_projection_init was called before, -1 else
+ */
+__EXPORT int get_bearing_to_next_waypoint_n(const struct map_projection_reference_s *ref, const double *lat_next,
+		const double *lon_next, float *bearing, unsigned n);
+
 __EXPORT void get_vector_to_next_waypoint(double lat_now, double lon_now, double lat_next, double lon_next, float *v_n,
 		float *v_e);
 
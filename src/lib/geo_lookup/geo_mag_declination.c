@@ -34,98 +34,284 @@
 /**
 * @file geo_mag_declination.c
 *
-* Calculation / lookup table for earth magnetic field declination.
+* Lookup of the earth magnetic field: declination, inclination and intensity.
 *
-* Lookup table from Scott Ferguson <scottfromscott@gmail.com>
+* The grid compiled into the firmware is generated from the World Magnetic
+* Model by Tools/generate_mag_grid.py (5 degree resolution, 10 degrees on boards
+* with little flash, see config_mag_grid_resolution). On POSIX a finer
+* grid file in the same format can be memory mapped instead, it is picked up
+* from MAG_GRID_FILE by geo_mag_grid_init() at startup or loaded with
+* geo_mag_grid_load().
 *
-* XXX Lookup table currently too coarse in resolution (only full degrees)
-* and lat/lon res - needs extension medium term.
+* Lookups read the active grid through mag_grid without locking. A grid is
+* completely set up before it is published there, and a mapped grid file is
+* never unmapped, so a lookup racing with a load or unload always sees a
+* valid grid.
 *
+* All lookups are a bilinear interpolation between the four surrounding grid
+* points, independent of the grid resolution.
 */
 
+#include <px4_defines.h>
 #include <geo/geo.h>
 
-/** set this always to the sampling in degrees for the table below */
-#define SAMPLING_RES		10.0f
-#define SAMPLING_MIN_LAT	-60.0f
-#define SAMPLING_MAX_LAT	60.0f
-#define SAMPLING_MIN_LON	-180.0f
-#define SAMPLING_MAX_LON	180.0f
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
-static const int8_t declination_table[13][37] = \
-{
-	{ 46, 45, 44, 42, 41, 40, 38, 36, 33, 28, 23, 16, 10, 4, -1, -5, -9, -14, -19, -26, -33, -40, -48, -55, -61, -66, -71, -74, -75, -72, -61, -25, 22, 40, 45, 47, 46 },
-	{ 30, 30, 30, 30, 29, 29, 29, 29, 27, 24, 18, 11, 3, -3, -9, -12, -15, -17, -21, -26, -32, -39, -45, -51, -55, -57, -56, -53, -44, -31, -14, 0, 13, 21, 26, 29, 30 },
-	{ 21, 22, 22, 22, 22, 22, 22, 22, 21, 18, 13, 5, -3, -11, -17, -20, -21, -22, -23, -25, -29, -35, -40, -44, -45, -44, -40, -32, -22, -12, -3, 3, 9, 14, 18, 20, 21 },
-	{ 16, 17, 17, 17, 17, 17, 16, 16, 16, 13, 8, 0, -9, -16, -21, -24, -25, -25, -23, -20, -21, -24, -28, -31, -31, -29, -24, -17, -9, -3, 0, 4, 7, 10, 13, 15, 16 },
-	{ 12, 13, 13, 13, 13, 13, 12, 12, 11, 9, 3, -4, -12, -19, -23, -24, -24, -22, -17, -12, -9, -10, -13, -17, -18, -16, -13, -8, -3, 0, 1, 3, 6, 8, 10, 12, 12 },
-	{ 10, 10, 10, 10, 10, 10, 10, 9, 9, 6, 0, -6, -14, -20, -22, -22, -19, -15, -10, -6, -2, -2, -4, -7, -8, -8, -7, -4, 0, 1, 1, 2, 4, 6, 8, 10, 10 },
-	{ 9, 9, 9, 9, 9, 9, 8, 8, 7, 4, -1, -8, -15, -19, -20, -18, -14, -9, -5, -2, 0, 1, 0, -2, -3, -4, -3, -2, 0, 0, 0, 1, 3, 5, 7, 8, 9 },
-	{ 8, 8, 8, 9, 9, 9, 8, 8, 6, 2, -3, -9, -15, -18, -17, -14, -10, -6, -2, 0, 1, 2, 2, 0, -1, -1, -2, -1, 0, 0, 0, 0, 1, 3, 5, 7, 8 },
-	{ 8, 9, 9, 10, 10, 10, 10, 8, 5, 0, -5, -11, -15, -16, -15, -12, -8, -4, -1, 0, 2, 3, 2, 1, 0, 0, 0, 0, 0, -1, -2, -2, -1, 0, 3, 6, 8 },
-	{ 6, 9, 10, 11, 12, 12, 11, 9, 5, 0, -7, -12, -15, -15, -13, -10, -7, -3, 0, 1, 2, 3, 3, 3, 2, 1, 0, 0, -1, -3, -4, -5, -5, -2, 0, 3, 6 },
-	{ 5, 8, 11, 13, 15, 15, 14, 11, 5, -1, -9, -14, -17, -16, -14, -11, -7, -3, 0, 1, 3, 4, 5, 5, 5, 4, 3, 1, -1, -4, -7, -8, -8, -6, -2, 1, 5 },
-	{ 4, 8, 12, 15, 17, 18, 16, 12, 5, -3, -12, -18, -20, -19, -16, -13, -8, -4, -1, 1, 4, 6, 8, 9, 9, 9, 7, 3, -1, -6, -10, -12, -11, -9, -5, 0, 4 },
-	{ 3, 9, 14, 17, 20, 21, 19, 14, 4, -8, -19, -25, -26, -25, -21, -17, -12, -7, -2, 1, 5, 9, 13, 15, 16, 16, 13, 7, 0, -7, -12, -15, -14, -11, -6, -1, 3 },
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAG_GRID_MMAP
+#endif
+
+#ifdef MAG_GRID_TABLE_10DEG
+#include "geo_magnetic_tables_10deg.h"
+#else
+#include "geo_magnetic_tables.h"
+#endif
+
+#define MAG_GRID_FILE		PX4_ROOTFSDIR"/fs/microsd/etc/mag_grid.bin"
+#define MAG_GRID_MAGIC		0x474d5850	/* 'PXMG' */
+#define MAG_GRID_VERSION	1
+
+enum mag_grid_field {
+	MAG_FIELD_DECLINATION = 0,	/* 0.01 deg */
+	MAG_FIELD_INCLINATION,		/* 0.01 deg */
+	MAG_FIELD_INTENSITY,		/* 1e-4 gauss */
+	MAG_NUM_FIELDS
 };
 
-static float get_lookup_table_val(unsigned lat, unsigned lon);
+struct mag_grid_s {
+	float lat_min;
+	float lon_min;
+	float res;
+	unsigned num_lat;
+	unsigned num_lon;
+	const int16_t *data;	/* [num_lat][num_lon][MAG_NUM_FIELDS] */
+};
+
+/* header of a grid file, followed by the data laid out like the embedded table */
+struct mag_grid_file_header_s {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t reserved;
+	float epoch;
+	float lat_min;
+	float lon_min;
+	float res;
+	uint16_t num_lat;
+	uint16_t num_lon;
+};
+
+static const struct mag_grid_s mag_grid_embedded = {
+	MAG_GRID_LAT_MIN,
+	MAG_GRID_LON_MIN,
+	MAG_GRID_RES,
+	MAG_GRID_NUM_LAT,
+	MAG_GRID_NUM_LON,
+	mag_grid_table
+};
+
+static const struct mag_grid_s *volatile mag_grid = &mag_grid_embedded;
+
+#ifdef MAG_GRID_MMAP
+/* serializes loading, lookups do not take it */
+static pthread_mutex_t mag_grid_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool mag_grid_init_done = false;
+#endif
+
+static float mag_grid_lookup(enum mag_grid_field field, float lat, float lon);
 
 __EXPORT float get_mag_declination(float lat, float lon)
+{
+	return mag_grid_lookup(MAG_FIELD_DECLINATION, lat, lon) * 0.01f;
+}
+
+__EXPORT float get_mag_inclination(float lat, float lon)
+{
+	return mag_grid_lookup(MAG_FIELD_INCLINATION, lat, lon) * 0.01f;
+}
+
+__EXPORT float get_mag_strength(float lat, float lon)
+{
+	return mag_grid_lookup(MAG_FIELD_INTENSITY, lat, lon) * 1e-4f;
+}
+
+float mag_grid_lookup(enum mag_grid_field field, float lat, float lon)
 {
 	/*
 	 * If the values exceed valid ranges, return zero as default
 	 * as we have no way of knowing what the closest real value
 	 * would be.
 	 */
-	if (lat < -90.0f || lat > 90.0f ||
-	    lon < -180.0f || lon > 180.0f) {
+	if (!(lat >= -90.0f && lat <= 90.0f &&
+	      lon >= -180.0f && lon <= 180.0f)) {
 		return 0.0f;
 	}
 
-	/* round down to nearest sampling resolution */
-	int min_lat = (int)(lat / SAMPLING_RES) * SAMPLING_RES;
-	int min_lon = (int)(lon / SAMPLING_RES) * SAMPLING_RES;
+	const struct mag_grid_s *grid = mag_grid;
 
-	/* for the rare case of hitting the bounds exactly
-	 * the rounding logic wouldn't fit, so enforce it.
-	 */
+	/* find the grid cell, the last row and column belong to the cell before them */
+	const float lat_index = (lat - grid->lat_min) / grid->res;
+	const float lon_index = (lon - grid->lon_min) / grid->res;
+	unsigned i = (unsigned)lat_index;
+	unsigned j = (unsigned)lon_index;
 
-	/* limit to table bounds - required for maxima even when table spans full globe range */
-	if (lat <= SAMPLING_MIN_LAT) {
-		min_lat = SAMPLING_MIN_LAT;
+	if (i > grid->num_lat - 2) {
+		i = grid->num_lat - 2;
 	}
 
-	if (lat >= SAMPLING_MAX_LAT) {
-		min_lat = (int)(lat / SAMPLING_RES) * SAMPLING_RES - SAMPLING_RES;
+	if (j > grid->num_lon - 2) {
+		j = grid->num_lon - 2;
 	}
 
-	if (lon <= SAMPLING_MIN_LON) {
-		min_lon = SAMPLING_MIN_LON;
+	const float u = lat_index - i;
+	const float v = lon_index - j;
+
+	const int16_t *sw = &grid->data[(i * grid->num_lon + j) * MAG_NUM_FIELDS + field];
+	const int16_t *nw = sw + grid->num_lon * MAG_NUM_FIELDS;
+
+	float value_sw = sw[0];
+	float value_se = sw[MAG_NUM_FIELDS];
+	float value_nw = nw[0];
+	float value_ne = nw[MAG_NUM_FIELDS];
+
+	if (field == MAG_FIELD_DECLINATION) {
+		/* close to the magnetic poles the declination wraps around within a cell */
+		value_se += (value_se - value_sw > 18000.0f) ? -36000.0f : (value_se - value_sw < -18000.0f) ? 36000.0f : 0.0f;
+		value_nw += (value_nw - value_sw > 18000.0f) ? -36000.0f : (value_nw - value_sw < -18000.0f) ? 36000.0f : 0.0f;
+		value_ne += (value_ne - value_sw > 18000.0f) ? -36000.0f : (value_ne - value_sw < -18000.0f) ? 36000.0f : 0.0f;
 	}
 
-	if (lon >= SAMPLING_MAX_LON) {
-		min_lon = (int)(lon / SAMPLING_RES) * SAMPLING_RES - SAMPLING_RES;
+	/* perform bilinear interpolation on the four grid corners */
+	const float value_s = value_sw + v * (value_se - value_sw);
+	const float value_n = value_nw + v * (value_ne - value_nw);
+	float value = value_s + u * (value_n - value_s);
+
+	if (field == MAG_FIELD_DECLINATION) {
+		if (value > 18000.0f) {
+			value -= 36000.0f;
+
+		} else if (value < -18000.0f) {
+			value += 36000.0f;
+		}
 	}
 
-	/* find index of nearest low sampling point */
-	unsigned min_lat_index = (-(SAMPLING_MIN_LAT) + min_lat)  / SAMPLING_RES;
-	unsigned min_lon_index = (-(SAMPLING_MIN_LON) + min_lon) / SAMPLING_RES;
+	return value;
+}
+
+__EXPORT float geo_mag_grid_resolution(void)
+{
+	return mag_grid->res;
+}
 
-	float declination_sw = get_lookup_table_val(min_lat_index, min_lon_index);
-	float declination_se = get_lookup_table_val(min_lat_index, min_lon_index + 1);
-	float declination_ne = get_lookup_table_val(min_lat_index + 1, min_lon_index + 1);
-	float declination_nw = get_lookup_table_val(min_lat_index + 1, min_lon_index);
+#ifdef MAG_GRID_MMAP
 
-	/* perform bilinear interpolation on the four grid corners */
+__EXPORT void geo_mag_grid_init(void)
+{
+	pthread_mutex_lock(&mag_grid_lock);
+	const bool init_done = mag_grid_init_done;
+	mag_grid_init_done = true;
+	pthread_mutex_unlock(&mag_grid_lock);
 
-	float declination_min = ((lon - min_lon) / SAMPLING_RES) * (declination_se - declination_sw) + declination_sw;
-	float declination_max = ((lon - min_lon) / SAMPLING_RES) * (declination_ne - declination_nw) + declination_nw;
+	if (!init_done) {
+		/* a missing file is fine, the embedded grid is used then */
+		geo_mag_grid_load(MAG_GRID_FILE);
+	}
+}
+
+__EXPORT int geo_mag_grid_load(const char *path)
+{
+	int fd = open(path, O_RDONLY);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	struct stat st;
+
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(struct mag_grid_file_header_s)) {
+		close(fd);
+		return -1;
+	}
+
+	/* pages are loaded on demand, only the cells actually used end up in memory */
+	void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (map == MAP_FAILED) {
+		return -1;
+	}
+
+	struct mag_grid_file_header_s header;
+	memcpy(&header, map, sizeof(header));
+
+	const size_t data_size = (size_t)header.num_lat * header.num_lon * MAG_NUM_FIELDS * sizeof(int16_t);
+
+	/* only global grids are supported */
+	if (header.magic != MAG_GRID_MAGIC || header.version != MAG_GRID_VERSION ||
+	    header.num_lat < 2 || header.num_lon < 2 || !(header.res > 0.0f) ||
+	    fabsf(header.lat_min + 90.0f) > 1e-3f || fabsf(header.lon_min + 180.0f) > 1e-3f ||
+	    fabsf((header.num_lat - 1) * header.res - 180.0f) > 1e-3f ||
+	    fabsf((header.num_lon - 1) * header.res - 360.0f) > 1e-3f ||
+	    (size_t)st.st_size < sizeof(header) + data_size) {
+
+		munmap(map, st.st_size);
+		return -1;
+	}
 
-	return ((lat - min_lat) / SAMPLING_RES) * (declination_max - declination_min) + declination_min;
+	/* a grid that was published may still be read, so every load gets its own descriptor */
+	struct mag_grid_s *grid = (struct mag_grid_s *)malloc(sizeof(struct mag_grid_s));
+
+	if (grid == NULL) {
+		munmap(map, st.st_size);
+		return -1;
+	}
+
+	grid->lat_min = header.lat_min;
+	grid->lon_min = header.lon_min;
+	grid->res = header.res;
+	grid->num_lat = header.num_lat;
+	grid->num_lon = header.num_lon;
+	grid->data = (const int16_t *)((const uint8_t *)map + sizeof(header));
+
+	/* publish the grid only once it is complete */
+	pthread_mutex_lock(&mag_grid_lock);
+	__sync_synchronize();
+	mag_grid = grid;
+	pthread_mutex_unlock(&mag_grid_lock);
+
+	return 0;
 }
 
-float get_lookup_table_val(unsigned lat_index, unsigned lon_index)
+__EXPORT void geo_mag_grid_unload(void)
+{
+	/* the previous grid stays mapped, a concurrent lookup may still use it */
+	pthread_mutex_lock(&mag_grid_lock);
+	mag_grid = &mag_grid_embedded;
+	pthread_mutex_unlock(&mag_grid_lock);
+}
+
+#else
+
+__EXPORT void geo_mag_grid_init(void)
 {
-	return declination_table[lat_index][lon_index];
-}
\ No newline at end of file
+}
+
+__EXPORT int geo_mag_grid_load(const char *path)
+{
+	/* the grid is compiled into flash */
+	return -1;
+}
+
+__EXPORT void geo_mag_grid_unload(void)
+{
+}
+
+#endif
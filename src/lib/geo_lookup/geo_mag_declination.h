@@ -34,7 +34,8 @@
 /**
 * @file geo_mag_declination.h
 *
-* Calculation / lookup table for earth magnetic field declination.
+* Calculation / lookup table for earth magnetic field declination,
+* inclination and intensity.
 *
 */
 
@@ -42,6 +43,52 @@
 
 __BEGIN_DECLS
 
+/**
+ * Magnetic declination in degrees, positive east of true north.
+ */
 __EXPORT float get_mag_declination(float lat, float lon);
 
+/**
+ * Magnetic inclination in degrees, positive pointing down.
+ */
+__EXPORT float get_mag_inclination(float lat, float lon);
+
+/**
+ * Total magnetic field intensity in gauss.
+ */
+__EXPORT float get_mag_strength(float lat, float lon);
+
+/**
+ * Resolution of the grid in use in degrees.
+ */
+__EXPORT float geo_mag_grid_resolution(void);
+
+/**
+ * Load the grid file from the SD card if there is one, only the first call
+ * has an effect. Call it from module startup, not from a control loop: it
+ * does blocking file I/O. Lookups before it use the compiled in grid.
+ */
+__EXPORT void geo_mag_grid_init(void);
+
+/**
+ * Use a grid file generated by Tools/generate_mag_grid.py instead of the grid
+ * compiled into the firmware. The file is memory mapped, POSIX only. Safe
+ * while other threads do lookups.
+ *
+ * The mapping and its descriptor are never released, lookups racing with a
+ * later load or unload may still read them. Every call costs the mapping of
+ * the file, so load once at startup (geo_mag_grid_init()) and reload only in
+ * tests and tools.
+ *
+ * @param path grid file
+ * @return 0 on success, -1 if the file is missing or invalid
+ */
+__EXPORT int geo_mag_grid_load(const char *path);
+
+/**
+ * Go back to the grid compiled into the firmware. A previously loaded grid
+ * file stays mapped, as concurrent lookups may still read it.
+ */
+__EXPORT void geo_mag_grid_unload(void);
+
 __END_DECLS
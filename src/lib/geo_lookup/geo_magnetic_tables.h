@@ -0,0 +1,754 @@
+/* Generated by Tools/generate_mag_grid.py from WMM2015 for 2017.0, do not edit. */
+
+#pragma once
+
+#define MAG_GRID_EPOCH		2017.0f
+#define MAG_GRID_RES		5.0f
+#define MAG_GRID_LAT_MIN	-90.0f
+#define MAG_GRID_LON_MIN	-180.0f
+#define MAG_GRID_NUM_LAT	37
+#define MAG_GRID_NUM_LON	73
+
+/* declination [0.01 deg], inclination [0.01 deg], intensity [1e-4 gauss] */
+static const int16_t mag_grid_table[MAG_GRID_NUM_LAT * MAG_GRID_NUM_LON * 3] = {
+	/* -90.0 */
+	14965, -7220, 5483, 14465, -7220, 5483, 13965, -7220, 5483, 13465, -7220, 5483,
+	12965, -7220, 5483, 12465, -7220, 5483, 11965, -7220, 5483, 11465, -7220, 5483,
+	10965, -7220, 5483, 10465, -7220, 5483, 9965, -7220, 5483, 9465, -7220, 5483,
+	8965, -7220, 5483, 8465, -7220, 5483, 7965, -7220, 5483, 7465, -7220, 5483,
+	6965, -7220, 5483, 6465, -7220, 5483, 5965, -7220, 5483, 5465, -7220, 5483,
+	4965, -7220, 5483, 4465, -7220, 5483, 3965, -7220, 5483, 3465, -7220, 5483,
+	2965, -7220, 5483, 2465, -7220, 5483, 1965, -7220, 5483, 1465, -7220, 5483,
+	965, -7220, 5483, 465, -7220, 5483, -35, -7220, 5483, -535, -7220, 5483,
+	-1035, -7220, 5483, -1535, -7220, 5483, -2035, -7220, 5483, -2535, -7220, 5483,
+	-3035, -7220, 5483, -3535, -7220, 5483, -4035, -7220, 5483, -4535, -7220, 5483,
+	-5035, -7220, 5483, -5535, -7220, 5483, -6035, -7220, 5483, -6535, -7220, 5483,
+	-7035, -7220, 5483, -7535, -7220, 5483, -8035, -7220, 5483, -8535, -7220, 5483,
+	-9035, -7220, 5483, -9535, -7220, 5483, -10035, -7220, 5483, -10535, -7220, 5483,
+	-11035, -7220, 5483, -11535, -7220, 5483, -12035, -7220, 5483, -12535, -7220, 5483,
+	-13035, -7220, 5483, -13535, -7220, 5483, -14035, -7220, 5483, -14535, -7220, 5483,
+	-15035, -7220, 5483, -15535, -7220, 5483, -16035, -7220, 5483, -16535, -7220, 5483,
+	-17035, -7220, 5483, -17535, -7220, 5483, 17965, -7220, 5483, 17465, -7220, 5483,
+	16965, -7220, 5483, 16465, -7220, 5483, 15965, -7220, 5483, 15465, -7220, 5483,
+	14965, -7220, 5483,
+	/* -85.0 */
+	14223, -7551, 5825, 13657, -7537, 5812, 13099, -7520, 5796, 12550, -7502, 5779,
+	12010, -7480, 5759, 11479, -7457, 5737, 10957, -7433, 5713, 10443, -7406, 5687,
+	9938, -7379, 5660, 9442, -7350, 5631, 8953, -7321, 5602, 8471, -7291, 5571,
+	7996, -7261, 5540, 7528, -7231, 5508, 7065, -7201, 5475, 6607, -7171, 5443,
+	6154, -7142, 5411, 5705, -7114, 5379, 5260, -7087, 5347, 4818, -7060, 5317,
+	4379, -7036, 5287, 3942, -7012, 5258, 3508, -6990, 5231, 3075, -6970, 5205,
+	2643, -6951, 5181, 2213, -6934, 5159, 1783, -6919, 5139, 1353, -6907, 5122,
+	922, -6896, 5107, 491, -6887, 5094, 59, -6880, 5084, -374, -6875, 5077,
+	-809, -6873, 5072, -1247, -6872, 5071, -1686, -6874, 5072, -2128, -6878, 5077,
+	-2573, -6885, 5084, -3022, -6893, 5095, -3474, -6904, 5108, -3929, -6917, 5125,
+	-4388, -6933, 5144, -4852, -6950, 5166, -5319, -6970, 5190, -5792, -6991, 5217,
+	-6268, -7014, 5246, -6750, -7040, 5276, -7237, -7067, 5309, -7729, -7095, 5343,
+	-8226, -7124, 5377, -8730, -7155, 5413, -9239, -7186, 5449, -9755, -7218, 5485,
+	-10277, -7250, 5521, -10806, -7283, 5556, -11341, -7315, 5590, -11884, -7346, 5623,
+	-12434, -7376, 5655, -12991, -7406, 5685, -13555, -7434, 5713, -14126, -7460, 5739,
+	-14703, -7484, 5763, -15286, -7505, 5784, -15873, -7525, 5802, -16465, -7541, 5817,
+	-17060, -7555, 5830, -17657, -7565, 5839, 17746, -7573, 5846, 17149, -7577, 5850,
+	16555, -7578, 5850, 15964, -7576, 5848, 15377, -7571, 5843, 14797, -7562, 5835,
+	14223, -7551, 5825,
+	/* -80.0 */
+	13007, -7847, 6089, 12377, -7812, 6061, 11776, -7771, 6029, 11203, -7727, 5993,
+	10656, -7680, 5953, 10134, -7629, 5910, 9633, -7576, 5863, 9153, -7521, 5814,
+	8689, -7464, 5763, 8240, -7406, 5708, 7804, -7348, 5652, 7379, -7289, 5595,
+	6963, -7230, 5535, 6555, -7171, 5475, 6153, -7114, 5414, 5756, -7057, 5353,
+	5363, -7003, 5292, 4974, -6951, 5231, 4588, -6901, 5172, 4204, -6854, 5113,
+	3823, -6810, 5057, 3444, -6769, 5002, 3066, -6732, 4950, 2690, -6698, 4901,
+	2315, -6668, 4855, 1941, -6641, 4813, 1568, -6618, 4774, 1194, -6598, 4740,
+	819, -6582, 4709, 443, -6569, 4684, 65, -6559, 4663, -315, -6551, 4647,
+	-700, -6548, 4636, -1088, -6547, 4631, -1481, -6550, 4632, -1880, -6556, 4639,
+	-2284, -6565, 4651, -2694, -6579, 4670, -3110, -6596, 4694, -3532, -6618, 4725,
+	-3960, -6643, 4762, -4394, -6674, 4805, -4835, -6708, 4854, -5281, -6747, 4908,
+	-5733, -6790, 4966, -6191, -6837, 5029, -6655, -6888, 5096, -7126, -6943, 5166,
+	-7604, -7001, 5238, -8089, -7061, 5312, -8583, -7124, 5387, -9087, -7189, 5462,
+	-9601, -7255, 5536, -10128, -7322, 5608, -10669, -7389, 5679, -11225, -7455, 5746,
+	-11799, -7520, 5810, -12392, -7582, 5870, -13007, -7642, 5925, -13644, -7699, 5974,
+	-14305, -7751, 6018, -14990, -7797, 6057, -15697, -7838, 6089, -16425, -7873, 6115,
+	-17170, -7900, 6135, -17926, -7920, 6149, 17313, -7932, 6157, 16553, -7936, 6159,
+	15803, -7932, 6156, 15068, -7921, 6147, 14355, -7902, 6132, 13667, -7878, 6113,
+	13007, -7847, 6089,
+	/* -75.0 */
+	11075, -8056, 6261, 10460, -7991, 6217, 9904, -7922, 6167, 9397, -7850, 6113,
+	8932, -7776, 6055, 8500, -7700, 5992, 8096, -7621, 5926, 7714, -7541, 5857,
+	7349, -7460, 5784, 6998, -7377, 5708, 6655, -7294, 5630, 6320, -7210, 5548,
+	5988, -7126, 5465, 5659, -7042, 5380, 5330, -6960, 5294, 5000, -6880, 5207,
+	4668, -6802, 5120, 4335, -6729, 5034, 4001, -6660, 4949, 3664, -6596, 4866,
+	3327, -6537, 4786, 2990, -6485, 4709, 2653, -6439, 4636, 2318, -6399, 4567,
+	1983, -6366, 4503, 1651, -6338, 4444, 1320, -6315, 4391, 991, -6297, 4343,
+	662, -6283, 4300, 333, -6273, 4264, 1, -6265, 4234, -334, -6261, 4210,
+	-674, -6259, 4193, -1020, -6259, 4184, -1374, -6263, 4183, -1737, -6270, 4190,
+	-2109, -6281, 4206, -2490, -6296, 4230, -2880, -6316, 4264, -3280, -6342, 4308,
+	-3687, -6374, 4361, -4101, -6413, 4424, -4522, -6459, 4496, -4948, -6511, 4576,
+	-5378, -6571, 4665, -5813, -6638, 4760, -6251, -6711, 4862, -6693, -6790, 4969,
+	-7139, -6874, 5080, -7591, -6963, 5194, -8049, -7057, 5309, -8514, -7154, 5424,
+	-8990, -7253, 5537, -9480, -7354, 5647, -9986, -7456, 5753, -10515, -7557, 5854,
+	-11070, -7657, 5948, -11659, -7755, 6034, -12290, -7850, 6113, -12972, -7939, 6182,
+	-13715, -8023, 6242, -14528, -8098, 6292, -15418, -8163, 6333, -16386, -8215, 6364,
+	-17422, -8254, 6385, 17495, -8277, 6397, 16398, -8284, 6400, 15325, -8275, 6395,
+	14310, -8252, 6382, 13373, -8216, 6361, 12524, -8170, 6334, 11760, -8116, 6300,
+	11075, -8056, 6261,
+	/* -70.0 */
+	8557, -8109, 6334, 8134, -8018, 6273, 7762, -7926, 6207, 7428, -7835, 6137,
+	7125, -7743, 6062, 6845, -7651, 5984, 6583, -7558, 5902, 6335, -7463, 5816,
+	6095, -7367, 5726, 5860, -7268, 5633, 5626, -7168, 5536, 5391, -7066, 5436,
+	5151, -6962, 5333, 4904, -6859, 5226, 4648, -6755, 5118, 4382, -6653, 5008,
+	4106, -6555, 4898, 3820, -6461, 4788, 3524, -6374, 4681, 3221, -6295, 4576,
+	2911, -6225, 4476, 2597, -6165, 4380, 2282, -6116, 4290, 1967, -6077, 4207,
+	1655, -6048, 4130, 1347, -6029, 4060, 1045, -6017, 3996, 747, -6012, 3940,
+	454, -6011, 3890, 164, -6013, 3847, -126, -6017, 3811, -418, -6021, 3782,
+	-716, -6026, 3761, -1023, -6031, 3749, -1341, -6036, 3746, -1671, -6043, 3752,
+	-2016, -6053, 3770, -2375, -6067, 3799, -2747, -6086, 3841, -3131, -6112, 3896,
+	-3525, -6146, 3963, -3926, -6189, 4044, -4333, -6242, 4138, -4742, -6305, 4244,
+	-5153, -6379, 4362, -5564, -6462, 4489, -5973, -6554, 4625, -6380, -6655, 4769,
+	-6785, -6763, 4917, -7188, -6878, 5069, -7591, -6999, 5223, -7995, -7125, 5376,
+	-8403, -7254, 5526, -8819, -7386, 5672, -9246, -7519, 5811, -9690, -7653, 5941,
+	-10161, -7787, 6062, -10669, -7918, 6171, -11231, -8047, 6268, -11872, -8172, 6352,
+	-12630, -8289, 6422, -13559, -8398, 6478, -14738, -8493, 6521, -16252, -8567, 6550,
+	17881, -8611, 6566, 15843, -8618, 6570, 13960, -8589, 6563, 12432, -8532, 6546,
+	11257, -8459, 6519, 10351, -8377, 6483, 9634, -8289, 6440, 9049, -8199, 6390,
+	8557, -8109, 6334,
+	/* -65.0 */
+	6282, -7990, 6314, 6094, -7889, 6237, 5918, -7789, 6156, 5752, -7692, 6072,
+	5595, -7595, 5984, 5447, -7498, 5893, 5306, -7401, 5798, 5171, -7302, 5701,
+	5037, -7201, 5599, 4904, -7097, 5494, 4766, -6988, 5384, 4621, -6876, 5269,
+	4464, -6759, 5150, 4293, -6640, 5026, 4105, -6519, 4899, 3897, -6399, 4769,
+	3669, -6280, 4638, 3421, -6167, 4508, 3154, -6062, 4380, 2870, -5968, 4257,
+	2572, -5888, 4139, 2265, -5823, 4028, 1953, -5775, 3926, 1640, -5743, 3833,
+	1331, -5728, 3748, 1030, -5727, 3673, 740, -5738, 3606, 462, -5758, 3548,
+	195, -5782, 3496, -63, -5808, 3452, -315, -5833, 3415, -566, -5855, 3384,
+	-822, -5873, 3361, -1088, -5886, 3347, -1368, -5895, 3342, -1667, -5902, 3348,
+	-1986, -5908, 3366, -2325, -5916, 3399, -2682, -5929, 3446, -3054, -5949, 3510,
+	-3439, -5979, 3590, -3831, -6021, 3687, -4226, -6076, 3801, -4621, -6145, 3931,
+	-5011, -6227, 4075, -5395, -6323, 4232, -5771, -6431, 4399, -6136, -6550, 4576,
+	-6490, -6678, 4759, -6833, -6815, 4946, -7165, -6959, 5134, -7487, -7107, 5321,
+	-7799, -7260, 5503, -8104, -7416, 5679, -8402, -7574, 5846, -8696, -7733, 6001,
+	-8988, -7891, 6143, -9282, -8049, 6269, -9586, -8204, 6379, -9911, -8357, 6471,
+	-10280, -8507, 6546, -10759, -8653, 6602, -11572, -8794, 6641, -14389, -8920, 6663,
+	10965, -8909, 6670, 8691, -8788, 6662, 7963, -8664, 6641, 7532, -8543, 6608,
+	7210, -8426, 6565, 6940, -8312, 6513, 6701, -8201, 6453, 6484, -8094, 6387,
+	6282, -7990, 6314,
+	/* -60.0 */
+	4730, -7760, 6217, 4673, -7659, 6126, 4607, -7560, 6032, 4537, -7464, 5936,
+	4464, -7368, 5837, 4393, -7274, 5736, 4325, -7179, 5633, 4259, -7082, 5528,
+	4195, -6982, 5419, 4131, -6878, 5305, 4063, -6768, 5187, 3988, -6652, 5063,
+	3900, -6530, 4932, 3793, -6401, 4796, 3664, -6267, 4654, 3508, -6131, 4508,
+	3323, -5995, 4361, 3108, -5864, 4213, 2863, -5742, 4068, 2590, -5633, 3928,
+	2295, -5543, 3797, 1981, -5475, 3675, 1657, -5432, 3564, 1330, -5414, 3466,
+	1007, -5420, 3380, 696, -5449, 3305, 402, -5494, 3242, 130, -5551, 3187,
+	-122, -5614, 3141, -354, -5676, 3101, -571, -5734, 3067, -781, -5783, 3038,
+	-992, -5821, 3016, -1213, -5848, 3001, -1452, -5863, 2994, -1714, -5869, 2998,
+	-2003, -5869, 3016, -2319, -5866, 3049, -2660, -5866, 3099, -3021, -5873, 3169,
+	-3397, -5890, 3258, -3779, -5923, 3369, -4163, -5972, 3500, -4542, -6039, 3649,
+	-4910, -6125, 3817, -5264, -6227, 4000, -5601, -6346, 4195, -5918, -6478, 4401,
+	-6213, -6622, 4613, -6486, -6775, 4829, -6733, -6935, 5045, -6955, -7099, 5259,
+	-7149, -7268, 5467, -7311, -7438, 5667, -7436, -7609, 5854, -7515, -7778, 6027,
+	-7534, -7946, 6183, -7469, -8110, 6320, -7276, -8268, 6436, -6874, -8417, 6531,
+	-6102, -8552, 6604, -4657, -8662, 6657, -2236, -8722, 6688, 538, -8708, 6701,
+	2493, -8636, 6695, 3587, -8534, 6674, 4183, -8423, 6638, 4509, -8308, 6589,
+	4682, -8194, 6530, 4763, -8081, 6462, 4785, -7972, 6386, 4770, -7865, 6304,
+	4730, -7760, 6217,
+	/* -55.0 */
+	3737, -7477, 6062, 3737, -7378, 5960, 3720, -7282, 5855, 3693, -7187, 5749,
+	3660, -7094, 5642, 3626, -7002, 5535, 3592, -6910, 5426, 3561, -6816, 5316,
+	3534, -6720, 5202, 3509, -6620, 5085, 3485, -6513, 4963, 3457, -6399, 4833,
+	3419, -6276, 4697, 3363, -6144, 4553, 3284, -6003, 4402, 3174, -5856, 4245,
+	3028, -5707, 4084, 2843, -5561, 3923, 2617, -5423, 3765, 2352, -5301, 3614,
+	2052, -5203, 3471, 1724, -5133, 3342, 1377, -5098, 3228, 1022, -5099, 3129,
+	672, -5135, 3047, 337, -5201, 2979, 27, -5291, 2925, -252, -5397, 2881,
+	-497, -5508, 2845, -710, -5618, 2814, -897, -5718, 2788, -1066, -5804, 2765,
+	-1229, -5871, 2746, -1399, -5918, 2731, -1588, -5944, 2722, -1804, -5953, 2724,
+	-2054, -5946, 2737, -2340, -5930, 2767, -2659, -5910, 2816, -3004, -5894, 2886,
+	-3367, -5889, 2981, -3738, -5900, 3100, -4108, -5933, 3243, -4467, -5990, 3410,
+	-4810, -6071, 3597, -5130, -6174, 3801, -5424, -6298, 4020, -5687, -6438, 4249,
+	-5917, -6591, 4485, -6110, -6753, 4724, -6264, -6922, 4961, -6374, -7094, 5194,
+	-6434, -7267, 5420, -6435, -7439, 5634, -6364, -7608, 5834, -6204, -7771, 6016,
+	-5927, -7926, 6178, -5497, -8068, 6319, -4871, -8193, 6435, -4006, -8294, 6528,
+	-2894, -8363, 6596, -1612, -8394, 6640, -327, -8386, 6662, 799, -8343, 6664,
+	1690, -8274, 6646, 2355, -8189, 6612, 2834, -8094, 6563, 3174, -7994, 6501,
+	3408, -7890, 6428, 3564, -7785, 6346, 3661, -7681, 6256, 3715, -7578, 6161,
+	3737, -7477, 6062,
+	/* -50.0 */
+	3071, -7164, 5868, 3093, -7066, 5757, 3098, -6971, 5644, 3091, -6877, 5532,
+	3077, -6785, 5419, 3058, -6693, 5306, 3039, -6602, 5194, 3023, -6511, 5080,
+	3010, -6418, 4965, 3003, -6321, 4847, 3000, -6219, 4724, 2998, -6109, 4594,
+	2991, -5990, 4456, 2971, -5860, 4309, 2930, -5718, 4154, 2859, -5567, 3992,
+	2748, -5410, 3825, 2591, -5253, 3656, 2384, -5103, 3490, 2126, -4970, 3331,
+	1819, -4864, 3183, 1472, -4796, 3050, 1096, -4772, 2936, 707, -4796, 2842,
+	320, -4866, 2767, -47, -4977, 2712, -381, -5119, 2671, -673, -5278, 2643,
+	-918, -5444, 2622, -1117, -5606, 2605, -1278, -5754, 2591, -1411, -5882, 2576,
+	-1528, -5985, 2562, -1644, -6062, 2549, -1774, -6110, 2539, -1932, -6129, 2536,
+	-2129, -6123, 2543, -2371, -6095, 2565, -2655, -6055, 2607, -2976, -6011, 2673,
+	-3320, -5974, 2766, -3674, -5954, 2887, -4025, -5960, 3038, -4361, -5995, 3215,
+	-4674, -6062, 3417, -4955, -6157, 3639, -5201, -6278, 3877, -5405, -6419, 4125,
+	-5564, -6574, 4378, -5674, -6738, 4633, -5729, -6908, 4885, -5722, -7077, 5129,
+	-5646, -7244, 5363, -5490, -7406, 5584, -5240, -7557, 5787, -4881, -7696, 5970,
+	-4399, -7818, 6131, -3791, -7919, 6268, -3066, -7993, 6379, -2257, -8040, 6464,
+	-1415, -8059, 6523, -596, -8051, 6558, 153, -8019, 6570, 808, -7970, 6561,
+	1359, -7905, 6533, 1812, -7829, 6488, 2175, -7745, 6429, 2460, -7654, 6357,
+	2678, -7559, 6273, 2838, -7461, 6181, 2952, -7361, 6081, 3027, -7262, 5976,
+	3071, -7164, 5868,
+	/* -45.0 */
+	2589, -6820, 5648, 2620, -6724, 5531, 2635, -6628, 5413, 2639, -6533, 5296,
+	2634, -6440, 5179, 2624, -6347, 5063, 2611, -6254, 4948, 2599, -6161, 4833,
+	2590, -6068, 4718, 2586, -5972, 4600, 2587, -5874, 4478, 2594, -5769, 4351,
+	2601, -5656, 4215, 2601, -5532, 4071, 2586, -5395, 3918, 2543, -5246, 3758,
+	2462, -5086, 3591, 2330, -4923, 3421, 2141, -4764, 3253, 1889, -4622, 3092,
+	1576, -4510, 2942, 1211, -4444, 2811, 806, -4433, 2700, 381, -4483, 2614,
+	-41, -4592, 2551, -440, -4751, 2510, -796, -4945, 2487, -1099, -5159, 2476,
+	-1344, -5378, 2473, -1534, -5589, 2472, -1676, -5784, 2471, -1780, -5956, 2467,
+	-1860, -6102, 2461, -1928, -6217, 2452, -1999, -6299, 2443, -2091, -6344, 2436,
+	-2219, -6353, 2437, -2396, -6327, 2449, -2628, -6274, 2480, -2907, -6205, 2535,
+	-3220, -6134, 2619, -3549, -6076, 2736, -3875, -6044, 2887, -4182, -6046, 3069,
+	-4460, -6087, 3280, -4699, -6164, 3515, -4893, -6272, 3766, -5035, -6405, 4028,
+	-5121, -6554, 4294, -5146, -6712, 4559, -5105, -6873, 4818, -4990, -7031, 5066,
+	-4796, -7182, 5301, -4514, -7321, 5519, -4140, -7443, 5718, -3674, -7546, 5894,
+	-3128, -7625, 6046, -2527, -7679, 6172, -1901, -7708, 6272, -1284, -7715, 6345,
+	-699, -7702, 6393, -159, -7675, 6417, 329, -7634, 6420, 764, -7583, 6402,
+	1148, -7523, 6367, 1482, -7454, 6315, 1767, -7377, 6249, 2004, -7294, 6170,
+	2196, -7205, 6080, 2346, -7111, 5981, 2458, -7015, 5875, 2537, -6918, 5763,
+	2589, -6820, 5648,
+	/* -40.0 */
+	2217, -6437, 5410, 2251, -6340, 5290, 2270, -6243, 5169, 2280, -6146, 5050,
+	2281, -6049, 4931, 2277, -5952, 4813, 2268, -5855, 4697, 2257, -5758, 4581,
+	2247, -5661, 4466, 2239, -5564, 4350, 2237, -5466, 4232, 2240, -5364, 4109,
+	2248, -5257, 3980, 2254, -5140, 3843, 2250, -5010, 3697, 2226, -4866, 3544,
+	2165, -4708, 3384, 2053, -4541, 3220, 1879, -4376, 3056, 1634, -4226, 2898,
+	1317, -4110, 2753, 936, -4047, 2626, 507, -4052, 2523, 54, -4130, 2446,
+	-395, -4279, 2397, -814, -4486, 2371, -1181, -4732, 2365, -1485, -4997, 2371,
+	-1725, -5263, 2385, -1903, -5519, 2399, -2032, -5756, 2412, -2120, -5971, 2421,
+	-2177, -6159, 2425, -2211, -6319, 2425, -2233, -6444, 2422, -2257, -6529, 2418,
+	-2303, -6570, 2415, -2394, -6564, 2419, -2546, -6516, 2438, -2760, -6435, 2479,
+	-3024, -6337, 2549, -3314, -6241, 2653, -3607, -6165, 2796, -3881, -6125, 2975,
+	-4122, -6127, 3188, -4318, -6173, 3427, -4461, -6258, 3686, -4544, -6372, 3956,
+	-4562, -6505, 4229, -4512, -6648, 4498, -4391, -6792, 4758, -4194, -6930, 5004,
+	-3919, -7056, 5234, -3566, -7165, 5443, -3142, -7253, 5630, -2662, -7316, 5793,
+	-2152, -7353, 5928, -1643, -7366, 6038, -1158, -7359, 6120, -713, -7337, 6179,
+	-309, -7306, 6214, 58, -7268, 6227, 395, -7224, 6222, 704, -7175, 6198,
+	988, -7119, 6158, 1247, -7055, 6103, 1477, -6984, 6033, 1678, -6906, 5951,
+	1847, -6820, 5857, 1984, -6729, 5755, 2089, -6633, 5644, 2165, -6535, 5528,
+	2217, -6437, 5410,
+	/* -35.0 */
+	1918, -6001, 5156, 1950, -5900, 5035, 1971, -5801, 4915, 1983, -5701, 4795,
+	1990, -5600, 4677, 1991, -5498, 4559, 1986, -5395, 4443, 1977, -5291, 4328,
+	1964, -5187, 4215, 1952, -5085, 4101, 1941, -4983, 3987, 1936, -4882, 3871,
+	1935, -4778, 3751, 1938, -4667, 3625, 1936, -4544, 3492, 1918, -4405, 3352,
+	1869, -4248, 3204, 1770, -4078, 3052, 1607, -3906, 2898, 1367, -3749, 2750,
+	1048, -3630, 2612, 657, -3572, 2494, 213, -3593, 2400, -256, -3703, 2334,
+	-717, -3894, 2297, -1140, -4151, 2285, -1503, -4448, 2293, -1796, -4762, 2314,
+	-2021, -5074, 2341, -2185, -5370, 2368, -2301, -5646, 2394, -2378, -5898, 2417,
+	-2422, -6127, 2436, -2435, -6329, 2450, -2418, -6499, 2459, -2378, -6628, 2464,
+	-2335, -6709, 2466, -2320, -6736, 2469, -2364, -6707, 2479, -2483, -6631, 2505,
+	-2673, -6520, 2557, -2909, -6395, 2644, -3163, -6278, 2769, -3406, -6191, 2936,
+	-3616, -6147, 3140, -3778, -6152, 3375, -3883, -6201, 3633, -3921, -6285, 3903,
+	-3891, -6393, 4176, -3791, -6512, 4443, -3621, -6631, 4699, -3382, -6743, 4938,
+	-3077, -6842, 5157, -2712, -6921, 5353, -2301, -6975, 5523, -1865, -7003, 5666,
+	-1434, -7004, 5781, -1031, -6984, 5869, -673, -6949, 5931, -359, -6908, 5972,
+	-82, -6864, 5993, 171, -6821, 5997, 410, -6777, 5984, 639, -6731, 5956,
+	858, -6679, 5913, 1066, -6619, 5856, 1257, -6552, 5786, 1429, -6475, 5703,
+	1579, -6391, 5608, 1702, -6299, 5504, 1798, -6202, 5393, 1869, -6101, 5276,
+	1918, -6001, 5156,
+	/* -30.0 */
+	1673, -5494, 4888, 1701, -5389, 4770, 1720, -5286, 4653, 1733, -5182, 4536,
+	1743, -5078, 4420, 1749, -4970, 4305, 1748, -4860, 4191, 1741, -4748, 4079,
+	1728, -4636, 3968, 1711, -4526, 3859, 1694, -4418, 3751, 1678, -4314, 3643,
+	1668, -4209, 3534, 1661, -4100, 3422, 1655, -3980, 3305, 1637, -3842, 3182,
+	1592, -3683, 3051, 1499, -3507, 2915, 1340, -3327, 2777, 1103, -3162, 2642,
+	782, -3041, 2517, 387, -2990, 2409, -62, -3033, 2326, -533, -3178, 2271,
+	-990, -3416, 2244, -1401, -3725, 2243, -1748, -4077, 2261, -2020, -4442, 2291,
+	-2224, -4799, 2327, -2368, -5137, 2365, -2467, -5449, 2403, -2528, -5736, 2440,
+	-2556, -5998, 2476, -2544, -6234, 2509, -2487, -6439, 2538, -2385, -6605, 2559,
+	-2253, -6720, 2573, -2125, -6777, 2581, -2045, -6771, 2589, -2047, -6707, 2605,
+	-2141, -6596, 2639, -2310, -6454, 2703, -2521, -6307, 2805, -2740, -6179, 2949,
+	-2937, -6088, 3134, -3088, -6047, 3354, -3178, -6055, 3600, -3201, -6103, 3861,
+	-3154, -6179, 4126, -3039, -6269, 4385, -2860, -6361, 4631, -2624, -6447, 4859,
+	-2335, -6520, 5064, -2001, -6572, 5243, -1637, -6600, 5394, -1267, -6600, 5514,
+	-918, -6574, 5605, -610, -6528, 5668, -351, -6473, 5708, -136, -6417, 5730,
+	51, -6367, 5737, 225, -6323, 5732, 398, -6281, 5714, 574, -6238, 5683,
+	750, -6190, 5639, 922, -6133, 5581, 1085, -6066, 5511, 1234, -5989, 5429,
+	1367, -5903, 5335, 1478, -5807, 5232, 1565, -5706, 5122, 1629, -5600, 5006,
+	1673, -5494, 4888,
+	/* -25.0 */
+	1471, -4902, 4610, 1494, -4791, 4497, 1509, -4682, 4385, 1521, -4574, 4274,
+	1531, -4465, 4164, 1540, -4353, 4055, 1543, -4237, 3946, 1539, -4117, 3839,
+	1527, -3997, 3734, 1509, -3878, 3632, 1486, -3763, 3532, 1464, -3652, 3435,
+	1444, -3544, 3338, 1430, -3433, 3242, 1417, -3310, 3142, 1396, -3168, 3038,
+	1349, -3001, 2928, 1256, -2815, 2811, 1097, -2624, 2692, 858, -2452, 2574,
+	536, -2331, 2464, 141, -2293, 2370, -304, -2361, 2298, -765, -2544, 2252,
+	-1205, -2832, 2232, -1595, -3197, 2237, -1916, -3606, 2260, -2163, -4027, 2296,
+	-2340, -4435, 2338, -2458, -4818, 2385, -2530, -5168, 2433, -2563, -5486, 2484,
+	-2556, -5774, 2538, -2504, -6031, 2591, -2397, -6255, 2641, -2233, -6437, 2683,
+	-2024, -6568, 2713, -1804, -6640, 2732, -1618, -6648, 2743, -1511, -6593, 2754,
+	-1506, -6484, 2774, -1600, -6336, 2815, -1765, -6170, 2890, -1965, -6011, 3004,
+	-2161, -5883, 3160, -2321, -5802, 3355, -2425, -5772, 3580, -2461, -5785, 3822,
+	-2428, -5829, 4070, -2331, -5891, 4314, -2178, -5958, 4544, -1976, -6022, 4757,
+	-1730, -6075, 4946, -1447, -6110, 5107, -1141, -6119, 5237, -837, -6100, 5334,
+	-558, -6053, 5399, -324, -5989, 5437, -141, -5919, 5454, 2, -5854, 5458,
+	124, -5801, 5453, 243, -5759, 5439, 371, -5722, 5417, 510, -5683, 5384,
+	657, -5638, 5339, 805, -5581, 5281, 947, -5513, 5212, 1080, -5434, 5131,
+	1199, -5342, 5041, 1299, -5241, 4941, 1378, -5131, 4834, 1435, -5017, 4723,
+	1471, -4902, 4610,
+	/* -20.0 */
+	1308, -4212, 4326, 1324, -4090, 4222, 1333, -3974, 4119, 1341, -3862, 4017,
+	1350, -3749, 3917, 1359, -3633, 3816, 1365, -3513, 3717, 1364, -3387, 3619,
+	1354, -3260, 3523, 1336, -3134, 3430, 1312, -3012, 3342, 1286, -2895, 3257,
+	1262, -2781, 3175, 1243, -2664, 3095, 1225, -2534, 3014, 1200, -2381, 2930,
+	1148, -2203, 2841, 1050, -2004, 2746, 886, -1802, 2647, 644, -1626, 2549,
+	321, -1510, 2456, -70, -1487, 2376, -504, -1584, 2314, -947, -1807, 2275,
+	-1363, -2143, 2258, -1726, -2563, 2264, -2018, -3030, 2288, -2234, -3510, 2326,
+	-2380, -3974, 2372, -2464, -4405, 2425, -2496, -4795, 2482, -2483, -5141, 2546,
+	-2426, -5445, 2614, -2320, -5708, 2685, -2159, -5931, 2753, -1944, -6108, 2814,
+	-1688, -6234, 2861, -1420, -6302, 2893, -1179, -6309, 2910, -1005, -6254, 2919,
+	-926, -6144, 2929, -950, -5991, 2952, -1063, -5813, 2999, -1235, -5635, 3082,
+	-1426, -5483, 3205, -1598, -5373, 3368, -1724, -5314, 3563, -1787, -5301, 3778,
+	-1786, -5321, 4002, -1725, -5361, 4223, -1613, -5409, 4434, -1459, -5458, 4627,
+	-1264, -5499, 4798, -1036, -5523, 4940, -786, -5523, 5050, -538, -5492, 5124,
+	-315, -5432, 5166, -138, -5355, 5180, -11, -5274, 5178, 80, -5205, 5165,
+	156, -5152, 5148, 236, -5116, 5128, 333, -5086, 5102, 449, -5053, 5067,
+	577, -5010, 5021, 709, -4953, 4964, 837, -4882, 4895, 957, -4797, 4818,
+	1065, -4698, 4731, 1158, -4587, 4636, 1230, -4465, 4536, 1279, -4338, 4431,
+	1308, -4212, 4326,
+	/* -15.0 */
+	1181, -3415, 4049, 1189, -3280, 3956, 1190, -3155, 3865, 1192, -3037, 3775,
+	1198, -2922, 3687, 1206, -2804, 3599, 1212, -2681, 3513, 1214, -2553, 3428,
+	1206, -2422, 3345, 1190, -2292, 3266, 1167, -2165, 3192, 1141, -2044, 3122,
+	1116, -1925, 3056, 1095, -1800, 2994, 1075, -1660, 2932, 1045, -1495, 2868,
+	988, -1303, 2801, 882, -1093, 2728, 711, -885, 2650, 463, -711, 2572,
+	140, -605, 2497, -244, -603, 2430, -662, -726, 2376, -1081, -983, 2339,
+	-1469, -1358, 2322, -1801, -1825, 2324, -2061, -2345, 2344, -2245, -2882, 2380,
+	-2354, -3401, 2427, -2396, -3882, 2483, -2378, -4308, 2548, -2309, -4677, 2620,
+	-2193, -4987, 2698, -2033, -5243, 2780, -1830, -5448, 2860, -1590, -5603, 2933,
+	-1325, -5707, 2992, -1057, -5758, 3034, -811, -5754, 3058, -617, -5692, 3069,
+	-498, -5578, 3074, -471, -5418, 3083, -533, -5231, 3109, -666, -5040, 3163,
+	-838, -4871, 3254, -1010, -4745, 3383, -1149, -4669, 3544, -1236, -4639, 3728,
+	-1265, -4644, 3921, -1241, -4670, 4115, -1172, -4706, 4301, -1064, -4746, 4472,
+	-919, -4782, 4623, -741, -4804, 4746, -540, -4800, 4837, -339, -4765, 4892,
+	-161, -4698, 4914, -26, -4614, 4910, 61, -4528, 4890, 115, -4457, 4865,
+	157, -4410, 4839, 210, -4382, 4813, 287, -4362, 4783, 388, -4337, 4746,
+	504, -4297, 4699, 626, -4240, 4641, 745, -4165, 4574, 858, -4072, 4499,
+	960, -3963, 4418, 1047, -3838, 4330, 1114, -3700, 4238, 1158, -3557, 4143,
+	1181, -3415, 4049,
+	/* -10.0 */
+	1084, -2514, 3793, 1085, -2364, 3714, 1079, -2228, 3637, 1075, -2105, 3563,
+	1076, -1988, 3490, 1081, -1871, 3418, 1087, -1749, 3347, 1090, -1622, 3279,
+	1085, -1492, 3213, 1071, -1361, 3152, 1050, -1234, 3095, 1025, -1111, 3042,
+	1002, -989, 2994, 983, -859, 2950, 961, -710, 2907, 927, -536, 2863,
+	862, -335, 2816, 747, -120, 2765, 566, 85, 2708, 313, 249, 2648,
+	-9, 337, 2588, -382, 319, 2531, -781, 174, 2482, -1174, -104, 2445,
+	-1532, -504, 2422, -1832, -1001, 2416, -2059, -1560, 2428, -2207, -2141, 2457,
+	-2275, -2707, 2501, -2270, -3228, 2557, -2200, -3684, 2624, -2075, -4066, 2699,
+	-1908, -4373, 2781, -1707, -4612, 2866, -1482, -4789, 2949, -1242, -4912, 3025,
+	-997, -4987, 3090, -757, -5014, 3138, -537, -4994, 3168, -352, -4924, 3182,
+	-222, -4803, 3186, -163, -4637, 3188, -185, -4441, 3200, -278, -4240, 3234,
+	-421, -4060, 3298, -579, -3923, 3396, -719, -3839, 3525, -818, -3802, 3675,
+	-868, -3799, 3837, -872, -3817, 4000, -838, -3848, 4158, -770, -3885, 4305,
+	-668, -3920, 4434, -533, -3944, 4539, -375, -3943, 4613, -213, -3909, 4652,
+	-71, -3842, 4660, 31, -3755, 4643, 89, -3669, 4612, 116, -3602, 4578,
+	135, -3564, 4545, 170, -3549, 4514, 234, -3541, 4480, 325, -3526, 4439,
+	434, -3492, 4390, 551, -3435, 4331, 665, -3356, 4265, 775, -3255, 4194,
+	875, -3135, 4118, 961, -2994, 4038, 1026, -2838, 3956, 1067, -2675, 3874,
+	1084, -2514, 3793,
+	/* -5.0 */
+	1014, -1529, 3576, 1011, -1364, 3513, 998, -1218, 3453, 987, -1091, 3396,
+	983, -974, 3339, 986, -860, 3285, 992, -743, 3233, 995, -621, 3183,
+	993, -494, 3138, 981, -367, 3096, 962, -244, 3058, 941, -124, 3025,
+	920, -2, 2996, 901, 129, 2970, 878, 281, 2947, 837, 458, 2922,
+	762, 658, 2895, 635, 866, 2862, 445, 1057, 2824, 187, 1202, 2779,
+	-131, 1269, 2730, -492, 1232, 2681, -869, 1074, 2633, -1235, 789, 2591,
+	-1562, 385, 2559, -1829, -120, 2541, -2021, -694, 2540, -2131, -1297, 2557,
+	-2159, -1889, 2593, -2109, -2433, 2644, -1992, -2904, 2707, -1823, -3289, 2779,
+	-1619, -3585, 2857, -1395, -3800, 2937, -1167, -3945, 3016, -943, -4034, 3089,
+	-729, -4078, 3153, -527, -4082, 3202, -340, -4047, 3236, -177, -3968, 3255,
+	-51, -3842, 3262, 23, -3671, 3264, 29, -3469, 3271, -32, -3259, 3293,
+	-146, -3072, 3340, -284, -2929, 3414, -414, -2841, 3515, -515, -2802, 3635,
+	-576, -2797, 3765, -599, -2813, 3898, -591, -2841, 4028, -553, -2877, 4150,
+	-485, -2915, 4257, -387, -2943, 4344, -266, -2948, 4403, -138, -2920, 4432,
+	-27, -2857, 4431, 48, -2775, 4407, 83, -2694, 4371, 91, -2637, 4331,
+	94, -2612, 4293, 117, -2612, 4255, 171, -2621, 4215, 255, -2619, 4170,
+	361, -2593, 4116, 475, -2539, 4056, 589, -2459, 3990, 699, -2353, 3922,
+	802, -2222, 3852, 890, -2067, 3781, 958, -1893, 3711, 999, -1709, 3642,
+	1014, -1529, 3576,
+	/* 0.0 */
+	965, -500, 3415, 960, -322, 3369, 944, -169, 3326, 929, -39, 3286,
+	921, 75, 3247, 922, 183, 3210, 928, 292, 3177, 934, 407, 3148,
+	934, 526, 3123, 925, 645, 3103, 909, 762, 3087, 889, 877, 3074,
+	869, 994, 3065, 848, 1122, 3059, 819, 1271, 3054, 769, 1442, 3048,
+	682, 1631, 3038, 541, 1820, 3021, 340, 1987, 2996, 78, 2105, 2962,
+	-235, 2148, 2920, -582, 2096, 2873, -937, 1934, 2823, -1275, 1657, 2774,
+	-1570, 1266, 2731, -1803, 777, 2699, -1959, 217, 2682, -2031, -377, 2683,
+	-2020, -965, 2705, -1933, -1507, 2744, -1781, -1973, 2798, -1584, -2346, 2860,
+	-1360, -2624, 2929, -1130, -2813, 2999, -908, -2927, 3069, -705, -2984, 3135,
+	-521, -2999, 3194, -354, -2981, 3243, -200, -2933, 3279, -60, -2848, 3303,
+	56, -2720, 3316, 134, -2548, 3324, 157, -2344, 3334, 119, -2131, 3354,
+	30, -1941, 3393, -87, -1798, 3453, -206, -1710, 3533, -302, -1671, 3627,
+	-366, -1667, 3729, -400, -1682, 3835, -408, -1708, 3939, -392, -1744, 4037,
+	-351, -1783, 4124, -284, -1816, 4194, -195, -1828, 4241, -99, -1808, 4261,
+	-16, -1755, 4257, 36, -1683, 4232, 53, -1615, 4195, 46, -1572, 4152,
+	37, -1564, 4108, 50, -1582, 4063, 96, -1609, 4015, 176, -1623, 3961,
+	278, -1609, 3901, 392, -1564, 3837, 509, -1487, 3771, 623, -1381, 3704,
+	732, -1245, 3639, 827, -1081, 3577, 901, -893, 3518, 947, -695, 3464,
+	965, -500, 3415,
+	/* 5.0 */
+	928, 523, 3317, 927, 706, 3288, 913, 862, 3262, 897, 991, 3238,
+	888, 1100, 3216, 889, 1200, 3197, 898, 1300, 3182, 908, 1405, 3173,
+	912, 1515, 3170, 906, 1627, 3171, 892, 1736, 3177, 873, 1845, 3186,
+	850, 1956, 3197, 824, 2078, 3210, 785, 2218, 3223, 721, 2376, 3234,
+	617, 2544, 3239, 460, 2707, 3235, 246, 2844, 3220, -20, 2932, 3192,
+	-329, 2952, 3152, -660, 2888, 3103, -992, 2728, 3048, -1301, 2466, 2990,
+	-1564, 2104, 2935, -1762, 1653, 2888, -1881, 1133, 2854, -1917, 579, 2838,
+	-1873, 29, 2843, -1758, -480, 2866, -1586, -917, 2905, -1375, -1265, 2954,
+	-1147, -1516, 3009, -919, -1678, 3068, -708, -1764, 3127, -523, -1793, 3185,
+	-363, -1784, 3239, -224, -1749, 3286, -96, -1691, 3325, 22, -1603, 3355,
+	127, -1477, 3376, 203, -1311, 3394, 235, -1112, 3412, 214, -906, 3439,
+	144, -721, 3478, 43, -582, 3530, -63, -497, 3596, -152, -462, 3671,
+	-216, -458, 3751, -254, -473, 3834, -271, -497, 3916, -270, -530, 3993,
+	-250, -568, 4063, -208, -602, 4119, -147, -619, 4156, -80, -608, 4173,
+	-23, -568, 4168, 6, -512, 4145, 6, -462, 4109, -15, -437, 4064,
+	-34, -447, 4014, -30, -485, 3959, 8, -530, 3899, 82, -562, 3834,
+	181, -566, 3765, 295, -535, 3695, 415, -470, 3624, 537, -371, 3557,
+	655, -239, 3495, 761, -74, 3440, 847, 117, 3392, 903, 321, 3351,
+	928, 523, 3317,
+	/* 10.0 */
+	895, 1487, 3286, 905, 1667, 3271, 898, 1820, 3259, 887, 1946, 3250,
+	881, 2049, 3243, 886, 2141, 3241, 900, 2232, 3244, 915, 2328, 3254,
+	925, 2429, 3271, 924, 2533, 3293, 912, 2637, 3320, 891, 2740, 3350,
+	864, 2847, 3382, 827, 2962, 3414, 774, 3091, 3445, 691, 3232, 3471,
+	566, 3376, 3489, 390, 3509, 3494, 162, 3614, 3485, -112, 3673, 3459,
+	-416, 3671, 3418, -734, 3597, 3364, -1043, 3443, 3302, -1322, 3202, 3234,
+	-1551, 2877, 3167, -1711, 2476, 3106, -1795, 2018, 3057, -1799, 1529, 3025,
+	-1729, 1044, 3013, -1595, 595, 3019, -1414, 208, 3041, -1202, -99, 3075,
+	-977, -318, 3116, -758, -452, 3163, -558, -514, 3213, -387, -521, 3265,
+	-244, -494, 3315, -124, -446, 3362, -17, -382, 3404, 85, -295, 3439,
+	178, -177, 3469, 250, -23, 3498, 286, 160, 3528, 276, 351, 3564,
+	219, 522, 3608, 133, 650, 3659, 38, 727, 3716, -44, 759, 3778,
+	-105, 761, 3842, -143, 748, 3908, -166, 726, 3973, -175, 698, 4036,
+	-169, 665, 4093, -148, 634, 4138, -112, 616, 4170, -72, 619, 4184,
+	-42, 646, 4181, -34, 684, 4161, -53, 714, 4127, -87, 719, 4079,
+	-117, 691, 4021, -124, 636, 3954, -95, 573, 3880, -29, 523, 3801,
+	65, 499, 3720, 179, 510, 3639, 304, 556, 3562, 434, 638, 3492,
+	563, 756, 3430, 684, 909, 3378, 784, 1091, 3337, 856, 1289, 3307,
+	895, 1487, 3286,
+	/* 15.0 */
+	857, 2356, 3316, 885, 2526, 3312, 893, 2671, 3312, 893, 2790, 3315,
+	897, 2888, 3322, 910, 2974, 3335, 931, 3058, 3354, 954, 3146, 3381,
+	970, 3240, 3417, 974, 3339, 3460, 964, 3439, 3507, 941, 3540, 3556,
+	907, 3643, 3607, 858, 3754, 3657, 786, 3872, 3704, 680, 3996, 3744,
+	531, 4118, 3773, 332, 4224, 3786, 86, 4300, 3780, -197, 4333, 3754,
+	-500, 4312, 3710, -806, 4230, 3651, -1094, 4081, 3580, -1343, 3862, 3502,
+	-1536, 3577, 3424, -1660, 3232, 3351, -1708, 2844, 3290, -1684, 2435, 3245,
+	-1594, 2031, 3218, -1451, 1657, 3210, -1270, 1334, 3216, -1063, 1078, 3236,
+	-847, 897, 3265, -637, 789, 3301, -447, 747, 3344, -286, 754, 3391,
+	-155, 793, 3440, -47, 848, 3488, 48, 915, 3532, 136, 997, 3573,
+	219, 1104, 3611, 286, 1240, 3649, 324, 1400, 3690, 320, 1566, 3736,
+	275, 1715, 3785, 200, 1827, 3838, 116, 1895, 3891, 41, 1923, 3945,
+	-16, 1924, 3999, -54, 1912, 4055, -79, 1894, 4110, -94, 1872, 4164,
+	-100, 1847, 4213, -95, 1822, 4253, -82, 1806, 4282, -68, 1806, 4297,
+	-64, 1821, 4297, -79, 1841, 4280, -117, 1852, 4246, -166, 1839, 4195,
+	-210, 1795, 4128, -229, 1727, 4048, -212, 1651, 3959, -157, 1583, 3863,
+	-69, 1538, 3767, 43, 1525, 3674, 171, 1547, 3587, 309, 1605, 3509,
+	451, 1700, 3443, 587, 1831, 3391, 706, 1993, 3353, 798, 2173, 3329,
+	857, 2356, 3316,
+	/* 20.0 */
+	806, 3117, 3403, 860, 3269, 3404, 890, 3402, 3412, 910, 3514, 3426,
+	929, 3606, 3445, 955, 3688, 3471, 987, 3767, 3505, 1019, 3851, 3549,
+	1042, 3941, 3601, 1052, 4037, 3661, 1043, 4136, 3726, 1018, 4237, 3794,
+	975, 4340, 3861, 911, 4447, 3927, 818, 4558, 3988, 688, 4669, 4039,
+	512, 4771, 4077, 288, 4855, 4096, 21, 4908, 4094, -275, 4920, 4068,
+	-582, 4884, 4021, -879, 4795, 3956, -1147, 4652, 3877, -1368, 4455, 3790,
+	-1526, 4207, 3702, -1614, 3917, 3619, -1631, 3599, 3548, -1582, 3270, 3493,
+	-1478, 2949, 3456, -1331, 2654, 3436, -1153, 2399, 3431, -955, 2196, 3439,
+	-750, 2053, 3457, -550, 1971, 3485, -367, 1943, 3523, -212, 1959, 3567,
+	-86, 2002, 3615, 15, 2060, 3663, 102, 2125, 3710, 181, 2202, 3755,
+	256, 2295, 3798, 318, 2410, 3843, 355, 2543, 3892, 358, 2681, 3944,
+	322, 2805, 3998, 259, 2899, 4053, 185, 2956, 4105, 117, 2980, 4156,
+	65, 2982, 4207, 28, 2972, 4258, 2, 2958, 4309, -17, 2942, 4360,
+	-33, 2925, 4407, -43, 2909, 4447, -51, 2898, 4477, -62, 2896, 4494,
+	-84, 2902, 4497, -125, 2909, 4482, -184, 2904, 4448, -252, 2876, 4393,
+	-311, 2821, 4318, -345, 2744, 4226, -342, 2656, 4121, -299, 2574, 4010,
+	-219, 2511, 3898, -111, 2475, 3790, 20, 2471, 3691, 165, 2501, 3604,
+	318, 2568, 3531, 470, 2670, 3475, 608, 2803, 3435, 723, 2957, 3412,
+	806, 3117, 3403,
+	/* 25.0 */
+	739, 3773, 3541, 823, 3903, 3544, 883, 4021, 3557, 929, 4124, 3578,
+	971, 4212, 3607, 1015, 4291, 3645, 1061, 4369, 3693, 1103, 4451, 3751,
+	1134, 4540, 3818, 1148, 4636, 3893, 1142, 4736, 3973, 1113, 4838, 4055,
+	1061, 4943, 4135, 982, 5049, 4213, 868, 5155, 4284, 712, 5256, 4345,
+	509, 5345, 4389, 257, 5413, 4413, -33, 5449, 4414, -346, 5446, 4389,
+	-660, 5400, 4340, -953, 5308, 4271, -1206, 5171, 4186, -1400, 4992, 4091,
+	-1528, 4778, 3995, -1584, 4538, 3905, -1573, 4282, 3827, -1504, 4025, 3764,
+	-1389, 3779, 3719, -1240, 3554, 3691, -1067, 3361, 3676, -877, 3207, 3675,
+	-681, 3099, 3685, -489, 3038, 3706, -312, 3022, 3738, -160, 3042, 3779,
+	-35, 3085, 3825, 65, 3141, 3874, 148, 3203, 3921, 222, 3272, 3968,
+	291, 3352, 4014, 350, 3447, 4062, 387, 3554, 4114, 395, 3664, 4169,
+	371, 3763, 4227, 321, 3839, 4283, 259, 3887, 4338, 199, 3908, 4390,
+	151, 3911, 4442, 116, 3905, 4494, 88, 3896, 4547, 64, 3886, 4600,
+	39, 3876, 4649, 13, 3868, 4693, -16, 3862, 4727, -52, 3861, 4748,
+	-102, 3862, 4754, -170, 3859, 4742, -253, 3842, 4707, -341, 3804, 4648,
+	-419, 3741, 4566, -470, 3658, 4464, -482, 3563, 4347, -452, 3470, 4223,
+	-381, 3392, 4097, -277, 3335, 3975, -145, 3307, 3864, 6, 3311, 3766,
+	169, 3348, 3685, 334, 3419, 3622, 490, 3519, 3577, 628, 3641, 3551,
+	739, 3773, 3541,
+	/* 30.0 */
+	658, 4343, 3726, 773, 4448, 3728, 868, 4549, 3743, 946, 4641, 3769,
+	1017, 4725, 3807, 1083, 4804, 3855, 1145, 4883, 3915, 1199, 4967, 3985,
+	1238, 5057, 4065, 1257, 5154, 4151, 1251, 5256, 4241, 1219, 5361, 4333,
+	1158, 5467, 4423, 1064, 5573, 4508, 929, 5676, 4585, 748, 5771, 4650,
+	517, 5852, 4699, 237, 5909, 4726, -80, 5934, 4729, -413, 5922, 4705,
+	-738, 5870, 4656, -1032, 5777, 4584, -1272, 5648, 4495, -1446, 5487, 4397,
+	-1547, 5302, 4296, -1577, 5103, 4201, -1544, 4899, 4117, -1459, 4700, 4048,
+	-1335, 4513, 3996, -1184, 4346, 3960, -1013, 4203, 3938, -830, 4090, 3929,
+	-641, 4011, 3931, -454, 3969, 3946, -279, 3961, 3972, -127, 3982, 4009,
+	0, 4023, 4052, 102, 4074, 4098, 187, 4131, 4145, 260, 4193, 4191,
+	327, 4260, 4237, 384, 4337, 4285, 424, 4421, 4337, 440, 4506, 4393,
+	428, 4583, 4451, 394, 4644, 4510, 346, 4684, 4568, 298, 4704, 4625,
+	256, 4710, 4682, 221, 4709, 4741, 190, 4706, 4800, 158, 4702, 4859,
+	122, 4700, 4914, 79, 4698, 4963, 27, 4698, 5003, -37, 4698, 5029,
+	-117, 4696, 5039, -214, 4686, 5027, -324, 4662, 4992, -435, 4617, 4932,
+	-533, 4549, 4845, -602, 4461, 4737, -629, 4363, 4612, -611, 4263, 4478,
+	-548, 4173, 4342, -448, 4101, 4211, -316, 4054, 4090, -161, 4034, 3983,
+	10, 4044, 3894, 186, 4084, 3823, 359, 4152, 3772, 519, 4241, 3740,
+	658, 4343, 3726,
+	/* 35.0 */
+	569, 4848, 3956, 716, 4929, 3955, 845, 5012, 3970, 958, 5093, 4000,
+	1060, 5172, 4043, 1152, 5251, 4100, 1234, 5333, 4168, 1300, 5420, 4248,
+	1348, 5514, 4336, 1371, 5614, 4429, 1366, 5718, 4526, 1330, 5825, 4622,
+	1260, 5933, 4716, 1151, 6039, 4803, 997, 6140, 4882, 791, 6231, 4947,
+	531, 6305, 4996, 221, 6356, 5024, -124, 6375, 5027, -481, 6358, 5003,
+	-821, 6303, 4955, -1119, 6213, 4883, -1352, 6092, 4795, -1511, 5947, 4695,
+	-1592, 5787, 4592, -1602, 5621, 4494, -1552, 5458, 4407, -1454, 5302, 4333,
+	-1323, 5160, 4275, -1168, 5036, 4232, -998, 4931, 4202, -816, 4849, 4186,
+	-629, 4793, 4181, -444, 4764, 4189, -269, 4762, 4208, -113, 4782, 4238,
+	19, 4818, 4276, 128, 4864, 4318, 218, 4915, 4361, 295, 4968, 4404,
+	364, 5025, 4449, 424, 5086, 4495, 470, 5151, 4545, 498, 5216, 4600,
+	503, 5275, 4658, 487, 5324, 4719, 458, 5359, 4782, 423, 5379, 4847,
+	388, 5390, 4913, 354, 5396, 4980, 318, 5399, 5048, 276, 5403, 5115,
+	224, 5408, 5179, 160, 5412, 5235, 81, 5417, 5280, -14, 5419, 5311,
+	-128, 5415, 5323, -258, 5401, 5314, -397, 5372, 5279, -535, 5322, 5217,
+	-653, 5250, 5130, -739, 5161, 5019, -780, 5060, 4891, -771, 4957, 4754,
+	-715, 4861, 4613, -617, 4778, 4478, -485, 4716, 4352, -326, 4677, 4240,
+	-149, 4664, 4144, 38, 4678, 4068, 225, 4716, 4011, 404, 4775, 3974,
+	569, 4848, 3956,
+	/* 40.0 */
+	482, 5311, 4225, 658, 5370, 4222, 819, 5437, 4236, 966, 5507, 4267,
+	1099, 5582, 4314, 1218, 5661, 4375, 1320, 5745, 4448, 1402, 5836, 4532,
+	1459, 5933, 4624, 1488, 6036, 4720, 1484, 6143, 4817, 1445, 6251, 4913,
+	1366, 6359, 5004, 1242, 6464, 5089, 1067, 6563, 5164, 835, 6650, 5225,
+	544, 6720, 5270, 201, 6765, 5294, -176, 6780, 5296, -560, 6760, 5272,
+	-918, 6706, 5225, -1223, 6620, 5156, -1454, 6508, 5069, -1603, 6378, 4972,
+	-1670, 6239, 4871, -1666, 6099, 4773, -1604, 5965, 4684, -1497, 5841, 4606,
+	-1358, 5730, 4543, -1198, 5635, 4493, -1023, 5557, 4456, -839, 5497, 4432,
+	-650, 5456, 4420, -462, 5437, 4420, -284, 5438, 4432, -121, 5456, 4454,
+	20, 5487, 4484, 140, 5527, 4519, 240, 5570, 4557, 327, 5615, 4597,
+	405, 5661, 4638, 474, 5710, 4682, 532, 5760, 4730, 576, 5809, 4783,
+	601, 5856, 4842, 609, 5895, 4906, 602, 5927, 4975, 583, 5950, 5047,
+	557, 5968, 5122, 524, 5981, 5200, 481, 5993, 5278, 424, 6005, 5354,
+	352, 6017, 5425, 261, 6029, 5488, 150, 6037, 5538, 17, 6041, 5573,
+	-135, 6037, 5588, -302, 6020, 5579, -475, 5986, 5545, -640, 5932, 5485,
+	-780, 5859, 5399, -880, 5770, 5290, -932, 5669, 5165, -930, 5565, 5030,
+	-877, 5466, 4892, -780, 5378, 4758, -644, 5306, 4632, -481, 5254, 4520,
+	-297, 5224, 4424, -102, 5217, 4346, 97, 5231, 4286, 294, 5263, 4246,
+	482, 5311, 4225,
+	/* 45.0 */
+	408, 5754, 4522, 608, 5796, 4519, 797, 5848, 4533, 973, 5909, 4563,
+	1134, 5979, 4610, 1278, 6057, 4671, 1401, 6142, 4744, 1499, 6234, 4826,
+	1569, 6333, 4915, 1605, 6437, 5007, 1605, 6544, 5100, 1563, 6653, 5189,
+	1476, 6759, 5274, 1337, 6862, 5350, 1139, 6957, 5416, 877, 7040, 5470,
+	551, 7104, 5507, 169, 7145, 5526, -245, 7156, 5524, -661, 7135, 5499,
+	-1042, 7081, 5453, -1357, 7000, 5388, -1589, 6898, 5307, -1732, 6781, 5215,
+	-1791, 6660, 5119, -1777, 6539, 5024, -1706, 6426, 4935, -1591, 6324, 4856,
+	-1444, 6234, 4789, -1277, 6158, 4734, -1095, 6097, 4690, -904, 6051, 4659,
+	-708, 6021, 4640, -514, 6007, 4632, -327, 6008, 4635, -154, 6023, 4648,
+	1, 6048, 4670, 137, 6080, 4697, 255, 6115, 4729, 359, 6152, 4763,
+	453, 6190, 4801, 539, 6228, 4842, 616, 6267, 4889, 682, 6305, 4942,
+	733, 6342, 5002, 767, 6377, 5070, 785, 6408, 5143, 786, 6435, 5223,
+	770, 6459, 5306, 738, 6482, 5392, 687, 6504, 5479, 613, 6525, 5562,
+	515, 6546, 5640, 390, 6564, 5707, 238, 6577, 5761, 61, 6583, 5798,
+	-137, 6578, 5815, -347, 6559, 5808, -557, 6522, 5776, -751, 6466, 5718,
+	-912, 6392, 5637, -1025, 6302, 5535, -1084, 6204, 5418, -1085, 6102, 5291,
+	-1031, 6004, 5161, -930, 5914, 5035, -790, 5838, 4916, -620, 5778, 4809,
+	-429, 5737, 4718, -224, 5715, 4642, -12, 5711, 4584, 200, 5725, 4544,
+	408, 5754, 4522,
+	/* 50.0 */
+	353, 6189, 4832, 573, 6219, 4829, 784, 6261, 4842, 984, 6315, 4870,
+	1169, 6379, 4913, 1335, 6453, 4969, 1479, 6536, 5036, 1595, 6627, 5111,
+	1678, 6725, 5191, 1726, 6827, 5273, 1731, 6932, 5354, 1690, 7038, 5432,
+	1595, 7141, 5505, 1439, 7239, 5569, 1215, 7329, 5624, 916, 7406, 5666,
+	545, 7465, 5694, 114, 7499, 5705, -348, 7506, 5699, -803, 7483, 5673,
+	-1211, 7431, 5630, -1540, 7355, 5569, -1774, 7261, 5495, -1913, 7157, 5411,
+	-1965, 7049, 5323, -1944, 6944, 5235, -1864, 6846, 5150, -1741, 6758, 5072,
+	-1586, 6681, 5003, -1409, 6618, 4945, -1216, 6566, 4897, -1014, 6528, 4860,
+	-808, 6503, 4834, -602, 6491, 4818, -401, 6491, 4813, -213, 6501, 4818,
+	-38, 6519, 4831, 119, 6543, 4850, 262, 6571, 4875, 392, 6599, 4905,
+	513, 6629, 4939, 625, 6659, 4979, 729, 6690, 5025, 823, 6722, 5079,
+	904, 6754, 5141, 968, 6786, 5211, 1013, 6818, 5288, 1036, 6850, 5372,
+	1034, 6883, 5461, 1004, 6915, 5552, 944, 6947, 5643, 851, 6978, 5731,
+	722, 7007, 5811, 557, 7032, 5881, 357, 7050, 5936, 126, 7058, 5974,
+	-127, 7053, 5991, -389, 7032, 5986, -642, 6993, 5957, -867, 6936, 5906,
+	-1048, 6862, 5832, -1172, 6775, 5741, -1234, 6680, 5636, -1233, 6583, 5523,
+	-1174, 6488, 5407, -1066, 6401, 5294, -919, 6325, 5187, -740, 6263, 5091,
+	-539, 6217, 5009, -324, 6186, 4940, -100, 6172, 4888, 127, 6173, 4852,
+	353, 6189, 4832,
+	/* 55.0 */
+	317, 6625, 5130, 554, 6647, 5128, 784, 6682, 5139, 1003, 6729, 5163,
+	1207, 6787, 5199, 1393, 6856, 5246, 1556, 6934, 5301, 1690, 7019, 5363,
+	1790, 7112, 5428, 1851, 7208, 5495, 1866, 7308, 5561, 1827, 7407, 5623,
+	1725, 7504, 5680, 1550, 7596, 5730, 1293, 7679, 5771, 947, 7749, 5801,
+	516, 7800, 5819, 19, 7828, 5823, -507, 7830, 5812, -1012, 7804, 5786,
+	-1452, 7753, 5745, -1796, 7681, 5691, -2032, 7595, 5626, -2165, 7501, 5553,
+	-2208, 7405, 5475, -2177, 7312, 5395, -2087, 7225, 5318, -1953, 7147, 5245,
+	-1786, 7080, 5178, -1596, 7023, 5120, -1389, 6977, 5070, -1172, 6942, 5030,
+	-950, 6919, 4999, -727, 6905, 4978, -508, 6902, 4966, -297, 6906, 4963,
+	-96, 6917, 4969, 91, 6933, 4981, 267, 6953, 5001, 432, 6975, 5026,
+	588, 6998, 5058, 735, 7023, 5097, 875, 7049, 5143, 1004, 7077, 5197,
+	1119, 7107, 5260, 1216, 7139, 5330, 1291, 7174, 5409, 1338, 7211, 5494,
+	1353, 7251, 5583, 1330, 7292, 5675, 1265, 7333, 5765, 1153, 7374, 5851,
+	991, 7412, 5930, 779, 7444, 5998, 521, 7467, 6052, 224, 7478, 6089,
+	-96, 7474, 6107, -420, 7452, 6105, -723, 7412, 6081, -983, 7355, 6037,
+	-1185, 7283, 5975, -1317, 7200, 5898, -1379, 7110, 5810, -1372, 7019, 5714,
+	-1306, 6931, 5617, -1188, 6850, 5521, -1030, 6779, 5431, -841, 6719, 5350,
+	-628, 6672, 5279, -401, 6639, 5221, -165, 6621, 5177, 76, 6616, 5146,
+	317, 6625, 5130,
+	/* 60.0 */
+	296, 7059, 5391, 548, 7076, 5388, 794, 7106, 5396, 1029, 7147, 5414,
+	1251, 7198, 5441, 1454, 7259, 5476, 1635, 7329, 5516, 1788, 7406, 5562,
+	1906, 7489, 5609, 1983, 7576, 5658, 2008, 7666, 5705, 1973, 7756, 5750,
+	1863, 7844, 5790, 1665, 7927, 5824, 1365, 8001, 5850, 954, 8062, 5868,
+	439, 8105, 5876, -151, 8125, 5874, -762, 8121, 5860, -1332, 8092, 5835,
+	-1807, 8040, 5799, -2162, 7972, 5752, -2393, 7893, 5697, -2513, 7809, 5636,
+	-2539, 7723, 5570, -2489, 7640, 5502, -2382, 7563, 5435, -2231, 7493, 5370,
+	-2046, 7432, 5310, -1837, 7380, 5255, -1611, 7337, 5208, -1374, 7303, 5167,
+	-1130, 7279, 5135, -884, 7262, 5111, -639, 7254, 5095, -399, 7253, 5088,
+	-166, 7257, 5088, 59, 7266, 5096, 275, 7279, 5112, 482, 7295, 5134,
+	682, 7313, 5164, 873, 7334, 5201, 1054, 7358, 5246, 1224, 7384, 5299,
+	1378, 7414, 5361, 1513, 7448, 5429, 1621, 7486, 5505, 1698, 7528, 5586,
+	1735, 7574, 5670, 1726, 7621, 5756, 1662, 7671, 5840, 1537, 7719, 5920,
+	1345, 7764, 5993, 1084, 7803, 6055, 759, 7831, 6105, 384, 7846, 6139,
+	-19, 7844, 6157, -419, 7824, 6158, -784, 7785, 6141, -1087, 7731, 6108,
+	-1313, 7663, 6060, -1455, 7586, 6000, -1515, 7504, 5930, -1502, 7422, 5856,
+	-1425, 7343, 5779, -1296, 7271, 5703, -1127, 7206, 5632, -925, 7152, 5567,
+	-701, 7109, 5511, -462, 7078, 5465, -212, 7059, 5429, 42, 7053, 5405,
+	296, 7059, 5391,
+	/* 65.0 */
+	283, 7483, 5593, 549, 7498, 5589, 809, 7522, 5592, 1060, 7557, 5603,
+	1298, 7600, 5619, 1518, 7652, 5640, 1717, 7711, 5665, 1888, 7776, 5694,
+	2024, 7847, 5723, 2115, 7922, 5753, 2151, 7999, 5783, 2117, 8077, 5809,
+	1995, 8153, 5833, 1762, 8224, 5852, 1399, 8287, 5865, 892, 8337, 5873,
+	252, 8371, 5873, -471, 8382, 5866, -1195, 8371, 5850, -1835, 8337, 5827,
+	-2336, 8286, 5796, -2684, 8221, 5758, -2890, 8149, 5713, -2977, 8074, 5664,
+	-2969, 7998, 5612, -2888, 7926, 5558, -2751, 7857, 5503, -2571, 7795, 5450,
+	-2360, 7740, 5399, -2124, 7691, 5353, -1872, 7651, 5311, -1607, 7618, 5275,
+	-1335, 7592, 5245, -1059, 7573, 5222, -782, 7561, 5206, -507, 7554, 5197,
+	-234, 7553, 5196, 33, 7556, 5201, 294, 7564, 5214, 549, 7575, 5234,
+	796, 7590, 5262, 1035, 7609, 5296, 1263, 7631, 5338, 1478, 7658, 5388,
+	1676, 7688, 5444, 1853, 7724, 5506, 2002, 7764, 5574, 2115, 7808, 5646,
+	2186, 7857, 5720, 2202, 7909, 5795, 2155, 7963, 5867, 2032, 8016, 5936,
+	1822, 8066, 5998, 1520, 8110, 6051, 1127, 8144, 6094, 660, 8163, 6125,
+	155, 8165, 6143, -345, 8149, 6147, -791, 8115, 6138, -1152, 8066, 6117,
+	-1412, 8006, 6084, -1569, 7938, 6042, -1632, 7867, 5993, -1615, 7796, 5939,
+	-1530, 7729, 5884, -1392, 7666, 5829, -1212, 7612, 5777, -1000, 7565, 5729,
+	-765, 7528, 5687, -513, 7501, 5652, -252, 7485, 5624, 15, 7479, 5605,
+	283, 7483, 5593,
+	/* 70.0 */
+	268, 7888, 5724, 546, 7900, 5717, 820, 7919, 5716, 1085, 7946, 5719,
+	1338, 7980, 5725, 1575, 8021, 5734, 1790, 8069, 5746, 1977, 8121, 5759,
+	2126, 8178, 5773, 2228, 8238, 5787, 2267, 8300, 5800, 2222, 8363, 5812,
+	2068, 8424, 5822, 1771, 8481, 5828, 1297, 8530, 5831, 629, 8568, 5830,
+	-206, 8588, 5825, -1112, 8588, 5814, -1956, 8568, 5799, -2634, 8530, 5778,
+	-3110, 8479, 5753, -3401, 8420, 5723, -3540, 8356, 5690, -3562, 8291, 5653,
+	-3495, 8227, 5614, -3361, 8165, 5573, -3177, 8106, 5533, -2956, 8053, 5493,
+	-2706, 8004, 5455, -2434, 7961, 5419, -2147, 7924, 5387, -1849, 7893, 5358,
+	-1542, 7867, 5335, -1230, 7847, 5316, -916, 7833, 5303, -601, 7823, 5296,
+	-287, 7819, 5295, 24, 7819, 5300, 332, 7823, 5312, 634, 7831, 5330,
+	929, 7844, 5354, 1217, 7861, 5384, 1493, 7882, 5421, 1756, 7907, 5463,
+	2002, 7937, 5510, 2227, 7972, 5562, 2424, 8012, 5618, 2587, 8056, 5676,
+	2705, 8104, 5735, 2769, 8156, 5794, 2764, 8209, 5852, 2674, 8263, 5905,
+	2480, 8315, 5954, 2166, 8362, 5997, 1726, 8400, 6031, 1171, 8425, 6057,
+	543, 8434, 6074, -89, 8425, 6082, -657, 8400, 6080, -1110, 8361, 6069,
+	-1431, 8312, 6051, -1624, 8257, 6026, -1705, 8199, 5996, -1694, 8142, 5963,
+	-1610, 8087, 5927, -1468, 8037, 5891, -1283, 7993, 5857, -1064, 7955, 5825,
+	-822, 7926, 5796, -562, 7904, 5771, -290, 7890, 5750, -13, 7885, 5734,
+	268, 7888, 5724,
+	/* 75.0 */
+	245, 8265, 5782, 532, 8272, 5775, 815, 8286, 5770, 1090, 8305, 5767,
+	1353, 8330, 5766, 1600, 8360, 5766, 1822, 8394, 5767, 2014, 8432, 5770,
+	2163, 8474, 5772, 2254, 8518, 5774, 2266, 8564, 5776, 2167, 8610, 5777,
+	1916, 8654, 5777, 1459, 8694, 5775, 743, 8726, 5771, -232, 8746, 5765,
+	-1356, 8749, 5756, -2423, 8735, 5744, -3262, 8705, 5730, -3828, 8664, 5713,
+	-4156, 8617, 5694, -4300, 8565, 5672, -4312, 8513, 5649, -4227, 8460, 5623,
+	-4072, 8409, 5597, -3865, 8359, 5570, -3618, 8313, 5543, -3343, 8270, 5517,
+	-3045, 8230, 5491, -2730, 8195, 5468, -2402, 8164, 5447, -2064, 8137, 5428,
+	-1720, 8114, 5413, -1370, 8096, 5401, -1018, 8082, 5394, -664, 8072, 5390,
+	-310, 8066, 5391, 43, 8065, 5397, 393, 8068, 5407, 739, 8074, 5422,
+	1079, 8085, 5442, 1412, 8100, 5465, 1735, 8118, 5494, 2047, 8141, 5526,
+	2343, 8169, 5561, 2621, 8200, 5599, 2876, 8236, 5639, 3100, 8275, 5681,
+	3286, 8318, 5723, 3424, 8363, 5765, 3499, 8411, 5805, 3493, 8460, 5843,
+	3382, 8508, 5877, 3139, 8554, 5908, 2736, 8594, 5933, 2160, 8625, 5954,
+	1435, 8643, 5969, 636, 8647, 5978, -125, 8636, 5981, -756, 8612, 5979,
+	-1214, 8579, 5972, -1503, 8540, 5962, -1647, 8498, 5947, -1677, 8456, 5930,
+	-1618, 8415, 5911, -1493, 8378, 5892, -1316, 8345, 5872, -1103, 8317, 5853,
+	-861, 8295, 5835, -600, 8278, 5819, -325, 8267, 5804, -42, 8263, 5792,
+	245, 8265, 5782,
+	/* 80.0 */
+	230, 8607, 5781, 506, 8611, 5774, 779, 8619, 5768, 1043, 8631, 5763,
+	1292, 8646, 5758, 1518, 8664, 5753, 1711, 8686, 5749, 1858, 8710, 5745,
+	1940, 8736, 5741, 1925, 8763, 5737, 1772, 8791, 5733, 1414, 8818, 5728,
+	765, 8841, 5723, -246, 8858, 5717, -1566, 8865, 5710, -2930, 8859, 5702,
+	-4030, 8840, 5693, -4760, 8813, 5682, -5171, 8779, 5671, -5352, 8743, 5659,
+	-5374, 8705, 5646, -5286, 8667, 5632, -5120, 8629, 5617, -4899, 8591, 5602,
+	-4636, 8555, 5587, -4342, 8520, 5572, -4024, 8488, 5557, -3688, 8457, 5543,
+	-3338, 8429, 5529, -2977, 8403, 5517, -2607, 8381, 5506, -2230, 8361, 5497,
+	-1848, 8344, 5490, -1463, 8330, 5485, -1075, 8319, 5483, -686, 8312, 5483,
+	-297, 8307, 5485, 91, 8306, 5491, 478, 8308, 5499, 861, 8314, 5510,
+	1241, 8322, 5523, 1615, 8334, 5539, 1982, 8348, 5557, 2341, 8367, 5577,
+	2689, 8388, 5599, 3025, 8412, 5622, 3343, 8439, 5647, 3642, 8469, 5671,
+	3915, 8501, 5696, 4154, 8536, 5721, 4352, 8572, 5745, 4494, 8609, 5767,
+	4562, 8647, 5788, 4531, 8685, 5807, 4368, 8721, 5824, 4031, 8754, 5838,
+	3478, 8781, 5849, 2697, 8801, 5857, 1750, 8810, 5863, 781, 8809, 5866,
+	-49, 8797, 5866, -660, 8778, 5864, -1050, 8755, 5861, -1256, 8731, 5855,
+	-1323, 8706, 5848, -1287, 8683, 5840, -1175, 8662, 5832, -1008, 8644, 5823,
+	-802, 8629, 5814, -567, 8618, 5805, -312, 8610, 5796, -45, 8606, 5788,
+	230, 8607, 5781,
+	/* 85.0 */
+	536, 8914, 5735, 597, 8916, 5731, 642, 8919, 5727, 644, 8924, 5723,
+	561, 8930, 5719, 336, 8937, 5715, -126, 8945, 5710, -959, 8952, 5706,
+	-2294, 8957, 5701, -4027, 8957, 5696, -5669, 8951, 5691, -6827, 8940, 5686,
+	-7495, 8926, 5681, -7819, 8909, 5675, -7920, 8890, 5669, -7876, 8870, 5664,
+	-7736, 8849, 5657, -7528, 8828, 5651, -7272, 8807, 5645, -6980, 8785, 5638,
+	-6661, 8764, 5632, -6321, 8743, 5625, -5964, 8722, 5618, -5594, 8702, 5612,
+	-5214, 8683, 5606, -4824, 8664, 5600, -4427, 8647, 5594, -4024, 8631, 5589,
+	-3616, 8616, 5584, -3204, 8602, 5581, -2789, 8590, 5577, -2372, 8579, 5575,
+	-1952, 8570, 5573, -1531, 8563, 5573, -1108, 8557, 5573, -686, 8554, 5575,
+	-263, 8551, 5577, 159, 8551, 5581, 581, 8553, 5585, 1001, 8556, 5591,
+	1419, 8561, 5597, 1835, 8568, 5604, 2247, 8577, 5613, 2656, 8587, 5621,
+	3061, 8599, 5631, 3460, 8612, 5641, 3853, 8627, 5651, 4239, 8644, 5661,
+	4615, 8662, 5671, 4981, 8680, 5682, 5333, 8700, 5692, 5669, 8721, 5701,
+	5984, 8742, 5710, 6275, 8764, 5719, 6534, 8786, 5727, 6752, 8807, 5734,
+	6916, 8829, 5740, 7009, 8850, 5745, 7005, 8870, 5750, 6869, 8889, 5753,
+	6554, 8905, 5756, 6009, 8919, 5757, 5202, 8930, 5758, 4176, 8936, 5758,
+	3088, 8938, 5757, 2129, 8936, 5756, 1410, 8932, 5754, 933, 8927, 5752,
+	650, 8923, 5749, 510, 8919, 5746, 466, 8916, 5743, 484, 8914, 5739,
+	536, 8914, 5735,
+	/* 90.0 */
+	17703, 8808, 5663, -17797, 8808, 5663, -17297, 8808, 5663, -16797, 8808, 5663,
+	-16297, 8808, 5663, -15797, 8808, 5663, -15297, 8808, 5663, -14797, 8808, 5663,
+	-14297, 8808, 5663, -13797, 8808, 5663, -13297, 8808, 5663, -12797, 8808, 5663,
+	-12297, 8808, 5663, -11797, 8808, 5663, -11297, 8808, 5663, -10797, 8808, 5663,
+	-10297, 8808, 5663, -9797, 8808, 5663, -9297, 8808, 5663, -8797, 8808, 5663,
+	-8297, 8808, 5663, -7797, 8808, 5663, -7297, 8808, 5663, -6797, 8808, 5663,
+	-6297, 8808, 5663, -5797, 8808, 5663, -5297, 8808, 5663, -4797, 8808, 5663,
+	-4297, 8808, 5663, -3797, 8808, 5663, -3297, 8808, 5663, -2797, 8808, 5663,
+	-2297, 8808, 5663, -1797, 8808, 5663, -1297, 8808, 5663, -797, 8808, 5663,
+	-297, 8808, 5663, 203, 8808, 5663, 703, 8808, 5663, 1203, 8808, 5663,
+	1703, 8808, 5663, 2203, 8808, 5663, 2703, 8808, 5663, 3203, 8808, 5663,
+	3703, 8808, 5663, 4203, 8808, 5663, 4703, 8808, 5663, 5203, 8808, 5663,
+	5703, 8808, 5663, 6203, 8808, 5663, 6703, 8808, 5663, 7203, 8808, 5663,
+	7703, 8808, 5663, 8203, 8808, 5663, 8703, 8808, 5663, 9203, 8808, 5663,
+	9703, 8808, 5663, 10203, 8808, 5663, 10703, 8808, 5663, 11203, 8808, 5663,
+	11703, 8808, 5663, 12203, 8808, 5663, 12703, 8808, 5663, 13203, 8808, 5663,
+	13703, 8808, 5663, 14203, 8808, 5663, 14703, 8808, 5663, 15203, 8808, 5663,
+	15703, 8808, 5663, 16203, 8808, 5663, 16703, 8808, 5663, 17203, 8808, 5663,
+	17703, 8808, 5663,
+};
@@ -0,0 +1,223 @@
+/* Generated by Tools/generate_mag_grid.py from WMM2015 for 2017.0, do not edit. */
+
+#pragma once
+
+#define MAG_GRID_EPOCH		2017.0f
+#define MAG_GRID_RES		10.0f
+#define MAG_GRID_LAT_MIN	-90.0f
+#define MAG_GRID_LON_MIN	-180.0f
+#define MAG_GRID_NUM_LAT	19
+#define MAG_GRID_NUM_LON	37
+
+/* declination [0.01 deg], inclination [0.01 deg], intensity [1e-4 gauss] */
+static const int16_t mag_grid_table[MAG_GRID_NUM_LAT * MAG_GRID_NUM_LON * 3] = {
+	/* -90.0 */
+	14965, -7220, 5483, 13965, -7220, 5483, 12965, -7220, 5483, 11965, -7220, 5483,
+	10965, -7220, 5483, 9965, -7220, 5483, 8965, -7220, 5483, 7965, -7220, 5483,
+	6965, -7220, 5483, 5965, -7220, 5483, 4965, -7220, 5483, 3965, -7220, 5483,
+	2965, -7220, 5483, 1965, -7220, 5483, 965, -7220, 5483, -35, -7220, 5483,
+	-1035, -7220, 5483, -2035, -7220, 5483, -3035, -7220, 5483, -4035, -7220, 5483,
+	-5035, -7220, 5483, -6035, -7220, 5483, -7035, -7220, 5483, -8035, -7220, 5483,
+	-9035, -7220, 5483, -10035, -7220, 5483, -11035, -7220, 5483, -12035, -7220, 5483,
+	-13035, -7220, 5483, -14035, -7220, 5483, -15035, -7220, 5483, -16035, -7220, 5483,
+	-17035, -7220, 5483, 17965, -7220, 5483, 16965, -7220, 5483, 15965, -7220, 5483,
+	14965, -7220, 5483,
+	/* -80.0 */
+	13007, -7847, 6089, 11776, -7771, 6029, 10656, -7680, 5953, 9633, -7576, 5863,
+	8689, -7464, 5763, 7804, -7348, 5652, 6963, -7230, 5535, 6153, -7114, 5414,
+	5363, -7003, 5292, 4588, -6901, 5172, 3823, -6810, 5057, 3066, -6732, 4950,
+	2315, -6668, 4855, 1568, -6618, 4774, 819, -6582, 4709, 65, -6559, 4663,
+	-700, -6548, 4636, -1481, -6550, 4632, -2284, -6565, 4651, -3110, -6596, 4694,
+	-3960, -6643, 4762, -4835, -6708, 4854, -5733, -6790, 4966, -6655, -6888, 5096,
+	-7604, -7001, 5238, -8583, -7124, 5387, -9601, -7255, 5536, -10669, -7389, 5679,
+	-11799, -7520, 5810, -13007, -7642, 5925, -14305, -7751, 6018, -15697, -7838, 6089,
+	-17170, -7900, 6135, 17313, -7932, 6157, 15803, -7932, 6156, 14355, -7902, 6132,
+	13007, -7847, 6089,
+	/* -70.0 */
+	8557, -8109, 6334, 7762, -7926, 6207, 7125, -7743, 6062, 6583, -7558, 5902,
+	6095, -7367, 5726, 5626, -7168, 5536, 5151, -6962, 5333, 4648, -6755, 5118,
+	4106, -6555, 4898, 3524, -6374, 4681, 2911, -6225, 4476, 2282, -6116, 4290,
+	1655, -6048, 4130, 1045, -6017, 3996, 454, -6011, 3890, -126, -6017, 3811,
+	-716, -6026, 3761, -1341, -6036, 3746, -2016, -6053, 3770, -2747, -6086, 3841,
+	-3525, -6146, 3963, -4333, -6242, 4138, -5153, -6379, 4362, -5973, -6554, 4625,
+	-6785, -6763, 4917, -7591, -6999, 5223, -8403, -7254, 5526, -9246, -7519, 5811,
+	-10161, -7787, 6062, -11231, -8047, 6268, -12630, -8289, 6422, -14738, -8493, 6521,
+	17881, -8611, 6566, 13960, -8589, 6563, 11257, -8459, 6519, 9634, -8289, 6440,
+	8557, -8109, 6334,
+	/* -60.0 */
+	4730, -7760, 6217, 4607, -7560, 6032, 4464, -7368, 5837, 4325, -7179, 5633,
+	4195, -6982, 5419, 4063, -6768, 5187, 3900, -6530, 4932, 3664, -6267, 4654,
+	3323, -5995, 4361, 2863, -5742, 4068, 2295, -5543, 3797, 1657, -5432, 3564,
+	1007, -5420, 3380, 402, -5494, 3242, -122, -5614, 3141, -571, -5734, 3067,
+	-992, -5821, 3016, -1452, -5863, 2994, -2003, -5869, 3016, -2660, -5866, 3099,
+	-3397, -5890, 3258, -4163, -5972, 3500, -4910, -6125, 3817, -5601, -6346, 4195,
+	-6213, -6622, 4613, -6733, -6935, 5045, -7149, -7268, 5467, -7436, -7609, 5854,
+	-7534, -7946, 6183, -7276, -8268, 6436, -6102, -8552, 6604, -2236, -8722, 6688,
+	2493, -8636, 6695, 4183, -8423, 6638, 4682, -8194, 6530, 4785, -7972, 6386,
+	4730, -7760, 6217,
+	/* -50.0 */
+	3071, -7164, 5868, 3098, -6971, 5644, 3077, -6785, 5419, 3039, -6602, 5194,
+	3010, -6418, 4965, 3000, -6219, 4724, 2991, -5990, 4456, 2930, -5718, 4154,
+	2748, -5410, 3825, 2384, -5103, 3490, 1819, -4864, 3183, 1096, -4772, 2936,
+	320, -4866, 2767, -381, -5119, 2671, -918, -5444, 2622, -1278, -5754, 2591,
+	-1528, -5985, 2562, -1774, -6110, 2539, -2129, -6123, 2543, -2655, -6055, 2607,
+	-3320, -5974, 2766, -4025, -5960, 3038, -4674, -6062, 3417, -5201, -6278, 3877,
+	-5564, -6574, 4378, -5729, -6908, 4885, -5646, -7244, 5363, -5240, -7557, 5787,
+	-4399, -7818, 6131, -3066, -7993, 6379, -1415, -8059, 6523, 153, -8019, 6570,
+	1359, -7905, 6533, 2175, -7745, 6429, 2678, -7559, 6273, 2952, -7361, 6081,
+	3071, -7164, 5868,
+	/* -40.0 */
+	2217, -6437, 5410, 2270, -6243, 5169, 2281, -6049, 4931, 2268, -5855, 4697,
+	2247, -5661, 4466, 2237, -5466, 4232, 2248, -5257, 3980, 2250, -5010, 3697,
+	2165, -4708, 3384, 1879, -4376, 3056, 1317, -4110, 2753, 507, -4052, 2523,
+	-395, -4279, 2397, -1181, -4732, 2365, -1725, -5263, 2385, -2032, -5756, 2412,
+	-2177, -6159, 2425, -2233, -6444, 2422, -2303, -6570, 2415, -2546, -6516, 2438,
+	-3024, -6337, 2549, -3607, -6165, 2796, -4122, -6127, 3188, -4461, -6258, 3686,
+	-4562, -6505, 4229, -4391, -6792, 4758, -3919, -7056, 5234, -3142, -7253, 5630,
+	-2152, -7353, 5928, -1158, -7359, 6120, -309, -7306, 6214, 395, -7224, 6222,
+	988, -7119, 6158, 1477, -6984, 6033, 1847, -6820, 5857, 2089, -6633, 5644,
+	2217, -6437, 5410,
+	/* -30.0 */
+	1673, -5494, 4888, 1720, -5286, 4653, 1743, -5078, 4420, 1748, -4860, 4191,
+	1728, -4636, 3968, 1694, -4418, 3751, 1668, -4209, 3534, 1655, -3980, 3305,
+	1592, -3683, 3051, 1340, -3327, 2777, 782, -3041, 2517, -62, -3033, 2326,
+	-990, -3416, 2244, -1748, -4077, 2261, -2224, -4799, 2327, -2467, -5449, 2403,
+	-2556, -5998, 2476, -2487, -6439, 2538, -2253, -6720, 2573, -2045, -6771, 2589,
+	-2141, -6596, 2639, -2521, -6307, 2805, -2937, -6088, 3134, -3178, -6055, 3600,
+	-3154, -6179, 4126, -2860, -6361, 4631, -2335, -6520, 5064, -1637, -6600, 5394,
+	-918, -6574, 5605, -351, -6473, 5708, 51, -6367, 5737, 398, -6281, 5714,
+	750, -6190, 5639, 1085, -6066, 5511, 1367, -5903, 5335, 1565, -5706, 5122,
+	1673, -5494, 4888,
+	/* -20.0 */
+	1308, -4212, 4326, 1333, -3974, 4119, 1350, -3749, 3917, 1365, -3513, 3717,
+	1354, -3260, 3523, 1312, -3012, 3342, 1262, -2781, 3175, 1225, -2534, 3014,
+	1148, -2203, 2841, 886, -1802, 2647, 321, -1510, 2456, -504, -1584, 2314,
+	-1363, -2143, 2258, -2018, -3030, 2288, -2380, -3974, 2372, -2496, -4795, 2482,
+	-2426, -5445, 2614, -2159, -5931, 2753, -1688, -6234, 2861, -1179, -6309, 2910,
+	-926, -6144, 2929, -1063, -5813, 2999, -1426, -5483, 3205, -1724, -5314, 3563,
+	-1786, -5321, 4002, -1613, -5409, 4434, -1264, -5499, 4798, -786, -5523, 5050,
+	-315, -5432, 5166, -11, -5274, 5178, 156, -5152, 5148, 333, -5086, 5102,
+	577, -5010, 5021, 837, -4882, 4895, 1065, -4698, 4731, 1230, -4465, 4536,
+	1308, -4212, 4326,
+	/* -10.0 */
+	1084, -2514, 3793, 1079, -2228, 3637, 1076, -1988, 3490, 1087, -1749, 3347,
+	1085, -1492, 3213, 1050, -1234, 3095, 1002, -989, 2994, 961, -710, 2907,
+	862, -335, 2816, 566, 85, 2708, -9, 337, 2588, -781, 174, 2482,
+	-1532, -504, 2422, -2059, -1560, 2428, -2275, -2707, 2501, -2200, -3684, 2624,
+	-1908, -4373, 2781, -1482, -4789, 2949, -997, -4987, 3090, -537, -4994, 3168,
+	-222, -4803, 3186, -185, -4441, 3200, -421, -4060, 3298, -719, -3839, 3525,
+	-868, -3799, 3837, -838, -3848, 4158, -668, -3920, 4434, -375, -3943, 4613,
+	-71, -3842, 4660, 89, -3669, 4612, 135, -3564, 4545, 234, -3541, 4480,
+	434, -3492, 4390, 665, -3356, 4265, 875, -3135, 4118, 1026, -2838, 3956,
+	1084, -2514, 3793,
+	/* 0.0 */
+	965, -500, 3415, 944, -169, 3326, 921, 75, 3247, 928, 292, 3177,
+	934, 526, 3123, 909, 762, 3087, 869, 994, 3065, 819, 1271, 3054,
+	682, 1631, 3038, 340, 1987, 2996, -235, 2148, 2920, -937, 1934, 2823,
+	-1570, 1266, 2731, -1959, 217, 2682, -2020, -965, 2705, -1781, -1973, 2798,
+	-1360, -2624, 2929, -908, -2927, 3069, -521, -2999, 3194, -200, -2933, 3279,
+	56, -2720, 3316, 157, -2344, 3334, 30, -1941, 3393, -206, -1710, 3533,
+	-366, -1667, 3729, -408, -1708, 3939, -351, -1783, 4124, -195, -1828, 4241,
+	-16, -1755, 4257, 53, -1615, 4195, 37, -1564, 4108, 96, -1609, 4015,
+	278, -1609, 3901, 509, -1487, 3771, 732, -1245, 3639, 901, -893, 3518,
+	965, -500, 3415,
+	/* 10.0 */
+	895, 1487, 3286, 898, 1820, 3259, 881, 2049, 3243, 900, 2232, 3244,
+	925, 2429, 3271, 912, 2637, 3320, 864, 2847, 3382, 774, 3091, 3445,
+	566, 3376, 3489, 162, 3614, 3485, -416, 3671, 3418, -1043, 3443, 3302,
+	-1551, 2877, 3167, -1795, 2018, 3057, -1729, 1044, 3013, -1414, 208, 3041,
+	-977, -318, 3116, -558, -514, 3213, -244, -494, 3315, -17, -382, 3404,
+	178, -177, 3469, 286, 160, 3528, 219, 522, 3608, 38, 727, 3716,
+	-105, 761, 3842, -166, 726, 3973, -169, 665, 4093, -112, 616, 4170,
+	-42, 646, 4181, -53, 714, 4127, -117, 691, 4021, -95, 573, 3880,
+	65, 499, 3720, 304, 556, 3562, 563, 756, 3430, 784, 1091, 3337,
+	895, 1487, 3286,
+	/* 20.0 */
+	806, 3117, 3403, 890, 3402, 3412, 929, 3606, 3445, 987, 3767, 3505,
+	1042, 3941, 3601, 1043, 4136, 3726, 975, 4340, 3861, 818, 4558, 3988,
+	512, 4771, 4077, 21, 4908, 4094, -582, 4884, 4021, -1147, 4652, 3877,
+	-1526, 4207, 3702, -1631, 3599, 3548, -1478, 2949, 3456, -1153, 2399, 3431,
+	-750, 2053, 3457, -367, 1943, 3523, -86, 2002, 3615, 102, 2125, 3710,
+	256, 2295, 3798, 355, 2543, 3892, 322, 2805, 3998, 185, 2956, 4105,
+	65, 2982, 4207, 2, 2958, 4309, -33, 2925, 4407, -51, 2898, 4477,
+	-84, 2902, 4497, -184, 2904, 4448, -311, 2821, 4318, -342, 2656, 4121,
+	-219, 2511, 3898, 20, 2471, 3691, 318, 2568, 3531, 608, 2803, 3435,
+	806, 3117, 3403,
+	/* 30.0 */
+	658, 4343, 3726, 868, 4549, 3743, 1017, 4725, 3807, 1145, 4883, 3915,
+	1238, 5057, 4065, 1251, 5256, 4241, 1158, 5467, 4423, 929, 5676, 4585,
+	517, 5852, 4699, -80, 5934, 4729, -738, 5870, 4656, -1272, 5648, 4495,
+	-1547, 5302, 4296, -1544, 4899, 4117, -1335, 4513, 3996, -1013, 4203, 3938,
+	-641, 4011, 3931, -279, 3961, 3972, 0, 4023, 4052, 187, 4131, 4145,
+	327, 4260, 4237, 424, 4421, 4337, 428, 4583, 4451, 346, 4684, 4568,
+	256, 4710, 4682, 190, 4706, 4800, 122, 4700, 4914, 27, 4698, 5003,
+	-117, 4696, 5039, -324, 4662, 4992, -533, 4549, 4845, -629, 4363, 4612,
+	-548, 4173, 4342, -316, 4054, 4090, 10, 4044, 3894, 359, 4152, 3772,
+	658, 4343, 3726,
+	/* 40.0 */
+	482, 5311, 4225, 819, 5437, 4236, 1099, 5582, 4314, 1320, 5745, 4448,
+	1459, 5933, 4624, 1484, 6143, 4817, 1366, 6359, 5004, 1067, 6563, 5164,
+	544, 6720, 5270, -176, 6780, 5296, -918, 6706, 5225, -1454, 6508, 5069,
+	-1670, 6239, 4871, -1604, 5965, 4684, -1358, 5730, 4543, -1023, 5557, 4456,
+	-650, 5456, 4420, -284, 5438, 4432, 20, 5487, 4484, 240, 5570, 4557,
+	405, 5661, 4638, 532, 5760, 4730, 601, 5856, 4842, 602, 5927, 4975,
+	557, 5968, 5122, 481, 5993, 5278, 352, 6017, 5425, 150, 6037, 5538,
+	-135, 6037, 5588, -475, 5986, 5545, -780, 5859, 5399, -932, 5669, 5165,
+	-877, 5466, 4892, -644, 5306, 4632, -297, 5224, 4424, 97, 5231, 4286,
+	482, 5311, 4225,
+	/* 50.0 */
+	353, 6189, 4832, 784, 6261, 4842, 1169, 6379, 4913, 1479, 6536, 5036,
+	1678, 6725, 5191, 1731, 6932, 5354, 1595, 7141, 5505, 1215, 7329, 5624,
+	545, 7465, 5694, -348, 7506, 5699, -1211, 7431, 5630, -1774, 7261, 5495,
+	-1965, 7049, 5323, -1864, 6846, 5150, -1586, 6681, 5003, -1216, 6566, 4897,
+	-808, 6503, 4834, -401, 6491, 4813, -38, 6519, 4831, 262, 6571, 4875,
+	513, 6629, 4939, 729, 6690, 5025, 904, 6754, 5141, 1013, 6818, 5288,
+	1034, 6883, 5461, 944, 6947, 5643, 722, 7007, 5811, 357, 7050, 5936,
+	-127, 7053, 5991, -642, 6993, 5957, -1048, 6862, 5832, -1234, 6680, 5636,
+	-1174, 6488, 5407, -919, 6325, 5187, -539, 6217, 5009, -100, 6172, 4888,
+	353, 6189, 4832,
+	/* 60.0 */
+	296, 7059, 5391, 794, 7106, 5396, 1251, 7198, 5441, 1635, 7329, 5516,
+	1906, 7489, 5609, 2008, 7666, 5705, 1863, 7844, 5790, 1365, 8001, 5850,
+	439, 8105, 5876, -762, 8121, 5860, -1807, 8040, 5799, -2393, 7893, 5697,
+	-2539, 7723, 5570, -2382, 7563, 5435, -2046, 7432, 5310, -1611, 7337, 5208,
+	-1130, 7279, 5135, -639, 7254, 5095, -166, 7257, 5088, 275, 7279, 5112,
+	682, 7313, 5164, 1054, 7358, 5246, 1378, 7414, 5361, 1621, 7486, 5505,
+	1735, 7574, 5670, 1662, 7671, 5840, 1345, 7764, 5993, 759, 7831, 6105,
+	-19, 7844, 6157, -784, 7785, 6141, -1313, 7663, 6060, -1515, 7504, 5930,
+	-1425, 7343, 5779, -1127, 7206, 5632, -701, 7109, 5511, -212, 7059, 5429,
+	296, 7059, 5391,
+	/* 70.0 */
+	268, 7888, 5724, 820, 7919, 5716, 1338, 7980, 5725, 1790, 8069, 5746,
+	2126, 8178, 5773, 2267, 8300, 5800, 2068, 8424, 5822, 1297, 8530, 5831,
+	-206, 8588, 5825, -1956, 8568, 5799, -3110, 8479, 5753, -3540, 8356, 5690,
+	-3495, 8227, 5614, -3177, 8106, 5533, -2706, 8004, 5455, -2147, 7924, 5387,
+	-1542, 7867, 5335, -916, 7833, 5303, -287, 7819, 5295, 332, 7823, 5312,
+	929, 7844, 5354, 1493, 7882, 5421, 2002, 7937, 5510, 2424, 8012, 5618,
+	2705, 8104, 5735, 2764, 8209, 5852, 2480, 8315, 5954, 1726, 8400, 6031,
+	543, 8434, 6074, -657, 8400, 6080, -1431, 8312, 6051, -1705, 8199, 5996,
+	-1610, 8087, 5927, -1283, 7993, 5857, -822, 7926, 5796, -290, 7890, 5750,
+	268, 7888, 5724,
+	/* 80.0 */
+	230, 8607, 5781, 779, 8619, 5768, 1292, 8646, 5758, 1711, 8686, 5749,
+	1940, 8736, 5741, 1772, 8791, 5733, 765, 8841, 5723, -1566, 8865, 5710,
+	-4030, 8840, 5693, -5171, 8779, 5671, -5374, 8705, 5646, -5120, 8629, 5617,
+	-4636, 8555, 5587, -4024, 8488, 5557, -3338, 8429, 5529, -2607, 8381, 5506,
+	-1848, 8344, 5490, -1075, 8319, 5483, -297, 8307, 5485, 478, 8308, 5499,
+	1241, 8322, 5523, 1982, 8348, 5557, 2689, 8388, 5599, 3343, 8439, 5647,
+	3915, 8501, 5696, 4352, 8572, 5745, 4562, 8647, 5788, 4368, 8721, 5824,
+	3478, 8781, 5849, 1750, 8810, 5863, -49, 8797, 5866, -1050, 8755, 5861,
+	-1323, 8706, 5848, -1175, 8662, 5832, -802, 8629, 5814, -312, 8610, 5796,
+	230, 8607, 5781,
+	/* 90.0 */
+	17703, 8808, 5663, -17297, 8808, 5663, -16297, 8808, 5663, -15297, 8808, 5663,
+	-14297, 8808, 5663, -13297, 8808, 5663, -12297, 8808, 5663, -11297, 8808, 5663,
+	-10297, 8808, 5663, -9297, 8808, 5663, -8297, 8808, 5663, -7297, 8808, 5663,
+	-6297, 8808, 5663, -5297, 8808, 5663, -4297, 8808, 5663, -3297, 8808, 5663,
+	-2297, 8808, 5663, -1297, 8808, 5663, -297, 8808, 5663, 703, 8808, 5663,
+	1703, 8808, 5663, 2703, 8808, 5663, 3703, 8808, 5663, 4703, 8808, 5663,
+	5703, 8808, 5663, 6703, 8808, 5663, 7703, 8808, 5663, 8703, 8808, 5663,
+	9703, 8808, 5663, 10703, 8808, 5663, 11703, 8808, 5663, 12703, 8808, 5663,
+	13703, 8808, 5663, 14703, 8808, 5663, 15703, 8808, 5663, 16703, 8808, 5663,
+	17703, 8808, 5663,
+};
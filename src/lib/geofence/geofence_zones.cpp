@@ -0,0 +1,856 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file geofence_zones.cpp
+ */
+
+#include "geofence_zones.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* padding around the zone bounding box, so zone vertices never lie on the grid border */
+#define GRID_PADDING 1.0f
+
+namespace
+{
+
+struct RowCrossing {
+	float x;
+	uint8_t zone;
+};
+
+int compare_crossings(const void *a, const void *b)
+{
+	const float xa = ((const RowCrossing *)a)->x;
+	const float xb = ((const RowCrossing *)b)->x;
+	return (xa < xb) ? -1 : ((xa > xb) ? 1 : 0);
+}
+
+/* half-open side test: points on the line count as left, which makes the
+ * crossing parity consistent for segments passing exactly through a vertex */
+inline bool left_of(float ax, float ay, float bx, float by, float px, float py)
+{
+	return (bx - ax) * (py - ay) - (by - ay) * (px - ax) >= 0.0f;
+}
+
+/* segment p0-p1 crosses segment a-b */
+inline bool segments_cross(float p0x, float p0y, float p1x, float p1y, float ax, float ay, float bx, float by)
+{
+	return (left_of(p0x, p0y, p1x, p1y, ax, ay) != left_of(p0x, p0y, p1x, p1y, bx, by)) &&
+	       (left_of(ax, ay, bx, by, p0x, p0y) != left_of(ax, ay, bx, by, p1x, p1y));
+}
+
+inline float point_segment_distance_sq(float px, float py, float ax, float ay, float bx, float by)
+{
+	const float dx = bx - ax;
+	const float dy = by - ay;
+	const float len_sq = dx * dx + dy * dy;
+	float t = 0.0f;
+
+	if (len_sq > FLT_EPSILON) {
+		t = ((px - ax) * dx + (py - ay) * dy) / len_sq;
+		t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+	}
+
+	const float ex = ax + t * dx - px;
+	const float ey = ay + t * dy - py;
+	return ex * ex + ey * ey;
+}
+
+}
+
+GeofenceZones::GeofenceZones() :
+	_ref{},
+	_zones{},
+	_num_zones(0),
+	_num_inclusion_zones(0),
+	_zone_open(false),
+	_x(nullptr),
+	_y(nullptr),
+	_num_vertices(0),
+	_vertex_capacity(0),
+	_grid_x0(0.0f),
+	_grid_y0(0.0f),
+	_cell_size_x(1.0f),
+	_cell_size_y(1.0f),
+	_grid_nx(0),
+	_grid_ny(0),
+	_cell_flags(nullptr),
+	_cell_zone_start(nullptr),
+	_cell_zones(nullptr),
+	_cell_edges(nullptr),
+	_vertex_next(nullptr)
+{
+}
+
+GeofenceZones::~GeofenceZones()
+{
+	clear();
+}
+
+void GeofenceZones::clear()
+{
+	free_index();
+
+	delete[] _x;
+	delete[] _y;
+	_x = nullptr;
+	_y = nullptr;
+	_num_vertices = 0;
+	_vertex_capacity = 0;
+
+	_num_zones = 0;
+	_num_inclusion_zones = 0;
+	_zone_open = false;
+	_ref.init_done = false;
+}
+
+void GeofenceZones::free_index()
+{
+	delete[] _cell_flags;
+	delete[] _cell_zone_start;
+	delete[] _cell_zones;
+	delete[] _cell_edges;
+	delete[] _vertex_next;
+	_cell_flags = nullptr;
+	_cell_zone_start = nullptr;
+	_cell_zones = nullptr;
+	_cell_edges = nullptr;
+	_vertex_next = nullptr;
+	_grid_nx = 0;
+	_grid_ny = 0;
+}
+
+int GeofenceZones::grow_vertices()
+{
+	unsigned capacity = (_vertex_capacity == 0) ? 64 : 2 * _vertex_capacity;
+
+	if (capacity > MAX_VERTICES) {
+		capacity = MAX_VERTICES;
+	}
+
+	if (capacity <= _vertex_capacity) {
+		return -1;
+	}
+
+	float *x = new float[capacity];
+	float *y = new float[capacity];
+
+	if (x == nullptr || y == nullptr) {
+		delete[] x;
+		delete[] y;
+		return -1;
+	}
+
+	if (_num_vertices > 0) {
+		memcpy(x, _x, _num_vertices * sizeof(float));
+		memcpy(y, _y, _num_vertices * sizeof(float));
+	}
+
+	delete[] _x;
+	delete[] _y;
+	_x = x;
+	_y = y;
+	_vertex_capacity = capacity;
+
+	return 0;
+}
+
+int GeofenceZones::begin_zone(ZoneType type)
+{
+	if (_zone_open) {
+		end_zone();
+	}
+
+	if (_num_zones >= MAX_ZONES) {
+		return -1;
+	}
+
+	/* the index is stale as soon as the zones change */
+	free_index();
+
+	Zone &zone = _zones[_num_zones];
+	zone.first_vertex = _num_vertices;
+	zone.num_vertices = 0;
+	zone.type = type;
+	_zone_open = true;
+
+	return 0;
+}
+
+int GeofenceZones::add_vertex(double lat, double lon)
+{
+	if (!_zone_open) {
+		return -1;
+	}
+
+	if (_num_vertices >= _vertex_capacity && grow_vertices() != 0) {
+		return -1;
+	}
+
+	if (!map_projection_initialized(&_ref)) {
+		map_projection_init_timestamped(&_ref, lat, lon, 0);
+	}
+
+	map_projection_project(&_ref, lat, lon, &_x[_num_vertices], &_y[_num_vertices]);
+	_num_vertices++;
+	_zones[_num_zones].num_vertices++;
+
+	return 0;
+}
+
+int GeofenceZones::end_zone()
+{
+	if (!_zone_open) {
+		return -1;
+	}
+
+	_zone_open = false;
+	Zone &zone = _zones[_num_zones];
+
+	/* a closing vertex equal to the first one is implicit */
+	if (zone.num_vertices > 1) {
+		const unsigned last = zone.first_vertex + zone.num_vertices - 1;
+
+		if (fabsf(_x[last] - _x[zone.first_vertex]) < FLT_EPSILON &&
+		    fabsf(_y[last] - _y[zone.first_vertex]) < FLT_EPSILON) {
+			zone.num_vertices--;
+			_num_vertices--;
+		}
+	}
+
+	if (zone.num_vertices < 3) {
+		_num_vertices = zone.first_vertex;
+		return -1;
+	}
+
+	if (zone.type == ZONE_INCLUSION) {
+		_num_inclusion_zones++;
+	}
+
+	_num_zones++;
+
+	return 0;
+}
+
+bool GeofenceZones::cell_of(float x, float y, unsigned &cell_x, unsigned &cell_y) const
+{
+	const float fx = (x - _grid_x0) / _cell_size_x;
+	const float fy = (y - _grid_y0) / _cell_size_y;
+
+	if (!(fx >= 0.0f && fy >= 0.0f && fx < (float)_grid_nx && fy < (float)_grid_ny)) {
+		return false;
+	}
+
+	cell_x = (unsigned)fx;
+	cell_y = (unsigned)fy;
+
+	/* guard against rounding at the upper border */
+	if (cell_x >= _grid_nx) { cell_x = _grid_nx - 1; }
+
+	if (cell_y >= _grid_ny) { cell_y = _grid_ny - 1; }
+
+	return true;
+}
+
+bool GeofenceZones::segment_touches_cell(float x0, float y0, float x1, float y1, unsigned cell_x,
+		unsigned cell_y) const
+{
+	/* Liang-Barsky clipping of the segment against the (closed) cell box */
+	const float dx = x1 - x0;
+	const float dy = y1 - y0;
+
+	const float box_x0 = _grid_x0 + cell_x * _cell_size_x;
+	const float box_y0 = _grid_y0 + cell_y * _cell_size_y;
+
+	const float p[4] = { -dx, dx, -dy, dy };
+	const float q[4] = { x0 - box_x0, box_x0 + _cell_size_x - x0, y0 - box_y0, box_y0 + _cell_size_y - y0 };
+
+	float t0 = 0.0f;
+	float t1 = 1.0f;
+
+	for (unsigned i = 0; i < 4; i++) {
+		if (fabsf(p[i]) < FLT_EPSILON) {
+			if (q[i] < 0.0f) {
+				return false;
+			}
+
+		} else {
+			const float t = q[i] / p[i];
+
+			if (p[i] < 0.0f) {
+				if (t > t1) { return false; }
+
+				if (t > t0) { t0 = t; }
+
+			} else {
+				if (t < t0) { return false; }
+
+				if (t < t1) { t1 = t; }
+			}
+		}
+	}
+
+	return true;
+}
+
+bool GeofenceZones::edge_touches_cell(unsigned edge, unsigned cell_x, unsigned cell_y) const
+{
+	const unsigned end = edge_end(edge);
+	return segment_touches_cell(_x[edge], _y[edge], _x[end], _y[end], cell_x, cell_y);
+}
+
+int GeofenceZones::build()
+{
+	if (_zone_open) {
+		end_zone();
+	}
+
+	free_index();
+
+	if (_num_zones == 0) {
+		return -1;
+	}
+
+	_vertex_next = new uint16_t[_num_vertices];
+
+	if (_vertex_next == nullptr) {
+		return -1;
+	}
+
+	for (unsigned z = 0; z < _num_zones; z++) {
+		const unsigned end = _zones[z].first_vertex + _zones[z].num_vertices;
+
+		for (unsigned v = _zones[z].first_vertex; v < end; v++) {
+			_vertex_next[v] = (v + 1 < end) ? v + 1 : _zones[z].first_vertex;
+		}
+	}
+
+	/* grid over the bounding box of all vertices */
+	float x_min = _x[0];
+	float x_max = _x[0];
+	float y_min = _y[0];
+	float y_max = _y[0];
+
+	for (unsigned i = 1; i < _num_vertices; i++) {
+		x_min = fminf(x_min, _x[i]);
+		x_max = fmaxf(x_max, _x[i]);
+		y_min = fminf(y_min, _y[i]);
+		y_max = fmaxf(y_max, _y[i]);
+	}
+
+	x_min -= GRID_PADDING;
+	y_min -= GRID_PADDING;
+	const float width = x_max + GRID_PADDING - x_min;
+	const float height = y_max + GRID_PADDING - y_min;
+
+	/* about one edge per cell, with roughly square cells */
+	unsigned num_cells = (_num_vertices < MAX_GRID_CELLS) ? _num_vertices : MAX_GRID_CELLS;
+	unsigned nx = (unsigned)ceilf(sqrtf(num_cells * width / height));
+	nx = (nx < 1) ? 1 : ((nx > num_cells) ? num_cells : nx);
+	unsigned ny = num_cells / nx;
+	ny = (ny < 1) ? 1 : ny;
+	num_cells = nx * ny;
+
+	_grid_x0 = x_min;
+	_grid_y0 = y_min;
+	_grid_nx = nx;
+	_grid_ny = ny;
+	_cell_size_x = width / nx;
+	_cell_size_y = height / ny;
+
+	/* first pass: count the zones and edges per cell */
+	uint32_t *edge_count = new uint32_t[num_cells + 1];
+	uint16_t *last_zone = new uint16_t[num_cells];
+	_cell_zone_start = new uint32_t[num_cells + 1];
+	_cell_flags = new uint8_t[num_cells];
+
+	if (edge_count == nullptr || last_zone == nullptr || _cell_zone_start == nullptr || _cell_flags == nullptr) {
+		delete[] edge_count;
+		delete[] last_zone;
+		free_index();
+		return -1;
+	}
+
+	memset(edge_count, 0, (num_cells + 1) * sizeof(uint32_t));
+	memset(_cell_zone_start, 0, (num_cells + 1) * sizeof(uint32_t));
+
+	for (unsigned c = 0; c < num_cells; c++) {
+		last_zone[c] = UINT16_MAX;
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (unsigned z = 0; z < _num_zones; z++) {
+			const Zone &zone = _zones[z];
+
+			for (unsigned e = zone.first_vertex; e < (unsigned)zone.first_vertex + zone.num_vertices; e++) {
+				const unsigned end = edge_end(e);
+				unsigned cx0, cy0, cx1, cy1;
+				cell_of(fminf(_x[e], _x[end]), fminf(_y[e], _y[end]), cx0, cy0);
+				cell_of(fmaxf(_x[e], _x[end]), fmaxf(_y[e], _y[end]), cx1, cy1);
+
+				for (unsigned cx = cx0; cx <= cx1; cx++) {
+					for (unsigned cy = cy0; cy <= cy1; cy++) {
+						if (!edge_touches_cell(e, cx, cy)) {
+							continue;
+						}
+
+						const unsigned c = cy * nx + cx;
+
+						if (pass == 0) {
+							edge_count[c + 1]++;
+
+							if (last_zone[c] != z) {
+								_cell_zone_start[c + 1]++;
+								last_zone[c] = z;
+							}
+
+						} else {
+							/* edge_count and _cell_zone_start hold the fill cursors in this pass */
+							if (last_zone[c] != z) {
+								CellZone &cell_zone = _cell_zones[_cell_zone_start[c]++];
+								cell_zone.first_edge = edge_count[c];
+								cell_zone.num_edges = 0;
+								cell_zone.zone = z;
+								cell_zone.center_inside = 0;
+								last_zone[c] = z;
+							}
+
+							_cell_zones[_cell_zone_start[c] - 1].num_edges++;
+							_cell_edges[edge_count[c]++] = e;
+						}
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			/* prefix sums */
+			for (unsigned c = 0; c < num_cells; c++) {
+				edge_count[c + 1] += edge_count[c];
+				_cell_zone_start[c + 1] += _cell_zone_start[c];
+				last_zone[c] = UINT16_MAX;
+			}
+
+			_cell_zones = new CellZone[_cell_zone_start[num_cells]];
+			_cell_edges = new uint16_t[edge_count[num_cells]];
+
+			if (_cell_zones == nullptr || _cell_edges == nullptr) {
+				delete[] edge_count;
+				delete[] last_zone;
+				free_index();
+				return -1;
+			}
+		}
+	}
+
+	/* the cursors now point at the end of each cell, shift them back to the start */
+	for (unsigned c = num_cells; c > 0; c--) {
+		_cell_zone_start[c] = _cell_zone_start[c - 1];
+	}
+
+	_cell_zone_start[0] = 0;
+
+	delete[] edge_count;
+	delete[] last_zone;
+
+	if (compute_cell_states() != 0) {
+		free_index();
+		return -1;
+	}
+
+	return 0;
+}
+
+int GeofenceZones::compute_cell_states()
+{
+	/* Scanline over the cell center rows: the crossings of all edges with the
+	 * row, sorted along the row, give the inside state of every cell center
+	 * for every zone (even-odd rule, same half-open convention as the queries) */
+	RowCrossing *crossings = new RowCrossing[_num_vertices];
+	uint8_t inside[MAX_ZONES];
+
+	if (crossings == nullptr) {
+		return -1;
+	}
+
+	for (unsigned cy = 0; cy < _grid_ny; cy++) {
+		const float row_y = _grid_y0 + (cy + 0.5f) * _cell_size_y;
+		unsigned num_crossings = 0;
+
+		for (unsigned z = 0; z < _num_zones; z++) {
+			const Zone &zone = _zones[z];
+
+			for (unsigned e = zone.first_vertex; e < (unsigned)zone.first_vertex + zone.num_vertices; e++) {
+				const unsigned end = edge_end(e);
+
+				if ((_y[e] > row_y) != (_y[end] > row_y)) {
+					crossings[num_crossings].x = _x[e] + (row_y - _y[e]) * (_x[end] - _x[e]) / (_y[end] - _y[e]);
+					crossings[num_crossings].zone = z;
+					num_crossings++;
+				}
+			}
+		}
+
+		qsort(crossings, num_crossings, sizeof(RowCrossing), compare_crossings);
+
+		memset(inside, 0, sizeof(inside));
+		int inclusion_count = 0;
+		int exclusion_count = 0;
+		unsigned next_crossing = 0;
+
+		for (unsigned cx = 0; cx < _grid_nx; cx++) {
+			const float center_x = _grid_x0 + (cx + 0.5f) * _cell_size_x;
+
+			while (next_crossing < num_crossings && crossings[next_crossing].x < center_x) {
+				const uint8_t z = crossings[next_crossing].zone;
+				inside[z] = !inside[z];
+				const int delta = inside[z] ? 1 : -1;
+
+				if (_zones[z].type == ZONE_INCLUSION) {
+					inclusion_count += delta;
+
+				} else {
+					exclusion_count += delta;
+				}
+
+				next_crossing++;
+			}
+
+			/* zones with edges in the cell are resolved per query, the others are constant over the cell */
+			const unsigned c = cy * _grid_nx + cx;
+			int cell_inclusion_count = inclusion_count;
+			int cell_exclusion_count = exclusion_count;
+
+			for (unsigned i = _cell_zone_start[c]; i < _cell_zone_start[c + 1]; i++) {
+				CellZone &cell_zone = _cell_zones[i];
+				cell_zone.center_inside = inside[cell_zone.zone];
+
+				if (cell_zone.center_inside) {
+					if (_zones[cell_zone.zone].type == ZONE_INCLUSION) {
+						cell_inclusion_count--;
+
+					} else {
+						cell_exclusion_count--;
+					}
+				}
+			}
+
+			_cell_flags[c] = (cell_inclusion_count > 0 ? CELL_INCLUDED : 0) |
+					 (cell_exclusion_count > 0 ? CELL_EXCLUDED : 0);
+		}
+	}
+
+	delete[] crossings;
+
+	return 0;
+}
+
+bool GeofenceZones::inside(double lat, double lon) const
+{
+	float x, y;
+
+	if (map_projection_project(&_ref, lat, lon, &x, &y) != 0) {
+		return true;
+	}
+
+	return inside_local(x, y);
+}
+
+bool GeofenceZones::inside_local(float x, float y) const
+{
+	if (!is_built()) {
+		return true;
+	}
+
+	unsigned cell_x, cell_y;
+
+	if (!cell_of(x, y, cell_x, cell_y)) {
+		/* outside the grid means outside all zones */
+		return _num_inclusion_zones == 0;
+	}
+
+	const unsigned c = cell_y * _grid_nx + cell_x;
+	const float center_x = _grid_x0 + (cell_x + 0.5f) * _cell_size_x;
+	const float center_y = _grid_y0 + (cell_y + 0.5f) * _cell_size_y;
+
+	bool included = _cell_flags[c] & CELL_INCLUDED;
+	bool excluded = _cell_flags[c] & CELL_EXCLUDED;
+
+	/* the segment from the cell center to the point stays in the cell, so only
+	 * the edges in the cell can change the state relative to the center */
+	for (unsigned i = _cell_zone_start[c]; i < _cell_zone_start[c + 1]; i++) {
+		const CellZone &cell_zone = _cell_zones[i];
+		bool zone_inside = cell_zone.center_inside;
+
+		for (unsigned k = cell_zone.first_edge; k < cell_zone.first_edge + cell_zone.num_edges; k++) {
+			const unsigned e = _cell_edges[k];
+			const unsigned end = edge_end(e);
+
+			if (segments_cross(center_x, center_y, x, y, _x[e], _y[e], _x[end], _y[end])) {
+				zone_inside = !zone_inside;
+			}
+		}
+
+		if (zone_inside) {
+			if (_zones[cell_zone.zone].type == ZONE_INCLUSION) {
+				included = true;
+
+			} else {
+				excluded = true;
+			}
+		}
+	}
+
+	return (included || _num_inclusion_zones == 0) && !excluded;
+}
+
+float GeofenceZones::distance_to_boundary(double lat, double lon, float max_distance) const
+{
+	float x, y;
+
+	if (map_projection_project(&_ref, lat, lon, &x, &y) != 0) {
+		return max_distance;
+	}
+
+	return distance_to_boundary_local(x, y, max_distance);
+}
+
+float GeofenceZones::cell_distance(unsigned cell, float x, float y, float best) const
+{
+	for (unsigned i = _cell_zone_start[cell]; i < _cell_zone_start[cell + 1]; i++) {
+		const CellZone &cell_zone = _cell_zones[i];
+
+		for (unsigned k = cell_zone.first_edge; k < cell_zone.first_edge + cell_zone.num_edges; k++) {
+			const unsigned e = _cell_edges[k];
+			const unsigned end = edge_end(e);
+			best = fminf(best, point_segment_distance_sq(x, y, _x[e], _y[e], _x[end], _y[end]));
+		}
+	}
+
+	return best;
+}
+
+float GeofenceZones::distance_to_boundary_local(float x, float y, float max_distance) const
+{
+	if (!is_built()) {
+		return max_distance;
+	}
+
+	const float grid_x1 = _grid_x0 + _grid_nx * _cell_size_x;
+	const float grid_y1 = _grid_y0 + _grid_ny * _cell_size_y;
+
+	/* distance to the grid box, no edge can be closer than that */
+	const float out_x = fmaxf(fmaxf(_grid_x0 - x, x - grid_x1), 0.0f);
+	const float out_y = fmaxf(fmaxf(_grid_y0 - y, y - grid_y1), 0.0f);
+
+	if (out_x * out_x + out_y * out_y >= max_distance * max_distance) {
+		return max_distance;
+	}
+
+	/* search rings of cells around the (clamped) cell of the point until the
+	 * closest edge found is closer than any cell not searched yet */
+	const float fx = fminf(fmaxf((x - _grid_x0) / _cell_size_x, 0.0f), _grid_nx - 1.0f);
+	const float fy = fminf(fmaxf((y - _grid_y0) / _cell_size_y, 0.0f), _grid_ny - 1.0f);
+	const int cell_x = (int)fx;
+	const int cell_y = (int)fy;
+	const int max_ring = (int)((_grid_nx > _grid_ny) ? _grid_nx : _grid_ny);
+
+	float best_sq = max_distance * max_distance;
+
+	for (int ring = 0; ring < max_ring; ring++) {
+		const int x0 = cell_x - ring;
+		const int x1 = cell_x + ring;
+		const int y0 = cell_y - ring;
+		const int y1 = cell_y + ring;
+
+		for (int cx = x0; cx <= x1; cx++) {
+			if (cx < 0 || cx >= (int)_grid_nx) {
+				continue;
+			}
+
+			/* full columns at the left and right border of the ring, top and bottom cells otherwise */
+			const int step = (cx == x0 || cx == x1) ? 1 : (y1 - y0);
+
+			for (int cy = y0; cy <= y1; cy += (step > 0 ? step : 1)) {
+				if (cy >= 0 && cy < (int)_grid_ny) {
+					best_sq = cell_distance(cy * _grid_nx + cx, x, y, best_sq);
+				}
+			}
+		}
+
+		/* lower bound for the distance to any cell outside of the searched rings */
+		float bound = max_distance;
+
+		if (x0 > 0) { bound = fminf(bound, x - (_grid_x0 + x0 * _cell_size_x)); }
+
+		if (x1 < (int)_grid_nx - 1) { bound = fminf(bound, _grid_x0 + (x1 + 1) * _cell_size_x - x); }
+
+		if (y0 > 0) { bound = fminf(bound, y - (_grid_y0 + y0 * _cell_size_y)); }
+
+		if (y1 < (int)_grid_ny - 1) { bound = fminf(bound, _grid_y0 + (y1 + 1) * _cell_size_y - y); }
+
+		bound = fmaxf(bound, 0.0f);
+
+		if (best_sq <= bound * bound || bound >= max_distance) {
+			break;
+		}
+	}
+
+	return fminf(sqrtf(best_sq), max_distance);
+}
+
+float GeofenceZones::first_breach(double lat0, double lon0, double lat1, double lon1) const
+{
+	float x0, y0, x1, y1;
+
+	if (map_projection_project(&_ref, lat0, lon0, &x0, &y0) != 0 ||
+	    map_projection_project(&_ref, lat1, lon1, &x1, &y1) != 0) {
+		return -1.0f;
+	}
+
+	return first_breach_local(x0, y0, x1, y1);
+}
+
+float GeofenceZones::first_breach_local(float x0, float y0, float x1, float y1) const
+{
+	if (!is_built()) {
+		return -1.0f;
+	}
+
+	if (!inside_local(x0, y0)) {
+		return 0.0f;
+	}
+
+	/* cells overlapping the path, clamped to the grid (outside the grid there are no edges) */
+	const float fx0 = fminf(fmaxf((fminf(x0, x1) - _grid_x0) / _cell_size_x, 0.0f), _grid_nx - 1.0f);
+	const float fy0 = fminf(fmaxf((fminf(y0, y1) - _grid_y0) / _cell_size_y, 0.0f), _grid_ny - 1.0f);
+	const float fx1 = fminf(fmaxf((fmaxf(x0, x1) - _grid_x0) / _cell_size_x, 0.0f), _grid_nx - 1.0f);
+	const float fy1 = fminf(fmaxf((fmaxf(y0, y1) - _grid_y0) / _cell_size_y, 0.0f), _grid_ny - 1.0f);
+
+	const float dx = x1 - x0;
+	const float dy = y1 - y0;
+
+	/* The allowed state can only change where the path crosses an edge. The
+	 * crossings are collected in sorted batches of the closest ones beyond
+	 * t_start, then the state is evaluated in the middle of every interval
+	 * between consecutive crossings. */
+	static constexpr unsigned BATCH_SIZE = 16;
+	float crossings[BATCH_SIZE];
+	float t_start = 0.0f;
+
+	for (;;) {
+		unsigned num_crossings = 0;
+		bool batch_full = false;
+
+		for (unsigned cx = (unsigned)fx0; cx <= (unsigned)fx1; cx++) {
+			for (unsigned cy = (unsigned)fy0; cy <= (unsigned)fy1; cy++) {
+				if (!segment_touches_cell(x0, y0, x1, y1, cx, cy)) {
+					continue;
+				}
+
+				const unsigned c = cy * _grid_nx + cx;
+
+				for (unsigned i = _cell_zone_start[c]; i < _cell_zone_start[c + 1]; i++) {
+					const CellZone &cell_zone = _cell_zones[i];
+
+					for (unsigned k = cell_zone.first_edge; k < cell_zone.first_edge + cell_zone.num_edges; k++) {
+						const unsigned e = _cell_edges[k];
+						const unsigned end = edge_end(e);
+						const float ex = _x[end] - _x[e];
+						const float ey = _y[end] - _y[e];
+						const float denom = dx * ey - dy * ex;
+
+						if (fabsf(denom) < FLT_EPSILON) {
+							continue;
+						}
+
+						const float ax = _x[e] - x0;
+						const float ay = _y[e] - y0;
+						const float t = (ax * ey - ay * ex) / denom;
+						const float u = (ax * dy - ay * dx) / denom;
+
+						if (t <= t_start || t > 1.0f || u < 0.0f || u > 1.0f) {
+							continue;
+						}
+
+						/* keep the batch sorted, an edge in several cells gives duplicates which are harmless */
+						if (num_crossings == BATCH_SIZE) {
+							batch_full = true;
+
+							if (t >= crossings[BATCH_SIZE - 1]) {
+								continue;
+							}
+
+							num_crossings--;
+						}
+
+						unsigned pos = num_crossings++;
+
+						while (pos > 0 && crossings[pos - 1] > t) {
+							crossings[pos] = crossings[pos - 1];
+							pos--;
+						}
+
+						crossings[pos] = t;
+					}
+				}
+			}
+		}
+
+		float t_prev = t_start;
+
+		for (unsigned i = 0; i < num_crossings; i++) {
+			const float t_mid = 0.5f * (t_prev + crossings[i]);
+
+			if (crossings[i] > t_prev && !inside_local(x0 + t_mid * dx, y0 + t_mid * dy)) {
+				return t_prev;
+			}
+
+			t_prev = crossings[i];
+		}
+
+		if (!batch_full) {
+			const float t_mid = 0.5f * (t_prev + 1.0f);
+			return inside_local(x0 + t_mid * dx, y0 + t_mid * dy) ? -1.0f : t_prev;
+		}
+
+		/* continue after the last crossing of this batch */
+		t_start = crossings[num_crossings - 1];
+	}
+}
@@ -0,0 +1,214 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file geofence_zones.h
+ *
+ * Set of inclusion and exclusion polygons with a uniform grid index for
+ * containment and distance to boundary queries.
+ *
+ * Vertices are projected into a local azimuthal equidistant frame centered on
+ * the first vertex. The grid stores for every cell the edges crossing it and
+ * the inside/outside state of the cell center for each zone touching the
+ * cell, so a containment query only needs to test the edges of a single cell.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <geo/geo.h>
+
+class __EXPORT GeofenceZones
+{
+public:
+	enum ZoneType {
+		ZONE_INCLUSION = 0,	/**< vehicle has to stay inside one of these */
+		ZONE_EXCLUSION = 1	/**< vehicle has to stay outside of all of these */
+	};
+
+	static constexpr unsigned MAX_ZONES = 64;
+	static constexpr unsigned MAX_VERTICES = 65535;
+	static constexpr unsigned MAX_GRID_CELLS = 4096;
+
+	GeofenceZones();
+	~GeofenceZones();
+
+	GeofenceZones(const GeofenceZones &) = delete;
+	GeofenceZones &operator=(const GeofenceZones &) = delete;
+
+	/**
+	 * Remove all zones and the index.
+	 */
+	void clear();
+
+	/**
+	 * Start a new zone. Vertices are added with add_vertex() and the zone is
+	 * completed by end_zone().
+	 * @return 0 on success, -1 if the zone limit is reached
+	 */
+	int begin_zone(ZoneType type);
+
+	/**
+	 * Add a vertex to the current zone.
+	 * @param lat in degrees
+	 * @param lon in degrees
+	 * @return 0 on success, -1 on error
+	 */
+	int add_vertex(double lat, double lon);
+
+	/**
+	 * Complete the current zone. Zones with less than 3 vertices are dropped.
+	 * @return 0 on success, -1 if the zone was dropped
+	 */
+	int end_zone();
+
+	/**
+	 * Build the spatial index. Has to be called after the last zone was added
+	 * and before querying.
+	 * @return 0 on success, -1 on error (no zones or out of memory)
+	 */
+	int build();
+
+	bool is_empty() const { return _num_zones == 0; }
+	bool is_built() const { return _cell_flags != nullptr; }
+
+	unsigned zone_count() const { return _num_zones; }
+	unsigned vertex_count() const { return _num_vertices; }
+
+	/**
+	 * Check if a position is allowed: inside at least one inclusion zone (if
+	 * any are defined) and outside of all exclusion zones.
+	 * @param lat in degrees
+	 * @param lon in degrees
+	 */
+	bool inside(double lat, double lon) const;
+
+	/**
+	 * Same as inside() for a position in the local frame of reference().
+	 */
+	bool inside_local(float x, float y) const;
+
+	/**
+	 * Horizontal distance to the closest zone edge.
+	 * @param lat in degrees
+	 * @param lon in degrees
+	 * @param max_distance search radius in meters
+	 * @return distance in meters, max_distance if no edge is closer
+	 */
+	float distance_to_boundary(double lat, double lon, float max_distance) const;
+
+	/**
+	 * Same as distance_to_boundary() for a position in the local frame of reference().
+	 */
+	float distance_to_boundary_local(float x, float y, float max_distance) const;
+
+	/**
+	 * Find where a straight path first leaves the allowed area.
+	 * @param lat0 start latitude in degrees
+	 * @param lon0 start longitude in degrees
+	 * @param lat1 end latitude in degrees
+	 * @param lon1 end longitude in degrees
+	 * @return fraction of the path in [0, 1] at which the first breach
+	 *         happens, 0 if the start is not allowed, -1 if there is no breach
+	 */
+	float first_breach(double lat0, double lon0, double lat1, double lon1) const;
+
+	/**
+	 * Same as first_breach() for a path in the local frame of reference().
+	 */
+	float first_breach_local(float x0, float y0, float x1, float y1) const;
+
+	/**
+	 * Projection of the local frame used by the zones.
+	 */
+	const struct map_projection_reference_s &reference() const { return _ref; }
+
+private:
+	enum CellFlags {
+		CELL_INCLUDED = 1,	/**< whole cell inside an inclusion zone which has no edge in the cell */
+		CELL_EXCLUDED = 2	/**< whole cell inside an exclusion zone which has no edge in the cell */
+	};
+
+	struct Zone {
+		uint16_t first_vertex;
+		uint16_t num_vertices;
+		uint8_t type;
+	};
+
+	/** zone touching a grid cell, with its edges in that cell */
+	struct CellZone {
+		uint32_t first_edge;	/**< index into _cell_edges */
+		uint16_t num_edges;
+		uint8_t zone;
+		uint8_t center_inside;	/**< cell center is inside the zone */
+	};
+
+	struct map_projection_reference_s _ref;
+
+	Zone _zones[MAX_ZONES];
+	unsigned _num_zones;
+	unsigned _num_inclusion_zones;
+	bool _zone_open;
+
+	float *_x;		/**< vertex north in m */
+	float *_y;		/**< vertex east in m */
+	unsigned _num_vertices;
+	unsigned _vertex_capacity;
+
+	/* grid index */
+	float _grid_x0;
+	float _grid_y0;
+	float _cell_size_x;
+	float _cell_size_y;
+	unsigned _grid_nx;
+	unsigned _grid_ny;
+
+	uint8_t *_cell_flags;		/**< CellFlags per cell */
+	uint32_t *_cell_zone_start;	/**< per cell index into _cell_zones, _grid_nx * _grid_ny + 1 entries */
+	CellZone *_cell_zones;
+	uint16_t *_cell_edges;		/**< edge index, edge i goes from vertex i to vertex _vertex_next[i] */
+	uint16_t *_vertex_next;		/**< next vertex in the same zone */
+
+	void free_index();
+	int grow_vertices();
+
+	unsigned edge_end(unsigned edge) const { return _vertex_next[edge]; }
+
+	bool cell_of(float x, float y, unsigned &cell_x, unsigned &cell_y) const;
+	bool segment_touches_cell(float x0, float y0, float x1, float y1, unsigned cell_x, unsigned cell_y) const;
+	bool edge_touches_cell(unsigned edge, unsigned cell_x, unsigned cell_y) const;
+	int compute_cell_states();
+
+	float cell_distance(unsigned cell, float x, float y, float best) const;
+};
@@ -0,0 +1,163 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file rc_scan.c
+ *
+ * Single pass auto-detection of the serial RC protocols on the 115200 8N1 line.
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+
+#include "rc_scan.h"
+#include "dsm.h"
+#include "st24.h"
+#include "sumd.h"
+
+#include <string.h>
+
+/*
+ * DSM frames carry no checksum and the DSM decoder also accepts frames in
+ * ST24 data. While several protocols are candidates, DSM is therefore only
+ * reported after this many frames without a checksummed frame in between.
+ *
+ * The count starts with the first frame the DSM decoder synced on, so the
+ * frames used to guess the 10/11 bit format count as well. At 22 ms per frame
+ * this locks within the 300 ms scan window of px4fmu.
+ */
+#define RC_SCAN_DSM_MIN_FRAMES	10
+
+static unsigned dsm_unconfirmed_frames;
+static unsigned dsm_frame_drops;	///< drop counter of the DSM decoder at the last frame
+
+void
+rc_scan_init(void)
+{
+	dsm_proto_init();
+	dsm_unconfirmed_frames = 0;
+	dsm_frame_drops = 0;
+}
+
+uint8_t
+rc_scan_parse(uint64_t now, const uint8_t *bytes, unsigned len, uint8_t candidates,
+	      uint16_t *values, uint16_t max_channels, struct rc_scan_result *result)
+{
+	uint8_t decoded = 0;
+
+	result->num_values = 0;
+	result->rssi = -1;
+	result->failsafe = false;
+	result->dsm_11_bit = false;
+	result->frame_drops = 0;
+
+	if (candidates == RC_SCAN_PROTO_DSM) {
+		/* locked onto DSM, which decodes whole buffers */
+		if (dsm_parse(now, (uint8_t *)bytes, len, values, &result->num_values, &result->dsm_11_bit,
+			      &result->frame_drops, max_channels)) {
+			decoded = RC_SCAN_PROTO_DSM;
+		}
+
+		result->protocol = decoded;
+		return decoded;
+	}
+
+	for (unsigned i = 0; i < len; i++) {
+		const uint8_t byte = bytes[i];
+
+		/* every decoder only writes the channel values once it has a complete, valid frame */
+		if (candidates & RC_SCAN_PROTO_DSM) {
+			uint16_t dsm_values[DSM_MAX_CHANNEL_COUNT];
+			uint16_t num_values;
+
+			const bool dsm_decoded = dsm_parse(now, (uint8_t *)&bytes[i], 1, dsm_values, &num_values,
+							   &result->dsm_11_bit, &result->frame_drops, DSM_MAX_CHANNEL_COUNT);
+
+			/* the decoder reports the frames it used for the format guess as drops */
+			if (dsm_decoded || result->frame_drops != dsm_frame_drops) {
+				dsm_frame_drops = result->frame_drops;
+				dsm_unconfirmed_frames++;
+			}
+
+			if (dsm_decoded && dsm_unconfirmed_frames >= RC_SCAN_DSM_MIN_FRAMES) {
+
+				if (num_values > max_channels) {
+					num_values = max_channels;
+				}
+
+				memcpy(values, dsm_values, num_values * sizeof(values[0]));
+				decoded = RC_SCAN_PROTO_DSM;
+				result->num_values = num_values;
+				result->rssi = -1;
+				result->failsafe = false;
+			}
+		}
+
+		if (candidates & RC_SCAN_PROTO_ST24) {
+			uint8_t rssi = 0;
+			uint8_t lost_count = 0;
+			uint16_t num_values;
+
+			if (st24_decode(byte, &rssi, &lost_count, &num_values, values, max_channels) == OK) {
+				dsm_unconfirmed_frames = 0;
+
+				/* ST24 keeps sending channels after the link is lost, only lost_count tells */
+				if (lost_count == 0) {
+					decoded = RC_SCAN_PROTO_ST24;
+					result->num_values = num_values;
+					result->rssi = rssi;
+					result->failsafe = false;
+				}
+			}
+		}
+
+		if (candidates & RC_SCAN_PROTO_SUMD) {
+			static uint8_t rx_count;
+			uint8_t rssi = 0;
+			uint16_t num_values;
+			bool failsafe;
+
+			if (sumd_decode(byte, &rssi, &rx_count, &num_values, values, max_channels, &failsafe) == OK) {
+				decoded = RC_SCAN_PROTO_SUMD;
+				dsm_unconfirmed_frames = 0;
+				result->num_values = num_values;
+				result->rssi = rssi;
+				result->failsafe = failsafe;
+			}
+		}
+	}
+
+	result->protocol = decoded;
+
+	return decoded;
+}
@@ -0,0 +1,89 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file rc_scan.h
+ *
+ * Auto-detection of the serial RC protocols sharing the 115200 8N1 line
+ * (Spektrum DSM, Yuneec ST24 and Graupner SUMD/SUMH).
+ *
+ * Received bytes are fed to all candidate decoders in a single pass, so the
+ * protocols do not need to be tried one after another. Once a protocol is
+ * detected, the caller narrows the candidate set down to that protocol.
+ *
+ * S.BUS uses an inverted 100000 8E2 line and PPM a timer input, so they
+ * can not share the byte stream and are scanned separately.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+__BEGIN_DECLS
+
+#define RC_SCAN_PROTO_DSM	(1 << 0)
+#define RC_SCAN_PROTO_ST24	(1 << 1)
+#define RC_SCAN_PROTO_SUMD	(1 << 2)
+#define RC_SCAN_PROTO_ALL	(RC_SCAN_PROTO_DSM | RC_SCAN_PROTO_ST24 | RC_SCAN_PROTO_SUMD)
+
+struct rc_scan_result {
+	uint8_t protocol;		///< RC_SCAN_PROTO_* of the last decoded frame, 0 if none
+	uint16_t num_values;		///< number of decoded channels
+	int rssi;			///< RSSI in percent, -1 if the protocol does not report it
+	bool failsafe;			///< receiver reported failsafe
+	bool dsm_11_bit;		///< DSM frame uses 11 bit encoding
+	unsigned frame_drops;		///< DSM frame drop counter
+};
+
+/**
+ * Reset all decoders, e.g. before switching the line to this protocol group.
+ */
+__EXPORT void	rc_scan_init(void);
+
+/**
+ * Feed received bytes to all candidate decoders in one pass.
+ *
+ * @param now timestamp of the reception of the bytes
+ * @param bytes received bytes
+ * @param len number of received bytes
+ * @param candidates RC_SCAN_PROTO_* bitmask of the decoders to run
+ * @param values output channel values, written when a frame is decoded
+ * @param max_channels size of values
+ * @param result details of the last decoded frame
+ * @return RC_SCAN_PROTO_* of the last decoded frame, 0 if no frame was decoded
+ */
+__EXPORT uint8_t	rc_scan_parse(uint64_t now, const uint8_t *bytes, unsigned len, uint8_t candidates,
+				      uint16_t *values, uint16_t max_channels, struct rc_scan_result *result);
+
+__END_DECLS
@@ -12,6 +12,7 @@
 #include <lib/rc/dsm.h>
 #include <lib/rc/st24.h>
 #include <lib/rc/sumd.h>
+#include <lib/rc/rc_scan.h>
 
 #if !defined(CONFIG_ARCH_BOARD_SITL)
 #define TEST_DATA_PATH "/fs/microsd"
@@ -33,6 +34,14 @@ private:
 	bool sbus2Test();
 	bool st24Test();
 	bool sumdTest();
+	bool rcScanTest(const char *filepath, uint8_t expected_protocol, unsigned min_frames);
+	bool rcScanTestST24();
+	bool rcScanTestSUMD();
+	bool rcScanTestDSM();
+	bool rcScanTestDSM22ms();
+	bool parseThroughputTest();
+
+	unsigned loadCapture(const char *filepath, uint8_t *bytes, hrt_abstime *stamps, unsigned max_bytes);
 };
 
 bool RCTest::run_tests(void)
@@ -42,6 +51,11 @@ bool RCTest::run_tests(void)
 	ut_run_test(sbus2Test);
 	ut_run_test(st24Test);
 	ut_run_test(sumdTest);
+	ut_run_test(rcScanTestST24);
+	ut_run_test(rcScanTestSUMD);
+	ut_run_test(rcScanTestDSM);
+	ut_run_test(rcScanTestDSM22ms);
+	ut_run_test(parseThroughputTest);
 
 	return (_tests_failed == 0);
 }
@@ -320,6 +334,202 @@ bool RCTest::sumdTest(void)
 	return true;
 }
 
+unsigned RCTest::loadCapture(const char *filepath, uint8_t *bytes, hrt_abstime *stamps, unsigned max_bytes)
+{
+	FILE *fp = fopen(filepath, "rt");
+
+	if (fp == nullptr) {
+		return 0;
+	}
+
+	// Trash the first 20 lines
+	for (unsigned i = 0; i < 20; i++) {
+		char buf[200];
+		(void)fgets(buf, sizeof(buf), fp);
+	}
+
+	float f;
+	unsigned x;
+	unsigned count = 0;
+
+	while (count < max_bytes && fscanf(fp, "%f,%x,,", &f, &x) == 2) {
+		bytes[count] = x;
+		stamps[count] = f * 1e6f;
+		count++;
+	}
+
+	fclose(fp);
+
+	return count;
+}
+
+bool RCTest::rcScanTestST24()
+{
+	return rcScanTest(TEST_DATA_PATH "st24_data.txt", RC_SCAN_PROTO_ST24, 500);
+}
+
+bool RCTest::rcScanTestSUMD()
+{
+	return rcScanTest(TEST_DATA_PATH "sumd_data.txt", RC_SCAN_PROTO_SUMD, 450);
+}
+
+bool RCTest::rcScanTestDSM()
+{
+	return rcScanTest(TEST_DATA_PATH "dsm_x_dx9_data.txt", RC_SCAN_PROTO_DSM, 400);
+}
+
+bool RCTest::rcScanTest(const char *filepath, uint8_t expected_protocol, unsigned min_frames)
+{
+	const unsigned max_bytes = 20000;
+	uint8_t *bytes = new uint8_t[max_bytes];
+	hrt_abstime *stamps = new hrt_abstime[max_bytes];
+
+	unsigned count = loadCapture(filepath, bytes, stamps, max_bytes);
+
+	uint16_t rc_values[18];
+	struct rc_scan_result scan;
+	unsigned frames[8] = {};
+
+	rc_scan_init();
+
+	// feed byte by byte through the shared pass, as it would arrive from a slow UART
+	for (unsigned i = 0; i < count; i++) {
+		uint8_t protocol = rc_scan_parse(stamps[i], &bytes[i], 1, RC_SCAN_PROTO_ALL, rc_values,
+						 sizeof(rc_values) / sizeof(rc_values[0]), &scan);
+		frames[protocol & 0x7]++;
+	}
+
+	delete[] bytes;
+	delete[] stamps;
+
+	PX4_INFO("dsm: %u st24: %u sumd: %u", frames[RC_SCAN_PROTO_DSM], frames[RC_SCAN_PROTO_ST24],
+		 frames[RC_SCAN_PROTO_SUMD]);
+
+	ut_test(count > 0);
+	ut_test(frames[expected_protocol] >= min_frames);
+
+	// no other decoder may claim frames from this capture
+	ut_test(frames[expected_protocol] == frames[RC_SCAN_PROTO_DSM] + frames[RC_SCAN_PROTO_ST24] +
+		frames[RC_SCAN_PROTO_SUMD]);
+
+	return true;
+}
+
+bool RCTest::rcScanTestDSM22ms()
+{
+	// px4fmu scans the 115200 8N1 protocols for 300 ms before it moves on
+	const hrt_abstime scan_window = 300 * 1000;
+	const unsigned max_bytes = 20000;
+	uint8_t *bytes = new uint8_t[max_bytes];
+	hrt_abstime *stamps = new hrt_abstime[max_bytes];
+
+	unsigned count = loadCapture(TEST_DATA_PATH "dsm_x_dx9_data.txt", bytes, stamps, max_bytes);
+
+	// the capture is from an 11 ms receiver, stretch every gap between two frames to get a 22 ms one
+	hrt_abstime stretch = 0;
+	hrt_abstime last = (count > 0) ? stamps[0] : 0;
+
+	for (unsigned i = 1; i < count; i++) {
+		const hrt_abstime captured = stamps[i];
+
+		if (captured - last > 5000) {
+			stretch += 11000;
+		}
+
+		last = captured;
+		stamps[i] += stretch;
+	}
+
+	uint16_t rc_values[18];
+	struct rc_scan_result scan;
+	unsigned windows = 0;
+	unsigned locked = 0;
+
+	// open the scan window at different points of the frame stream, like the scan rotation does
+	for (unsigned start = 0; count > 0 && stamps[count - 1] - stamps[start] > scan_window; start += 37) {
+		rc_scan_init();
+		windows++;
+
+		for (unsigned i = start; i < count && stamps[i] - stamps[start] < scan_window; i++) {
+			if (rc_scan_parse(stamps[i], &bytes[i], 1, RC_SCAN_PROTO_ALL, rc_values,
+					  sizeof(rc_values) / sizeof(rc_values[0]), &scan) == RC_SCAN_PROTO_DSM) {
+				locked++;
+				break;
+			}
+		}
+	}
+
+	delete[] bytes;
+	delete[] stamps;
+
+	PX4_INFO("dsm 22 ms: locked in %u of %u scan windows", locked, windows);
+
+	ut_test(windows > 0);
+	ut_test(locked == windows);
+
+	return true;
+}
+
+bool RCTest::parseThroughputTest()
+{
+	const unsigned max_bytes = 20000;
+	const unsigned runs = 20;
+	uint8_t *bytes = new uint8_t[max_bytes];
+	hrt_abstime *stamps = new hrt_abstime[max_bytes];
+	uint16_t rc_values[18];
+	uint16_t max_channels = sizeof(rc_values) / sizeof(rc_values[0]);
+	uint16_t num_values;
+
+	// SBUS
+	unsigned count = loadCapture(TEST_DATA_PATH "sbus2_r7008SB.txt", bytes, stamps, max_bytes);
+	ut_test(count > 0);
+
+	unsigned frames = 0;
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned run = 0; run < runs; run++) {
+		bool sbus_failsafe;
+		bool sbus_frame_drop;
+		unsigned sbus_frame_drops = 0;
+
+		for (unsigned i = 0; i < count; i++) {
+			frames += sbus_parse(stamps[i], &bytes[i], 1, rc_values, &num_values,
+					     &sbus_failsafe, &sbus_frame_drop, &sbus_frame_drops, max_channels);
+		}
+	}
+
+	hrt_abstime elapsed = hrt_elapsed_time(&start);
+	PX4_INFO("sbus: %u frames, %u bytes in %llu us (%.1f kB/s)", frames, count * runs, (unsigned long long)elapsed,
+		 (double)(count * runs * 1000.0f / (elapsed > 0 ? elapsed : 1)));
+
+	// DSM
+	count = loadCapture(TEST_DATA_PATH "dsm_x_data.txt", bytes, stamps, max_bytes);
+	ut_test(count > 0);
+
+	frames = 0;
+	start = hrt_absolute_time();
+
+	for (unsigned run = 0; run < runs; run++) {
+		bool dsm_11_bit;
+		unsigned dsm_frame_drops = 0;
+
+		dsm_proto_init();
+
+		for (unsigned i = 0; i < count; i++) {
+			frames += dsm_parse(stamps[i] + run * stamps[count - 1], &bytes[i], 1, rc_values, &num_values,
+					    &dsm_11_bit, &dsm_frame_drops, max_channels);
+		}
+	}
+
+	elapsed = hrt_elapsed_time(&start);
+	PX4_INFO("dsm: %u frames, %u bytes in %llu us (%.1f kB/s)", frames, count * runs, (unsigned long long)elapsed,
+		 (double)(count * runs * 1000.0f / (elapsed > 0 ? elapsed : 1)));
+
+	delete[] bytes;
+	delete[] stamps;
+
+	return true;
+}
 
 
 ut_declare_test_c(rc_tests_main, RCTest)
@@ -0,0 +1,567 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file terrain_database.cpp
+ */
+
+#include "terrain_database.h"
+
+#include <px4_defines.h>
+#include <px4_log.h>
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TERRAIN_FILE_MAGIC	0x52545850	/* 'PXTR' */
+#define TERRAIN_FILE_VERSION	1
+
+struct terrain_file_header_s {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t tile_size;
+	int16_t lat_deg;
+	int16_t lon_deg;
+	uint16_t samples_per_degree;
+	uint16_t tiles_per_side;
+};
+
+TerrainDatabase::TerrainDatabase() :
+	_directory(nullptr),
+	_num_requests(0),
+	_tiles(nullptr),
+	_num_tiles(0),
+	_height_buffer(nullptr),
+	_staging(nullptr),
+	_last_tile(0),
+	_tile_size(0),
+	_tiles_per_side(0),
+	_samples_per_degree(0),
+	_fd(-1),
+	_fd_square(0),
+	_missing_next(0),
+	_queries(0),
+	_hits(0),
+	_loads(0),
+	_load_failures(0)
+{
+	for (unsigned i = 0; i < MAX_MISSING_FILES; i++) {
+		_missing_files[i] = KEY_INVALID;
+	}
+
+	memset(&_work, 0, sizeof(_work));
+	px4_sem_init(&_lock, 0, 1);
+	px4_sem_init(&_load_lock, 0, 1);
+}
+
+TerrainDatabase::~TerrainDatabase()
+{
+	work_cancel(LPWORK, &_work);
+
+	/* wait for a load in progress */
+	px4_sem_wait(&_load_lock);
+
+	px4_sem_destroy(&_lock);
+	px4_sem_destroy(&_load_lock);
+
+	if (_fd >= 0) {
+		close(_fd);
+	}
+
+	free(_directory);
+	delete[] _tiles;
+	delete[] _height_buffer;
+}
+
+int TerrainDatabase::init(const char *directory, unsigned cache_tiles)
+{
+	struct stat st;
+
+	if (_tiles != nullptr || cache_tiles == 0 || stat(directory, &st) != 0 || !S_ISDIR(st.st_mode)) {
+		return -1;
+	}
+
+	_directory = strdup(directory);
+	_tiles = new Tile[cache_tiles];
+
+	if (_directory == nullptr || _tiles == nullptr) {
+		free(_directory);
+		_directory = nullptr;
+		delete[] _tiles;
+		_tiles = nullptr;
+		return -1;
+	}
+
+	_num_tiles = cache_tiles;
+
+	for (unsigned i = 0; i < _num_tiles; i++) {
+		_tiles[i].key = KEY_INVALID;
+		_tiles[i].last_used = 0;
+		_tiles[i].heights = nullptr;
+	}
+
+	return 0;
+}
+
+bool TerrainDatabase::file_missing(uint32_t square) const
+{
+	for (unsigned i = 0; i < MAX_MISSING_FILES; i++) {
+		if (_missing_files[i] == square) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int TerrainDatabase::open_file(int lat_deg, int lon_deg)
+{
+	const uint32_t square = square_of(lat_deg, lon_deg);
+
+	if (_fd >= 0 && _fd_square == square) {
+		return _fd;
+	}
+
+	if (file_missing(square)) {
+		return -1;
+	}
+
+	if (_fd >= 0) {
+		close(_fd);
+		_fd = -1;
+	}
+
+	char path[128];
+	snprintf(path, sizeof(path), "%s/%c%02d%c%03d.dat", _directory, lat_deg < 0 ? 'S' : 'N', abs(lat_deg),
+		 lon_deg < 0 ? 'W' : 'E', abs(lon_deg));
+
+	int fd = open(path, O_RDONLY);
+	struct terrain_file_header_s header;
+
+	if (fd >= 0 && ::read(fd, &header, sizeof(header)) == (ssize_t)sizeof(header)
+	    && header.magic == TERRAIN_FILE_MAGIC && header.version == TERRAIN_FILE_VERSION
+	    && header.lat_deg == lat_deg && header.lon_deg == lon_deg
+	    && header.tile_size > 0 && header.tile_size <= 64
+	    && header.tiles_per_side > 0 && header.tiles_per_side <= MAX_TILES_PER_SIDE
+	    && header.tile_size * header.tiles_per_side >= header.samples_per_degree) {
+
+		if (_tile_size == 0) {
+			/* the first file defines the layout of the whole database */
+			const unsigned tile_heights = (header.tile_size + 1) * (header.tile_size + 1);
+			_height_buffer = new int16_t[(_num_tiles + 1) * tile_heights];
+
+			if (_height_buffer != nullptr) {
+				px4_sem_wait(&_lock);
+
+				for (unsigned i = 0; i < _num_tiles; i++) {
+					_tiles[i].heights = &_height_buffer[i * tile_heights];
+				}
+
+				_staging = &_height_buffer[_num_tiles * tile_heights];
+				_tile_size = header.tile_size;
+				_tiles_per_side = header.tiles_per_side;
+				_samples_per_degree = header.samples_per_degree;
+
+				px4_sem_post(&_lock);
+			}
+		}
+
+		if (header.tile_size == _tile_size && header.tiles_per_side == _tiles_per_side
+		    && header.samples_per_degree == _samples_per_degree) {
+			_fd = fd;
+			_fd_square = square;
+			return _fd;
+		}
+
+		PX4_WARN("terrain: %s does not match the database layout", path);
+	}
+
+	if (fd >= 0) {
+		close(fd);
+	}
+
+	/* remember, so flying over an area without data does not hit the storage on every query */
+	_missing_files[_missing_next] = square;
+	_missing_next = (_missing_next + 1) % MAX_MISSING_FILES;
+	return -1;
+}
+
+bool TerrainDatabase::degree_square(double lat, double lon, int &lat_deg, int &lon_deg)
+{
+	if (!(lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0)) {
+		return false;
+	}
+
+	lat_deg = (int)floor(lat);
+	lon_deg = (int)floor(lon);
+
+	if (lat_deg > 89) {
+		lat_deg = 89;
+	}
+
+	if (lon_deg > 179) {
+		lon_deg = 179;
+	}
+
+	return true;
+}
+
+bool TerrainDatabase::locate(double lat, double lon, uint32_t &key, float &row, float &col)
+{
+	int lat_deg;
+	int lon_deg;
+
+	/* the layout is only known after a load has read the first file */
+	if (_tile_size == 0 || !degree_square(lat, lon, lat_deg, lon_deg)) {
+		return false;
+	}
+
+	/* position in samples within the degree square */
+	const float row_square = (float)((lat - lat_deg) * _samples_per_degree);
+	const float col_square = (float)((lon - lon_deg) * _samples_per_degree);
+	unsigned tile_row = (unsigned)row_square / _tile_size;
+	unsigned tile_col = (unsigned)col_square / _tile_size;
+
+	if (tile_row >= _tiles_per_side) {
+		tile_row = _tiles_per_side - 1;
+	}
+
+	if (tile_col >= _tiles_per_side) {
+		tile_col = _tiles_per_side - 1;
+	}
+
+	key = (square_of(lat_deg, lon_deg) << 14) | (tile_row << 7) | tile_col;
+	row = row_square - tile_row * _tile_size;
+	col = col_square - tile_col * _tile_size;
+	return true;
+}
+
+TerrainDatabase::Tile *TerrainDatabase::find_tile(uint32_t key)
+{
+	if (_tiles[_last_tile].key == key) {
+		return &_tiles[_last_tile];
+	}
+
+	for (unsigned i = 0; i < _num_tiles; i++) {
+		if (_tiles[i].key == key) {
+			_last_tile = i;
+			return &_tiles[i];
+		}
+	}
+
+	return nullptr;
+}
+
+bool TerrainDatabase::load_tile(uint32_t key)
+{
+	const uint32_t square = key >> 14;
+	const int lat_deg = (int)(square / 360) - 90;
+	const int lon_deg = (int)(square % 360) - 180;
+	const unsigned tile_row = (key >> 7) & 0x7f;
+	const unsigned tile_col = key & 0x7f;
+
+	const int fd = open_file(lat_deg, lon_deg);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	const size_t tile_bytes = (_tile_size + 1) * (_tile_size + 1) * sizeof(int16_t);
+	const off_t offset = sizeof(struct terrain_file_header_s) + (tile_row * _tiles_per_side + tile_col) * tile_bytes;
+
+	/* read without holding _lock, lookups continue from the cache meanwhile */
+	const bool ok = lseek(fd, offset, SEEK_SET) == offset && ::read(fd, _staging, tile_bytes) == (ssize_t)tile_bytes;
+
+	px4_sem_wait(&_lock);
+
+	if (ok) {
+		/* replace the least recently used tile */
+		unsigned oldest = 0;
+
+		for (unsigned i = 1; i < _num_tiles; i++) {
+			if (_tiles[i].key == KEY_INVALID
+			    || (_tiles[oldest].key != KEY_INVALID && _tiles[i].last_used < _tiles[oldest].last_used)) {
+				oldest = i;
+			}
+		}
+
+		Tile &tile = _tiles[oldest];
+		memcpy(tile.heights, _staging, tile_bytes);
+		tile.key = key;
+		tile.last_used = _queries;
+		_last_tile = oldest;
+		_loads++;
+
+	} else {
+		_load_failures++;
+	}
+
+	px4_sem_post(&_lock);
+	return ok;
+}
+
+bool TerrainDatabase::interpolate(double lat, double lon, float &height_amsl, bool &cached)
+{
+	uint32_t key;
+	float row, col;
+	Tile *tile;
+
+	cached = false;
+
+	if (!locate(lat, lon, key, row, col) || (tile = find_tile(key)) == nullptr) {
+		return false;
+	}
+
+	cached = true;
+	tile->last_used = _queries;
+
+	/* bilinear interpolation in the cell, the last row and column belong to the cell before them */
+	unsigned i = (unsigned)row;
+	unsigned j = (unsigned)col;
+
+	if (i >= _tile_size) {
+		i = _tile_size - 1;
+	}
+
+	if (j >= _tile_size) {
+		j = _tile_size - 1;
+	}
+
+	const float u = row - i;
+	const float v = col - j;
+	const unsigned stride = _tile_size + 1;
+	const int16_t *sw = &tile->heights[i * stride + j];
+	const int16_t *nw = sw + stride;
+
+	if (sw[0] == HEIGHT_INVALID || sw[1] == HEIGHT_INVALID || nw[0] == HEIGHT_INVALID || nw[1] == HEIGHT_INVALID) {
+		return false;
+	}
+
+	const float height_s = sw[0] + v * (sw[1] - sw[0]);
+	const float height_n = nw[0] + v * (nw[1] - nw[0]);
+	height_amsl = height_s + u * (height_n - height_s);
+	return true;
+}
+
+bool TerrainDatabase::height(double lat, double lon, float &height_amsl, bool load)
+{
+	if (_tiles == nullptr) {
+		return false;
+	}
+
+	bool cached;
+
+	px4_sem_wait(&_lock);
+	_queries++;
+	bool valid = interpolate(lat, lon, height_amsl, cached);
+	_hits += cached;
+	px4_sem_post(&_lock);
+
+	if (cached || !load) {
+		return valid;
+	}
+
+	prefetch(lat, lon, lat, lon);
+
+	px4_sem_wait(&_lock);
+	valid = interpolate(lat, lon, height_amsl, cached);
+	px4_sem_post(&_lock);
+
+	return valid;
+}
+
+unsigned TerrainDatabase::prefetch(double lat0, double lon0, double lat1, double lon1)
+{
+	int lat_deg;
+	int lon_deg;
+
+	if (_tiles == nullptr || !degree_square(lat0, lon0, lat_deg, lon_deg)) {
+		return 0;
+	}
+
+	px4_sem_wait(&_load_lock);
+
+	/* reads the first file header if needed */
+	if (_tile_size == 0 && open_file(lat_deg, lon_deg) < 0) {
+		px4_sem_post(&_load_lock);
+		return 0;
+	}
+
+	/* step by half a tile so no tile along the path is skipped */
+	const double step = 0.5 * _tile_size / _samples_per_degree;
+	const double length = fmax(fabs(lat1 - lat0), fabs(lon1 - lon0));
+	const unsigned num_steps = (unsigned)(length / step) + 1;
+	const unsigned max_tiles = (_num_tiles + 1) / 2;
+	unsigned num_loads = 0;
+	uint32_t key_last = KEY_INVALID;
+	unsigned tiles_used = 0;
+
+	/* the tiles closest to the start of the path are needed first, stop before they get evicted */
+	for (unsigned k = 0; k <= num_steps && tiles_used < max_tiles; k++) {
+		const double t = (double)k / num_steps;
+		uint32_t key;
+		float row, col;
+
+		if (locate(lat0 + t * (lat1 - lat0), lon0 + t * (lon1 - lon0), key, row, col) && key != key_last) {
+			key_last = key;
+			tiles_used++;
+
+			px4_sem_wait(&_lock);
+			Tile *tile = find_tile(key);
+
+			if (tile != nullptr) {
+				/* mark as used, so loading the rest of the path does not evict it */
+				tile->last_used = _queries;
+			}
+
+			px4_sem_post(&_lock);
+
+			if (tile == nullptr && load_tile(key)) {
+				num_loads++;
+			}
+		}
+	}
+
+	px4_sem_post(&_load_lock);
+	return num_loads;
+}
+
+void TerrainDatabase::request(double lat0, double lon0, double lat1, double lon1)
+{
+	if (_tiles == nullptr) {
+		return;
+	}
+
+	px4_sem_wait(&_lock);
+
+	const bool idle = _num_requests == 0;
+
+	if (_num_requests < MAX_REQUESTS) {
+		_num_requests++;
+	}
+
+	_requests[_num_requests - 1] = { lat0, lon0, lat1, lon1 };
+
+	px4_sem_post(&_lock);
+
+	if (idle) {
+		work_queue(LPWORK, &_work, (worker_t)&TerrainDatabase::load_trampoline, this, 0);
+	}
+}
+
+void TerrainDatabase::load_trampoline(void *arg)
+{
+	TerrainDatabase *dev = reinterpret_cast<TerrainDatabase *>(arg);
+
+	dev->load_requests();
+}
+
+void TerrainDatabase::load_requests()
+{
+	Path requests[MAX_REQUESTS];
+
+	px4_sem_wait(&_lock);
+	const unsigned num_requests = _num_requests;
+	memcpy(requests, _requests, num_requests * sizeof(requests[0]));
+	_num_requests = 0;
+	px4_sem_post(&_lock);
+
+	for (unsigned i = 0; i < num_requests; i++) {
+		prefetch(requests[i].lat0, requests[i].lon0, requests[i].lat1, requests[i].lon1);
+	}
+}
+
+bool TerrainDatabase::max_height_on_path(double lat0, double lon0, double lat1, double lon1, float &height_max,
+		bool load)
+{
+	float height_sample;
+
+	if (!height(lat0, lon0, height_sample, load)) {
+		if (!load) {
+			request(lat0, lon0, lat1, lon1);
+		}
+
+		return false;
+	}
+
+	/* sample at the DEM resolution */
+	const double step = 1.0 / _samples_per_degree;
+	const double length = fmax(fabs(lat1 - lat0), fabs(lon1 - lon0));
+	const unsigned num_steps = (unsigned)(length / step) + 1;
+
+	height_max = height_sample;
+
+	for (unsigned k = 1; k <= num_steps; k++) {
+		const double t = (double)k / num_steps;
+
+		if (!height(lat0 + t * (lat1 - lat0), lon0 + t * (lon1 - lon0), height_sample, load)) {
+			if (!load) {
+				request(lat0 + t * (lat1 - lat0), lon0 + t * (lon1 - lon0), lat1, lon1);
+			}
+
+			return false;
+		}
+
+		height_max = fmaxf(height_max, height_sample);
+	}
+
+	return true;
+}
+
+void TerrainDatabase::print_status()
+{
+	if (_tiles == nullptr) {
+		PX4_INFO("terrain: no data");
+		return;
+	}
+
+	unsigned used = 0;
+
+	px4_sem_wait(&_lock);
+
+	for (unsigned i = 0; i < _num_tiles; i++) {
+		used += _tiles[i].key != KEY_INVALID;
+	}
+
+	px4_sem_post(&_lock);
+
+	PX4_INFO("terrain: %s, %u of %u tiles cached, %u queries, %.1f%% hits, %u loads, %u failed",
+		 _directory, used, _num_tiles, _queries, _queries > 0 ? 100.0 * _hits / _queries : 0.0,
+		 _loads, _load_failures);
+}
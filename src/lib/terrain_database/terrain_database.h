@@ -0,0 +1,199 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file terrain_database.h
+ *
+ * Terrain height lookup from offline DEM tiles with a fixed size LRU cache.
+ *
+ * The terrain directory holds one file per 1x1 degree square, named like the
+ * SRTM files (e.g. N47E008.dat) and generated by Tools/generate_terrain_tiles.py.
+ * A file is split into square tiles of tile_size x tile_size cells, each tile
+ * stores (tile_size + 1)^2 heights so that interpolation never needs a
+ * neighbouring tile. Tiles are read individually on demand.
+ *
+ * Reading a tile blocks on the storage for milliseconds. Control loops only
+ * do non blocking lookups and hand tile loading to the low priority work
+ * queue with request(), the blocking variants are meant for tools and tests.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <px4_sem.h>
+#include <px4_workqueue.h>
+
+class __EXPORT TerrainDatabase
+{
+public:
+	TerrainDatabase();
+	~TerrainDatabase();
+
+	TerrainDatabase(const TerrainDatabase &) = delete;
+	TerrainDatabase &operator=(const TerrainDatabase &) = delete;
+
+#if defined(__PX4_NUTTX)
+	static constexpr unsigned DEFAULT_CACHE_TILES = 8;
+#else
+	static constexpr unsigned DEFAULT_CACHE_TILES = 64;
+#endif
+
+	static constexpr int16_t HEIGHT_INVALID = -32768;	/**< no data, e.g. SRTM voids */
+
+	/**
+	 * Use the tiles in a directory. The cache is allocated only if the
+	 * directory exists, without data the database costs no memory.
+	 * @param directory terrain directory
+	 * @param cache_tiles number of tiles kept in RAM
+	 * @return 0 on success, -1 if the directory is missing or out of memory
+	 */
+	int init(const char *directory, unsigned cache_tiles = DEFAULT_CACHE_TILES);
+
+	/**
+	 * @return true if init() succeeded
+	 */
+	bool enabled() const { return _tiles != nullptr; }
+
+	/**
+	 * Terrain height by bilinear interpolation.
+	 * @param lat latitude in degrees
+	 * @param lon longitude in degrees
+	 * @param height_amsl terrain height in meters AMSL
+	 * @param load read the tile from storage in the calling thread if it is
+	 *        not cached, otherwise the lookup never blocks and fails on a cache miss
+	 * @return true if there is terrain data for this position
+	 */
+	bool height(double lat, double lon, float &height_amsl, bool load = true);
+
+	/**
+	 * Load the tiles along a path into the cache, starting at its beginning.
+	 * At most half the cache is used so tiles needed right now are not pushed out.
+	 * Blocks on the storage, see request().
+	 * @return number of tiles read from storage
+	 */
+	unsigned prefetch(double lat0, double lon0, double lat1, double lon1);
+
+	/**
+	 * Like prefetch(), but the tiles are loaded on the low priority work queue
+	 * and the call returns immediately. If more than MAX_REQUESTS paths are
+	 * waiting, the newest one replaces the last waiting one.
+	 */
+	void request(double lat0, double lon0, double lat1, double lon1);
+
+	/**
+	 * Highest terrain along a path, sampled at the DEM resolution.
+	 * @param height_max highest terrain height in meters AMSL
+	 * @param load see height(), without it a path that is not fully cached is
+	 *        passed to request() so a later call can answer
+	 * @return true if terrain data covers the whole path
+	 */
+	bool max_height_on_path(double lat0, double lon0, double lat1, double lon1, float &height_max,
+				bool load = true);
+
+	/**
+	 * Print cache statistics.
+	 */
+	void print_status();
+
+	uint32_t queries() const { return _queries; }
+	uint32_t hits() const { return _hits; }
+	uint32_t loads() const { return _loads; }
+
+private:
+	struct Tile {
+		uint32_t key;		/**< degree square and tile within it, KEY_INVALID if unused */
+		uint32_t last_used;	/**< _queries at the last access, for LRU replacement */
+		int16_t *heights;	/**< (tile_size + 1)^2 heights, row major from the south west */
+	};
+
+	struct Path {
+		double lat0;
+		double lon0;
+		double lat1;
+		double lon1;
+	};
+
+	static constexpr uint32_t KEY_INVALID = 0xffffffff;
+	static constexpr unsigned MAX_TILES_PER_SIDE = 128;
+	static constexpr unsigned MAX_MISSING_FILES = 8;
+	static constexpr unsigned MAX_REQUESTS = 4;
+
+	bool locate(double lat, double lon, uint32_t &key, float &row, float &col);
+	bool interpolate(double lat, double lon, float &height_amsl, bool &cached);
+	Tile *find_tile(uint32_t key);
+	bool load_tile(uint32_t key);
+	int open_file(int lat_deg, int lon_deg);
+	bool file_missing(uint32_t square) const;
+	void load_requests();
+
+	static void load_trampoline(void *arg);
+	static bool degree_square(double lat, double lon, int &lat_deg, int &lon_deg);
+	static uint32_t square_of(int lat_deg, int lon_deg) { return (lat_deg + 90) * 360 + (lon_deg + 180); }
+
+	char *_directory;
+
+	/*
+	 * _lock protects the cached tiles, the statistics and the requests and is
+	 * only held for lookups in memory. _load_lock serializes the storage access
+	 * and the staging buffer, tiles are read without holding _lock. The layout
+	 * is set once under both locks.
+	 */
+	px4_sem_t _lock;
+	px4_sem_t _load_lock;
+	struct work_s _work;
+
+	Path _requests[MAX_REQUESTS];
+	unsigned _num_requests;
+
+	Tile *_tiles;
+	unsigned _num_tiles;
+	int16_t *_height_buffer;	/**< heights of all cached tiles, followed by the staging tile */
+	int16_t *_staging;		/**< tile being read from storage */
+	unsigned _last_tile;		/**< tile of the last query, checked first */
+
+	unsigned _tile_size;		/**< cells per tile side, 0 until the first file has been read */
+	unsigned _tiles_per_side;
+	unsigned _samples_per_degree;
+
+	int _fd;			/**< file of _fd_square, -1 if none is open */
+	uint32_t _fd_square;
+	uint32_t _missing_files[MAX_MISSING_FILES];
+	unsigned _missing_next;
+
+	uint32_t _queries;
+	uint32_t _hits;
+	uint32_t _loads;
+	uint32_t _load_failures;
+};
@@ -40,12 +40,15 @@
 #include <geo/geo.h>
 
 #define DISTANCE_TIMEOUT 100000		// time in usec after which laser is considered dead
+#define GPS_TIMEOUT 500000		// time in usec after which a terrain database estimate is considered stale
 
 TerrainEstimator::TerrainEstimator() :
 	_distance_last(0.0f),
 	_terrain_valid(false),
+	_terrain_dem_valid(false),
 	_time_last_distance(0),
-	_time_last_gps(0)
+	_time_last_gps(0),
+	_terrain(nullptr)
 {
 	memset(&_x._data[0], 0, sizeof(_x._data));
 	_u_z = 0.0f;
@@ -169,9 +172,17 @@ void TerrainEstimator::measurement_update(uint64_t time_ref, const struct vehicl
 		_x += K * r;
 		_P -= K * C * _P;
 
+		// without a usable range measurement fall back to the terrain database,
+		// the result holds until the next GPS sample
+		_terrain_dem_valid = !_terrain_valid && _terrain != nullptr && terrain_update(gps);
+
 		_time_last_gps = gps->timestamp;
 	}
 
+	if (time_ref > _time_last_gps + GPS_TIMEOUT) {
+		_terrain_dem_valid = false;
+	}
+
 	// reinitialise filter if we find bad data
 	bool reinit = false;
 
@@ -196,3 +207,37 @@ void TerrainEstimator::measurement_update(uint64_t time_ref, const struct vehicl
 	}
 
 }
+
+bool TerrainEstimator::terrain_update(const struct vehicle_gps_position_s *gps)
+{
+	const double lat = gps->lat * 1e-7;
+	const double lon = gps->lon * 1e-7;
+	float terrain_alt;
+
+	// only cached tiles are used here, a missing tile is loaded on the work queue
+	// so that the estimator loop never blocks on file access
+	if (!_terrain->height(lat, lon, terrain_alt, false)) {
+		_terrain->request(lat, lon, lat, lon);
+		return false;
+	}
+
+	matrix::Matrix<float, 1, n_x> C;
+	C(0, 0) = -1; // measured altitude,
+
+	// DEM and GPS altitude errors are in the order of several meters
+	float R = 25.0f;
+
+	matrix::Vector<float, 1> y;
+	y(0) = gps->alt * 1e-3f - terrain_alt;
+
+	matrix::Matrix<float, 1, 1> S_I = (C * _P * C.transpose());
+	S_I(0, 0) += R;
+	S_I = matrix::inv<float, 1>(S_I);
+	matrix::Vector<float, 1> r = y - C * _x;
+
+	matrix::Matrix<float, n_x, 1> K = _P * C.transpose() * S_I;
+	_x += K * r;
+	_P -= K * C * _P;
+
+	return true;
+}
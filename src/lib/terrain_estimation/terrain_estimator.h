@@ -41,6 +41,7 @@
 #include <uORB/topics/vehicle_gps_position.h>
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/distance_sensor.h>
+#include <terrain_database/terrain_database.h>
 
 
 /*
@@ -51,6 +52,8 @@
 * The measurement_update(...) function does a measurement update based on range finder and gps
 * velocity measurements. Both functions should always be called together when there is new
 * acceleration data available.
+* If a terrain database is set, the GPS altitude above the terrain height from the database
+* is used as a coarse ground distance measurement while the range finder is out of range.
 * The is_valid() function provides information whether the estimate is valid.
 */
 
@@ -60,7 +63,7 @@ public:
 	TerrainEstimator();
 	~TerrainEstimator() {};
 
-	bool is_valid() {return _terrain_valid;}
+	bool is_valid() {return _terrain_valid || _terrain_dem_valid;}
 	float get_distance_to_ground() {return -_x(0);}
 	float get_velocity() {return _x(1);};
 
@@ -70,11 +73,18 @@ public:
 				const struct distance_sensor_s *distance,
 				const struct vehicle_attitude_s *attitude);
 
+	/**
+	 * Use terrain heights from a database while there is no valid range measurement.
+	 * @param terrain database, nullptr to disable
+	 */
+	void set_terrain_database(TerrainDatabase *terrain) { _terrain = terrain; }
+
 private:
 	enum {n_x = 3};
 
 	float _distance_last;
-	bool _terrain_valid;
+	bool _terrain_valid;		// estimate backed by the range finder
+	bool _terrain_dem_valid;	// estimate backed by the terrain database and GPS altitude
 
 	// kalman filter variables
 	matrix::Vector<float, n_x> _x;		// state: ground distance, velocity, accel bias in z direction
@@ -85,6 +95,8 @@ private:
 	uint64_t _time_last_distance;
 	uint64_t _time_last_gps;
 
+	TerrainDatabase *_terrain;
+
 	/*
 	struct {
 		float var_acc_z;
@@ -96,5 +108,6 @@ private:
 	*/
 
 	bool is_distance_valid(float distance);
+	bool terrain_update(const struct vehicle_gps_position_s *gps);
 
 };
\ No newline at end of file
@@ -71,6 +71,7 @@
 #include <systemlib/systemlib.h>
 #include <systemlib/param/param.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/latency_trace.h>
 #include <systemlib/err.h>
 #include <systemlib/mavlink_log.h>
 
@@ -258,6 +259,9 @@ int AttitudeEstimatorQ::start()
 {
 	ASSERT(_control_task == -1);
 
+	/* pick up the mag grid file here, the estimator loop must not block on the SD card */
+	geo_mag_grid_init();
+
 	/* start the task */
 	_control_task = px4_task_spawn_cmd("attitude_estimator_q",
 					   SCHED_DEFAULT,
@@ -467,6 +471,8 @@ void AttitudeEstimatorQ::task_main()
 
 		struct vehicle_attitude_s att = {};
 		att.timestamp = sensors.timestamp;
+		att.timestamp_sample = sensors.timestamp;
+		att.trace_id = sensors.trace_id;
 
 		att.rollspeed = _rates(0);
 		att.pitchspeed = _rates(1);
@@ -482,6 +488,8 @@ void AttitudeEstimatorQ::task_main()
 			struct control_state_s ctrl_state = {};
 
 			ctrl_state.timestamp = sensors.timestamp;
+			ctrl_state.timestamp_sample = sensors.timestamp;
+			ctrl_state.trace_id = sensors.trace_id;
 
 			/* attitude quaternions for control state */
 			ctrl_state.q[0] = _q(0);
@@ -527,6 +535,8 @@ void AttitudeEstimatorQ::task_main()
 			int ctrl_inst;
 			/* publish to control state topic */
 			orb_publish_auto(ORB_ID(control_state), &_ctrl_state_pub, &ctrl_state, &ctrl_inst, ORB_PRIO_HIGH);
+
+			latency_trace_hop(latency_trace_s::HOP_ESTIMATOR, sensors.trace_id);
 		}
 
 		{
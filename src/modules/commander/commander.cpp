@@ -1173,6 +1173,7 @@ bool handle_command(struct vehicle_status_s *status_local, const struct safety_s
 	case vehicle_command_s::VEHICLE_CMD_START_RX_PAIR:
 	case vehicle_command_s::VEHICLE_CMD_LOGGING_START:
 	case vehicle_command_s::VEHICLE_CMD_LOGGING_STOP:
+	case vehicle_command_s::VEHICLE_CMD_MISSION_STORAGE:
 		/* ignore commands that handled in low prio loop */
 		break;
 
@@ -1457,7 +1458,7 @@ int commander_thread_main(int argc, char *argv[])
 	orb_advert_t commander_state_pub = nullptr;
 
 	if (dm_read(DM_KEY_MISSION_STATE, 0, &mission, sizeof(mission_s)) == sizeof(mission_s)) {
-		if (mission.dataman_id >= 0 && mission.dataman_id <= 1) {
+		if (DM_OFFBOARD_ID_VALID(mission.dataman_id)) {
 			if (mission.count > 0) {
 				mavlink_log_info(&mavlink_log_pub, "[cmd] Mission #%d loaded, %u WPs, curr: %d",
 						 mission.dataman_id, mission.count, mission.current_seq);
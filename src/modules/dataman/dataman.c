@@ -49,6 +49,7 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/err.h>
 #include <queue.h>
@@ -56,6 +57,13 @@
 #include <semaphore.h>
 #include <unistd.h>
 #include <platforms/px4_getopt.h>
+#include <drivers/drv_hrt.h>
+
+#if defined(__PX4_LINUX) || defined(__PX4_DARWIN)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define DM_MMAP_BACKEND
+#endif
 
 #include "dataman.h"
 #include <systemlib/param/param.h>
@@ -89,11 +97,22 @@ static ssize_t _ram_read(dm_item_t item, unsigned char index, void *buf, size_t
 static int  _ram_clear(dm_item_t item);
 static int  _ram_restart(dm_reset_reason reason);
 
+#ifdef DM_MMAP_BACKEND
+/* Private memory mapped file Operations, reads are served by _ram_read */
+static ssize_t _mmap_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf,
+			   size_t count);
+static int  _mmap_clear(dm_item_t item);
+static int  _mmap_restart(dm_reset_reason reason);
+static int  _mmap_sync(void);
+#endif
+
 typedef struct dm_operations_t {
 	ssize_t (*write)(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count);
 	ssize_t (*read)(dm_item_t item, unsigned char index, void *buf, size_t count);
 	int (*clear)(dm_item_t item);
 	int (*restart)(dm_reset_reason reason);
+	int (*sync)(void);	/**< flush coalesced writes to storage, NULL if writes are synchronous */
+	bool direct;		/**< operations on different item types may run concurrently in the caller's context */
 } dm_operations_t;
 
 static dm_operations_t dm_file_operations = {
@@ -101,6 +120,7 @@ static dm_operations_t dm_file_operations = {
 	.read    = _file_read,
 	.clear   = _file_clear,
 	.restart = _file_restart,
+	.direct  = false,
 };
 
 static dm_operations_t dm_ram_operations = {
@@ -108,8 +128,20 @@ static dm_operations_t dm_ram_operations = {
 	.read    = _ram_read,
 	.clear   = _ram_clear,
 	.restart = _ram_restart,
+	.direct  = true,
 };
 
+#ifdef DM_MMAP_BACKEND
+static dm_operations_t dm_mmap_operations = {
+	.write   = _mmap_write,
+	.read    = _ram_read,
+	.clear   = _mmap_clear,
+	.restart = _mmap_restart,
+	.sync    = _mmap_sync,
+	.direct  = true,
+};
+#endif
+
 static dm_operations_t *g_dm_ops = &dm_file_operations;
 
 /** Types of function calls supported by the worker task */
@@ -118,6 +150,7 @@ typedef enum {
 	dm_read_func,
 	dm_clear_func,
 	dm_restart_func,
+	dm_write_items_func,
 	dm_number_of_funcs
 } dm_function_t;
 
@@ -125,6 +158,7 @@ typedef enum {
 typedef struct {
 	sq_entry_t link;	/**< list linkage */
 	px4_sem_t wait_sem;
+	hrt_abstime queued;	/**< time the item was put on the work queue */
 	unsigned char first;
 	unsigned char func;
 	ssize_t result;
@@ -136,6 +170,14 @@ typedef struct {
 			const void *buf;
 			size_t count;
 		} write_params;
+		struct {
+			dm_item_t item;
+			unsigned char index;
+			dm_persitence_t persistence;
+			const void *buf;
+			size_t count;
+			unsigned num;
+		} write_items_params;
 		struct {
 			dm_item_t item;
 			unsigned char index;
@@ -153,8 +195,15 @@ typedef struct {
 
 const size_t k_work_item_allocation_chunk_size = 8;
 
-/* Usage statistics */
-static unsigned g_func_counts[dm_number_of_funcs];
+/* Usage statistics per item type, updated while holding the item type lock or by the worker thread */
+typedef struct {
+	unsigned counts[dm_number_of_funcs];	/**< operations on this item type */
+	hrt_abstime wait_total;			/**< time spent waiting for the work queue or the item lock, us */
+	hrt_abstime wait_max;
+} dm_item_stats_t;
+
+static dm_item_stats_t g_item_stats[DM_KEY_NUM_KEYS];
+static unsigned g_restart_count;
 
 /* table of maximum number of instances for each item type */
 static const unsigned g_per_item_max_index[DM_KEY_NUM_KEYS] = {
@@ -162,8 +211,11 @@ static const unsigned g_per_item_max_index[DM_KEY_NUM_KEYS] = {
 	DM_KEY_FENCE_POINTS_MAX,
 	DM_KEY_WAYPOINTS_OFFBOARD_0_MAX,
 	DM_KEY_WAYPOINTS_OFFBOARD_1_MAX,
+	DM_KEY_WAYPOINTS_OFFBOARD_2_MAX,
+	DM_KEY_WAYPOINTS_OFFBOARD_3_MAX,
 	DM_KEY_WAYPOINTS_ONBOARD_MAX,
 	DM_KEY_MISSION_STATE_MAX,
+	DM_KEY_MISSION_SLOTS_MAX,
 	DM_KEY_COMPAT_MAX
 };
 
@@ -174,6 +226,15 @@ static unsigned int g_key_offsets[DM_KEY_NUM_KEYS];
 static px4_sem_t *g_item_locks[DM_KEY_NUM_KEYS];
 static px4_sem_t g_sys_state_mutex;
 
+/* Reader/writer lock per item type, serializes direct access to the same item type only */
+typedef struct {
+	px4_sem_t mutex;	/**< protects readers */
+	px4_sem_t write;	/**< held by a writer or by the group of active readers */
+	unsigned readers;
+} dm_rwlock_t;
+
+static dm_rwlock_t g_item_rwlocks[DM_KEY_NUM_KEYS];
+
 /* The data manager store file handle and file name */
 static int g_fd = -1;
 static int g_task_fd = -1;
@@ -188,6 +249,18 @@ static uint8_t *g_task_data = NULL;
 static uint8_t *g_task_data_end = NULL;
 static bool g_on_disk = true;
 
+#ifdef DM_MMAP_BACKEND
+/* Memory mapped file state, writes are coalesced and flushed with msync */
+static bool g_use_mmap = true;		/**< false selects seek based file I/O (-s) */
+static size_t g_mmap_size = 0;
+static unsigned g_dirty_start = UINT_MAX;	/**< byte range modified since the last msync */
+static unsigned g_dirty_end = 0;
+static hrt_abstime g_dirty_since = 0;	/**< time of the oldest write not flushed yet */
+static unsigned g_sync_count = 0;
+static px4_sem_t g_dirty_mutex;		/**< protects the dirty range and sync state, writers may run concurrently */
+static const unsigned k_mmap_sync_interval = 500000;	/**< max. time writes stay unflushed, us */
+#endif
+
 /* The data manager work queues */
 
 typedef struct {
@@ -317,6 +390,8 @@ dequeue_work_item(void)
 static int
 enqueue_work_item_and_wait_for_result(work_q_item_t *item)
 {
+	item->queued = hrt_absolute_time();
+
 	/* put the work item at the end of the work queue */
 	lock_queue(&g_work_q);
 	sq_addlast(&item->link, &(g_work_q.q));
@@ -345,6 +420,107 @@ static bool is_running(void)
 {
 	return (g_on_disk ?  g_fd != -1 : g_data != NULL);
 }
+
+/* Account an operation and the time it waited to be served, caller must own the item type */
+static void
+account_wait(dm_item_t item, dm_function_t func, hrt_abstime wait)
+{
+	if (item >= DM_KEY_NUM_KEYS) {
+		return;
+	}
+
+	dm_item_stats_t *stats = &g_item_stats[item];
+	stats->counts[func]++;
+	stats->wait_total += wait;
+
+	if (wait > stats->wait_max) {
+		stats->wait_max = wait;
+	}
+}
+
+/* Item type locks for direct access, readers of one item type share the lock */
+static void
+init_item_locks(void)
+{
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		px4_sem_init(&g_item_rwlocks[i].mutex, 1, 1);
+		px4_sem_init(&g_item_rwlocks[i].write, 1, 1);
+		g_item_rwlocks[i].readers = 0;
+	}
+}
+
+static void
+destroy_item_locks(void)
+{
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		px4_sem_destroy(&g_item_rwlocks[i].mutex);
+		px4_sem_destroy(&g_item_rwlocks[i].write);
+	}
+}
+
+static void
+lock_item_read(dm_item_t item, dm_function_t func)
+{
+	dm_rwlock_t *lock = &g_item_rwlocks[item];
+	hrt_abstime start = hrt_absolute_time();
+
+	px4_sem_wait(&lock->mutex);
+
+	/* The first reader locks out writers for the whole group */
+	if (++lock->readers == 1) {
+		px4_sem_wait(&lock->write);
+	}
+
+	/* No writer can be active now, and other readers are held off by the mutex */
+	account_wait(item, func, hrt_elapsed_time(&start));
+	px4_sem_post(&lock->mutex);
+}
+
+static void
+unlock_item_read(dm_item_t item)
+{
+	dm_rwlock_t *lock = &g_item_rwlocks[item];
+
+	px4_sem_wait(&lock->mutex);
+
+	if (--lock->readers == 0) {
+		px4_sem_post(&lock->write);
+	}
+
+	px4_sem_post(&lock->mutex);
+}
+
+static void
+lock_item_write(dm_item_t item, dm_function_t func)
+{
+	hrt_abstime start = hrt_absolute_time();
+
+	px4_sem_wait(&g_item_rwlocks[item].write);
+	account_wait(item, func, hrt_elapsed_time(&start));
+}
+
+static void
+unlock_item_write(dm_item_t item)
+{
+	px4_sem_post(&g_item_rwlocks[item].write);
+}
+
+/* Exclusive access to all item types, always taken in the same order */
+static void
+lock_all_items(void)
+{
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		px4_sem_wait(&g_item_rwlocks[i].write);
+	}
+}
+
+static void
+unlock_all_items(void)
+{
+	for (unsigned i = DM_KEY_NUM_KEYS; i > 0; i--) {
+		px4_sem_post(&g_item_rwlocks[i - 1].write);
+	}
+}
 /* Calculate the offset in file of specific item */
 static int
 calculate_offset(dm_item_t item, unsigned char index)
@@ -749,6 +925,122 @@ _file_restart(dm_reset_reason reason)
 	return result;
 }
 
+#ifdef DM_MMAP_BACKEND
+/* Remember a modified byte range of the mapping for the next msync */
+static void
+_mmap_mark_dirty(unsigned offset, unsigned len)
+{
+	px4_sem_wait(&g_dirty_mutex);
+
+	bool was_clean = g_dirty_end <= g_dirty_start;
+
+	if (was_clean) {
+		g_dirty_since = hrt_absolute_time();
+	}
+
+	if (offset < g_dirty_start) {
+		g_dirty_start = offset;
+	}
+
+	if (offset + len > g_dirty_end) {
+		g_dirty_end = offset + len;
+	}
+
+	px4_sem_post(&g_dirty_mutex);
+
+	/* Writes done in the caller's context must wake the worker to arm the sync timer */
+	if (was_clean) {
+		px4_sem_post(&g_work_queued_sema);
+	}
+}
+
+/* true if the mapping has writes that are not flushed yet, wait_us is the time until they are due */
+static bool
+_mmap_pending(unsigned *wait_us)
+{
+	px4_sem_wait(&g_dirty_mutex);
+	bool pending = g_dirty_end > g_dirty_start;
+	hrt_abstime elapsed = hrt_elapsed_time(&g_dirty_since);
+	px4_sem_post(&g_dirty_mutex);
+
+	*wait_us = elapsed < k_mmap_sync_interval ? k_mmap_sync_interval - elapsed : 0;
+	return pending;
+}
+
+/* true if the oldest unflushed write has waited for the sync interval */
+static bool
+_mmap_sync_due(void)
+{
+	px4_sem_wait(&g_dirty_mutex);
+	bool due = g_dirty_end > g_dirty_start && hrt_elapsed_time(&g_dirty_since) >= k_mmap_sync_interval;
+	px4_sem_post(&g_dirty_mutex);
+	return due;
+}
+
+/* Flush the modified part of the mapping to the data manager file */
+static int
+_mmap_sync(void)
+{
+	px4_sem_wait(&g_dirty_mutex);
+
+	if (g_dirty_end <= g_dirty_start) {
+		px4_sem_post(&g_dirty_mutex);
+		return 0;
+	}
+
+	/* msync needs a page aligned start address */
+	const unsigned page_size = sysconf(_SC_PAGESIZE);
+	unsigned start = g_dirty_start - (g_dirty_start % page_size);
+	unsigned end = g_dirty_end;
+
+	g_dirty_start = UINT_MAX;
+	g_dirty_end = 0;
+	g_sync_count++;
+
+	px4_sem_post(&g_dirty_mutex);
+
+	/* Writes landing in the range meanwhile are marked dirty again and flushed by the next sync */
+	return msync(&g_task_data[start], end - start, MS_SYNC);
+}
+
+/* write to the mapping, the file is updated by the next _mmap_sync() */
+static ssize_t
+_mmap_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
+{
+	ssize_t ret = _ram_write(item, index, persistence, buf, count);
+
+	if (ret >= 0) {
+		_mmap_mark_dirty(calculate_offset(item, index), DM_SECTOR_HDR_SIZE + count);
+	}
+
+	return ret;
+}
+
+static int
+_mmap_clear(dm_item_t item)
+{
+	int result = _ram_clear(item);
+
+	if (item < DM_KEY_NUM_KEYS) {
+		_mmap_mark_dirty(g_key_offsets[item], g_per_item_max_index[item] * k_sector_size);
+	}
+
+	/* Like the file backend, make sure bulk changes are on physical media when we return */
+	_mmap_sync();
+	return result;
+}
+
+static int
+_mmap_restart(dm_reset_reason reason)
+{
+	int result = _ram_restart(reason);
+
+	_mmap_mark_dirty(0, g_mmap_size);
+	_mmap_sync();
+	return result;
+}
+#endif
+
 /** Write to the data manager file */
 __EXPORT ssize_t
 dm_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count)
@@ -760,6 +1052,23 @@ dm_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const
 		return -1;
 	}
 
+	/* Fast backends are called directly, only writers of the same item type are serialized */
+	if (g_dm_ops->direct) {
+		if (item >= DM_KEY_NUM_KEYS) {
+			return -1;
+		}
+
+		ssize_t result = -1;
+		lock_item_write(item, dm_write_func);
+
+		if (is_running() && !g_task_should_exit) {
+			result = g_dm_ops->write(item, index, persistence, buf, count);
+		}
+
+		unlock_item_write(item);
+		return result;
+	}
+
 	/* get a work item and queue up a write request */
 	if ((work = create_work_item()) == NULL) {
 		return -1;
@@ -776,6 +1085,70 @@ dm_write(dm_item_t item, unsigned char index, dm_persitence_t persistence, const
 	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
 }
 
+/* Write consecutive items one by one, stops at the first failure */
+static ssize_t
+_write_items(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count,
+	     unsigned num)
+{
+	const uint8_t *data = (const uint8_t *)buf;
+	unsigned i;
+
+	for (i = 0; i < num; i++) {
+		if (index + i > UCHAR_MAX ||
+		    g_dm_ops->write(item, index + i, persistence, data + i * count, count) != (ssize_t)count) {
+			break;
+		}
+	}
+
+	/* Only fail outright if nothing could be written */
+	return (i == 0 && num > 0) ? -1 : (ssize_t)i;
+}
+
+/** Write a run of items with a single request */
+__EXPORT ssize_t
+dm_write_items(dm_item_t item, unsigned char index, dm_persitence_t persistence, const void *buf, size_t count,
+	       unsigned num)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	if (g_dm_ops->direct) {
+		if (item >= DM_KEY_NUM_KEYS) {
+			return -1;
+		}
+
+		ssize_t result = -1;
+		lock_item_write(item, dm_write_items_func);
+
+		if (is_running() && !g_task_should_exit) {
+			result = _write_items(item, index, persistence, buf, count, num);
+		}
+
+		unlock_item_write(item);
+		return result;
+	}
+
+	/* get a work item and queue up a write request for all items */
+	if ((work = create_work_item()) == NULL) {
+		return -1;
+	}
+
+	work->func = dm_write_items_func;
+	work->write_items_params.item = item;
+	work->write_items_params.index = index;
+	work->write_items_params.persistence = persistence;
+	work->write_items_params.buf = buf;
+	work->write_items_params.count = count;
+	work->write_items_params.num = num;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+}
+
 /** Retrieve from the data manager file */
 __EXPORT ssize_t
 dm_read(dm_item_t item, unsigned char index, void *buf, size_t count)
@@ -787,6 +1160,23 @@ dm_read(dm_item_t item, unsigned char index, void *buf, size_t count)
 		return -1;
 	}
 
+	/* Fast backends are called directly, readers only wait for writers of the same item type */
+	if (g_dm_ops->direct) {
+		if (item >= DM_KEY_NUM_KEYS) {
+			return -1;
+		}
+
+		ssize_t result = -1;
+		lock_item_read(item, dm_read_func);
+
+		if (is_running() && !g_task_should_exit) {
+			result = g_dm_ops->read(item, index, buf, count);
+		}
+
+		unlock_item_read(item);
+		return result;
+	}
+
 	/* get a work item and queue up a read request */
 	if ((work = create_work_item()) == NULL) {
 		return -1;
@@ -813,6 +1203,22 @@ dm_clear(dm_item_t item)
 		return -1;
 	}
 
+	if (g_dm_ops->direct) {
+		if (item >= DM_KEY_NUM_KEYS) {
+			return -1;
+		}
+
+		int result = -1;
+		lock_item_write(item, dm_clear_func);
+
+		if (is_running() && !g_task_should_exit) {
+			result = g_dm_ops->clear(item);
+		}
+
+		unlock_item_write(item);
+		return result;
+	}
+
 	/* get a work item and queue up a clear request */
 	if ((work = create_work_item()) == NULL) {
 		return -1;
@@ -902,9 +1308,10 @@ task_main(int argc, char *argv[])
 
 	unsigned max_offset = g_key_offsets[DM_KEY_NUM_KEYS - 1] + (g_per_item_max_index[DM_KEY_NUM_KEYS - 1] * k_sector_size);
 
-	for (unsigned i = 0; i < dm_number_of_funcs; i++) {
-		g_func_counts[i] = 0;
-	}
+	memset(g_item_stats, 0, sizeof(g_item_stats));
+	g_restart_count = 0;
+
+	init_item_locks();
 
 	/* Initialize the item type locks, for now only DM_KEY_MISSION_STATE supports locking */
 	px4_sem_init(&g_sys_state_mutex, 1, 1); /* Initially unlocked */
@@ -921,6 +1328,12 @@ task_main(int argc, char *argv[])
 	init_q(&g_free_q);
 
 	px4_sem_init(&g_work_queued_sema, 1, 0);
+#ifdef DM_MMAP_BACKEND
+	px4_sem_init(&g_dirty_mutex, 1, 1);
+#endif
+
+	/* the backend of a previous run may still be selected */
+	g_dm_ops = &dm_file_operations;
 
 	if (!on_disk) {
 
@@ -935,6 +1348,7 @@ task_main(int argc, char *argv[])
 
 		memset(g_task_data, 0, max_offset);
 		g_task_data_end = &g_task_data[max_offset - 1];
+		g_dm_ops = &dm_ram_operations;
 
 	} else {
 		/* See if the data manage file exists and is a multiple of the sector size */
@@ -976,6 +1390,40 @@ task_main(int argc, char *argv[])
 			return -1;
 		}
 
+#ifdef DM_MMAP_BACKEND
+
+		if (g_use_mmap) {
+			/* The mapping must not extend past the end of the file */
+			struct stat st;
+
+			if (fstat(g_task_fd, &st) != 0 ||
+			    ((unsigned)st.st_size < max_offset && ftruncate(g_task_fd, max_offset) != 0)) {
+				close(g_task_fd);
+				PX4_WARN("Could not size data manager file %s", k_data_manager_device_path);
+				px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+				return -1;
+			}
+
+			g_task_data = mmap(NULL, max_offset, PROT_READ | PROT_WRITE, MAP_SHARED, g_task_fd, 0);
+
+			if (g_task_data == MAP_FAILED) {
+				g_task_data = NULL;
+				close(g_task_fd);
+				PX4_WARN("Could not map data manager file %s", k_data_manager_device_path);
+				px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+				return -1;
+			}
+
+			g_task_data_end = &g_task_data[max_offset - 1];
+			g_mmap_size = max_offset;
+			g_dirty_start = UINT_MAX;
+			g_dirty_end = 0;
+			g_sync_count = 0;
+			g_dm_ops = &dm_mmap_operations;
+		}
+
+#endif
+
 		/* Write current compat info */
 		struct dataman_compat_s compat_state;
 		compat_state.key = DM_COMPAT_KEY;
@@ -985,11 +1433,13 @@ task_main(int argc, char *argv[])
 			PX4_ERR("Failed writing compat: %d", ret);
 		}
 
+		if (g_dm_ops->sync) {
+			g_dm_ops->sync();
+		}
+
 		fsync(g_task_fd);
 	}
 
-	g_dm_ops = on_disk ? &dm_file_operations : &dm_ram_operations;
-
 	/* see if we need to erase any items based on restart type */
 	int sys_restart_val;
 
@@ -1018,8 +1468,8 @@ task_main(int argc, char *argv[])
 	g_on_disk = on_disk;
 
 	if (g_on_disk) {
-		PX4_INFO("%s, data manager file '%s' size is %d bytes",
-			 restart_type_str, k_data_manager_device_path, max_offset);
+		PX4_INFO("%s, data manager file '%s' size is %d bytes%s",
+			 restart_type_str, k_data_manager_device_path, max_offset, g_dm_ops->sync ? ", memory mapped" : "");
 
 	} else {
 		PX4_INFO("%s, data manager RAM size is %d bytes",
@@ -1034,8 +1484,28 @@ task_main(int argc, char *argv[])
 
 		/* do we need to exit ??? */
 		if (!g_task_should_exit) {
-			/* wait for work */
-			px4_sem_wait(&g_work_queued_sema);
+#ifdef DM_MMAP_BACKEND
+
+			unsigned sync_wait_us;
+
+			if (g_dm_ops->sync && _mmap_pending(&sync_wait_us)) {
+				/* wait for work, but wake up in time to flush coalesced writes */
+				struct timespec ts;
+				px4_clock_gettime(CLOCK_REALTIME, &ts);
+
+				const unsigned billion = (1000 * 1000 * 1000);
+				uint64_t nsecs = ts.tv_nsec + (uint64_t)sync_wait_us * 1000;
+				ts.tv_sec += nsecs / billion;
+				ts.tv_nsec = nsecs % billion;
+
+				px4_sem_timedwait(&g_work_queued_sema, &ts);
+
+			} else
+#endif
+			{
+				/* wait for work */
+				px4_sem_wait(&g_work_queued_sema);
+			}
 
 		} else {
 			if (g_on_disk) {
@@ -1055,10 +1525,12 @@ task_main(int argc, char *argv[])
 		/* Empty the work queue */
 		while ((work = dequeue_work_item())) {
 
+			hrt_abstime wait = hrt_elapsed_time(&work->queued);
+
 			/* handle each work item with the appropriate handler */
 			switch (work->func) {
 			case dm_write_func:
-				g_func_counts[dm_write_func]++;
+				account_wait(work->write_params.item, dm_write_func, wait);
 				work->result =
 					g_dm_ops->write(work->write_params.item, work->write_params.index, work->write_params.persistence,
 							work->write_params.buf,
@@ -1066,19 +1538,30 @@ task_main(int argc, char *argv[])
 				break;
 
 			case dm_read_func:
-				g_func_counts[dm_read_func]++;
+				account_wait(work->read_params.item, dm_read_func, wait);
 				work->result =
 					g_dm_ops->read(work->read_params.item, work->read_params.index, work->read_params.buf, work->read_params.count);
 				break;
 
+			case dm_write_items_func:
+				account_wait(work->write_items_params.item, dm_write_items_func, wait);
+				work->result =
+					_write_items(work->write_items_params.item, work->write_items_params.index,
+						     work->write_items_params.persistence, work->write_items_params.buf,
+						     work->write_items_params.count, work->write_items_params.num);
+				break;
+
 			case dm_clear_func:
-				g_func_counts[dm_clear_func]++;
+				account_wait(work->clear_params.item, dm_clear_func, wait);
 				work->result = g_dm_ops->clear(work->clear_params.item);
 				break;
 
 			case dm_restart_func:
-				g_func_counts[dm_restart_func]++;
+				/* A restart touches all item types, keep direct callers out meanwhile */
+				lock_all_items();
+				g_restart_count++;
 				work->result = g_dm_ops->restart(work->restart_params.reason);
+				unlock_all_items();
 				break;
 
 			default: /* should never happen */
@@ -1090,13 +1573,34 @@ task_main(int argc, char *argv[])
 			px4_sem_post(&work->wait_sem);
 		}
 
+#ifdef DM_MMAP_BACKEND
+
+		/* flush writes coalesced over the sync interval, or all of them when stopping */
+		if (g_dm_ops->sync && (g_task_should_exit || _mmap_sync_due())) {
+			g_dm_ops->sync();
+		}
+
+#endif
+
 		/* time to go???? */
 		if ((g_task_should_exit) && !is_running()) {
 			break;
 		}
 	}
 
+	/* Wait for direct callers that got in before is_running() turned false */
+	lock_all_items();
+	unlock_all_items();
+
 	if (on_disk) {
+#ifdef DM_MMAP_BACKEND
+
+		if (g_dm_ops->sync) {
+			g_dm_ops->sync();
+			munmap(g_task_data, g_mmap_size);
+		}
+
+#endif
 		close(g_task_fd);
 
 	} else {
@@ -1109,21 +1613,33 @@ task_main(int argc, char *argv[])
 	/* revert back to qualifying is_running based on disk */
 	g_on_disk = true;
 
-	/* The work queue is now empty, empty the free queue */
+	/* The work queue is now empty, empty the free queue. Items are allocated in chunks,
+	 * so only free the chunks once no queued item points into them anymore. */
+	sq_queue_t chunks;
+	sq_init(&chunks);
+
 	for (;;) {
 		if ((work = (work_q_item_t *)sq_remfirst(&(g_free_q.q))) == NULL) {
 			break;
 		}
 
 		if (work->first) {
-			free(work);
+			sq_addlast(&work->link, &chunks);
 		}
 	}
 
+	while ((work = (work_q_item_t *)sq_remfirst(&chunks))) {
+		free(work);
+	}
+
 	destroy_q(&g_work_q);
 	destroy_q(&g_free_q);
 	px4_sem_destroy(&g_work_queued_sema);
 	px4_sem_destroy(&g_sys_state_mutex);
+	destroy_item_locks();
+#ifdef DM_MMAP_BACKEND
+	px4_sem_destroy(&g_dirty_mutex);
+#endif
 
 	return 0;
 }
@@ -1151,12 +1667,53 @@ start(void)
 static void
 status(void)
 {
+	static const char *const item_names[DM_KEY_NUM_KEYS] = {
+		"safe points",
+		"fence points",
+		"waypoints 0",
+		"waypoints 1",
+		"waypoints 2",
+		"waypoints 3",
+		"onboard wps",
+		"mission state",
+		"mission slots",
+		"compat"
+	};
+
+	unsigned counts[dm_number_of_funcs] = {};
+
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		for (unsigned f = 0; f < dm_number_of_funcs; f++) {
+			counts[f] += g_item_stats[i].counts[f];
+		}
+	}
+
 	/* display usage statistics */
-	PX4_INFO("Writes   %d", g_func_counts[dm_write_func]);
-	PX4_INFO("Reads    %d", g_func_counts[dm_read_func]);
-	PX4_INFO("Clears   %d", g_func_counts[dm_clear_func]);
-	PX4_INFO("Restarts %d", g_func_counts[dm_restart_func]);
+	PX4_INFO("Writes   %d", counts[dm_write_func]);
+	PX4_INFO("Batches  %d", counts[dm_write_items_func]);
+	PX4_INFO("Reads    %d", counts[dm_read_func]);
+	PX4_INFO("Clears   %d", counts[dm_clear_func]);
+	PX4_INFO("Restarts %d", g_restart_count);
 	PX4_INFO("Max Q lengths work %d, free %d", g_work_q.max_size, g_free_q.max_size);
+	PX4_INFO("Access %s, wait time per item type:", g_dm_ops->direct ? "direct, per item type locks" : "work queue");
+
+	for (unsigned i = 0; i < DM_KEY_NUM_KEYS; i++) {
+		const dm_item_stats_t *stats = &g_item_stats[i];
+		unsigned ops = stats->counts[dm_write_func] + stats->counts[dm_read_func] + stats->counts[dm_clear_func] +
+			       stats->counts[dm_write_items_func];
+
+		if (ops > 0) {
+			PX4_INFO("  %-13s %6u ops, avg %5u us, max %6u us", item_names[i], ops,
+				 (unsigned)(stats->wait_total / ops), (unsigned)stats->wait_max);
+		}
+	}
+#ifdef DM_MMAP_BACKEND
+
+	if (g_dm_ops->sync) {
+		PX4_INFO("Msyncs   %d", g_sync_count);
+	}
+
+#endif
 }
 
 static void
@@ -1170,7 +1727,10 @@ stop(void)
 static void
 usage(void)
 {
-	PX4_INFO("usage: dataman {start [-f datafile]|[-r]|stop|status|poweronrestart|inflightrestart}");
+	PX4_INFO("usage: dataman {start [-f datafile [-s]]|[-r]|stop|status|poweronrestart|inflightrestart}");
+#ifdef DM_MMAP_BACKEND
+	PX4_INFO("       the data file is memory mapped, -s selects seek based file I/O instead");
+#endif
 }
 
 int
@@ -1194,9 +1754,13 @@ dataman_main(int argc, char *argv[])
 		int dmoptind = 1;
 		const char *dmoptarg = NULL;
 
+#ifdef DM_MMAP_BACKEND
+		g_use_mmap = true;
+#endif
+
 		/* jump over start and look at options first */
 
-		while ((ch = px4_getopt(argc, argv, "f:r", &dmoptind, &dmoptarg)) != EOF) {
+		while ((ch = px4_getopt(argc, argv, "f:rs", &dmoptind, &dmoptarg)) != EOF) {
 			switch (ch) {
 			case 'f':
 				k_data_manager_device_path = strdup(dmoptarg);
@@ -1207,6 +1771,12 @@ dataman_main(int argc, char *argv[])
 				in_ram = true;
 				break;
 
+			case 's':
+#ifdef DM_MMAP_BACKEND
+				g_use_mmap = false;
+#endif
+				break;
+
 
 			//no break
 			default:
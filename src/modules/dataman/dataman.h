@@ -55,15 +55,19 @@ typedef enum {
 	DM_KEY_FENCE_POINTS,		/* Fence vertex coordinates */
 	DM_KEY_WAYPOINTS_OFFBOARD_0,	/* Mission way point coordinates sent over mavlink */
 	DM_KEY_WAYPOINTS_OFFBOARD_1,	/* (alernate between 0 and 1) */
+	DM_KEY_WAYPOINTS_OFFBOARD_2,	/* Stored missions, activated without re-upload */
+	DM_KEY_WAYPOINTS_OFFBOARD_3,
 	DM_KEY_WAYPOINTS_ONBOARD,	/* Mission way point coordinates generated onboard */
 	DM_KEY_MISSION_STATE,		/* Persistent mission state */
+	DM_KEY_MISSION_SLOTS,		/* Mission state of the mission stored in each offboard slot */
 	DM_KEY_COMPAT,
 	DM_KEY_NUM_KEYS			/* Total number of item types defined */
 } dm_item_t;
 
-#define DM_KEY_WAYPOINTS_OFFBOARD(_id) (_id == 0 ? DM_KEY_WAYPOINTS_OFFBOARD_0 : DM_KEY_WAYPOINTS_OFFBOARD_1)
-
 #if defined(MEMORY_CONSTRAINED_SYSTEM)
+/** Number of usable offboard waypoint slots */
+#define DM_NUM_OFFBOARD_MISSIONS 2
+
 enum {
 	DM_KEY_SAFE_POINTS_MAX = 8,
 #ifdef __cplusplus
@@ -73,11 +77,17 @@ enum {
 #endif
 	DM_KEY_WAYPOINTS_OFFBOARD_0_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_WAYPOINTS_OFFBOARD_1_MAX = NUM_MISSIONS_SUPPORTED,
+	DM_KEY_WAYPOINTS_OFFBOARD_2_MAX = 0,
+	DM_KEY_WAYPOINTS_OFFBOARD_3_MAX = 0,
 	DM_KEY_WAYPOINTS_ONBOARD_MAX = (NUM_MISSIONS_SUPPORTED / 10),
 	DM_KEY_MISSION_STATE_MAX = 1,
+	DM_KEY_MISSION_SLOTS_MAX = DM_NUM_OFFBOARD_MISSIONS,
 	DM_KEY_COMPAT_MAX = 1
 };
 #else
+/** Number of usable offboard waypoint slots */
+#define DM_NUM_OFFBOARD_MISSIONS 4
+
 /** The maximum number of instances for each item type */
 enum {
 	DM_KEY_SAFE_POINTS_MAX = 8,
@@ -88,11 +98,23 @@ enum {
 #endif
 	DM_KEY_WAYPOINTS_OFFBOARD_0_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_WAYPOINTS_OFFBOARD_1_MAX = NUM_MISSIONS_SUPPORTED,
+	DM_KEY_WAYPOINTS_OFFBOARD_2_MAX = NUM_MISSIONS_SUPPORTED,
+	DM_KEY_WAYPOINTS_OFFBOARD_3_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_WAYPOINTS_ONBOARD_MAX = NUM_MISSIONS_SUPPORTED,
 	DM_KEY_MISSION_STATE_MAX = 1,
+	DM_KEY_MISSION_SLOTS_MAX = DM_NUM_OFFBOARD_MISSIONS,
 	DM_KEY_COMPAT_MAX = 1
 };
 #endif
+
+/** true if _id is an offboard waypoint storage slot */
+#define DM_OFFBOARD_ID_VALID(_id) ((_id) >= 0 && (_id) < DM_NUM_OFFBOARD_MISSIONS)
+
+/* Offboard waypoint storage slots are consecutive item types, an invalid ID gives
+ * DM_KEY_NUM_KEYS which the data manager rejects */
+#define DM_KEY_WAYPOINTS_OFFBOARD(_id) (DM_OFFBOARD_ID_VALID(_id) ? \
+					(dm_item_t)(DM_KEY_WAYPOINTS_OFFBOARD_0 + (_id)) : DM_KEY_NUM_KEYS)
+
 /** Data persistence levels */
 typedef enum {
 	DM_PERSIST_POWER_ON_RESET = 0,	/* Data survives all resets */
@@ -112,7 +134,7 @@ struct dataman_compat_s {
 };
 
 /* increment this define whenever a binary incompatible change is performed */
-#define DM_COMPAT_VERSION	1ULL
+#define DM_COMPAT_VERSION	2ULL
 
 #define DM_COMPAT_KEY ((DM_COMPAT_VERSION << 32) + (sizeof(struct mission_item_s) << 24) + (sizeof(struct mission_s) << 16) + (sizeof(struct fence_vertex_s) << 8) + sizeof(struct dataman_compat_s))
 
@@ -149,6 +171,17 @@ dm_write(
 	size_t buflen			/* Length in bytes of data to retrieve */
 );
 
+/** write consecutive items of one type to the data manager store, returns the number of items written */
+__EXPORT ssize_t
+dm_write_items(
+	dm_item_t  item,		/* The item type to store */
+	unsigned char index,		/* The index of the first item */
+	dm_persitence_t persistence,	/* The persistence level of these items */
+	const void *buffer,		/* Pointer to num items of buflen bytes each */
+	size_t buflen,			/* Length in bytes of each item */
+	unsigned num			/* Number of items to store */
+);
+
 /** Lock all items of this type */
 __EXPORT void
 dm_lock(
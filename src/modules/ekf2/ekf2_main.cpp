@@ -58,6 +58,7 @@
 #include <systemlib/param/param.h>
 #include <systemlib/err.h>
 #include <systemlib/systemlib.h>
+#include <systemlib/latency_trace.h>
 #include <mathlib/mathlib.h>
 #include <mathlib/math/filter/LowPassFilter2p.hpp>
 #include <platforms/px4_defines.h>
@@ -706,6 +707,8 @@ void Ekf2::task_main()
 				float gyro_bias[3] = {};
 				_ekf.get_gyro_bias(gyro_bias);
 				ctrl_state.timestamp = hrt_absolute_time();
+				ctrl_state.timestamp_sample = sensors.timestamp;
+				ctrl_state.trace_id = sensors.trace_id;
 				gyro_rad[0] = sensors.gyro_rad[0] - gyro_bias[0];
 				gyro_rad[1] = sensors.gyro_rad[1] - gyro_bias[1];
 				gyro_rad[2] = sensors.gyro_rad[2] - gyro_bias[2];
@@ -788,6 +791,8 @@ void Ekf2::task_main()
 				// generate vehicle attitude quaternion data
 				struct vehicle_attitude_s att = {};
 				att.timestamp = hrt_absolute_time();
+				att.timestamp_sample = sensors.timestamp;
+				att.trace_id = sensors.trace_id;
 
 				att.q[0] = q(0);
 				att.q[1] = q(1);
@@ -805,6 +810,8 @@ void Ekf2::task_main()
 				} else {
 					orb_publish(ORB_ID(vehicle_attitude), _att_pub, &att);
 				}
+
+				latency_trace_hop(latency_trace_s::HOP_ESTIMATOR, sensors.trace_id);
 			}
 
 			// generate vehicle local position data
@@ -77,6 +77,7 @@
 #include <geo/geo.h>
 #include <systemlib/perf_counter.h>
 #include <systemlib/systemlib.h>
+#include <systemlib/latency_trace.h>
 #include <mathlib/mathlib.h>
 
 #include <ecl/attitude_fw/ecl_pitch_controller.h>
@@ -1164,9 +1165,12 @@ FixedwingAttitudeControl::task_main()
 
 			/* lazily publish the setpoint only once available */
 			_actuators.timestamp = hrt_absolute_time();
-			_actuators.timestamp_sample = _ctrl_state.timestamp;
+			/* estimators that do not know the sensor sample only set the timestamp */
+			_actuators.timestamp_sample = (_ctrl_state.timestamp_sample != 0) ? _ctrl_state.timestamp_sample :
+						      _ctrl_state.timestamp;
+			_actuators.trace_id = _ctrl_state.trace_id;
 			_actuators_airframe.timestamp = hrt_absolute_time();
-			_actuators_airframe.timestamp_sample = _ctrl_state.timestamp;
+			_actuators_airframe.timestamp_sample = _actuators.timestamp_sample;
 
 			/* Only publish if any of the proper modes are enabled */
 			if (_vcontrol_mode.flag_control_rates_enabled ||
@@ -1175,6 +1179,7 @@ FixedwingAttitudeControl::task_main()
 				/* publish the actuator controls */
 				if (_actuators_0_pub != nullptr) {
 					orb_publish(_actuators_id, _actuators_0_pub, &_actuators);
+					latency_trace_hop(latency_trace_s::HOP_CONTROL, _actuators.trace_id);
 
 				} else if (_actuators_id) {
 					_actuators_0_pub = orb_advertise(_actuators_id, &_actuators);
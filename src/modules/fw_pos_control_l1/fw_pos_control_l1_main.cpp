@@ -68,6 +68,7 @@
 #include <px4_posix.h>
 
 #include "landingslope.h"
+#include "leg_geometry.h"
 
 #include <arch/board/board.h>
 #include <drivers/drv_accel.h>
@@ -211,6 +212,7 @@ private:
 	bool _land_useterrain;
 
 	Landingslope _landingslope;
+	LegGeometry _leg;			/**< geometry of the leg between the previous and current setpoint */
 
 	hrt_abstime _time_started_landing;	//*< time at which landing started */
 
@@ -591,6 +593,7 @@ FixedwingPositionControl::FixedwingPositionControl() :
 	_land_onslope(false),
 	_land_useterrain(false),
 	_landingslope(),
+	_leg(),
 	_time_started_landing(0),
 	_t_alt_prev_valid(0),
 	_time_last_t_alt(0),
@@ -961,6 +964,9 @@ FixedwingPositionControl::vehicle_setpoint_poll()
 
 	if (pos_sp_triplet_updated) {
 		orb_copy(ORB_ID(position_setpoint_triplet), _pos_sp_triplet_sub, &_pos_sp_triplet);
+
+		/* only recomputed if the waypoints moved, not on every triplet update */
+		_leg.update_leg(_pos_sp_triplet.previous, _pos_sp_triplet.current);
 	}
 }
 
@@ -1050,13 +1056,11 @@ FixedwingPositionControl::calculate_gndspeed_undershoot(const math::Vector<2> &c
 		float delta_altitude = 0.0f;
 
 		if (pos_sp_triplet.previous.valid) {
-			distance = get_distance_to_next_waypoint(pos_sp_triplet.previous.lat, pos_sp_triplet.previous.lon,
-					pos_sp_triplet.current.lat, pos_sp_triplet.current.lon);
+			distance = _leg.leg_distance();
 			delta_altitude = pos_sp_triplet.current.alt - pos_sp_triplet.previous.alt;
 
 		} else {
-			distance = get_distance_to_next_waypoint(current_position(0), current_position(1), pos_sp_triplet.current.lat,
-					pos_sp_triplet.current.lon);
+			distance = _leg.distance_to_current();
 			delta_altitude = pos_sp_triplet.current.alt -  _global_pos.alt;
 		}
 
@@ -1278,6 +1282,9 @@ FixedwingPositionControl::control_position(const math::Vector<2> &current_positi
 
 	bool setpoint = true;
 
+	/* distance and bearing to the current waypoint, used by several of the modes below */
+	_leg.update_position(_global_pos.lat, _global_pos.lon);
+
 	_att_sp.fw_control_yaw = false;		// by default we don't want yaw to be contoller directly with rudder
 	_att_sp.apply_flaps = false;		// by default we don't use flaps
 	float eas2tas = 1.0f; // XXX calculate actual number based on current measurements
@@ -1476,13 +1483,12 @@ FixedwingPositionControl::control_position(const math::Vector<2> &current_positi
 				_fw_pos_ctrl_status.abort_landing = false;
 			}
 
-			float bearing_lastwp_currwp = get_bearing_to_next_waypoint(prev_wp(0), prev_wp(1), curr_wp(0), curr_wp(1));
-			float bearing_airplane_currwp = get_bearing_to_next_waypoint(current_position(0), current_position(1), curr_wp(0),
-							curr_wp(1));
+			float bearing_lastwp_currwp = _leg.leg_bearing();
+			float bearing_airplane_currwp = _leg.bearing_to_current();
 
 			/* Horizontal landing control */
 			/* switch to heading hold for the last meters, continue heading hold after */
-			float wp_distance = get_distance_to_next_waypoint(current_position(0), current_position(1), curr_wp(0), curr_wp(1));
+			float wp_distance = _leg.distance_to_current();
 
 			/* calculate a waypoint distance value which is 0 when the aircraft is behind the waypoint */
 			float wp_distance_save = wp_distance;
@@ -1491,18 +1497,6 @@ FixedwingPositionControl::control_position(const math::Vector<2> &current_positi
 				wp_distance_save = 0.0f;
 			}
 
-			// create virtual waypoint which is on the desired flight path but
-			// some distance behind landing waypoint. This will make sure that the plane
-			// will always follow the desired flight path even if we get close or past
-			// the landing waypoint
-			math::Vector<2> curr_wp_shifted;
-			double lat;
-			double lon;
-			create_waypoint_from_line_and_dist(pos_sp_triplet.current.lat, pos_sp_triplet.current.lon,
-							   pos_sp_triplet.previous.lat, pos_sp_triplet.previous.lon, -1000.0f, &lat, &lon);
-			curr_wp_shifted(0) = (float)lat;
-			curr_wp_shifted(1) = (float)lon;
-
 			// we want the plane to keep tracking the desired flight path until we start flaring
 			// if we go into heading hold mode earlier then we risk to be pushed away from the runway by cross winds
 			//if (land_noreturn_vertical) {
@@ -2366,9 +2360,7 @@ FixedwingPositionControl::task_main()
 					_fw_pos_ctrl_status.target_bearing = _l1_control.target_bearing();
 					_fw_pos_ctrl_status.xtrack_error = _l1_control.crosstrack_error();
 
-					math::Vector<2> curr_wp((float)_pos_sp_triplet.current.lat, (float)_pos_sp_triplet.current.lon);
-					_fw_pos_ctrl_status.wp_dist = get_distance_to_next_waypoint(current_position(0), current_position(1), curr_wp(0),
-								      curr_wp(1));
+					_fw_pos_ctrl_status.wp_dist = _leg.distance_to_current();
 
 					fw_pos_ctrl_status_publish();
 				}
@@ -0,0 +1,277 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file fw_pos_control_l1_tests.cpp
+ * Fixed wing position control unit tests. Run the tests as follows:
+ *   nsh> fw_pos_control_l1_tests
+ *
+ */
+
+#include <drivers/drv_hrt.h>
+#include <geo/geo.h>
+#include <mathlib/mathlib.h>
+#include <px4_log.h>
+#include <systemlib/err.h>
+#include <unit_test/unit_test.h>
+
+#include <math.h>
+#include <string.h>
+
+#include "../landingslope.h"
+#include "../leg_geometry.h"
+
+extern "C" __EXPORT int fw_pos_control_l1_tests_main(int argc, char *argv[]);
+
+class FwPosControlTests : public UnitTest
+{
+public:
+	virtual bool run_tests(void);
+
+private:
+	/* 20 s of final approach at 50 Hz, the rate of the position controller */
+	static constexpr unsigned NUM_SAMPLES = 1000;
+
+	bool leg_update_test();
+	bool leg_position_test();
+	bool landingslope_test();
+	bool landing_benchmark();
+
+	void record_approach();
+
+	double _lat[NUM_SAMPLES];
+	double _lon[NUM_SAMPLES];
+};
+
+static constexpr double land_lat = 47.397742;
+static constexpr double land_lon = 8.545594;
+static constexpr double approach_lat = 47.410000;
+static constexpr double approach_lon = 8.560000;
+
+void FwPosControlTests::record_approach()
+{
+	/* straight in from the approach waypoint, with cross wind drift and position noise,
+	 * flying over the landing waypoint at the end like a real touch down */
+	srand(42);
+
+	for (unsigned i = 0; i < NUM_SAMPLES; i++) {
+		const double t = 1.1 * i / NUM_SAMPLES;
+		const double drift = 2e-5 * sin(6.0 * t);
+		_lat[i] = approach_lat + t * (land_lat - approach_lat) + drift + 1e-6 * ((double)rand() / RAND_MAX - 0.5);
+		_lon[i] = approach_lon + t * (land_lon - approach_lon) - drift + 1e-6 * ((double)rand() / RAND_MAX - 0.5);
+	}
+}
+
+bool FwPosControlTests::leg_update_test()
+{
+	LegGeometry leg;
+	position_setpoint_s previous = {};
+	position_setpoint_s current = {};
+
+	current.valid = true;
+	current.lat = land_lat;
+	current.lon = land_lon;
+	current.alt = 488.0f;
+
+	ut_assert_false(leg.valid());
+	ut_assert_true(leg.update_leg(previous, current));
+	ut_assert_true(leg.valid());
+	ut_assert_false(leg.previous_valid());
+	ut_compare_float("no previous bearing", leg.leg_bearing(), 0.0f, 6);
+
+	previous.valid = true;
+	previous.lat = approach_lat;
+	previous.lon = approach_lon;
+	ut_assert_true(leg.update_leg(previous, current));
+
+	ut_compare_float("leg bearing", leg.leg_bearing(),
+			 get_bearing_to_next_waypoint(approach_lat, approach_lon, land_lat, land_lon), 6);
+	ut_compare_float("leg distance", leg.leg_distance(),
+			 get_distance_to_next_waypoint(approach_lat, approach_lon, land_lat, land_lon), 3);
+
+	/* altitude, speed or type changes keep the geometry */
+	current.alt = 480.0f;
+	current.type = position_setpoint_s::SETPOINT_TYPE_LAND;
+	ut_assert_false(leg.update_leg(previous, current));
+
+	/* millimeter jitter of the waypoint is not a new leg */
+	current.lat += 1e-8;
+	ut_assert_false(leg.update_leg(previous, current));
+
+	current.lat += 1e-5;
+	ut_assert_true(leg.update_leg(previous, current));
+
+	leg.invalidate();
+	ut_assert_true(leg.update_leg(previous, current));
+
+	return true;
+}
+
+bool FwPosControlTests::leg_position_test()
+{
+	LegGeometry leg;
+	position_setpoint_s previous = {};
+	position_setpoint_s current = {};
+
+	previous.valid = true;
+	previous.lat = approach_lat;
+	previous.lon = approach_lon;
+	current.valid = true;
+	current.lat = land_lat;
+	current.lon = land_lon;
+
+	leg.update_leg(previous, current);
+	record_approach();
+
+	float distance_err = 0.0f;
+	float bearing_err = 0.0f;
+
+	for (unsigned i = 0; i < NUM_SAMPLES; i++) {
+		leg.update_position(_lat[i], _lon[i]);
+
+		const float distance = get_distance_to_next_waypoint(_lat[i], _lon[i], land_lat, land_lon);
+		const float bearing = get_bearing_to_next_waypoint(_lat[i], _lon[i], land_lat, land_lon);
+
+		distance_err = math::max(distance_err, fabsf(leg.distance_to_current() - distance));
+
+		/* the bearing is ill defined right over the waypoint */
+		if (distance > 5.0f) {
+			bearing_err = math::max(bearing_err, fabsf(_wrap_pi(leg.bearing_to_current() - bearing)));
+		}
+	}
+
+	PX4_INFO("approach: max distance error %.3f m, max bearing error %.5f rad", (double)distance_err,
+		 (double)bearing_err);
+
+	ut_assert("distance error", distance_err < 0.1f);
+	ut_assert("bearing error", bearing_err < 1e-3f);
+
+	return true;
+}
+
+bool FwPosControlTests::landingslope_test()
+{
+	Landingslope slope;
+	slope.update(math::radians(5.0f), 15.0f, 5.0f, 2.0f);
+
+	for (float d = 0.0f; d < 500.0f; d += 7.3f) {
+		ut_compare_float("relative altitude", slope.getLandingSlopeRelativeAltitude(d),
+				 Landingslope::getLandingSlopeRelativeAltitude(d, slope.horizontal_slope_displacement(),
+						 slope.landing_slope_angle_rad()), 3);
+		ut_compare_float("absolute altitude", slope.getLandingSlopeAbsoluteAltitude(d, 488.0f),
+				 Landingslope::getLandingSlopeAbsoluteAltitude(d, 488.0f, slope.horizontal_slope_displacement(),
+						 slope.landing_slope_angle_rad()), 3);
+	}
+
+	return true;
+}
+
+bool FwPosControlTests::landing_benchmark()
+{
+	LegGeometry leg;
+	position_setpoint_s previous = {};
+	position_setpoint_s current = {};
+	Landingslope slope;
+
+	previous.valid = true;
+	previous.lat = approach_lat;
+	previous.lon = approach_lon;
+	current.valid = true;
+	current.lat = land_lat;
+	current.lon = land_lon;
+
+	slope.update(math::radians(5.0f), 15.0f, 5.0f, 2.0f);
+	record_approach();
+
+	float sum = 0.0f;
+
+	/* what the landing branch of control_position computed every iteration */
+	hrt_abstime t0 = hrt_absolute_time();
+
+	for (unsigned i = 0; i < NUM_SAMPLES; i++) {
+		const float bearing_lastwp_currwp = get_bearing_to_next_waypoint(approach_lat, approach_lon, land_lat, land_lon);
+		const float bearing_airplane_currwp = get_bearing_to_next_waypoint(_lat[i], _lon[i], land_lat, land_lon);
+		const float wp_distance = get_distance_to_next_waypoint(_lat[i], _lon[i], land_lat, land_lon);
+		const float leg_distance = get_distance_to_next_waypoint(approach_lat, approach_lon, land_lat, land_lon);
+
+		double lat;
+		double lon;
+		create_waypoint_from_line_and_dist(land_lat, land_lon, approach_lat, approach_lon, -1000.0f, &lat, &lon);
+
+		sum += leg_distance + (float)lat + (float)lon;
+		sum += Landingslope::getLandingSlopeRelativeAltitude(wp_distance, slope.horizontal_slope_displacement(),
+				slope.landing_slope_angle_rad());
+		sum += slope.getFlareCurveRelativeAltitudeSave(wp_distance, bearing_lastwp_currwp, bearing_airplane_currwp);
+	}
+
+	hrt_abstime t1 = hrt_absolute_time();
+
+	for (unsigned i = 0; i < NUM_SAMPLES; i++) {
+		/* triplet updates arrive at a much lower rate, most of them do not move the waypoints */
+		if (i % 50 == 0) {
+			leg.update_leg(previous, current);
+		}
+
+		leg.update_position(_lat[i], _lon[i]);
+
+		sum += leg.leg_distance();
+		sum += slope.getLandingSlopeRelativeAltitude(leg.distance_to_current());
+		sum += slope.getFlareCurveRelativeAltitudeSave(leg.distance_to_current(), leg.leg_bearing(),
+				leg.bearing_to_current());
+	}
+
+	hrt_abstime t2 = hrt_absolute_time();
+
+	PX4_INFO("landing geometry per iteration: %.3f us recomputed, %.3f us cached (%.1f)",
+		 (double)(t1 - t0) / NUM_SAMPLES, (double)(t2 - t1) / NUM_SAMPLES, (double)sum);
+
+	return true;
+}
+
+bool FwPosControlTests::run_tests(void)
+{
+	ut_run_test(leg_update_test);
+	ut_run_test(leg_position_test);
+	ut_run_test(landingslope_test);
+	ut_run_test(landing_benchmark);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test(fwPosControlTests, FwPosControlTests)
+
+int fw_pos_control_l1_tests_main(int argc, char *argv[])
+{
+	return fwPosControlTests() ? 0 : -1;
+}
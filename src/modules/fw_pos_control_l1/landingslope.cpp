@@ -55,7 +55,8 @@ Landingslope::Landingslope() :
 	_d1(0.0f),
 	_flare_constant(0.0f),
 	_flare_length(0.0f),
-	_horizontal_slope_displacement(0.0f)
+	_horizontal_slope_displacement(0.0f),
+	_landing_slope_tan(0.0f)
 {
 }
 
@@ -75,8 +76,9 @@ void Landingslope::update(float landing_slope_angle_rad_new,
 
 void Landingslope::calculateSlopeValues()
 {
+	_landing_slope_tan = tanf(_landing_slope_angle_rad);
 	_H0 =  _flare_relative_alt + _H1_virt;
-	_d1 = _flare_relative_alt / tanf(_landing_slope_angle_rad);
+	_d1 = _flare_relative_alt / _landing_slope_tan;
 	_flare_constant = (_H0 * _d1) / _flare_relative_alt;
 	_flare_length = - logf(_H1_virt / _H0) * _flare_constant;
 	_horizontal_slope_displacement = (_flare_length - _d1);
@@ -84,8 +86,7 @@ void Landingslope::calculateSlopeValues()
 
 float Landingslope::getLandingSlopeRelativeAltitude(float wp_landing_distance)
 {
-	return Landingslope::getLandingSlopeRelativeAltitude(wp_landing_distance, _horizontal_slope_displacement,
-			_landing_slope_angle_rad);
+	return (wp_landing_distance - _horizontal_slope_displacement) * _landing_slope_tan;
 }
 
 float Landingslope::getLandingSlopeRelativeAltitudeSave(float wp_landing_distance, float bearing_lastwp_currwp,
@@ -102,8 +103,7 @@ float Landingslope::getLandingSlopeRelativeAltitudeSave(float wp_landing_distanc
 
 float Landingslope::getLandingSlopeAbsoluteAltitude(float wp_landing_distance, float wp_altitude)
 {
-	return Landingslope::getLandingSlopeAbsoluteAltitude(wp_landing_distance, wp_altitude, _horizontal_slope_displacement,
-			_landing_slope_angle_rad);
+	return getLandingSlopeRelativeAltitude(wp_landing_distance) + wp_altitude;
 }
 
 float Landingslope::getLandingSlopeAbsoluteAltitudeSave(float wp_landing_distance, float bearing_lastwp_currwp,
@@ -56,6 +56,7 @@ private:
 	float _flare_constant;
 	float _flare_length;					/**< d1 + delta d in the plot */
 	float _horizontal_slope_displacement;  /**< delta d in the plot */
+	float _landing_slope_tan;				/**< tan(phi), the slope is evaluated every iteration while landing */
 
 	void calculateSlopeValues();
 
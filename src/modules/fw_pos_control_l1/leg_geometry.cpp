@@ -0,0 +1,122 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file leg_geometry.cpp
+ */
+
+#include "leg_geometry.h"
+
+#include <math.h>
+
+/* waypoints closer than this are the same waypoint */
+static constexpr float LEG_CHANGE_TOLERANCE = 0.01f;
+
+LegGeometry::LegGeometry() :
+	_ref{},
+	_previous_lat(0.0),
+	_previous_lon(0.0),
+	_current_lat(0.0),
+	_current_lon(0.0),
+	_previous_x(0.0f),
+	_previous_y(0.0f),
+	_previous_valid(false),
+	_valid(false),
+	_leg_bearing(0.0f),
+	_leg_distance(0.0f),
+	_distance_to_current(0.0f),
+	_bearing_to_current(0.0f)
+{
+}
+
+bool LegGeometry::update_leg(const struct position_setpoint_s &previous, const struct position_setpoint_s &current)
+{
+	if (_valid && previous.valid == _previous_valid) {
+		/* project both waypoints into the plane around the stored current waypoint */
+		const double lat[2] = {current.lat, previous.lat};
+		const double lon[2] = {current.lon, previous.lon};
+		float x[2];
+		float y[2];
+
+		if (map_projection_project_n_fast(&_ref, lat, lon, x, y, previous.valid ? 2 : 1) == 0
+		    && fabsf(x[0]) < LEG_CHANGE_TOLERANCE && fabsf(y[0]) < LEG_CHANGE_TOLERANCE
+		    && (!previous.valid || (fabsf(x[1] - _previous_x) < LEG_CHANGE_TOLERANCE
+					    && fabsf(y[1] - _previous_y) < LEG_CHANGE_TOLERANCE))) {
+			return false;
+		}
+	}
+
+	_current_lat = current.lat;
+	_current_lon = current.lon;
+	_previous_lat = previous.lat;
+	_previous_lon = previous.lon;
+	_previous_valid = previous.valid;
+
+	map_projection_init(&_ref, _current_lat, _current_lon);
+
+	if (_previous_valid) {
+		map_projection_project_n_fast(&_ref, &_previous_lat, &_previous_lon, &_previous_x, &_previous_y, 1);
+		_leg_bearing = get_bearing_to_next_waypoint(_previous_lat, _previous_lon, _current_lat, _current_lon);
+		_leg_distance = get_distance_to_next_waypoint(_previous_lat, _previous_lon, _current_lat, _current_lon);
+
+	} else {
+		_previous_x = 0.0f;
+		_previous_y = 0.0f;
+		_leg_bearing = 0.0f;
+		_leg_distance = 0.0f;
+	}
+
+	_valid = true;
+	return true;
+}
+
+void LegGeometry::update_position(double lat, double lon)
+{
+	float x;
+	float y;
+
+	if (!_valid || map_projection_project_n_fast(&_ref, &lat, &lon, &x, &y, 1) != 0) {
+		return;
+	}
+
+	/* the projection is centered on the waypoint, the vehicle looks back at it */
+	_distance_to_current = sqrtf(x * x + y * y);
+
+	if (_distance_to_current > 0.01f) {
+		_bearing_to_current = atan2f(-y, -x);
+
+	} else {
+		_bearing_to_current = _leg_bearing;
+	}
+}
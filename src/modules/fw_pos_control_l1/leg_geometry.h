@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file leg_geometry.h
+ *
+ * Geometry of the mission leg flown by the fixed wing position controller.
+ *
+ * Everything that only depends on the previous and current waypoint is
+ * computed once when the position setpoint triplet changes. The per
+ * iteration part is a single projection of the vehicle position into the
+ * plane around the current waypoint.
+ */
+
+#pragma once
+
+#include <geo/geo.h>
+#include <uORB/topics/position_setpoint_triplet.h>
+
+class LegGeometry
+{
+public:
+	LegGeometry();
+	~LegGeometry() {}
+
+	/**
+	 * Recompute the leg if the waypoints changed.
+	 * @return true if the leg was recomputed
+	 */
+	bool update_leg(const struct position_setpoint_s &previous, const struct position_setpoint_s &current);
+
+	/**
+	 * Forget the leg, the next update_leg() recomputes it.
+	 */
+	void invalidate() { _valid = false; }
+
+	/**
+	 * Update the vehicle position relative to the current waypoint.
+	 * @param lat vehicle latitude in degrees
+	 * @param lon vehicle longitude in degrees
+	 */
+	void update_position(double lat, double lon);
+
+	bool valid() const { return _valid; }
+	bool previous_valid() const { return _previous_valid; }
+
+	/** @return bearing from the previous to the current waypoint, 0 without previous waypoint */
+	float leg_bearing() const { return _leg_bearing; }
+
+	/** @return distance from the previous to the current waypoint, 0 without previous waypoint */
+	float leg_distance() const { return _leg_distance; }
+
+	/** @return distance from the vehicle to the current waypoint */
+	float distance_to_current() const { return _distance_to_current; }
+
+	/** @return bearing from the vehicle to the current waypoint */
+	float bearing_to_current() const { return _bearing_to_current; }
+
+private:
+	struct map_projection_reference_s _ref;	/**< projection around the current waypoint */
+
+	double _previous_lat;
+	double _previous_lon;
+	double _current_lat;
+	double _current_lon;
+	float _previous_x;		/**< previous waypoint in the projection around the current one */
+	float _previous_y;
+	bool _previous_valid;
+	bool _valid;
+
+	float _leg_bearing;
+	float _leg_distance;
+
+	float _distance_to_current;
+	float _bearing_to_current;
+};
@@ -46,7 +46,9 @@ namespace logger
 
 
 LogWriterMavlink::LogWriterMavlink(unsigned int queue_size) :
-	_queue_size(queue_size)
+	_queue_size(queue_size),
+	// unacked messages wait in the ulog_stream queue while mavlink is busy, they must not be overwritten
+	_window_size(math::max(1, math::min((int)queue_size, (int)ulog_stream_ack_s::ACK_WINDOW)))
 {
 	_ulog_stream_data.length = 0;
 }
@@ -79,12 +81,14 @@ void LogWriterMavlink::start_log()
 	_ulog_stream_data.sequence = 0;
 	_ulog_stream_data.length = 0;
 	_ulog_stream_data.first_message_offset = 0;
+	_num_unacked = 0;
 	_is_started = true;
 }
 
 void LogWriterMavlink::stop_log()
 {
 	_ulog_stream_data.length = 0;
+	_num_unacked = 0;
 	_is_started = false;
 }
 
@@ -125,6 +129,9 @@ void LogWriterMavlink::set_need_reliable_transfer(bool need_reliable)
 			// make sure to send previous data using reliable transfer
 			publish_message();
 		}
+
+		// everything sent reliably must be acked before unreliable data follows
+		wait_for_acks(0);
 	}
 
 	_need_reliable_transfer = need_reliable;
@@ -137,6 +144,12 @@ int LogWriterMavlink::publish_message()
 
 	if (_need_reliable_transfer) {
 		_ulog_stream_data.flags = _ulog_stream_data.FLAGS_NEED_ACK;
+
+		// wait for a free slot in the window. Note that this blocks the main logger thread, so if a file logging
+		// is already running, it will miss samples.
+		if (wait_for_acks(_window_size - 1)) {
+			return -2;
+		}
 	}
 
 	if (_ulog_stream_pub == nullptr) {
@@ -147,48 +160,56 @@ int LogWriterMavlink::publish_message()
 	}
 
 	if (_need_reliable_transfer) {
-		// we need to wait for an ack. Note that this blocks the main logger thread, so if a file logging
-		// is already running, it will miss samples.
-		px4_pollfd_struct_t fds[1];
-		fds[0].fd = _ulog_stream_ack_sub;
-		fds[0].events = POLLIN;
-		bool got_ack = false;
-		const int timeout_ms = ulog_stream_ack_s::ACK_TIMEOUT * ulog_stream_ack_s::ACK_MAX_TRIES;
+		_unacked_sequences[_num_unacked++] = _ulog_stream_data.sequence;
+	}
 
-		hrt_abstime started = hrt_absolute_time();
+	_ulog_stream_data.sequence++;
+	_ulog_stream_data.length = 0;
+	_ulog_stream_data.first_message_offset = 255;
+	return 0;
+}
 
-		do {
-			int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), timeout_ms);
+int LogWriterMavlink::wait_for_acks(unsigned max_unacked)
+{
+	px4_pollfd_struct_t fds[1];
+	fds[0].fd = _ulog_stream_ack_sub;
+	fds[0].events = POLLIN;
+	const int timeout_ms = ulog_stream_ack_s::ACK_STALL_TIMEOUT;
+
+	// the timeout restarts with every ack, a slow link is fine as long as it makes progress.
+	// It covers several retransmissions at the largest backoff of the sender, see MavlinkULogWindow
+	hrt_abstime last_progress = hrt_absolute_time();
+
+	while (_num_unacked > max_unacked) {
+		if (hrt_elapsed_time(&last_progress) / 1000 >= timeout_ms) {
+			break;
+		}
 
-			if (ret <= 0) {
-				break;
-			}
+		int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), timeout_ms);
 
-			if (fds[0].revents & POLLIN) {
-				ulog_stream_ack_s ack;
-				orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
+		if (ret <= 0 || !(fds[0].revents & POLLIN)) {
+			break;
+		}
 
-				if (ack.sequence == _ulog_stream_data.sequence) {
-					got_ack = true;
-				}
+		ulog_stream_ack_s ack;
+		orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
 
-			} else {
+		// acks are selective and can arrive in any order
+		for (unsigned i = 0; i < _num_unacked; ++i) {
+			if (_unacked_sequences[i] == ack.sequence) {
+				_unacked_sequences[i] = _unacked_sequences[--_num_unacked];
+				last_progress = hrt_absolute_time();
 				break;
 			}
-		} while (!got_ack && hrt_elapsed_time(&started) / 1000 < timeout_ms);
-
-		if (!got_ack) {
-			PX4_ERR("Ack timeout. Stopping mavlink log");
-			stop_log();
-			return -2;
 		}
+	}
 
-		PX4_DEBUG("got ack in %i ms", (int)(hrt_elapsed_time(&started) / 1000));
+	if (_num_unacked > max_unacked) {
+		PX4_ERR("Ack timeout. Stopping mavlink log");
+		stop_log();
+		return -2;
 	}
 
-	_ulog_stream_data.sequence++;
-	_ulog_stream_data.length = 0;
-	_ulog_stream_data.first_message_offset = 255;
 	return 0;
 }
 
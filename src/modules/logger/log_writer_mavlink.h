@@ -72,15 +72,24 @@ public:
 
 private:
 
-	/** publish message, wait for ack if needed & reset message */
+	/** publish message, wait for a free slot in the ack window if needed & reset message */
 	int publish_message();
 
+	/**
+	 * wait until at most max_unacked reliable messages are not acked yet. Stops the log on timeout.
+	 * @return 0 on success, -2 on timeout
+	 */
+	int wait_for_acks(unsigned max_unacked);
+
 	ulog_stream_s _ulog_stream_data;
 	orb_advert_t _ulog_stream_pub = nullptr;
 	int _ulog_stream_ack_sub = -1;
 	bool _need_reliable_transfer = false;
 	bool _is_started = false;
 	const unsigned int _queue_size;
+	const unsigned int _window_size; ///< maximum number of reliable messages in flight
+	uint16_t _unacked_sequences[ulog_stream_ack_s::ACK_WINDOW];
+	unsigned int _num_unacked = 0;
 };
 
 }
@@ -2230,7 +2230,7 @@ Mavlink::task_main(int argc, char *argv[])
 				if (current_command_ack == vehicle_command_s::VEHICLE_CMD_LOGGING_START) {
 					_mavlink_ulog->start_ack_received();
 				}
-				int ret = _mavlink_ulog->handle_update(get_channel());
+				int ret = _mavlink_ulog->handle_update(get_channel(), get_free_tx_buf());
 				if (ret < 0) { //abort the streaming on error
 					if (ret != -1) {
 						PX4_WARN("mavlink ulog stream update failed, stopping (%i)", ret);
@@ -2529,6 +2529,11 @@ Mavlink::display_status()
 	if (_mavlink_ulog) {
 		printf("\tULog rate: %.1f%% of max %.1f%%\n", (double)_mavlink_ulog->current_data_rate()*100.,
 				(double)_mavlink_ulog->maximum_data_rate()*100.);
+		const MavlinkULogWindow &window = _mavlink_ulog->window();
+		printf("\tULog stream: %.3f kB/s, window %i/%.1f, rtt %i ms, %i retransmissions\n",
+				(double)_mavlink_ulog->achieved_data_rate() / 1000., window.outstanding(),
+				(double)window.congestion_window(), (int)(window.round_trip_time() / 1000),
+				(int)window.retransmissions());
 	}
 	printf("\taccepting commands: %s\n", (accepting_commands()) ? "YES" : "NO");
 	printf("\tMAVLink version: %i\n", _protocol_version);
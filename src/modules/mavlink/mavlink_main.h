@@ -439,10 +439,10 @@ public:
 
 	/** get ulog streaming if active, nullptr otherwise */
 	MavlinkULog		*get_ulog_streaming() { return _mavlink_ulog; }
-	void			try_start_ulog_streaming(uint8_t target_system, uint8_t target_component) {
+	void			try_start_ulog_streaming(uint8_t target_system, uint8_t target_component, unsigned ack_window = 1) {
 		if (_mavlink_ulog) { return; }
 
-		_mavlink_ulog = MavlinkULog::try_start(_datarate, 0.7f, target_system, target_component);
+		_mavlink_ulog = MavlinkULog::try_start(_datarate, 0.7f, target_system, target_component, ack_window);
 	}
 	void			request_stop_ulog_streaming() {
 		if (_mavlink_ulog) { _mavlink_ulog_stop_requested = true; }
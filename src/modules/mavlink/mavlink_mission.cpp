@@ -53,6 +53,7 @@
 #include <navigator/navigation.h>
 #include <uORB/topics/mission.h>
 #include <uORB/topics/mission_result.h>
+#include <uORB/topics/vehicle_command.h>
 
 int MavlinkMissionManager::_dataman_id = 0;
 bool MavlinkMissionManager::_dataman_init = false;
@@ -82,6 +83,10 @@ MavlinkMissionManager::MavlinkMissionManager(Mavlink *mavlink) : MavlinkStream(m
 	_transfer_current_seq(-1),
 	_transfer_partner_sysid(0),
 	_transfer_partner_compid(0),
+	_transfer_store(false),
+	_store_dataman_id(-1),
+	_window_size(1),
+	_param_window(PARAM_INVALID),
 	_offboard_mission_sub(-1),
 	_mission_result_sub(-1),
 	_offboard_mission_pub(nullptr),
@@ -90,6 +95,7 @@ MavlinkMissionManager::MavlinkMissionManager(Mavlink *mavlink) : MavlinkStream(m
 {
 	_offboard_mission_sub = orb_subscribe(ORB_ID(offboard_mission));
 	_mission_result_sub = orb_subscribe(ORB_ID(mission_result));
+	_param_window = param_find("MAV_MIS_WINDOW");
 
 	init_offboard_mission();
 }
@@ -122,7 +128,7 @@ MavlinkMissionManager::init_offboard_mission()
 		_dataman_init = true;
 		int ret = dm_read(DM_KEY_MISSION_STATE, 0, &mission_state, sizeof(mission_s)) == sizeof(mission_s);
 
-		if (ret > 0) {
+		if (ret > 0 && DM_OFFBOARD_ID_VALID(mission_state.dataman_id)) {
 			_dataman_id = mission_state.dataman_id;
 			_count = mission_state.count;
 			_current_seq = mission_state.current_seq;
@@ -186,6 +192,86 @@ MavlinkMissionManager::update_active_mission(int dataman_id, unsigned count, int
 	}
 }
 
+/**
+ * Write the mission state of a dataman slot, so the mission stored there can be activated later without re-upload.
+ */
+int
+MavlinkMissionManager::update_stored_mission(int dataman_id, unsigned count, int seq)
+{
+	struct mission_s mission;
+
+	mission.dataman_id = dataman_id;
+	mission.count = count;
+	mission.current_seq = seq;
+
+	if (dm_write(DM_KEY_MISSION_SLOTS, dataman_id, DM_PERSIST_POWER_ON_RESET, &mission,
+		     sizeof(mission_s)) != sizeof(mission_s)) {
+		warnx("WPM: ERROR: can't save state of mission slot %d", dataman_id);
+		return PX4_ERROR;
+	}
+
+	return PX4_OK;
+}
+
+/**
+ * Switch to the mission stored in a dataman slot. The items are already in place, so this only
+ * flips the mission state, which is a single item write and therefore atomic for navigator.
+ */
+int
+MavlinkMissionManager::activate_stored_mission(int dataman_id)
+{
+	struct mission_s mission;
+
+	if (!DM_OFFBOARD_ID_VALID(dataman_id)) {
+		return PX4_ERROR;
+	}
+
+	if (dm_read(DM_KEY_MISSION_SLOTS, dataman_id, &mission, sizeof(mission_s)) != sizeof(mission_s) ||
+	    mission.dataman_id != dataman_id || mission.count == 0) {
+		if (_verbose) { warnx("WPM: no mission stored in slot %d", dataman_id); }
+
+		return PX4_ERROR;
+	}
+
+	return update_active_mission(dataman_id, mission.count, mission.current_seq);
+}
+
+void
+MavlinkMissionManager::update_window_size()
+{
+	int32_t window = 1;
+
+	if (_param_window != PARAM_INVALID) {
+		param_get(_param_window, &window);
+	}
+
+	_window_size = (window < 1) ? 1 : ((unsigned)window > MavlinkMissionWindow::MAX_SIZE ? MavlinkMissionWindow::MAX_SIZE : window);
+}
+
+int
+MavlinkMissionManager::flush_transfer_batch()
+{
+	if (_transfer_window.ready() == 0) {
+		return PX4_OK;
+	}
+
+	dm_item_t dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_transfer_dataman_id);
+	unsigned first = _transfer_window.commit_seq();
+	unsigned num = _transfer_window.ready();
+
+	ssize_t written = dm_write_items(dm_item, first, DM_PERSIST_POWER_ON_RESET, _transfer_window.items(),
+					 sizeof(struct mission_item_s), num);
+	_transfer_window.commit();
+
+	if (written != (ssize_t)num) {
+		if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: error writing seq %u..%u to dataman ID %i", first, first + num - 1, _transfer_dataman_id); }
+
+		return PX4_ERROR;
+	}
+
+	return PX4_OK;
+}
+
 void
 MavlinkMissionManager::send_mission_ack(uint8_t sysid, uint8_t compid, uint8_t type)
 {
@@ -329,6 +415,17 @@ MavlinkMissionManager::send_mission_request(uint8_t sysid, uint8_t compid, uint1
 }
 
 
+void
+MavlinkMissionManager::send_mission_requests()
+{
+	unsigned seq;
+
+	while (_transfer_window.next_request(&seq)) {
+		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, seq);
+	}
+}
+
+
 void
 MavlinkMissionManager::send_mission_item_reached(uint16_t seq)
 {
@@ -392,11 +489,12 @@ MavlinkMissionManager::send(const hrt_abstime now)
 		_transfer_in_progress = false;
 
 	} else if (_state == MAVLINK_WPM_STATE_GETLIST && hrt_elapsed_time(&_time_last_sent) > _retry_timeout) {
-		/* try to request item again after timeout,
+		/* try to request the missing items again after timeout,
 		 * toggle int32 or float protocol variant to try both */
 		_int_mode = !_int_mode;
 
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		_transfer_window.rerequest_missing();
+		send_mission_requests();
 
 	} else if (_state == MAVLINK_WPM_STATE_SENDLIST && hrt_elapsed_time(&_time_last_sent) > _retry_timeout) {
 		if (_transfer_seq == 0) {
@@ -451,6 +549,10 @@ MavlinkMissionManager::handle_message(const mavlink_message_t *msg)
 		handle_mission_clear_all(msg);
 		break;
 
+	case MAVLINK_MSG_ID_COMMAND_LONG:
+		handle_mission_storage_command(msg);
+		break;
+
 	default:
 		break;
 	}
@@ -539,6 +641,7 @@ MavlinkMissionManager::handle_mission_request_list(const mavlink_message_t *msg)
 			_state = MAVLINK_WPM_STATE_SENDLIST;
 			_transfer_seq = 0;
 			_transfer_count = _count;
+			update_window_size();
 			_transfer_partner_sysid = msg->sysid;
 			_transfer_partner_compid = msg->compid;
 
@@ -599,6 +702,14 @@ MavlinkMissionManager::handle_mission_request_both(const mavlink_message_t *msg)
 
 					_transfer_seq++;
 
+				} else if (_window_size > 1 && wpr.seq < _transfer_count) {
+					/* windowed transfer, the partner may request ahead or re-request any lost item */
+					if (_verbose) { warnx("WPM: MISSION_ITEM_REQUEST(_INT) seq %u from ID %u (windowed)", wpr.seq, msg->sysid); }
+
+					if (wpr.seq >= _transfer_seq) {
+						_transfer_seq = wpr.seq + 1;
+					}
+
 				} else if (wpr.seq == _transfer_seq - 1) {
 					if (_verbose) { warnx("WPM: MISSION_ITEM_REQUEST(_INT) seq %u from ID %u (again)", wpr.seq, msg->sysid); }
 
@@ -670,6 +781,10 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 
 			_transfer_in_progress = true;
 
+			/* a stored slot applies to this upload only, whether it completes or not */
+			const int store_dataman_id = _store_dataman_id;
+			_store_dataman_id = -1;
+
 			if (wpc.count > _max_count) {
 				if (_verbose) { warnx("WPM: MISSION_COUNT ERROR: too many waypoints (%d), supported: %d", wpc.count, _max_count); }
 
@@ -681,8 +796,13 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			if (wpc.count == 0) {
 				if (_verbose) { warnx("WPM: MISSION_COUNT 0, clearing waypoints list and staying in state MAVLINK_WPM_STATE_IDLE"); }
 
-				/* alternate dataman ID anyway to let navigator know about changes */
-				update_active_mission(_dataman_id == 0 ? 1 : 0, 0, 0);
+				if (store_dataman_id >= 0) {
+					update_stored_mission(store_dataman_id, 0, 0);
+
+				} else {
+					/* alternate dataman ID anyway to let navigator know about changes */
+					update_active_mission(_dataman_id == 0 ? 1 : 0, 0, 0);
+				}
 
 				send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ACCEPTED);
 				_transfer_in_progress = false;
@@ -696,8 +816,22 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			_transfer_partner_sysid = msg->sysid;
 			_transfer_partner_compid = msg->compid;
 			_transfer_count = wpc.count;
-			_transfer_dataman_id = _dataman_id == 0 ? 1 : 0;	// use inactive storage for transmission
 			_transfer_current_seq = -1;
+			update_window_size();
+			_transfer_window.reset(_transfer_count, _window_size);
+
+			_transfer_store = store_dataman_id >= 0;
+
+			if (_transfer_store) {
+				/* stored mission, kept inactive until activated by command */
+				_transfer_dataman_id = store_dataman_id;
+
+			} else {
+				_transfer_dataman_id = _dataman_id == 0 ? 1 : 0;	// use inactive storage for transmission
+			}
+
+			/* the slot is overwritten now, it must not be activated unless the upload completes */
+			update_stored_mission(_transfer_dataman_id, 0, 0);
 
 		} else if (_state == MAVLINK_WPM_STATE_GETLIST) {
 			_time_last_recv = hrt_absolute_time();
@@ -722,7 +856,8 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			return;
 		}
 
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		_transfer_window.rerequest_missing();
+		send_mission_requests();
 	}
 }
 
@@ -763,8 +898,8 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 		if (_state == MAVLINK_WPM_STATE_GETLIST) {
 			_time_last_recv = hrt_absolute_time();
 
-			if (wp.seq != _transfer_seq) {
-				if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: seq %u was not the expected %u", wp.seq, _transfer_seq); }
+			if (wp.seq < _transfer_window.first_missing() || wp.seq >= _transfer_count) {
+				if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: seq %u was not the expected %u", wp.seq, _transfer_window.first_missing()); }
 
 				/* don't send request here, it will be performed in eventloop after timeout */
 				return;
@@ -798,16 +933,10 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 			return;
 		}
 
-		dm_item_t dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_transfer_dataman_id);
-
-		if (dm_write(dm_item, wp.seq, DM_PERSIST_POWER_ON_RESET, &mission_item,
-			     sizeof(struct mission_item_s)) != sizeof(struct mission_item_s)) {
-			if (_verbose) { warnx("WPM: MISSION_ITEM ERROR: error writing seq %u to dataman ID %i", wp.seq, _transfer_dataman_id); }
+		/* items may arrive out of order in a windowed transfer, duplicates are dropped */
+		if (!_transfer_window.receive(wp.seq, mission_item)) {
+			if (_verbose) { warnx("WPM: MISSION_ITEM seq %u ignored, duplicate or outside window", wp.seq); }
 
-			send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ERROR);
-			_mavlink->send_statustext_critical("Unable to write on micro SD");
-			_state = MAVLINK_WPM_STATE_IDLE;
-			_transfer_in_progress = false;
 			return;
 		}
 
@@ -818,15 +947,32 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 
 		if (_verbose) { warnx("WPM: MISSION_ITEM seq %u received", wp.seq); }
 
-		_transfer_seq = wp.seq + 1;
+		_transfer_seq = _transfer_window.first_missing();
 
-		if (_transfer_seq == _transfer_count) {
+		/* items are written in batches, so dataman round trips don't slow down the upload */
+		if (_transfer_window.commit_due()) {
+			if (flush_transfer_batch() != PX4_OK) {
+				send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ERROR);
+				_mavlink->send_statustext_critical("Unable to write on micro SD");
+				_state = MAVLINK_WPM_STATE_IDLE;
+				_transfer_in_progress = false;
+				return;
+			}
+		}
+
+		if (_transfer_window.complete()) {
 			/* got all new mission items successfully */
 			if (_verbose) { warnx("WPM: MISSION_ITEM got all %u items, current_seq=%u, changing state to MAVLINK_WPM_STATE_IDLE", _transfer_count, _transfer_current_seq); }
 
 			_state = MAVLINK_WPM_STATE_IDLE;
 
-			if (update_active_mission(_transfer_dataman_id, _transfer_count, _transfer_current_seq) == PX4_OK) {
+			int res = update_stored_mission(_transfer_dataman_id, _transfer_count, _transfer_current_seq);
+
+			if (res == PX4_OK && !_transfer_store) {
+				res = update_active_mission(_transfer_dataman_id, _transfer_count, _transfer_current_seq);
+			}
+
+			if (res == PX4_OK) {
 				send_mission_ack(_transfer_partner_sysid, _transfer_partner_compid, MAV_MISSION_ACCEPTED);
 
 			} else {
@@ -836,8 +982,8 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 			_transfer_in_progress = false;
 
 		} else {
-			/* request next item */
-			send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+			/* keep the request window full */
+			send_mission_requests();
 		}
 	}
 }
@@ -872,6 +1018,52 @@ MavlinkMissionManager::handle_mission_clear_all(const mavlink_message_t *msg)
 	}
 }
 
+void
+MavlinkMissionManager::handle_mission_storage_command(const mavlink_message_t *msg)
+{
+	mavlink_command_long_t cmd;
+	mavlink_msg_command_long_decode(msg, &cmd);
+
+	if (cmd.command != vehicle_command_s::VEHICLE_CMD_MISSION_STORAGE || !CHECK_SYSID_COMPID_MISSION(cmd)) {
+		return;
+	}
+
+	const int action = (int)(cmd.param1 + 0.5f);
+	const int dataman_id = (int)(cmd.param2 + 0.5f);
+	uint8_t result = MAV_RESULT_ACCEPTED;
+
+	if (_state != MAVLINK_WPM_STATE_IDLE || _transfer_in_progress) {
+		result = MAV_RESULT_TEMPORARILY_REJECTED;
+
+	} else if (action == 0) {
+		/* slots 0 and 1 alternate on regular uploads, only the others keep a mission */
+		if (dataman_id < 2 || dataman_id >= DM_NUM_OFFBOARD_MISSIONS || dataman_id == _dataman_id) {
+			result = MAV_RESULT_DENIED;
+
+		} else {
+			_store_dataman_id = dataman_id;
+
+			if (_verbose) { warnx("WPM: next upload is stored in slot %d", dataman_id); }
+		}
+
+	} else if (action == 1) {
+		if (activate_stored_mission(dataman_id) != PX4_OK) {
+			result = MAV_RESULT_FAILED;
+
+		} else if (_verbose) {
+			warnx("WPM: activated mission slot %d, %u items", dataman_id, _count);
+		}
+
+	} else {
+		result = MAV_RESULT_UNSUPPORTED;
+	}
+
+	mavlink_command_ack_t ack;
+	ack.command = cmd.command;
+	ack.result = result;
+	mavlink_msg_command_ack_send_struct(_mavlink->get_channel(), &ack);
+}
+
 int
 MavlinkMissionManager::parse_mavlink_mission_item(const mavlink_mission_item_t *mavlink_mission_item,
 						  struct mission_item_s *mission_item)
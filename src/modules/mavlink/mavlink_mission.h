@@ -43,8 +43,11 @@
 #pragma once
 
 #include <uORB/uORB.h>
+#include <navigator/navigation.h>
+#include <systemlib/param/param.h>
 
 #include "mavlink_bridge_header.h"
+#include "mavlink_mission_window.h"
 #include "mavlink_rate_limiter.h"
 #include "mavlink_stream.h"
 
@@ -130,6 +133,12 @@ private:
 	unsigned		_transfer_partner_sysid;		///< Partner system ID for current transmission
 	unsigned		_transfer_partner_compid;		///< Partner component ID for current transmission
 	static bool		_transfer_in_progress;			///< Global variable checking for current transmission
+	bool			_transfer_store;			///< Current transmission goes to a stored slot and is not activated
+	int			_store_dataman_id;			///< Slot for the next upload to be stored without activating it, -1 if none
+
+	MavlinkMissionWindow	_transfer_window;			///< Outstanding requests and received items not yet written to dataman
+	unsigned		_window_size;				///< Items in flight per transfer, 1 for the standard protocol
+	param_t			_param_window;
 
 	int			_offboard_mission_sub;
 	int			_mission_result_sub;
@@ -150,6 +159,31 @@ private:
 
 	int update_active_mission(int dataman_id, unsigned count, int seq);
 
+	/**
+	 *  @brief Remember the mission stored in a dataman slot so it can be activated later
+	 */
+	int update_stored_mission(int dataman_id, unsigned count, int seq);
+
+	/**
+	 *  @brief Make a stored mission the active one, only the mission state is rewritten
+	 */
+	int activate_stored_mission(int dataman_id);
+
+	/**
+	 *  @brief Write the contiguous received items of the current transmission to dataman
+	 */
+	int flush_transfer_batch();
+
+	/**
+	 *  @brief Read the transfer window size from MAV_MIS_WINDOW
+	 */
+	void update_window_size();
+
+	/**
+	 *  @brief Fill the request window of the current transmission
+	 */
+	void send_mission_requests();
+
 	/**
 	 *  @brief Sends an waypoint ack message
 	 */
@@ -199,6 +233,11 @@ private:
 
 	void handle_mission_clear_all(const mavlink_message_t *msg);
 
+	/**
+	 *  @brief Handles VEHICLE_CMD_MISSION_STORAGE to store uploads in or activate stored mission slots
+	 */
+	void handle_mission_storage_command(const mavlink_message_t *msg);
+
 	/**
 	 * Parse mavlink MISSION_ITEM message to get mission_item_s.
 	 *
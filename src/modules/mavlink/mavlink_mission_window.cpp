@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_mission_window.cpp
+ * Reorder buffer for windowed mission uploads.
+ */
+
+#include "mavlink_mission_window.h"
+
+#include <string.h>
+
+MavlinkMissionWindow::MavlinkMissionWindow() :
+	_received(0),
+	_requested(0),
+	_base(0),
+	_ready(0),
+	_count(0),
+	_window(1)
+{
+}
+
+void
+MavlinkMissionWindow::reset(unsigned count, unsigned window)
+{
+	_received = 0;
+	_requested = 0;
+	_base = 0;
+	_ready = 0;
+	_count = count;
+	_window = (window < 1) ? 1 : (window > MAX_SIZE ? MAX_SIZE : window);
+}
+
+bool
+MavlinkMissionWindow::next_request(unsigned *seq)
+{
+	/* The window starts at the first missing item, and must fit into the buffer */
+	unsigned end = _ready + _window;
+
+	if (end > _slots()) {
+		end = _slots();
+	}
+
+	for (unsigned i = _ready; i < end; i++) {
+		const uint32_t bit = 1u << i;
+
+		if (!(_received & bit) && !(_requested & bit)) {
+			_requested |= bit;
+			*seq = _base + i;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void
+MavlinkMissionWindow::rerequest_missing()
+{
+	_requested = 0;
+}
+
+bool
+MavlinkMissionWindow::receive(unsigned seq, const struct mission_item_s &item)
+{
+	if (seq < _base || seq >= _base + _slots()) {
+		return false;
+	}
+
+	const unsigned i = seq - _base;
+	const uint32_t bit = 1u << i;
+
+	if (_received & bit) {
+		return false;
+	}
+
+	_items[i] = item;
+	_received |= bit;
+	_requested &= ~bit;
+
+	while (_ready < MAX_SIZE && (_received & (1u << _ready))) {
+		_ready++;
+	}
+
+	return true;
+}
+
+bool
+MavlinkMissionWindow::commit_due() const
+{
+	return _ready >= MAX_SIZE / 2 || (_ready > 0 && _base + _ready == _count);
+}
+
+void
+MavlinkMissionWindow::commit()
+{
+	if (_ready == 0) {
+		return;
+	}
+
+	/* Move the items received out of order to the front */
+	memmove(&_items[0], &_items[_ready], (MAX_SIZE - _ready) * sizeof(_items[0]));
+
+	_received = (_ready < 32) ? _received >> _ready : 0;
+	_requested = (_ready < 32) ? _requested >> _ready : 0;
+	_base += _ready;
+	_ready = 0;
+
+	while (_ready < MAX_SIZE && (_received & (1u << _ready))) {
+		_ready++;
+	}
+}
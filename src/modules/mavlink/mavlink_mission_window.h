@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_mission_window.h
+ * Reorder buffer for windowed mission uploads.
+ *
+ * The vehicle keeps up to a window of MISSION_REQUESTs outstanding. Items may arrive in
+ * any order, missing ones are requested again, and contiguous runs are handed out in
+ * sequence order to be written to dataman in batches. With a window of one this is the
+ * standard one item at a time protocol.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <navigator/navigation.h>
+
+class MavlinkMissionWindow
+{
+public:
+	static constexpr unsigned MAX_SIZE = 16;	///< Reorder buffer capacity in items, also the largest window
+
+	MavlinkMissionWindow();
+
+	/**
+	 * Start a new transfer.
+	 *
+	 * @param count		number of items in the transfer
+	 * @param window	number of requests to keep outstanding, clamped to [1, MAX_SIZE]
+	 */
+	void reset(unsigned count, unsigned window);
+
+	/**
+	 * Get the next item to request. Call repeatedly until it returns false to fill the window.
+	 */
+	bool next_request(unsigned *seq);
+
+	/**
+	 * Mark all items in the window that were requested but not received as not requested,
+	 * so next_request() hands them out again. Used after a retry timeout.
+	 */
+	void rerequest_missing();
+
+	/**
+	 * Store a received item.
+	 *
+	 * @return false if the item is outside the window or was already received
+	 */
+	bool receive(unsigned seq, const struct mission_item_s &item);
+
+	/**
+	 * True if the contiguous received items should be written now: either half the buffer
+	 * is filled or the transfer is complete.
+	 */
+	bool commit_due() const;
+
+	unsigned commit_seq() const { return _base; }		///< Sequence of the first ready item
+	unsigned ready() const { return _ready; }			///< Number of contiguous received items
+	const struct mission_item_s *items() const { return _items; }	///< The ready items, in order
+
+	/**
+	 * Drop the ready items after they were written.
+	 */
+	void commit();
+
+	/**
+	 * True if all items were received and committed.
+	 */
+	bool complete() const { return _base == _count; }
+
+	/**
+	 * Sequence of the first item not received yet, equal to the count once all arrived.
+	 */
+	unsigned first_missing() const { return _base + _ready; }
+
+private:
+	struct mission_item_s _items[MAX_SIZE];	///< Item for _base + i in slot i
+	uint32_t	_received;			///< Bit i set if _items[i] is valid
+	uint32_t	_requested;			///< Bit i set if _base + i was requested and not received
+	unsigned	_base;				///< Sequence of _items[0]
+	unsigned	_ready;				///< Number of contiguous valid items from slot 0
+	unsigned	_count;
+	unsigned	_window;
+
+	/* Buffer slots usable for the transfer, the tail of the transfer may be shorter */
+	unsigned _slots() const { return (_count - _base < MAX_SIZE) ? _count - _base : MAX_SIZE; }
+};
@@ -56,7 +56,11 @@ MavlinkOrbSubscription::MavlinkOrbSubscription(const orb_id_t topic, int instanc
 	_instance(instance),
 	_published(false),
 	_subscribe_from_beginning(false),
-	_last_pub_check(0)
+	_last_pub_check(0),
+	_generation(nullptr),
+	_last_generation(0),
+	_stat_generation(0),
+	_time_topic(0)
 {
 }
 
@@ -89,9 +93,20 @@ MavlinkOrbSubscription::update(uint64_t *time, void *data)
 
 	uint64_t time_topic;
 
-	if (orb_stat(_fd, &time_topic)) {
-		/* error getting last topic publication time */
-		time_topic = 0;
+	if (_generation != nullptr && *_generation == _stat_generation) {
+		/* not published since the last orb_stat, no need to ask again */
+		time_topic = _time_topic;
+
+	} else {
+		const unsigned generation = (_generation != nullptr) ? *_generation : 0;
+
+		if (orb_stat(_fd, &time_topic)) {
+			/* error getting last topic publication time */
+			time_topic = 0;
+		}
+
+		_stat_generation = generation;
+		_time_topic = time_topic;
 	}
 
 	if (update(data)) {
@@ -137,12 +152,24 @@ MavlinkOrbSubscription::update_if_changed(void *data)
 		return false;
 	}
 
+	// Nothing was published since orb_check last reported no update,
+	// so we can skip the ioctl
+	const unsigned generation = (_generation != nullptr) ? *_generation : 0;
+
+	if (_generation != nullptr && generation == _last_generation && prevpub == _published) {
+		return false;
+	}
+
 	bool updated;
 
 	if (orb_check(_fd, &updated)) {
 		return false;
 	}
 
+	if (!updated) {
+		_last_generation = generation;
+	}
+
 	// If we didn't update and this topic did not change
 	// its publication status then nothing really changed
 	if (!updated && prevpub == _published) {
@@ -190,6 +217,12 @@ MavlinkOrbSubscription::is_published()
 	}
 #endif
 
+	if (_generation == nullptr && _fd >= 0 && orb_get_generation(_fd, &_generation) == PX4_OK) {
+		// differ from the current generation, so that the first checks go to the topic
+		_last_generation = *_generation - 1;
+		_stat_generation = _last_generation;
+	}
+
 	bool updated;
 	orb_check(_fd, &updated);
 
@@ -100,6 +100,10 @@ private:
 	bool _published;		///< topic was ever published
 	bool _subscribe_from_beginning; ///< we need to subscribe from the beginning, e.g. for vehicle_command_acks
 	hrt_abstime _last_pub_check;	///< when we checked last
+	const volatile unsigned *_generation;	///< generation counter of the topic, read without ioctl
+	unsigned _last_generation;	///< generation at which orb_check last reported no update
+	unsigned _stat_generation;	///< generation at which _time_topic was read
+	uint64_t _time_topic;		///< last publication time from orb_stat
 
 	/* do not allow copying this class */
 	MavlinkOrbSubscription(const MavlinkOrbSubscription &);
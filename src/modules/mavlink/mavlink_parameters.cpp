@@ -48,9 +48,13 @@
 #include "mavlink_main.h"
 
 #define HASH_PARAM "_HASH_CHECK"
+#define EPOCH_PARAM "_PARAM_EPOCH"
 
 MavlinkParametersManager::MavlinkParametersManager(Mavlink *mavlink) : MavlinkStream(mavlink),
 	_send_all_index(-1),
+	_send_since_epoch(0),
+	_send_epoch(0),
+	_send_epoch_pending(false),
 	_rc_param_map_pub(nullptr),
 	_rc_param_map(),
 	_uavcan_parameter_request_pub(nullptr),
@@ -98,6 +102,9 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 					/* a restart should skip the hash check on the ground */
 					_send_all_index = 0;
 				}
+
+				_send_since_epoch = 0;
+				_send_epoch_pending = false;
 			}
 
 			if (req_list.target_system == mavlink_system.sysid && req_list.target_component < 127 &&
@@ -140,6 +147,13 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 					return;
 				}
 
+				if (strncmp(name, EPOCH_PARAM, sizeof(name)) == 0) {
+					uint32_t epoch;
+					memcpy(&epoch, &set.param_value, sizeof(epoch));
+					start_send_since(epoch);
+					return;
+				}
+
 				/* attempt to find parameter, set and send it */
 				param_t param = param_find_no_notification(name);
 
@@ -221,6 +235,9 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 						memcpy(&param_value.param_value, &hash, sizeof(hash));
 						mavlink_msg_param_value_send_struct(_mavlink->get_channel(), &param_value);
 
+					} else if (strncmp(req_read.param_id, EPOCH_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN) == 0) {
+						send_epoch(param_epoch());
+
 					} else {
 						/* local name buffer to enforce null-terminated string */
 						char name[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 1];
@@ -354,6 +371,11 @@ MavlinkParametersManager::send(const hrt_abstime t)
 		mavlink_msg_param_value_encode_chan(mavlink_system.sysid, value.node_id, _mavlink->get_channel(), &mavlink_packet, &msg);
 		_mavlink_resend_uart(_mavlink->get_channel(), &mavlink_packet);
 
+	} else if (_send_epoch_pending && space_available) {
+		/* the modified params are out, tell the ground where to continue */
+		send_epoch(_send_epoch);
+		_send_epoch_pending = false;
+
 	} else if (_send_all_index >= 0 && _mavlink->boot_complete()) {
 		/* send all parameters if requested, but only after the system has booted */
 
@@ -385,14 +407,15 @@ MavlinkParametersManager::send(const hrt_abstime t)
 			return;
 		}
 
-		/* look for the first parameter which is used */
+		/* look for the first parameter which is used (and modified, if requested) */
 		param_t p;
 
 		do {
 			/* walk through all parameters, including unused ones */
 			p = param_for_index(_send_all_index);
 			_send_all_index++;
-		} while (p != PARAM_INVALID && !param_used(p));
+		} while (p != PARAM_INVALID && (!param_used(p) ||
+						(_send_since_epoch > 0 && param_get_epoch(p) <= _send_since_epoch)));
 
 		if (p != PARAM_INVALID) {
 			send_param(p);
@@ -400,6 +423,11 @@ MavlinkParametersManager::send(const hrt_abstime t)
 
 		if ((p == PARAM_INVALID) || (_send_all_index >= (int) param_count())) {
 			_send_all_index = -1;
+
+			if (_send_since_epoch > 0) {
+				_send_since_epoch = 0;
+				_send_epoch_pending = true;
+			}
 		}
 
 	} else if (_send_all_index == PARAM_HASH && hrt_absolute_time() > 20 * 1000 * 1000) {
@@ -409,6 +437,38 @@ MavlinkParametersManager::send(const hrt_abstime t)
 	}
 }
 
+void
+MavlinkParametersManager::start_send_since(uint32_t epoch)
+{
+	uint32_t current = param_epoch();
+
+	if (!param_epoch_current_boot(epoch)) {
+		/* not a cache of this boot: full list */
+		_send_since_epoch = 0;
+		_send_all_index = PARAM_HASH;
+
+	} else {
+		/* params modified while sending have a later epoch and go out next time */
+		_send_since_epoch = epoch;
+		_send_epoch = current;
+		_send_all_index = 0;
+	}
+
+	_send_epoch_pending = false;
+}
+
+void
+MavlinkParametersManager::send_epoch(uint32_t epoch)
+{
+	mavlink_param_value_t msg;
+	msg.param_count = param_count_used();
+	msg.param_index = -1;
+	strncpy(msg.param_id, EPOCH_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
+	msg.param_type = MAV_PARAM_TYPE_UINT32;
+	memcpy(&msg.param_value, &epoch, sizeof(epoch));
+	mavlink_msg_param_value_send_struct(_mavlink->get_channel(), &msg);
+}
+
 int
 MavlinkParametersManager::send_param(param_t param, int component_id)
 {
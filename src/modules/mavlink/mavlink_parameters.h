@@ -48,6 +48,20 @@
 #include <uORB/uORB.h>
 #include <uORB/topics/rc_parameter_map.h>
 
+/**
+ * Parameter protocol, with an extension for ground stations which keep a cache
+ * of the parameters across connections:
+ *
+ * - PARAM_REQUEST_READ of _PARAM_EPOCH returns the current modification
+ *   epoch (see param_epoch()) as PARAM_VALUE of type UINT32, index -1.
+ * - PARAM_SET of _PARAM_EPOCH with the epoch of the cache (UINT32 in the
+ *   value bytes) streams only the used parameters modified since, followed by
+ *   _PARAM_EPOCH with the epoch to use next time. The ground station then
+ *   validates the cache with _HASH_CHECK, which covers the parameters changed
+ *   before a reboot.
+ * - If the epoch is unknown (0, from an earlier boot, or the vehicle does not
+ *   track epochs) the full list is sent as for PARAM_REQUEST_LIST.
+ */
 class MavlinkParametersManager : public MavlinkStream
 {
 public:
@@ -79,6 +93,9 @@ public:
 
 private:
 	int		_send_all_index;
+	uint32_t	_send_since_epoch;	///< only send params modified after this epoch, 0 for all
+	uint32_t	_send_epoch;		///< epoch reported after the modified params
+	bool		_send_epoch_pending;
 
 	/* do not allow top copying this class */
 	MavlinkParametersManager(MavlinkParametersManager &);
@@ -92,6 +109,10 @@ protected:
 
 	int send_param(param_t param, int component_id=-1);
 
+	void send_epoch(uint32_t epoch);
+
+	void start_send_since(uint32_t epoch);
+
 	orb_advert_t _rc_param_map_pub;
 	struct rc_parameter_map_s _rc_param_map;
 
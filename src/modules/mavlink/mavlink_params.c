@@ -111,6 +111,20 @@ PARAM_DEFINE_INT32(MAV_FWDEXTSP, 1);
  */
 PARAM_DEFINE_INT32(MAV_BROADCAST, 0);
 
+/**
+ * Mission transfer window
+ *
+ * Number of mission items requested ahead during a mission upload. Items may then
+ * arrive out of order and lost ones are requested again, which speeds up transfers
+ * over links with high latency. During a download, requests for any item are served.
+ * 1 is the standard protocol, one item at a time.
+ *
+ * @min 1
+ * @max 16
+ * @group MAVLink
+ */
+PARAM_DEFINE_INT32(MAV_MIS_WINDOW, 1);
+
 /**
  * Test parameter
  *
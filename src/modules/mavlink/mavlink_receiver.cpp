@@ -414,7 +414,15 @@ MavlinkReceiver::handle_message_command_long(mavlink_message_t *msg)
 				// mavlink channel streaming was requested. But in fact it's possible that the logger is
 				// not even running. The main mavlink thread takes care of this by waiting for an ack
 				// from the logger.
-				_mavlink->try_start_ulog_streaming(msg->sysid, msg->compid);
+				// param2 is reserved (0): acked data goes out stop-and-wait, in order. A ground station
+				// that orders the log by sequence can allow more messages in flight with it.
+				unsigned ack_window = 1;
+
+				if (PX4_ISFINITE(cmd_mavlink.param2) && cmd_mavlink.param2 >= 2.0f) {
+					ack_window = (unsigned)math::min(cmd_mavlink.param2, (float)MavlinkULogWindow::MAX_SIZE);
+				}
+
+				_mavlink->try_start_ulog_streaming(msg->sysid, msg->compid, ack_window);
 
 			} else if (cmd_mavlink.command == MAV_CMD_LOGGING_STOP) {
 				_mavlink->request_stop_ulog_streaming();
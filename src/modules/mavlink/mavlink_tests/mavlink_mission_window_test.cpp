@@ -0,0 +1,277 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/// @file mavlink_mission_window_test.cpp
+///	Tests the windowed mission upload reorder buffer over a simulated lossy link.
+
+#include <string.h>
+
+#include "mavlink_mission_window_test.h"
+
+/// Item content for a sequence number, so the receiver can verify order and integrity
+static void make_item(unsigned seq, struct mission_item_s *item)
+{
+	memset(item, 0, sizeof(*item));
+	item->lat = 47.0 + seq * 1e-5;
+	item->lon = 8.0 - seq * 1e-5;
+	item->nav_cmd = NAV_CMD_WAYPOINT;
+	item->do_jump_mission_index = seq;
+}
+
+/// Deterministic pseudo random numbers, the link behaves the same in every run
+static unsigned next_random(uint32_t *state)
+{
+	*state = *state * 1103515245u + 12345u;
+	return (*state >> 16) & 0x7fff;
+}
+
+MavlinkMissionWindowTest::TransferResult
+MavlinkMissionWindowTest::_transfer(unsigned count, unsigned window, unsigned loss_percent, unsigned latency,
+				    unsigned timeout)
+{
+	/// A message in flight on the simulated link
+	struct Packet {
+		unsigned	deliver_at;
+		unsigned	seq;
+		bool		is_request;
+	};
+
+	static const unsigned max_in_flight = 2 * MavlinkMissionWindow::MAX_SIZE * 4;
+	Packet link[max_in_flight];
+	unsigned in_flight = 0;
+
+	uint32_t random_state = 42;
+	MavlinkMissionWindow vehicle;
+	TransferResult result = { false, 0, 0 };
+	unsigned next_commit = 0;
+	unsigned last_progress = 0;
+	bool content_ok = true;
+
+	vehicle.reset(count, window);
+
+	for (unsigned now = 0; now < 100000; now++) {
+		/* vehicle keeps its window full */
+		unsigned seq;
+
+		while (vehicle.next_request(&seq)) {
+			result.requests++;
+
+			if (next_random(&random_state) % 100 >= loss_percent && in_flight < max_in_flight) {
+				link[in_flight++] = { now + latency, seq, true };
+			}
+		}
+
+		/* deliver due packets, the GCS answers every request with the item */
+		for (unsigned i = 0; i < in_flight;) {
+			if (link[i].deliver_at > now) {
+				i++;
+				continue;
+			}
+
+			Packet p = link[i];
+			link[i] = link[--in_flight];
+
+			if (p.is_request) {
+				if (next_random(&random_state) % 100 >= loss_percent && in_flight < max_in_flight) {
+					/* random extra delay reorders the replies */
+					link[in_flight++] = { now + latency + next_random(&random_state) % 3, p.seq, false };
+				}
+
+			} else {
+				struct mission_item_s item;
+				make_item(p.seq, &item);
+
+				if (vehicle.receive(p.seq, item)) {
+					last_progress = now;
+				}
+
+				if (vehicle.commit_due()) {
+					for (unsigned k = 0; k < vehicle.ready(); k++) {
+						content_ok = content_ok && vehicle.commit_seq() + k == next_commit &&
+							     vehicle.items()[k].do_jump_mission_index == (int)next_commit;
+						next_commit++;
+					}
+
+					vehicle.commit();
+				}
+			}
+		}
+
+		if (vehicle.complete()) {
+			result.complete = content_ok && next_commit == count;
+			result.ticks = now;
+			return result;
+		}
+
+		/* nothing arrived for a while, ask again for what is missing */
+		if (now - last_progress > timeout) {
+			vehicle.rerequest_missing();
+			last_progress = now;
+		}
+	}
+
+	return result;
+}
+
+bool MavlinkMissionWindowTest::_standard_protocol_test(void)
+{
+	MavlinkMissionWindow window;
+	struct mission_item_s item;
+	unsigned seq;
+
+	window.reset(3, 1);
+
+	for (unsigned i = 0; i < 3; i++) {
+		/* exactly one outstanding request, like the standard protocol */
+		ut_assert_true(window.next_request(&seq));
+		ut_compare("requested seq", seq, i);
+		ut_assert_false(window.next_request(&seq));
+
+		make_item(i, &item);
+		ut_assert_true(window.receive(i, item));
+	}
+
+	ut_assert_true(window.commit_due());
+	ut_compare("ready items", window.ready(), 3);
+	window.commit();
+	ut_assert_true(window.complete());
+
+	return true;
+}
+
+bool MavlinkMissionWindowTest::_out_of_order_test(void)
+{
+	MavlinkMissionWindow window;
+	struct mission_item_s item;
+	unsigned seq;
+
+	window.reset(4, 4);
+
+	for (unsigned i = 0; i < 4; i++) {
+		ut_assert_true(window.next_request(&seq));
+		ut_compare("requested seq", seq, i);
+	}
+
+	ut_assert_false(window.next_request(&seq));
+
+	const unsigned order[] = { 3, 1, 2, 0 };
+
+	for (unsigned i = 0; i < 3; i++) {
+		make_item(order[i], &item);
+		ut_assert_true(window.receive(order[i], item));
+
+		/* item 0 is still missing, nothing can be written yet */
+		ut_compare("ready items", window.ready(), 0);
+		ut_assert_false(window.commit_due());
+	}
+
+	make_item(0, &item);
+	ut_assert_true(window.receive(0, item));
+	ut_compare("ready items", window.ready(), 4);
+
+	for (unsigned i = 0; i < 4; i++) {
+		ut_compare("item order", window.items()[i].do_jump_mission_index, i);
+	}
+
+	window.commit();
+	ut_assert_true(window.complete());
+
+	return true;
+}
+
+bool MavlinkMissionWindowTest::_duplicate_test(void)
+{
+	MavlinkMissionWindow window;
+	struct mission_item_s item;
+	unsigned seq;
+
+	window.reset(MavlinkMissionWindow::MAX_SIZE * 2, 2);
+
+	make_item(0, &item);
+	ut_assert_true(window.receive(0, item));
+	ut_assert_false(window.receive(0, item));
+
+	/* beyond the buffer */
+	make_item(MavlinkMissionWindow::MAX_SIZE, &item);
+	ut_assert_false(window.receive(MavlinkMissionWindow::MAX_SIZE, item));
+
+	/* a lost request is handed out again after rerequest_missing() */
+	ut_assert_true(window.next_request(&seq));
+	ut_compare("requested seq", seq, 1);
+	ut_assert_true(window.next_request(&seq));
+	ut_compare("requested seq", seq, 2);
+	ut_assert_false(window.next_request(&seq));
+	window.rerequest_missing();
+	ut_assert_true(window.next_request(&seq));
+	ut_compare("re-requested seq", seq, 1);
+
+	return true;
+}
+
+bool MavlinkMissionWindowTest::_lossy_link_test(void)
+{
+	const unsigned count = 200;
+	const unsigned latency = 10;
+	const unsigned timeout = 3 * latency;
+
+	/* a clean link, the window divides the round trips */
+	TransferResult standard = _transfer(count, 1, 0, latency, timeout);
+	TransferResult windowed = _transfer(count, MavlinkMissionWindow::MAX_SIZE, 0, latency, timeout);
+
+	ut_assert_true(standard.complete);
+	ut_assert_true(windowed.complete);
+	ut_compare("requests without loss", standard.requests, count);
+	ut_assert("windowed transfer is faster", windowed.ticks * 4 < standard.ticks);
+
+	/* 20% of all messages lost, items must still arrive complete and in order */
+	standard = _transfer(count, 1, 20, latency, timeout);
+	windowed = _transfer(count, MavlinkMissionWindow::MAX_SIZE, 20, latency, timeout);
+
+	ut_assert_true(standard.complete);
+	ut_assert_true(windowed.complete);
+	ut_assert("windowed transfer is faster on a lossy link", windowed.ticks * 4 < standard.ticks);
+
+	return true;
+}
+
+bool MavlinkMissionWindowTest::run_tests(void)
+{
+	ut_run_test(_standard_protocol_test);
+	ut_run_test(_out_of_order_test);
+	ut_run_test(_duplicate_test);
+	ut_run_test(_lossy_link_test);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test(mavlink_mission_window_test, MavlinkMissionWindowTest)
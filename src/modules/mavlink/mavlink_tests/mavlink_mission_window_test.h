@@ -0,0 +1,73 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/// @file mavlink_mission_window_test.h
+///	Tests the windowed mission upload reorder buffer over a simulated lossy link.
+
+#pragma once
+
+#include <unit_test/unit_test.h>
+#include "../mavlink_mission_window.h"
+
+class MavlinkMissionWindowTest : public UnitTest
+{
+public:
+	MavlinkMissionWindowTest() = default;
+	virtual ~MavlinkMissionWindowTest() = default;
+
+	virtual bool run_tests(void);
+
+	// We don't want any of these
+	MavlinkMissionWindowTest(const MavlinkMissionWindowTest &);
+	MavlinkMissionWindowTest &operator=(const MavlinkMissionWindowTest &);
+
+private:
+	bool _standard_protocol_test(void);
+	bool _out_of_order_test(void);
+	bool _duplicate_test(void);
+	bool _lossy_link_test(void);
+
+	/// Result of a simulated transfer
+	struct TransferResult {
+		bool		complete;	///< all items committed, in order and with the right content
+		unsigned	ticks;		///< simulated time the transfer took
+		unsigned	requests;	///< MISSION_REQUESTs sent by the vehicle
+	};
+
+	/// Upload count items over a link dropping loss_percent of all messages in either direction,
+	/// each message takes latency ticks, the vehicle re-requests missing items after timeout ticks.
+	TransferResult _transfer(unsigned count, unsigned window, unsigned loss_percent, unsigned latency,
+				 unsigned timeout);
+};
+
+bool mavlink_mission_window_test(void);
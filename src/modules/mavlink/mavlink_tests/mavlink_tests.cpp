@@ -38,10 +38,16 @@
 #include <systemlib/err.h>
 
 #include "mavlink_ftp_test.h"
+#include "mavlink_mission_window_test.h"
+#include "mavlink_ulog_window_test.h"
 
 extern "C" __EXPORT int mavlink_tests_main(int argc, char *argv[]);
 
 int mavlink_tests_main(int argc, char *argv[])
 {
-	return mavlink_ftp_test() ? 0 : -1;
+	bool ftp_ok = mavlink_ftp_test();
+	bool mission_window_ok = mavlink_mission_window_test();
+	bool ulog_window_ok = mavlink_ulog_window_test();
+
+	return (ftp_ok && mission_window_ok && ulog_window_ok) ? 0 : -1;
 }
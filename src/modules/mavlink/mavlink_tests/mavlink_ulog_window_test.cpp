@@ -0,0 +1,305 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/// @file mavlink_ulog_window_test.cpp
+///	Tests the ULog send window and measures the streaming rate over a simulated link.
+
+#include <errno.h>
+#include <string.h>
+
+#include "mavlink_ulog_window_test.h"
+
+/// Message with a recognizable payload for a sequence number
+static void make_message(uint16_t sequence, ulog_stream_s *msg)
+{
+	memset(msg, 0, sizeof(*msg));
+	msg->sequence = sequence;
+	msg->length = sizeof(msg->data);
+	msg->flags = ulog_stream_s::FLAGS_NEED_ACK;
+	msg->data[0] = sequence & 0xff;
+}
+
+/// Deterministic pseudo random numbers, the link behaves the same in every run
+static unsigned next_random(uint32_t *state)
+{
+	*state = *state * 1103515245u + 12345u;
+	return (*state >> 16) & 0x7fff;
+}
+
+MavlinkULogWindowTest::StreamResult
+MavlinkULogWindowTest::_stream(unsigned count, unsigned window, unsigned loss_percent, hrt_abstime latency)
+{
+	/// A message in flight on the simulated link
+	struct Packet {
+		hrt_abstime	deliver_at;
+		uint16_t	sequence;
+		bool		is_ack;
+	};
+
+	static const unsigned max_in_flight = 4 * MavlinkULogWindow::MAX_SIZE;
+	static const hrt_abstime update_interval = 10000;
+	Packet link[max_in_flight];
+	unsigned in_flight = 0;
+
+	uint32_t random_state = 42;
+	MavlinkULogWindow sender;
+	StreamResult result = { false, 0, 0.f, 0 };
+	uint16_t next_sequence = 0;
+
+	sender.reset(window);
+
+	for (hrt_abstime now = update_interval; now < 600 * 1000000ull; now += update_interval) {
+		/* deliver due packets, the receiver acks every data message, also duplicates */
+		for (unsigned i = 0; i < in_flight;) {
+			if (link[i].deliver_at > now) {
+				i++;
+				continue;
+			}
+
+			Packet p = link[i];
+			link[i] = link[--in_flight];
+
+			if (p.is_ack) {
+				sender.ack(p.sequence, now);
+
+			} else if (next_random(&random_state) % 100 >= loss_percent && in_flight < max_in_flight) {
+				link[in_flight++] = { now + latency, p.sequence, true };
+			}
+		}
+
+		if (sender.acked() == count) {
+			result.complete = true;
+			result.duration = now;
+			result.rate = count * sizeof(ulog_stream_s::data) / (now / 1e6f);
+			result.retransmissions = sender.retransmissions();
+			return result;
+		}
+
+		/* one message per update: a retransmission if one is due, otherwise a new one */
+		const ulog_stream_s *resend;
+		ulog_stream_s msg;
+		int ret = sender.retransmission(now, &resend);
+
+		if (ret < 0) {
+			return result;
+
+		} else if (ret > 0) {
+			msg = *resend;
+
+		} else if (next_sequence < count && sender.can_send()) {
+			make_message(next_sequence++, &msg);
+			sender.sent(msg, now);
+
+		} else {
+			continue;
+		}
+
+		if (next_random(&random_state) % 100 >= loss_percent && in_flight < max_in_flight) {
+			link[in_flight++] = { now + latency, msg.sequence, false };
+		}
+	}
+
+	return result;
+}
+
+bool MavlinkULogWindowTest::_selective_ack_test(void)
+{
+	MavlinkULogWindow window;
+	ulog_stream_s msg;
+
+	window.reset();
+
+	/* slow start: one message, then one more per ack */
+	make_message(0, &msg);
+	ut_assert_true(window.can_send());
+	ut_assert_true(window.sent(msg, 0));
+	ut_assert_false(window.can_send());
+	ut_assert_true(window.ack(0, 1000));
+	ut_compare("window after first ack", (int)window.congestion_window(), 2);
+
+	for (uint16_t i = 1; i < 3; i++) {
+		make_message(i, &msg);
+		ut_assert_true(window.can_send());
+		ut_assert_true(window.sent(msg, 2000));
+	}
+
+	ut_assert_false(window.can_send());
+
+	/* acks arrive out of order and release exactly their message */
+	ut_assert_true(window.ack(2, 3000));
+	ut_compare("in flight", window.outstanding(), 1);
+	ut_assert_false(window.ack(2, 3000));
+	ut_assert_false(window.ack(7, 3000));
+	ut_assert_true(window.ack(1, 3000));
+	ut_compare("in flight", window.outstanding(), 0);
+	ut_compare("acked", window.acked(), 3);
+
+	/* a full window refuses more messages */
+	window.reset();
+
+	for (uint16_t i = 0; i < MavlinkULogWindow::MAX_SIZE; i++) {
+		make_message(i, &msg);
+		ut_assert_true(window.sent(msg, 0));
+	}
+
+	make_message(MavlinkULogWindow::MAX_SIZE, &msg);
+	ut_assert_false(window.sent(msg, 0));
+
+	return true;
+}
+
+bool MavlinkULogWindowTest::_retransmission_test(void)
+{
+	MavlinkULogWindow window;
+	const ulog_stream_s *resend;
+	ulog_stream_s msg;
+	const hrt_abstime timeout = window.timeout();
+
+	window.reset();
+
+	for (uint16_t i = 0; i < 3; i++) {
+		make_message(i, &msg);
+		ut_assert_true(window.sent(msg, i));
+	}
+
+	ut_compare("nothing due", window.retransmission(timeout - 1, &resend), 0);
+
+	/* message 1 was acked, only 0 and 2 are sent again, oldest first */
+	ut_assert_true(window.ack(1, 10));
+	ut_compare("first due", window.retransmission(timeout + 2, &resend), 1);
+	ut_compare("oldest first", resend->sequence, 0);
+
+	/* the timeout backs off after a loss, so message 2 is due later */
+	ut_compare("timeout backed off", (int)window.timeout(), (int)(2 * timeout));
+	ut_compare("nothing due", window.retransmission(timeout + 2, &resend), 0);
+	ut_compare("second due", window.retransmission(2 * timeout + 2, &resend), 1);
+	ut_compare("then the next", resend->sequence, 2);
+	ut_compare("nothing due", window.retransmission(2 * timeout + 2, &resend), 0);
+	ut_compare("retransmissions", window.retransmissions(), 2);
+
+	return true;
+}
+
+bool MavlinkULogWindowTest::_timeout_test(void)
+{
+	MavlinkULogWindow window;
+	const ulog_stream_s *resend;
+	ulog_stream_s msg;
+	hrt_abstime now = 0;
+
+	/* the retransmission timeout follows the round trip time of a slow link */
+	window.reset();
+
+	for (uint16_t i = 0; i < 20; i++) {
+		make_message(i, &msg);
+		ut_assert_true(window.sent(msg, now));
+		now += 600000;
+		ut_assert_true(window.ack(i, now));
+	}
+
+	ut_compare("round trip time [ms]", (int)(window.round_trip_time() / 1000), 600);
+	ut_assert("timeout above the round trip time", window.timeout() > window.round_trip_time());
+	ut_assert("timeout bounded", window.timeout() <= MavlinkULogWindow::MAX_TIMEOUT);
+
+	/* a message that is never acked fails after ACK_MAX_TRIES */
+	make_message(100, &msg);
+	ut_assert_true(window.sent(msg, now));
+	int ret;
+	int tries = 1;
+
+	do {
+		now += MavlinkULogWindow::MAX_TIMEOUT;
+		ret = window.retransmission(now, &resend);
+
+		if (ret > 0) {
+			tries++;
+		}
+	} while (ret > 0);
+
+	ut_compare("gives up", ret, -ETIMEDOUT);
+	ut_compare("tries", tries, ulog_stream_ack_s::ACK_MAX_TRIES);
+
+	return true;
+}
+
+bool MavlinkULogWindowTest::_streaming_rate_test(void)
+{
+	struct LinkConfig {
+		const char	*name;
+		hrt_abstime	latency;
+		unsigned	loss_percent;
+	};
+
+	const LinkConfig links[] = {
+		{ "local", 5000, 0 },
+		{ "lte", 50000, 0 },
+		{ "lte, 5% loss", 50000, 5 },
+		{ "satellite, 10% loss", 300000, 10 },
+	};
+
+	const unsigned count = 200;
+
+	for (unsigned i = 0; i < sizeof(links) / sizeof(links[0]); i++) {
+		StreamResult standard = _stream(count, 1, links[i].loss_percent, links[i].latency);
+		StreamResult windowed = _stream(count, MavlinkULogWindow::MAX_SIZE, links[i].loss_percent, links[i].latency);
+
+		ut_assert_true(standard.complete);
+		ut_assert_true(windowed.complete);
+
+		PX4_INFO("%s link: stop-and-wait %.1f kB/s (%u retransmissions), window %.1f kB/s (%u retransmissions)",
+			 links[i].name, (double)standard.rate / 1000., (unsigned)standard.retransmissions,
+			 (double)windowed.rate / 1000., (unsigned)windowed.retransmissions);
+
+		ut_assert("window is never slower", windowed.duration <= standard.duration);
+
+		/* with a round trip of many update intervals the window multiplies the rate */
+		if (links[i].latency >= 50000) {
+			ut_assert("window is faster on a high latency link", windowed.rate > 3 * standard.rate);
+		}
+	}
+
+	return true;
+}
+
+bool MavlinkULogWindowTest::run_tests(void)
+{
+	ut_run_test(_selective_ack_test);
+	ut_run_test(_retransmission_test);
+	ut_run_test(_timeout_test);
+	ut_run_test(_streaming_rate_test);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test(mavlink_ulog_window_test, MavlinkULogWindowTest)
@@ -0,0 +1,75 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/// @file mavlink_ulog_window_test.h
+///	Tests the ULog send window and measures the streaming rate over a simulated link.
+
+#pragma once
+
+#include <unit_test/unit_test.h>
+#include "../mavlink_ulog_window.h"
+
+class MavlinkULogWindowTest : public UnitTest
+{
+public:
+	MavlinkULogWindowTest() = default;
+	virtual ~MavlinkULogWindowTest() = default;
+
+	virtual bool run_tests(void);
+
+	// We don't want any of these
+	MavlinkULogWindowTest(const MavlinkULogWindowTest &);
+	MavlinkULogWindowTest &operator=(const MavlinkULogWindowTest &);
+
+private:
+	bool _selective_ack_test(void);
+	bool _retransmission_test(void);
+	bool _timeout_test(void);
+	bool _streaming_rate_test(void);
+
+	/// Result of a simulated stream
+	struct StreamResult {
+		bool		complete;		///< all messages acked
+		hrt_abstime	duration;		///< simulated time the stream took [us]
+		float		rate;			///< achieved ulog payload rate [B/s]
+		uint32_t	retransmissions;
+	};
+
+	/// Stream count messages that need an ack over a link dropping loss_percent of all messages in
+	/// either direction, each message takes latency us. The sender runs every 10 ms like the mavlink
+	/// main loop and may send one message per run, about 25 kB/s.
+	StreamResult _stream(unsigned count, unsigned window, unsigned loss_percent, hrt_abstime latency);
+};
+
+bool mavlink_ulog_window_test(void);
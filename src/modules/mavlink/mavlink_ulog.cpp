@@ -49,7 +49,8 @@ px4_sem_t MavlinkULog::_lock;
 const float MavlinkULog::_rate_calculation_delta_t = 0.1f;
 
 
-MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component)
+MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component,
+		unsigned ack_window)
 	: _target_system(target_system), _target_component(target_component),
 	_max_rate_factor(max_rate_factor),
 	_max_num_messages(math::max(1, (int)ceilf(_rate_calculation_delta_t * _max_rate_factor * datarate /
@@ -62,8 +63,9 @@ MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, uint8_t target_sys
 		PX4_ERR("orb_subscribe failed (%i)", errno);
 	}
 	_waiting_for_initial_ack = true;
-	_last_sent_time = hrt_absolute_time(); //(ab)use this timestamp during initialization
-	_next_rate_check = _last_sent_time + _rate_calculation_delta_t * 1.e6f;
+	_window.reset(ack_window);
+	_start_time = hrt_absolute_time();
+	_next_rate_check = _start_time + _rate_calculation_delta_t * 1.e6f;
 }
 
 MavlinkULog::~MavlinkULog()
@@ -79,89 +81,77 @@ MavlinkULog::~MavlinkULog()
 void MavlinkULog::start_ack_received()
 {
 	if (_waiting_for_initial_ack) {
-		_last_sent_time = 0;
 		_waiting_for_initial_ack = false;
 		PX4_DEBUG("got logger ack");
 	}
 }
 
-int MavlinkULog::handle_update(mavlink_channel_t channel)
+int MavlinkULog::handle_update(mavlink_channel_t channel, unsigned free_tx_buf)
 {
 	static_assert(sizeof(ulog_stream_s::data) == MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN, "Invalid uorb ulog_stream.data length");
 	static_assert(sizeof(ulog_stream_s::data) == MAVLINK_MSG_LOGGING_DATA_ACKED_FIELD_DATA_LEN, "Invalid uorb ulog_stream.data length");
 
 	if (_waiting_for_initial_ack) {
-		if (hrt_elapsed_time(&_last_sent_time) > 3e5) {
+		if (hrt_elapsed_time(&_start_time) > 3e5) {
 			PX4_WARN("no ack from logger (is it running?)");
 			return -1;
 		}
 		return 0;
 	}
 
-	// check if we're waiting for an ACK
-	if (_last_sent_time) {
-		bool check_for_updates = false;
-		if (_ack_received) {
-			_last_sent_time = 0;
-			check_for_updates = true;
-		} else {
+	// only send what fits into the tx buffer, everything else would be dropped by the link
+	const unsigned msg_len = MAVLINK_MSG_ID_LOGGING_DATA_ACKED_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 
-			if (hrt_elapsed_time(&_last_sent_time) > ulog_stream_ack_s::ACK_TIMEOUT * 1000) {
-				if (++_sent_tries > ulog_stream_ack_s::ACK_MAX_TRIES) {
-					return -ETIMEDOUT;
-				} else {
-					PX4_DEBUG("re-sending ulog mavlink message (try=%i)", _sent_tries);
-					_last_sent_time = hrt_absolute_time();
-					mavlink_logging_data_acked_t msg;
-					msg.sequence = _ulog_data.sequence;
-					msg.length = _ulog_data.length;
-					msg.first_message_offset = _ulog_data.first_message_offset;
-					msg.target_system = _target_system;
-					msg.target_component = _target_component;
-					memcpy(msg.data, _ulog_data.data, sizeof(msg.data));
-					mavlink_msg_logging_data_acked_send_struct(channel, &msg);
-				}
-			}
+	// retransmit lost messages first, they are older than anything new
+	while (_current_num_msgs < _max_num_messages && free_tx_buf >= msg_len) {
+		ulog_stream_s resend;
+		const ulog_stream_s *msg;
+		lock();
+		int ret = _window.retransmission(hrt_absolute_time(), &msg);
+		if (ret > 0) {
+			resend = *msg;
 		}
+		unlock();
 
-		if (!check_for_updates) {
-			return 0;
+		if (ret < 0) {
+			return ret;
+		} else if (ret == 0) {
+			break;
 		}
+
+		PX4_DEBUG("re-sending ulog mavlink message %i", resend.sequence);
+		send_message(channel, resend);
+		++_current_num_msgs;
+		free_tx_buf -= msg_len;
 	}
 
-	bool updated = false;
-	int ret = orb_check(_ulog_stream_sub, &updated);
-	while (updated && !ret && _current_num_msgs < _max_num_messages) {
-		orb_copy(ORB_ID(ulog_stream), _ulog_stream_sub, &_ulog_data);
+	while (_current_num_msgs < _max_num_messages && free_tx_buf >= msg_len) {
+		// a message that did not fit into the window last time is still pending
+		if (!_ulog_data_pending) {
+			bool updated = false;
+			int ret = orb_check(_ulog_stream_sub, &updated);
+			if (ret || !updated) {
+				break;
+			}
+			orb_copy(ORB_ID(ulog_stream), _ulog_stream_sub, &_ulog_data);
+			_ulog_data_pending = true;
+		}
+
 		if (_ulog_data.flags & ulog_stream_s::FLAGS_NEED_ACK) {
-			_sent_tries = 1;
-			_last_sent_time = hrt_absolute_time();
 			lock();
-			_wait_for_ack_sequence = _ulog_data.sequence;
-			_ack_received = false;
+			bool added = _window.can_send() && _window.sent(_ulog_data, hrt_absolute_time());
 			unlock();
 
-			mavlink_logging_data_acked_t msg;
-			msg.sequence = _ulog_data.sequence;
-			msg.length = _ulog_data.length;
-			msg.first_message_offset = _ulog_data.first_message_offset;
-			msg.target_system = _target_system;
-			msg.target_component = _target_component;
-			memcpy(msg.data, _ulog_data.data, sizeof(msg.data));
-			mavlink_msg_logging_data_acked_send_struct(channel, &msg);
-
-		} else {
-			mavlink_logging_data_t msg;
-			msg.sequence = _ulog_data.sequence;
-			msg.length = _ulog_data.length;
-			msg.first_message_offset = _ulog_data.first_message_offset;
-			msg.target_system = _target_system;
-			msg.target_component = _target_component;
-			memcpy(msg.data, _ulog_data.data, sizeof(msg.data));
-			mavlink_msg_logging_data_send_struct(channel, &msg);
+			if (!added) {
+				break;
+			}
 		}
+
+		send_message(channel, _ulog_data);
+		_ulog_data_pending = false;
+		_sent_bytes += _ulog_data.length;
 		++_current_num_msgs;
-		ret = orb_check(_ulog_stream_sub, &updated);
+		free_tx_buf -= msg_len;
 	}
 
 	//need to update the rate?
@@ -172,15 +162,42 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 		} else {
 			_current_rate_factor = _max_rate_factor;
 		}
+		_achieved_rate = _sent_bytes / _rate_calculation_delta_t;
+		_sent_bytes = 0;
 		_current_num_msgs = 0;
 		_next_rate_check = t + _rate_calculation_delta_t * 1.e6f;
-		PX4_DEBUG("current rate=%.3f (max=%i msgs in %.3fs)", (double)_current_rate_factor, _max_num_messages,
-				(double)_rate_calculation_delta_t);
+		PX4_DEBUG("current rate=%.3f (max=%i msgs in %.3fs), %.0f B/s, window=%.1f", (double)_current_rate_factor,
+				_max_num_messages, (double)_rate_calculation_delta_t, (double)_achieved_rate,
+				(double)_window.congestion_window());
 	}
 
 	return 0;
 }
 
+void MavlinkULog::send_message(mavlink_channel_t channel, const ulog_stream_s &ulog_data)
+{
+	if (ulog_data.flags & ulog_stream_s::FLAGS_NEED_ACK) {
+		mavlink_logging_data_acked_t msg;
+		msg.sequence = ulog_data.sequence;
+		msg.length = ulog_data.length;
+		msg.first_message_offset = ulog_data.first_message_offset;
+		msg.target_system = _target_system;
+		msg.target_component = _target_component;
+		memcpy(msg.data, ulog_data.data, sizeof(msg.data));
+		mavlink_msg_logging_data_acked_send_struct(channel, &msg);
+
+	} else {
+		mavlink_logging_data_t msg;
+		msg.sequence = ulog_data.sequence;
+		msg.length = ulog_data.length;
+		msg.first_message_offset = ulog_data.first_message_offset;
+		msg.target_system = _target_system;
+		msg.target_component = _target_component;
+		memcpy(msg.data, ulog_data.data, sizeof(msg.data));
+		mavlink_msg_logging_data_send_struct(channel, &msg);
+	}
+}
+
 void MavlinkULog::initialize()
 {
 	if (_init) {
@@ -190,13 +207,14 @@ void MavlinkULog::initialize()
 	_init = true;
 }
 
-MavlinkULog* MavlinkULog::try_start(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component)
+MavlinkULog* MavlinkULog::try_start(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component,
+		unsigned ack_window)
 {
 	MavlinkULog *ret = nullptr;
 	bool failed = false;
 	lock();
 	if (!_instance) {
-		ret = _instance = new MavlinkULog(datarate, max_rate_factor, target_system, target_component);
+		ret = _instance = new MavlinkULog(datarate, max_rate_factor, target_system, target_component, ack_window);
 		if (!_instance) {
 			failed = true;
 		}
@@ -223,8 +241,8 @@ void MavlinkULog::handle_ack(mavlink_logging_ack_t ack)
 {
 	lock();
 	if (_instance) { // make sure stop() was not called right before
-		if (_wait_for_ack_sequence == ack.sequence) {
-			_ack_received = true;
+		// acks are selective: each one releases only the message with its sequence
+		if (_window.ack(ack.sequence, hrt_absolute_time())) {
 			publish_ack(ack.sequence);
 		}
 	}
@@ -238,7 +256,7 @@ void MavlinkULog::publish_ack(uint16_t sequence)
 	ack.sequence = sequence;
 
 	if (_ulog_stream_ack_pub == nullptr) {
-		_ulog_stream_ack_pub = orb_advertise_queue(ORB_ID(ulog_stream_ack), &ack, 3);
+		_ulog_stream_ack_pub = orb_advertise_queue(ORB_ID(ulog_stream_ack), &ack, ulog_stream_ack_s::ACK_WINDOW);
 
 	} else {
 		orb_publish(ORB_ID(ulog_stream_ack), _ulog_stream_ack_pub, &ack);
@@ -50,6 +50,7 @@
 #include <uORB/topics/ulog_stream_ack.h>
 
 #include "mavlink_bridge_header.h"
+#include "mavlink_ulog_window.h"
 
 /**
  * @class MavlinkULog
@@ -70,9 +71,12 @@ public:
 	 * @param max_rate_factor let ulog streaming use a maximum of max_rate_factor * datarate
 	 * @param target_system ID for mavlink message
 	 * @param target_component ID for mavlink message
+	 * @param ack_window messages in flight without an ack. 1 (stop-and-wait) keeps them in order,
+	 *                   larger windows only for receivers that order the log by sequence.
 	 * @return instance, or nullptr
 	 */
-	static MavlinkULog *try_start(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component);
+	static MavlinkULog *try_start(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component,
+				      unsigned ack_window = 1);
 
 	/**
 	 * stop the stream. It also deletes the singleton object, so make sure cleanup
@@ -83,9 +87,10 @@ public:
 
 	/**
 	 * periodic update method: check for ulog stream messages and handle retransmission.
+	 * @param free_tx_buf free space in the tx buffer of the channel [bytes]
 	 * @return 0 on success, <0 otherwise
 	 */
-	int handle_update(mavlink_channel_t channel);
+	int handle_update(mavlink_channel_t channel, unsigned free_tx_buf);
 
 	/** ack from mavlink for a data message */
 	void handle_ack(mavlink_logging_ack_t ack);
@@ -96,10 +101,16 @@ public:
 	float current_data_rate() const { return _current_rate_factor; }
 	float maximum_data_rate() const { return _max_rate_factor; }
 
+	/** ulog payload sent within the last rate interval, without retransmissions [B/s] */
+	float achieved_data_rate() const { return _achieved_rate; }
+
+	const MavlinkULogWindow &window() const { return _window; }
+
 	int get_ulog_stream_fd() const { return _ulog_stream_sub; }
 private:
 
-	MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component);
+	MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component,
+		    unsigned ack_window);
 
 	~MavlinkULog();
 
@@ -115,6 +126,8 @@ private:
 
 	void publish_ack(uint16_t sequence);
 
+	void send_message(mavlink_channel_t channel, const ulog_stream_s &ulog_data);
+
 	static px4_sem_t _lock;
 	static bool _init;
 	static MavlinkULog *_instance;
@@ -122,11 +135,10 @@ private:
 
 	int _ulog_stream_sub = -1;
 	orb_advert_t _ulog_stream_ack_pub = nullptr;
-	uint16_t _wait_for_ack_sequence;
-	uint8_t _sent_tries = 0;
-	volatile bool _ack_received = false; ///< set to true if a matching ack received
-	hrt_abstime _last_sent_time = 0; ///< last time we sent a message that requires an ack
+	MavlinkULogWindow _window; ///< messages in flight that need an ack, protected by _lock
+	hrt_abstime _start_time = 0; ///< time the stream was requested, to detect a missing logger ack
 	ulog_stream_s _ulog_data;
+	bool _ulog_data_pending = false; ///< _ulog_data is read but not sent yet, because the window was full
 	bool _waiting_for_initial_ack = false;
 	const uint8_t _target_system;
 	const uint8_t _target_component;
@@ -136,6 +148,8 @@ private:
 	float _current_rate_factor; ///< currently used rate percentage
 	int _current_num_msgs = 0;  ///< number of messages sent within the current time interval
 	hrt_abstime _next_rate_check; ///< next timestamp at which to update the rate
+	unsigned _sent_bytes = 0; ///< ulog payload sent within the current time interval
+	float _achieved_rate = 0.f; ///< ulog payload rate of the last time interval [B/s]
 
 	/* do not allow copying this class */
 	MavlinkULog(const MavlinkULog &) = delete;
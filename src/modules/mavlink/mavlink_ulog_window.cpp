@@ -0,0 +1,184 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_ulog_window.cpp
+ * Send window for ULog messages that need an ack.
+ */
+
+#include "mavlink_ulog_window.h"
+
+#include <errno.h>
+
+MavlinkULogWindow::MavlinkULogWindow()
+{
+	reset();
+}
+
+void
+MavlinkULogWindow::reset(unsigned size)
+{
+	for (unsigned i = 0; i < MAX_SIZE; i++) {
+		_entries[i].used = false;
+	}
+
+	_size = (size < 1) ? 1 : (size > MAX_SIZE ? MAX_SIZE : size);
+	_outstanding = 0;
+	_congestion_window = 1.f;
+	_slow_start_threshold = _size;
+	_srtt = 0;
+	_rttvar = 0;
+	_timeout = MIN_TIMEOUT;
+	_last_reduction = 0;
+	_acked = 0;
+	_retransmissions = 0;
+}
+
+bool
+MavlinkULogWindow::sent(const ulog_stream_s &msg, hrt_abstime now)
+{
+	for (unsigned i = 0; i < _size; i++) {
+		if (!_entries[i].used) {
+			_entries[i].msg = msg;
+			_entries[i].sent = now;
+			_entries[i].tries = 1;
+			_entries[i].used = true;
+			_outstanding++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool
+MavlinkULogWindow::ack(uint16_t sequence, hrt_abstime now)
+{
+	for (unsigned i = 0; i < _size; i++) {
+		Entry &entry = _entries[i];
+
+		if (!entry.used || entry.msg.sequence != sequence) {
+			continue;
+		}
+
+		/* only messages sent once give an unambiguous round trip time (Karn's algorithm) */
+		if (entry.tries == 1) {
+			_update_timeout(now - entry.sent);
+		}
+
+		entry.used = false;
+		_outstanding--;
+		_acked++;
+
+		/* exponential growth up to the threshold, then one message per window of acks */
+		if (_congestion_window < _slow_start_threshold) {
+			_congestion_window += 1.f;
+
+		} else {
+			_congestion_window += 1.f / _congestion_window;
+		}
+
+		if (_congestion_window > _size) {
+			_congestion_window = _size;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+int
+MavlinkULogWindow::retransmission(hrt_abstime now, const ulog_stream_s **msg)
+{
+	Entry *oldest = nullptr;
+
+	for (unsigned i = 0; i < _size; i++) {
+		Entry &entry = _entries[i];
+
+		if (entry.used && now - entry.sent >= _timeout && (!oldest || entry.sent < oldest->sent)) {
+			oldest = &entry;
+		}
+	}
+
+	if (!oldest) {
+		return 0;
+	}
+
+	if (oldest->tries >= ulog_stream_ack_s::ACK_MAX_TRIES) {
+		return -ETIMEDOUT;
+	}
+
+	/* a loss: back off once per timeout period, not for every message of the same window */
+	if (now - _last_reduction >= _timeout) {
+		_slow_start_threshold = _congestion_window / 2.f;
+
+		if (_slow_start_threshold < 1.f) {
+			_slow_start_threshold = 1.f;
+		}
+
+		_congestion_window = _slow_start_threshold;
+		_timeout = (2 * _timeout > MAX_TIMEOUT) ? MAX_TIMEOUT : 2 * _timeout;
+		_last_reduction = now;
+	}
+
+	oldest->tries++;
+	oldest->sent = now;
+	_retransmissions++;
+	*msg = &oldest->msg;
+	return 1;
+}
+
+void
+MavlinkULogWindow::_update_timeout(hrt_abstime rtt)
+{
+	/* RFC 6298 estimator */
+	if (_srtt == 0) {
+		_srtt = rtt;
+		_rttvar = rtt / 2;
+
+	} else {
+		const hrt_abstime delta = (_srtt > rtt) ? _srtt - rtt : rtt - _srtt;
+		_rttvar = (3 * _rttvar + delta) / 4;
+		_srtt = (7 * _srtt + rtt) / 8;
+	}
+
+	_timeout = _srtt + 4 * _rttvar;
+
+	if (_timeout < MIN_TIMEOUT) {
+		_timeout = MIN_TIMEOUT;
+
+	} else if (_timeout > MAX_TIMEOUT) {
+		_timeout = MAX_TIMEOUT;
+	}
+}
@@ -0,0 +1,131 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mavlink_ulog_window.h
+ * Send window for ULog messages that need an ack.
+ *
+ * Up to a window of messages are in flight at once. Acks are selective: each one
+ * releases exactly the message with its sequence, so a single loss only delays that
+ * message. Lost messages are retransmitted after a timeout that follows the measured
+ * round trip time. The usable window grows with every ack and is halved on a timeout,
+ * so a congested link is not flooded with retransmissions.
+ *
+ * With a window larger than 1 a retransmitted message arrives after the ones sent
+ * behind it. A receiver which writes the log in arrival order needs a window of 1
+ * (stop-and-wait), see MavlinkULog::try_start().
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <drivers/drv_hrt.h>
+#include <uORB/topics/ulog_stream.h>
+#include <uORB/topics/ulog_stream_ack.h>
+
+class MavlinkULogWindow
+{
+public:
+	static constexpr unsigned MAX_SIZE = ulog_stream_ack_s::ACK_WINDOW;	///< Largest number of unacked messages
+	static constexpr hrt_abstime MIN_TIMEOUT = ulog_stream_ack_s::ACK_TIMEOUT * 1000;	///< Lower retransmission timeout bound [us]
+	static constexpr hrt_abstime MAX_TIMEOUT = 1000000;	///< Upper retransmission timeout bound [us]
+
+	static_assert(ulog_stream_ack_s::ACK_STALL_TIMEOUT * 1000 >= 8 * MAX_TIMEOUT,
+		      "the logger must wait for several retransmissions at the largest timeout before it gives up");
+
+	MavlinkULogWindow();
+
+	/**
+	 * Drop all messages and restart with a small window.
+	 *
+	 * @param size		largest window to use, clamped to [1, MAX_SIZE]. 1 is stop-and-wait.
+	 */
+	void reset(unsigned size = MAX_SIZE);
+
+	/**
+	 * True if another message can be sent within the current congestion window.
+	 */
+	bool can_send() const { return _outstanding < (unsigned)_congestion_window; }
+
+	/**
+	 * Store a message that was just sent for the first time.
+	 *
+	 * @return false if the window is full
+	 */
+	bool sent(const ulog_stream_s &msg, hrt_abstime now);
+
+	/**
+	 * Handle an ack from the receiver.
+	 *
+	 * @return true if it acked a message in flight, false for duplicates and unknown sequences
+	 */
+	bool ack(uint16_t sequence, hrt_abstime now);
+
+	/**
+	 * Get the oldest message whose retransmission timeout expired. Call repeatedly until it
+	 * returns 0 to send all of them. The message is marked as sent again.
+	 *
+	 * @param msg		set to the message to retransmit
+	 * @return 1 if msg is set, 0 if nothing is due, -ETIMEDOUT if a message exceeded ACK_MAX_TRIES
+	 */
+	int retransmission(hrt_abstime now, const ulog_stream_s **msg);
+
+	unsigned outstanding() const { return _outstanding; }			///< Messages in flight
+	float congestion_window() const { return _congestion_window; }	///< Usable window [messages]
+	hrt_abstime timeout() const { return _timeout; }				///< Current retransmission timeout [us]
+	hrt_abstime round_trip_time() const { return _srtt; }			///< Smoothed round trip time [us], 0 if unknown
+	uint32_t acked() const { return _acked; }					///< Messages acked since reset()
+	uint32_t retransmissions() const { return _retransmissions; }	///< Retransmissions since reset()
+
+private:
+	struct Entry {
+		ulog_stream_s	msg;
+		hrt_abstime	sent;		///< Time of the last (re-)transmission
+		uint8_t		tries;
+		bool		used;
+	};
+
+	Entry		_entries[MAX_SIZE];
+	unsigned	_size;
+	unsigned	_outstanding;
+	float		_congestion_window;
+	float		_slow_start_threshold;
+	hrt_abstime	_srtt;
+	hrt_abstime	_rttvar;
+	hrt_abstime	_timeout;
+	hrt_abstime	_last_reduction;	///< Time the window was last reduced after a loss
+	uint32_t	_acked;
+	uint32_t	_retransmissions;
+
+	void _update_timeout(hrt_abstime rtt);
+};
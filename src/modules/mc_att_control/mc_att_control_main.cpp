@@ -86,6 +86,7 @@
 #include <systemlib/perf_counter.h>
 #include <systemlib/systemlib.h>
 #include <systemlib/circuit_breaker.h>
+#include <systemlib/latency_trace.h>
 #include <lib/mathlib/mathlib.h>
 #include <lib/geo/geo.h>
 #include <lib/tailsitter_recovery/tailsitter_recovery.h>
@@ -1110,7 +1111,10 @@ MulticopterAttitudeControl::task_main()
 				_actuators.control[3] = (PX4_ISFINITE(_thrust_sp)) ? _thrust_sp : 0.0f;
 				_actuators.control[7] = _v_att_sp.landing_gear;
 				_actuators.timestamp = hrt_absolute_time();
-				_actuators.timestamp_sample = _ctrl_state.timestamp;
+				/* estimators that do not know the sensor sample only set the timestamp */
+				_actuators.timestamp_sample = (_ctrl_state.timestamp_sample != 0) ? _ctrl_state.timestamp_sample :
+							      _ctrl_state.timestamp;
+				_actuators.trace_id = _ctrl_state.trace_id;
 
 				/* scale effort by battery status */
 				if (_params.bat_scale_en && _battery_status.scale > 0.0f) {
@@ -1129,6 +1133,7 @@ MulticopterAttitudeControl::task_main()
 
 						orb_publish(_actuators_id, _actuators_0_pub, &_actuators);
 						perf_end(_controller_latency_perf);
+						latency_trace_hop(latency_trace_s::HOP_CONTROL, _actuators.trace_id);
 
 					} else if (_actuators_id) {
 						_actuators_0_pub = orb_advertise(_actuators_id, &_actuators);
@@ -1122,13 +1122,20 @@ void MulticopterPositionControl::control_auto(float dt)
 
 	math::Vector<3> prev_sp;
 	math::Vector<3> curr_sp;
+	math::Vector<3> next_sp;
+
+	/* project previous, current and next setpoint to local frame in one batch */
+	const double sp_lat[3] = {_pos_sp_triplet.previous.lat, _pos_sp_triplet.current.lat, _pos_sp_triplet.next.lat};
+	const double sp_lon[3] = {_pos_sp_triplet.previous.lon, _pos_sp_triplet.current.lon, _pos_sp_triplet.next.lon};
+	float sp_x[3] = {NAN, NAN, NAN};
+	float sp_y[3] = {NAN, NAN, NAN};
+
+	map_projection_project_n(&_ref_pos, sp_lat, sp_lon, sp_x, sp_y, 3);
 
 	if (_pos_sp_triplet.current.valid) {
 
-		/* project setpoint to local frame */
-		map_projection_project(&_ref_pos,
-				       _pos_sp_triplet.current.lat, _pos_sp_triplet.current.lon,
-				       &curr_sp.data[0], &curr_sp.data[1]);
+		curr_sp(0) = sp_x[1];
+		curr_sp(1) = sp_y[1];
 		curr_sp(2) = -(_pos_sp_triplet.current.alt - _ref_alt);
 
 		if (PX4_ISFINITE(curr_sp(0)) &&
@@ -1139,9 +1146,8 @@ void MulticopterPositionControl::control_auto(float dt)
 	}
 
 	if (_pos_sp_triplet.previous.valid) {
-		map_projection_project(&_ref_pos,
-				       _pos_sp_triplet.previous.lat, _pos_sp_triplet.previous.lon,
-				       &prev_sp.data[0], &prev_sp.data[1]);
+		prev_sp(0) = sp_x[0];
+		prev_sp(1) = sp_y[0];
 		prev_sp(2) = -(_pos_sp_triplet.previous.alt - _ref_alt);
 
 		if (PX4_ISFINITE(prev_sp(0)) &&
@@ -1191,10 +1197,8 @@ void MulticopterPositionControl::control_auto(float dt)
 					/* copter is closer to waypoint than unit radius */
 					/* check next waypoint and use it to avoid slowing down when passing via waypoint */
 					if (_pos_sp_triplet.next.valid) {
-						math::Vector<3> next_sp;
-						map_projection_project(&_ref_pos,
-								       _pos_sp_triplet.next.lat, _pos_sp_triplet.next.lon,
-								       &next_sp.data[0], &next_sp.data[1]);
+						next_sp(0) = sp_x[2];
+						next_sp(1) = sp_y[2];
 						next_sp(2) = -(_pos_sp_triplet.next.alt - _ref_alt);
 
 						if ((next_sp - curr_sp).length() > MIN_DIST) {
@@ -51,6 +51,8 @@
 #include <px4_config.h>
 #include <px4_defines.h>
 #include <unistd.h>
+#include <float.h>
+#include <math.h>
 #include <geo/geo.h>
 #include <drivers/drv_hrt.h>
 #include "navigator.h"
@@ -67,13 +69,14 @@ Geofence::Geofence(Navigator *navigator) :
 	_last_vertical_range_warning(0),
 	_altitude_min(0),
 	_altitude_max(0),
-	_vertices_count(0),
+	_zones(),
 	_param_action(this, "GF_ACTION", false),
 	_param_altitude_mode(this, "GF_ALTMODE", false),
 	_param_source(this, "GF_SOURCE", false),
 	_param_counter_threshold(this, "GF_COUNT", false),
 	_param_max_hor_distance(this, "GF_MAX_HOR_DIST", false),
 	_param_max_ver_distance(this, "GF_MAX_VER_DIST", false),
+	_param_predict_time(this, "GF_PREDICT_T", false),
 	_outside_counter(0)
 {
 	/* Load initial params */
@@ -199,36 +202,8 @@ bool Geofence::inside_polygon(double lat, double lon, float altitude)
 				return false;
 			}
 
-			/*Horizontal check */
-			/* Adaptation of algorithm originally presented as
-			 * PNPOLY - Point Inclusion in Polygon Test
-			 * W. Randolph Franklin (WRF) */
-
-			bool c = false;
-
-			struct fence_vertex_s temp_vertex_i;
-			struct fence_vertex_s temp_vertex_j;
-
-			/* Red until fence is finished */
-			for (unsigned i = 0, j = _vertices_count - 1; i < _vertices_count; j = i++) {
-				if (dm_read(DM_KEY_FENCE_POINTS, i, &temp_vertex_i, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
-					break;
-				}
-
-				if (dm_read(DM_KEY_FENCE_POINTS, j, &temp_vertex_j, sizeof(struct fence_vertex_s)) != sizeof(struct fence_vertex_s)) {
-					break;
-				}
-
-				// skip vertex 0 (return point)
-				if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-				    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-				     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
-					c = !c;
-				}
-
-			}
-
-			return c;
+			/* Horizontal check */
+			return _zones.inside(lat, lon);
 
 		} else {
 			/* Empty fence --> accept all points */
@@ -241,6 +216,87 @@ bool Geofence::inside_polygon(double lat, double lon, float altitude)
 	}
 }
 
+float Geofence::predictBreach(const struct vehicle_global_position_s &global_position,
+			      const struct vehicle_gps_position_s &gps_position,
+			      const struct position_setpoint_triplet_s &pos_sp_triplet)
+{
+	const float lookahead_time = _param_predict_time.get();
+
+	if (lookahead_time < FLT_EPSILON || isEmpty() || !valid()) {
+		return NAN;
+	}
+
+	/* same position source as the breach check in inside() */
+	double lat;
+	double lon;
+	float vel_n;
+	float vel_e;
+
+	if (getSource() == Geofence::GF_SOURCE_GLOBALPOS) {
+		lat = global_position.lat;
+		lon = global_position.lon;
+		vel_n = global_position.vel_n;
+		vel_e = global_position.vel_e;
+
+	} else {
+		if (!gps_position.vel_ned_valid) {
+			return NAN;
+		}
+
+		lat = (double)gps_position.lat * 1.0e-7;
+		lon = (double)gps_position.lon * 1.0e-7;
+		vel_n = gps_position.vel_n_m_s;
+		vel_e = gps_position.vel_e_m_s;
+	}
+
+	/* work in the local frame of the fence index */
+	const struct map_projection_reference_s &ref = _zones.reference();
+	float x, y;
+
+	if (map_projection_project(&ref, lat, lon, &x, &y) != 0) {
+		return NAN;
+	}
+
+	const float horizon = sqrtf(vel_n * vel_n + vel_e * vel_e) * lookahead_time;
+
+	if (horizon < FLT_EPSILON) {
+		return NAN;
+	}
+
+	float breach_distance = NAN;
+
+	/* straight on with the current velocity */
+	float t = _zones.first_breach_local(x, y, x + vel_n * lookahead_time, y + vel_e * lookahead_time);
+
+	if (t >= 0.0f) {
+		breach_distance = t * horizon;
+	}
+
+	/* towards the current setpoint, up to the distance covered within the look-ahead time */
+	const struct position_setpoint_s &current = pos_sp_triplet.current;
+
+	if (current.valid && (current.type == position_setpoint_s::SETPOINT_TYPE_POSITION ||
+			      current.type == position_setpoint_s::SETPOINT_TYPE_LOITER ||
+			      current.type == position_setpoint_s::SETPOINT_TYPE_TAKEOFF ||
+			      current.type == position_setpoint_s::SETPOINT_TYPE_LAND)) {
+		float sp_x, sp_y;
+		map_projection_project(&ref, current.lat, current.lon, &sp_x, &sp_y);
+
+		const float leg_length = sqrtf((sp_x - x) * (sp_x - x) + (sp_y - y) * (sp_y - y));
+
+		if (leg_length > FLT_EPSILON) {
+			const float scale = (leg_length > horizon) ? horizon / leg_length : 1.0f;
+			t = _zones.first_breach_local(x, y, x + (sp_x - x) * scale, y + (sp_y - y) * scale);
+
+			if (t >= 0.0f && !(t * leg_length * scale >= breach_distance)) {
+				breach_distance = t * leg_length * scale;
+			}
+		}
+	}
+
+	return breach_distance;
+}
+
 bool
 Geofence::valid()
 {
@@ -249,13 +305,8 @@ Geofence::valid()
 		return true;
 	}
 
-	// Otherwise
-	if ((_vertices_count < 4) || (_vertices_count > fence_s::GEOFENCE_MAX_VERTICES)) {
-		warnx("Fence must have at least 3 sides and not more than %d", fence_s::GEOFENCE_MAX_VERTICES - 1);
-		return false;
-	}
-
-	return true;
+	// Otherwise the index has to be built
+	return _zones.is_built();
 }
 
 void
@@ -268,6 +319,7 @@ Geofence::addPoint(int argc, char *argv[])
 
 	if ((argc == 1) && (strcmp("-clear", argv[0]) == 0)) {
 		dm_clear(DM_KEY_FENCE_POINTS);
+		_zones.clear();
 		publishFence(0);
 		return;
 	}
@@ -296,6 +348,7 @@ Geofence::addPoint(int argc, char *argv[])
 
 	if (dm_write(DM_KEY_FENCE_POINTS, ix, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) == sizeof(vertex)) {
 		if (last) {
+			loadFromDm((unsigned)ix + 1);
 			publishFence((unsigned)ix + 1);
 		}
 
@@ -316,6 +369,32 @@ Geofence::publishFence(unsigned vertices)
 	}
 }
 
+int
+Geofence::loadFromDm(unsigned vertices)
+{
+	struct fence_vertex_s vertex;
+
+	_zones.clear();
+	_zones.begin_zone(GeofenceZones::ZONE_INCLUSION);
+
+	for (unsigned i = 0; i < vertices; i++) {
+		if (dm_read(DM_KEY_FENCE_POINTS, i, &vertex, sizeof(vertex)) != sizeof(vertex)) {
+			_zones.clear();
+			return PX4_ERROR;
+		}
+
+		_zones.add_vertex(vertex.lat, vertex.lon);
+	}
+
+	if (_zones.end_zone() != 0 || _zones.build() != 0) {
+		warnx("Fence must have at least 3 sides");
+		_zones.clear();
+		return PX4_ERROR;
+	}
+
+	return PX4_OK;
+}
+
 int
 Geofence::loadFromFile(const char *filename)
 {
@@ -328,6 +407,7 @@ Geofence::loadFromFile(const char *filename)
 
 	/* Make sure no data is left in the datamanager */
 	clearDm();
+	_zones.clear();
 
 	/* open the mixer definition file */
 	fp = fopen(GEOFENCE_FILENAME, "r");
@@ -336,7 +416,7 @@ Geofence::loadFromFile(const char *filename)
 		return PX4_ERROR;
 	}
 
-	/* create geofence points from valid lines and store in DM */
+	/* create geofence polygons from valid lines */
 	for (;;) {
 		/* get a line, bail on error/EOF */
 		if (fgets(line, sizeof(line), fp) == NULL) {
@@ -359,6 +439,19 @@ Geofence::loadFromFile(const char *filename)
 		}
 
 		if (gotVertical) {
+			/* a keyword line starts a new polygon */
+			if (strncmp(&line[textStart], "INCLUDE", 7) == 0 || strncmp(&line[textStart], "EXCLUDE", 7) == 0) {
+				_zones.end_zone();
+
+				if (_zones.begin_zone(line[textStart] == 'I' ? GeofenceZones::ZONE_INCLUSION :
+						      GeofenceZones::ZONE_EXCLUSION) != 0) {
+					warnx("Geofence: too many polygons (max %u)", GeofenceZones::MAX_ZONES);
+					goto error;
+				}
+
+				continue;
+			}
+
 			/* Parse the line as a geofence point */
 			struct fence_vertex_s vertex;
 
@@ -385,12 +478,11 @@ Geofence::loadFromFile(const char *filename)
 				}
 			}
 
-			if (dm_write(DM_KEY_FENCE_POINTS, pointCounter, DM_PERSIST_POWER_ON_RESET, &vertex, sizeof(vertex)) != sizeof(vertex)) {
+			if (_zones.add_vertex(vertex.lat, vertex.lon) != 0) {
+				warnx("Geofence: can't store point %d", pointCounter);
 				goto error;
 			}
 
-			warnx("Geofence: point: %d, lat %.5f: lon: %.5f", pointCounter, (double)vertex.lat, (double)vertex.lon);
-
 			pointCounter++;
 
 		} else {
@@ -401,13 +493,17 @@ Geofence::loadFromFile(const char *filename)
 
 			warnx("Geofence: alt min: %.4f, alt_max: %.4f", (double)_altitude_min, (double)_altitude_max);
 			gotVertical = true;
+
+			/* vertices without a keyword line form an inclusion polygon */
+			_zones.begin_zone(GeofenceZones::ZONE_INCLUSION);
 		}
 	}
 
 	/* Check if import was successful */
-	if (gotVertical && pointCounter > 0) {
-		_vertices_count = pointCounter;
-		warnx("Geofence: imported successfully");
+	_zones.end_zone();
+
+	if (gotVertical && pointCounter > 0 && _zones.build() == 0) {
+		warnx("Geofence: imported %u polygons with %u points", _zones.zone_count(), _zones.vertex_count());
 		mavlink_log_info(_navigator->get_mavlink_log_pub(), "Geofence imported");
 		rc = PX4_OK;
 
@@ -417,6 +513,11 @@ Geofence::loadFromFile(const char *filename)
 	}
 
 error:
+
+	if (rc != PX4_OK) {
+		_zones.clear();
+	}
+
 	fclose(fp);
 	return rc;
 }
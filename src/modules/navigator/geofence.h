@@ -46,9 +46,11 @@
 #include <uORB/topics/vehicle_gps_position.h>
 #include <uORB/topics/sensor_combined.h>
 #include <uORB/topics/home_position.h>
+#include <uORB/topics/position_setpoint_triplet.h>
 #include <controllib/blocks.hpp>
 #include <controllib/block/BlockParam.hpp>
 #include <drivers/drv_hrt.h>
+#include <geofence/geofence_zones.h>
 #include <px4_defines.h>
 
 #define GEOFENCE_FILENAME PX4_ROOTFSDIR"/fs/microsd/etc/geofence.txt"
@@ -92,6 +94,18 @@ public:
 
 	bool inside_polygon(double lat, double lon, float altitude);
 
+	/**
+	 * Predict a breach of the geofence polygons along the path the vehicle
+	 * is going to take within the look-ahead time GF_PREDICT_T: along the
+	 * current velocity and from the position towards the current setpoint.
+	 * Position and velocity come from GF_SOURCE, like for the breach check.
+	 *
+	 * @return distance in meters to the predicted breach, NAN if there is none
+	 */
+	float predictBreach(const struct vehicle_global_position_s &global_position,
+			    const struct vehicle_gps_position_s &gps_position,
+			    const struct position_setpoint_triplet_s &pos_sp_triplet);
+
 	int clearDm();
 
 	bool valid();
@@ -103,9 +117,17 @@ public:
 
 	void publishFence(unsigned vertices);
 
+	/**
+	 * Load the fence from a text file.
+	 *
+	 * The first line holds the minimum and maximum altitude, every following
+	 * line a vertex in decimal degrees or as "DMS d m s d m s". A line
+	 * "INCLUDE" or "EXCLUDE" starts a new inclusion or exclusion polygon,
+	 * vertices before the first such line form an inclusion polygon.
+	 */
 	int loadFromFile(const char *filename);
 
-	bool isEmpty() {return _vertices_count == 0;}
+	bool isEmpty() { return _zones.is_empty(); }
 
 	int getAltitudeMode() { return _param_altitude_mode.get(); }
 
@@ -127,7 +149,7 @@ private:
 	float _altitude_min;
 	float _altitude_max;
 
-	unsigned _vertices_count;
+	GeofenceZones _zones;
 
 	/* Params */
 	control::BlockParamInt _param_action;
@@ -136,9 +158,12 @@ private:
 	control::BlockParamInt _param_counter_threshold;
 	control::BlockParamFloat _param_max_hor_distance;
 	control::BlockParamFloat _param_max_ver_distance;
+	control::BlockParamFloat _param_predict_time;
 
 	int _outside_counter;
 
+	int loadFromDm(unsigned vertices);
+
 	bool inside(double lat, double lon, float altitude);
 	bool inside(const struct vehicle_global_position_s &global_position);
 	bool inside(const struct vehicle_global_position_s &global_position, float baro_altitude_amsl);
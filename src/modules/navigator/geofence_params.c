@@ -129,3 +129,19 @@ PARAM_DEFINE_FLOAT(GF_MAX_HOR_DIST, 0);
  * @group Geofence
  */
 PARAM_DEFINE_FLOAT(GF_MAX_VER_DIST, 0);
+
+/**
+ * Geofence breach prediction look-ahead time.
+ *
+ * The path along the current velocity and towards the current setpoint is checked against the
+ * geofence polygons for this time ahead. A predicted breach is reported as a warning and in
+ * geofence_result, the geofence action is only triggered by an actual violation. Disabled if 0.
+ *
+ * @unit s
+ * @min 0
+ * @max 30
+ * @decimal 1
+ * @increment 0.5
+ * @group Geofence
+ */
+PARAM_DEFINE_FLOAT(GF_PREDICT_T, 0.0f);
@@ -85,6 +85,10 @@ Mission::Mission(Navigator *navigator, const char *name) :
 	_home_inited(false),
 	_need_mission_reset(false),
 	_missionFeasibilityChecker(),
+	_mission_cache(),
+	_saved_mission_state{},
+	_saved_mission_state_valid(false),
+	_time_terrain_prefetch(0),
 	_min_current_sp_distance_xy(FLT_MAX),
 	_distance_current_previous(0.0f),
 	_work_item_type(WORK_ITEM_TYPE_DEFAULT)
@@ -144,7 +148,7 @@ Mission::on_inactive()
 
 		dm_unlock(DM_KEY_MISSION_STATE);
 
-		if (read_res == sizeof(mission_s)) {
+		if (read_res == sizeof(mission_s) && DM_OFFBOARD_ID_VALID(mission_state.dataman_id)) {
 			_offboard_mission.dataman_id = mission_state.dataman_id;
 			_offboard_mission.count = mission_state.count;
 			_current_offboard_mission_index = mission_state.current_seq;
@@ -206,6 +210,14 @@ Mission::on_active()
 		set_mission_items();
 	}
 
+	/* a long leg can cover more tiles than one prefetch loads, top up while flying it */
+	if (_mission_type == MISSION_TYPE_OFFBOARD && _navigator->get_terrain().enabled()
+	    && item_contains_position(&_mission_item) && hrt_elapsed_time(&_time_terrain_prefetch) > 5 * 1000 * 1000) {
+		_navigator->get_terrain().request(_navigator->get_global_position()->lat, _navigator->get_global_position()->lon,
+						  _mission_item.lat, _mission_item.lon);
+		_time_terrain_prefetch = hrt_absolute_time();
+	}
+
 	/* lets check if we reached the current mission item */
 	if (_mission_type != MISSION_TYPE_NONE && is_mission_item_reached()) {
 
@@ -281,25 +293,21 @@ Mission::find_offboard_land_start()
 
 	dm_item_t dm_current = DM_KEY_WAYPOINTS_OFFBOARD(_offboard_mission.dataman_id);
 
-	for (size_t i = 0; i < _offboard_mission.count; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(missionitem);
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return -1;
-		}
-
-		if (missionitem.nav_cmd == NAV_CMD_DO_LAND_START) {
-			return i;
-		}
+	/* the index is normally built when the mission is updated */
+	if (!_mission_cache.index_valid(dm_current, _offboard_mission.count)
+	    && !_mission_cache.build_index(dm_current, _offboard_mission.count)) {
+		/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+		return -1;
 	}
 
-	return -1;
+	return _mission_cache.land_start_index();
 }
 
 void
 Mission::update_onboard_mission()
 {
+	_mission_cache.invalidate();
+
 	if (orb_copy(ORB_ID(onboard_mission), _navigator->get_onboard_mission_sub(), &_onboard_mission) == OK) {
 		/* accept the current index set by the onboard mission if it is within bounds */
 		if (_onboard_mission.current_seq >= 0
@@ -345,10 +353,21 @@ Mission::update_offboard_mission()
 {
 	bool failed = true;
 
+	/* the mission or its state has been changed by someone else */
+	_mission_cache.invalidate();
+	_saved_mission_state_valid = false;
+
 	if (orb_copy(ORB_ID(offboard_mission), _navigator->get_offboard_mission_sub(), &_offboard_mission) == OK) {
 		warnx("offboard mission updated: dataman_id=%d, count=%d, current_seq=%d", _offboard_mission.dataman_id,
 		      _offboard_mission.count, _offboard_mission.current_seq);
 
+		if (!DM_OFFBOARD_ID_VALID(_offboard_mission.dataman_id)) {
+			/* nothing to read from, continue without mission */
+			PX4_WARN("invalid offboard mission slot %d", _offboard_mission.dataman_id);
+			_offboard_mission.dataman_id = 0;
+			_offboard_mission.count = 0;
+		}
+
 		/* determine current index */
 		if (_offboard_mission.current_seq >= 0 && _offboard_mission.current_seq < (int)_offboard_mission.count) {
 			_current_offboard_mission_index = _offboard_mission.current_seq;
@@ -473,6 +492,12 @@ Mission::set_mission_items()
 
 		_mission_type = MISSION_TYPE_OFFBOARD;
 
+		/* have the terrain of the next leg in memory before it is needed */
+		if (has_next_position_item && item_contains_position(&_mission_item)) {
+			_navigator->get_terrain().request(_mission_item.lat, _mission_item.lon,
+							  mission_item_next_position.lat, mission_item_next_position.lon);
+		}
+
 	} else {
 		/* no mission available or mission finished, switch to loiter */
 		if (_mission_type != MISSION_TYPE_NONE) {
@@ -1118,6 +1143,12 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 		dm_item = DM_KEY_WAYPOINTS_OFFBOARD(_offboard_mission.dataman_id);
 	}
 
+	/* Keep the items ahead of the current one in the cache, so reading the next position
+	 * item and following DO_JUMPs back into the window does not block on the dataman. */
+	if (offset == 0 && *mission_index_ptr >= 0) {
+		_mission_cache.prefetch(dm_item, mission->count, *mission_index_ptr);
+	}
+
 	/* Repeat this several times in case there are several DO JUMPS that we need to follow along, however, after
 	 * 10 iterations we have to assume that the DO JUMPS are probably cycling and give up. */
 	for (int i = 0; i < 10; i++) {
@@ -1132,13 +1163,11 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 			return false;
 		}
 
-		const ssize_t len = sizeof(struct mission_item_s);
-
 		/* read mission item to temp storage first to not overwrite current mission item if data damaged */
 		struct mission_item_s mission_item_tmp;
 
-		/* read mission item from datamanager */
-		if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
+		/* read mission item from the cache in front of the datamanager */
+		if (!_mission_cache.read(dm_item, mission->count, *mission_index_ptr, &mission_item_tmp)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "ERROR waypoint could not be read");
 			return false;
@@ -1156,8 +1185,7 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 					(mission_item_tmp.do_jump_current_count)++;
 
 					/* save repeat count */
-					if (dm_write(dm_item, *mission_index_ptr, DM_PERSIST_POWER_ON_RESET,
-						     &mission_item_tmp, len) != len) {
+					if (!_mission_cache.write(dm_item, *mission_index_ptr, &mission_item_tmp)) {
 						/* not supposed to happen unless the datamanager can't access the
 						 * dataman */
 						mavlink_log_critical(_navigator->get_mavlink_log_pub(), "ERROR DO JUMP waypoint could not be written");
@@ -1195,6 +1223,14 @@ Mission::read_mission_item(bool onboard, int offset, struct mission_item_s *miss
 void
 Mission::save_offboard_mission_state()
 {
+	/* this runs for every new mission item, skip the dataman if the stored state is ours already */
+	if (_saved_mission_state_valid
+	    && _saved_mission_state.dataman_id == _offboard_mission.dataman_id
+	    && _saved_mission_state.count == _offboard_mission.count
+	    && _saved_mission_state.current_seq == _current_offboard_mission_index) {
+		return;
+	}
+
 	mission_s mission_state;
 
 	/* lock MISSION_STATE item */
@@ -1208,12 +1244,22 @@ Mission::save_offboard_mission_state()
 		if (mission_state.dataman_id == _offboard_mission.dataman_id && mission_state.count == _offboard_mission.count) {
 			/* navigator may modify only sequence, write modified state only if it changed */
 			if (mission_state.current_seq != _current_offboard_mission_index) {
+				mission_state.current_seq = _current_offboard_mission_index;
+
 				if (dm_write(DM_KEY_MISSION_STATE, 0, DM_PERSIST_POWER_ON_RESET, &mission_state,
 					     sizeof(mission_s)) != sizeof(mission_s)) {
 
 					warnx("ERROR: can't save mission state");
 					mavlink_log_critical(_navigator->get_mavlink_log_pub(), "ERROR: can't save mission state");
+
+				} else {
+					_saved_mission_state = mission_state;
+					_saved_mission_state_valid = true;
 				}
+
+			} else {
+				_saved_mission_state = mission_state;
+				_saved_mission_state_valid = true;
 			}
 		}
 
@@ -1232,6 +1278,10 @@ Mission::save_offboard_mission_state()
 
 			warnx("ERROR: can't save mission state");
 			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "ERROR: can't save mission state");
+
+		} else {
+			_saved_mission_state = mission_state;
+			_saved_mission_state_valid = true;
 		}
 	}
 
@@ -1297,6 +1347,9 @@ Mission::check_mission_valid(bool force)
 				_navigator->get_default_acceptance_radius(),
 				_navigator->get_land_detected()->landed);
 
+		/* index DO_JUMP and DO_LAND_START once per mission instead of scanning on every use */
+		_mission_cache.build_index(dm_current, _offboard_mission.count);
+
 		_navigator->get_mission_result()->seq_total = _offboard_mission.count;
 		_navigator->increment_mission_instance_count();
 		_navigator->set_mission_result_updated();
@@ -1307,10 +1360,12 @@ Mission::check_mission_valid(bool force)
 void
 Mission::reset_offboard_mission(struct mission_s &mission)
 {
+	_saved_mission_state_valid = false;
+
 	dm_lock(DM_KEY_MISSION_STATE);
 
 	if (dm_read(DM_KEY_MISSION_STATE, 0, &mission, sizeof(mission_s)) == sizeof(mission_s)) {
-		if (mission.dataman_id >= 0 && mission.dataman_id <= 1) {
+		if (DM_OFFBOARD_ID_VALID(mission.dataman_id)) {
 			/* set current item to 0 */
 			mission.current_seq = 0;
 
@@ -1318,11 +1373,15 @@ Mission::reset_offboard_mission(struct mission_s &mission)
 			if (mission.count > 0) {
 				dm_item_t dm_current = DM_KEY_WAYPOINTS_OFFBOARD(mission.dataman_id);
 
-				for (unsigned index = 0; index < mission.count; index++) {
+				/* only the DO_JUMP items need to be visited if they are indexed */
+				const bool indexed = _mission_cache.index_valid(dm_current, mission.count) && _mission_cache.jump_count() >= 0;
+				const unsigned num_items = indexed ? (unsigned)_mission_cache.jump_count() : mission.count;
+
+				for (unsigned i = 0; i < num_items; i++) {
+					const unsigned index = indexed ? _mission_cache.jump_index(i) : i;
 					struct mission_item_s item;
-					const ssize_t len = sizeof(struct mission_item_s);
 
-					if (dm_read(dm_current, index, &item, len) != len) {
+					if (!_mission_cache.read(dm_current, mission.count, index, &item)) {
 						PX4_WARN("could not read mission item during reset");
 						break;
 					}
@@ -1330,7 +1389,7 @@ Mission::reset_offboard_mission(struct mission_s &mission)
 					if (item.nav_cmd == NAV_CMD_DO_JUMP) {
 						item.do_jump_current_count = 0;
 
-						if (dm_write(dm_current, index, DM_PERSIST_POWER_ON_RESET, &item, len) != len) {
+						if (!_mission_cache.write(dm_current, index, &item)) {
 							PX4_WARN("could not save mission item during reset");
 							break;
 						}
@@ -63,6 +63,7 @@
 #include "navigator_mode.h"
 #include "mission_block.h"
 #include "mission_feasibility_checker.h"
+#include "mission_item_cache.h"
 
 class Navigator;
 
@@ -254,6 +255,13 @@ private:
 
 	MissionFeasibilityChecker _missionFeasibilityChecker; /**< class that checks if a mission is feasible */
 
+	MissionItemCache _mission_cache;	/**< cached mission items and DO_JUMP/DO_LAND_START index */
+
+	struct mission_s _saved_mission_state;	/**< offboard mission state last read from or written to the dataman */
+	bool _saved_mission_state_valid;	/**< false if the stored state might have been changed since */
+
+	hrt_abstime _time_terrain_prefetch;	/**< last prefetch of the terrain along the current leg */
+
 	float _min_current_sp_distance_xy; /**< minimum distance which was achieved to the current waypoint  */
 
 	float _distance_current_previous; /**< distance from previous to current sp in pos_sp_triplet,
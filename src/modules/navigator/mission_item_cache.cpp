@@ -0,0 +1,194 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mission_item_cache.cpp
+ * Sliding window cache of mission items in front of the dataman.
+ */
+
+#include "mission_item_cache.h"
+
+#include <string.h>
+
+MissionItemCache::MissionItemCache() :
+	_dm_item(DM_KEY_WAYPOINTS_OFFBOARD_0),
+	_count(0),
+	_selected(false),
+	_index_built(false),
+	_land_start_index(-1),
+	_num_jumps(0),
+	_jumps_overflow(false)
+{
+	invalidate();
+}
+
+void
+MissionItemCache::invalidate()
+{
+	for (unsigned i = 0; i < WINDOW_SIZE; i++) {
+		_item_index[i] = -1;
+	}
+
+	_selected = false;
+	_index_built = false;
+	_land_start_index = -1;
+	_num_jumps = 0;
+	_jumps_overflow = false;
+}
+
+void
+MissionItemCache::select(dm_item_t dm_item, unsigned count)
+{
+	if (!_selected || dm_item != _dm_item || count != _count) {
+		invalidate();
+		_dm_item = dm_item;
+		_count = count;
+		_selected = true;
+	}
+}
+
+bool
+MissionItemCache::load(unsigned index)
+{
+	const unsigned slot = index % WINDOW_SIZE;
+	const ssize_t len = sizeof(struct mission_item_s);
+
+	if (dm_read(_dm_item, index, &_items[slot], len) != len) {
+		_item_index[slot] = -1;
+		return false;
+	}
+
+	_item_index[slot] = index;
+	return true;
+}
+
+bool
+MissionItemCache::read(dm_item_t dm_item, unsigned count, unsigned index, struct mission_item_s *item)
+{
+	if (index >= count) {
+		return false;
+	}
+
+	select(dm_item, count);
+
+	const unsigned slot = index % WINDOW_SIZE;
+
+	if (_item_index[slot] != (int)index && !load(index)) {
+		return false;
+	}
+
+	memcpy(item, &_items[slot], sizeof(struct mission_item_s));
+	return true;
+}
+
+bool
+MissionItemCache::write(dm_item_t dm_item, unsigned index, const struct mission_item_s *item)
+{
+	const ssize_t len = sizeof(struct mission_item_s);
+
+	if (dm_write(dm_item, index, DM_PERSIST_POWER_ON_RESET, item, len) != len) {
+		/* the stored item is unknown now */
+		if (_selected && dm_item == _dm_item && _item_index[index % WINDOW_SIZE] == (int)index) {
+			_item_index[index % WINDOW_SIZE] = -1;
+		}
+
+		return false;
+	}
+
+	if (_selected && dm_item == _dm_item && _item_index[index % WINDOW_SIZE] == (int)index) {
+		memcpy(&_items[index % WINDOW_SIZE], item, sizeof(struct mission_item_s));
+	}
+
+	return true;
+}
+
+void
+MissionItemCache::prefetch(dm_item_t dm_item, unsigned count, unsigned index)
+{
+	select(dm_item, count);
+
+	for (unsigned i = index; i < count && i < index + WINDOW_SIZE; i++) {
+		if (_item_index[i % WINDOW_SIZE] != (int)i && !load(i)) {
+			break;
+		}
+	}
+}
+
+bool
+MissionItemCache::build_index(dm_item_t dm_item, unsigned count)
+{
+	select(dm_item, count);
+
+	_land_start_index = -1;
+	_num_jumps = 0;
+	_jumps_overflow = false;
+
+	for (unsigned i = 0; i < count; i++) {
+		const unsigned slot = i % WINDOW_SIZE;
+		struct mission_item_s missionitem;
+		const ssize_t len = sizeof(missionitem);
+
+		if (dm_read(dm_item, i, &missionitem, len) != len) {
+			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+			_index_built = false;
+			return false;
+		}
+
+		/* keep the start of the mission in the cache */
+		if (i < WINDOW_SIZE) {
+			memcpy(&_items[slot], &missionitem, sizeof(missionitem));
+			_item_index[slot] = i;
+		}
+
+		if (missionitem.nav_cmd == NAV_CMD_DO_LAND_START && _land_start_index < 0) {
+			_land_start_index = i;
+
+		} else if (missionitem.nav_cmd == NAV_CMD_DO_JUMP) {
+			if (_num_jumps < MAX_JUMPS) {
+				_jump_index[_num_jumps++] = i;
+
+			} else {
+				_jumps_overflow = true;
+			}
+		}
+	}
+
+	_index_built = true;
+	return true;
+}
+
+bool
+MissionItemCache::index_valid(dm_item_t dm_item, unsigned count) const
+{
+	return _index_built && _selected && dm_item == _dm_item && count == _count;
+}
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file mission_item_cache.h
+ * Sliding window cache of mission items in front of the dataman, plus an
+ * index of the items the navigator looks up by command.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <dataman/dataman.h>
+#include <navigator/navigation.h>
+
+class MissionItemCache
+{
+public:
+	static constexpr unsigned WINDOW_SIZE = 16;	/**< number of cached items */
+	static constexpr unsigned MAX_JUMPS = 16;	/**< number of DO_JUMP items kept in the index */
+
+	MissionItemCache();
+	~MissionItemCache() = default;
+
+	/**
+	 * Drop all cached items and the index, has to be called whenever the
+	 * mission storage might have been changed by someone else.
+	 */
+	void invalidate();
+
+	/**
+	 * Read a mission item, from the cache if possible.
+	 * @param dm_item storage of the mission
+	 * @param count number of items in the mission
+	 * @param index item to read
+	 * @return true on success
+	 */
+	bool read(dm_item_t dm_item, unsigned count, unsigned index, struct mission_item_s *item);
+
+	/**
+	 * Write a mission item to the dataman and keep the cache in sync.
+	 * @return true on success
+	 */
+	bool write(dm_item_t dm_item, unsigned index, const struct mission_item_s *item);
+
+	/**
+	 * Load the items from index on which are not cached yet, so that following
+	 * reads up to WINDOW_SIZE items ahead do not block on the dataman.
+	 * Once the window is filled, moving on by one item costs one read.
+	 */
+	void prefetch(dm_item_t dm_item, unsigned count, unsigned index);
+
+	/**
+	 * Scan the whole mission once and index DO_LAND_START and DO_JUMP items.
+	 * The first WINDOW_SIZE items are kept in the cache.
+	 * @return true on success
+	 */
+	bool build_index(dm_item_t dm_item, unsigned count);
+
+	/**
+	 * @return true if the index was built for this mission
+	 */
+	bool index_valid(dm_item_t dm_item, unsigned count) const;
+
+	/**
+	 * @return index of the first DO_LAND_START item, -1 if there is none
+	 */
+	int land_start_index() const { return _land_start_index; }
+
+	/**
+	 * @return number of DO_JUMP items, -1 if there are more than MAX_JUMPS
+	 */
+	int jump_count() const { return _jumps_overflow ? -1 : (int)_num_jumps; }
+
+	/**
+	 * @return mission index of the i-th DO_JUMP item
+	 */
+	unsigned jump_index(unsigned i) const { return _jump_index[i]; }
+
+private:
+	void select(dm_item_t dm_item, unsigned count);
+	bool load(unsigned index);
+
+	struct mission_item_s _items[WINDOW_SIZE];
+	int _item_index[WINDOW_SIZE];	/**< mission index held in a slot, -1 if empty */
+
+	dm_item_t _dm_item;
+	unsigned _count;
+	bool _selected;
+
+	bool _index_built;
+	int _land_start_index;
+	uint16_t _jump_index[MAX_JUMPS];
+	unsigned _num_jumps;
+	bool _jumps_overflow;
+};
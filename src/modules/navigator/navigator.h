@@ -46,6 +46,7 @@
 #include <controllib/blocks.hpp>
 #include <controllib/block/BlockParam.hpp>
 #include <navigator/navigation.h>
+#include <terrain_database/terrain_database.h>
 
 #include <uORB/uORB.h>
 #include <uORB/topics/mission.h>
@@ -77,6 +78,11 @@
  */
 #define NAVIGATOR_MODE_ARRAY_SIZE 10
 
+/**
+ * Terrain tiles generated by Tools/generate_terrain_tiles.py
+ */
+#define TERRAIN_DIRECTORY PX4_ROOTFSDIR"/fs/microsd/terrain"
+
 class Navigator : public control::SuperBlock
 {
 public:
@@ -151,6 +157,7 @@ public:
 	int		get_onboard_mission_sub() { return _onboard_mission_sub; }
 	int		get_offboard_mission_sub() { return _offboard_mission_sub; }
 	Geofence&	get_geofence() { return _geofence; }
+	TerrainDatabase &get_terrain() { return _terrain; }
 	bool		get_can_loiter_at_sp() { return _can_loiter_at_sp; }
 	float		get_loiter_radius() { return _param_loiter_radius.get(); }
 
@@ -267,7 +274,9 @@ private:
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
 
 	Geofence	_geofence;			/**< class that handles the geofence */
+	TerrainDatabase	_terrain;			/**< terrain heights, only enabled if tiles are available */
 	bool		_geofence_violation_warning_sent; /**< prevents spaming to mavlink */
+	bool		_geofence_prediction_warning_sent; /**< prevents spaming predicted breaches to mavlink */
 
 	bool		_inside_fence;			/**< vehicle is inside fence */
 
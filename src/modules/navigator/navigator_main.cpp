@@ -137,7 +137,9 @@ Navigator::Navigator() :
 	_mission_instance_count(0),
 	_loop_perf(perf_alloc(PC_ELAPSED, "navigator")),
 	_geofence(this),
+	_terrain(),
 	_geofence_violation_warning_sent(false),
+	_geofence_prediction_warning_sent(false),
 	_inside_fence(true),
 	_can_loiter_at_sp(false),
 	_pos_sp_triplet_updated(false),
@@ -299,6 +301,11 @@ Navigator::task_main()
 		}
 	}
 
+	/* terrain tiles are optional */
+	if (_terrain.init(TERRAIN_DIRECTORY) == OK) {
+		PX4_INFO("using terrain data in %s", TERRAIN_DIRECTORY);
+	}
+
 	/* do subscriptions */
 	_global_pos_sub = orb_subscribe(ORB_ID(vehicle_global_position));
 	_gps_pos_sub = orb_subscribe(ORB_ID(vehicle_gps_position));
@@ -530,10 +537,25 @@ Navigator::task_main()
 			(hrt_elapsed_time(&last_geofence_check) > GEOFENCE_CHECK_INTERVAL)) {
 
 			bool inside = _geofence.inside(_global_pos, _gps_pos, _sensor_combined.baro_alt_meter, _home_pos, home_position_valid());
+			float breach_distance = _geofence.predictBreach(_global_pos, _gps_pos, _pos_sp_triplet);
 			last_geofence_check = hrt_absolute_time();
 			have_geofence_position_data = false;
 
 			_geofence_result.geofence_action = _geofence.getGeofenceAction();
+			_geofence_result.geofence_breach_predicted = PX4_ISFINITE(breach_distance);
+			_geofence_result.breach_distance = breach_distance;
+
+			/* a predicted breach is only a warning, the geofence action is left to an actual violation */
+			if (inside && _geofence_result.geofence_breach_predicted) {
+				if (!_geofence_prediction_warning_sent) {
+					mavlink_log_critical(&_mavlink_log_pub, "Geofence breach predicted in %.0f m", (double)breach_distance);
+					_geofence_prediction_warning_sent = true;
+				}
+
+			} else {
+				_geofence_prediction_warning_sent = false;
+			}
+
 			if (!inside) {
 				/* inform other apps via the mission result */
 				_geofence_result.geofence_violated = true;
@@ -710,6 +732,8 @@ Navigator::status()
 	} else {
 		PX4_INFO("Geofence not set (no /etc/geofence.txt on microsd) or not valid");
 	}
+
+	_terrain.print_status();
 }
 
 void
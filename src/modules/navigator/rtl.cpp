@@ -40,6 +40,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <float.h>
 #include <fcntl.h>
 
 #include <systemlib/mavlink_log.h>
@@ -60,10 +61,13 @@ RTL::RTL(Navigator *navigator, const char *name) :
 	MissionBlock(navigator, name),
 	_rtl_state(RTL_STATE_NONE),
 	_rtl_start_lock(false),
+	_return_alt(0.0f),
+	_time_terrain_request(0),
 	_param_return_alt(this, "RTL_RETURN_ALT", false),
 	_param_descend_alt(this, "RTL_DESCEND_ALT", false),
 	_param_land_delay(this, "RTL_LAND_DELAY", false),
-	_param_rtl_min_dist(this, "RTL_MIN_DIST", false)
+	_param_rtl_min_dist(this, "RTL_MIN_DIST", false),
+	_param_terrain_clearance(this, "RTL_TERR_CLR", false)
 {
 	/* load initial params */
 	updateParams();
@@ -82,6 +86,14 @@ RTL::on_inactive()
 	if (!_navigator->get_can_loiter_at_sp()) {
 		_rtl_state = RTL_STATE_NONE;
 	}
+
+	/* keep the terrain on the way home cached, return_altitude() does not wait for the storage */
+	if (_param_terrain_clearance.get() > FLT_EPSILON && _navigator->get_terrain().enabled()
+	    && _navigator->home_position_valid() && hrt_elapsed_time(&_time_terrain_request) > 5 * 1000 * 1000) {
+		_navigator->get_terrain().request(_navigator->get_global_position()->lat, _navigator->get_global_position()->lon,
+						  _navigator->get_home_position()->lat, _navigator->get_home_position()->lon);
+		_time_terrain_request = hrt_absolute_time();
+	}
 }
 
 void
@@ -100,6 +112,8 @@ RTL::on_activation()
 
 	/* decide where to enter the RTL procedure when we switch into it */
 	if (_rtl_state == RTL_STATE_NONE) {
+		_return_alt = return_altitude();
+
 		/* for safety reasons don't go into RTL if landed */
 		if (_navigator->get_land_detected()->landed) {
 			_rtl_state = RTL_STATE_LANDED;
@@ -108,8 +122,7 @@ RTL::on_activation()
 			/* if lower than return altitude, climb up first */
 
 		} else if (home_dist > _param_rtl_min_dist.get()
-			   && _navigator->get_global_position()->alt < _navigator->get_home_position()->alt
-			   + _param_return_alt.get()) {
+			   && _navigator->get_global_position()->alt < _return_alt) {
 			_rtl_state = RTL_STATE_CLIMB;
 
 			/* otherwise go straight to return */
@@ -135,6 +148,24 @@ RTL::on_active()
 	}
 }
 
+float
+RTL::return_altitude()
+{
+	float return_alt = _navigator->get_home_position()->alt + _param_return_alt.get();
+	float terrain_max;
+
+	/* without terrain data along the whole path the return altitude stays relative to home */
+	if (_param_terrain_clearance.get() > FLT_EPSILON
+	    && _navigator->get_terrain().max_height_on_path(_navigator->get_global_position()->lat,
+			    _navigator->get_global_position()->lon, _navigator->get_home_position()->lat,
+			    _navigator->get_home_position()->lon, terrain_max, false)) {
+
+		return_alt = fmaxf(return_alt, terrain_max + _param_terrain_clearance.get());
+	}
+
+	return return_alt;
+}
+
 void
 RTL::set_rtl_item()
 {
@@ -151,7 +182,7 @@ RTL::set_rtl_item()
 
 	switch (_rtl_state) {
 	case RTL_STATE_CLIMB: {
-			float climb_alt = _navigator->get_home_position()->alt + _param_return_alt.get();
+			float climb_alt = _return_alt;
 
 			_mission_item.lat = _navigator->get_global_position()->lat;
 			_mission_item.lon = _navigator->get_global_position()->lon;
@@ -44,6 +44,7 @@
 #include <controllib/blocks.hpp>
 #include <controllib/block/BlockParam.hpp>
 
+#include <drivers/drv_hrt.h>
 #include <navigator/navigation.h>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/vehicle_global_position.h>
@@ -77,6 +78,11 @@ private:
 	 */
 	void		advance_rtl();
 
+	/**
+	 * Altitude to return at, raised above the terrain on the way home if required
+	 */
+	float		return_altitude();
+
 	enum RTLState {
 		RTL_STATE_NONE = 0,
 		RTL_STATE_CLIMB,
@@ -89,11 +95,14 @@ private:
 	} _rtl_state;
 
 	bool _rtl_start_lock;
+	float _return_alt;
+	hrt_abstime _time_terrain_request;	/**< last request to cache the terrain on the way home */
 
 	control::BlockParamFloat _param_return_alt;
 	control::BlockParamFloat _param_descend_alt;
 	control::BlockParamFloat _param_land_delay;
 	control::BlockParamFloat _param_rtl_min_dist;
+	control::BlockParamFloat _param_terrain_clearance;
 };
 
 #endif
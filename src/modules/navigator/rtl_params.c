@@ -103,3 +103,19 @@ PARAM_DEFINE_FLOAT(RTL_LAND_DELAY, -1.0f);
  * @group Return To Land
  */
 PARAM_DEFINE_FLOAT(RTL_MIN_DIST, 5.0f);
+
+/**
+ * RTL terrain clearance
+ *
+ * If terrain data is available, the return altitude is raised so that the
+ * vehicle stays at least this high above the highest terrain on the direct
+ * path home. Set to 0 to disable.
+ *
+ * @unit m
+ * @min 0
+ * @max 500
+ * @decimal 1
+ * @increment 0.5
+ * @group Return To Land
+ */
+PARAM_DEFINE_FLOAT(RTL_TERR_CLR, 0.0f);
@@ -71,6 +71,7 @@
 #include <platforms/px4_defines.h>
 
 #include <terrain_estimation/terrain_estimator.h>
+#include <terrain_database/terrain_database.h>
 #include "position_estimator_inav_params.h"
 #include "inertial_filter.h"
 
@@ -408,6 +409,13 @@ int position_estimator_inav_thread_main(int argc, char *argv[])
 	bool wait_baro = true;
 	TerrainEstimator terrain_estimator;
 
+	/* a few tiles around the vehicle are enough for the terrain estimator */
+	TerrainDatabase terrain_database;
+
+	if (terrain_database.init(PX4_ROOTFSDIR"/fs/microsd/terrain", 4) == 0) {
+		terrain_estimator.set_terrain_database(&terrain_database);
+	}
+
 	thread_running = true;
 	hrt_abstime baro_wait_for_sample_time = hrt_absolute_time();
 
@@ -48,6 +48,7 @@
 #include <rc/sumd.h>
 #include <rc/sbus.h>
 #include <rc/dsm.h>
+#include <rc/rc_scan.h>
 
 #include "px4io.h"
 
@@ -95,56 +96,36 @@ bool dsm_port_input(uint16_t *rssi, bool *dsm_updated, bool *st24_updated, bool
 
 	perf_end(c_gather_dsm);
 
-	/* get data from FD and attempt to parse with DSM and ST24 libs */
-	uint8_t st24_rssi, lost_count;
-	uint16_t st24_channel_count = 0;
+	/* feed the same bytes to the ST24 and SUMD decoders in one pass */
+	struct rc_scan_result scan;
+	uint8_t scan_proto = rc_scan_parse(hrt_absolute_time(), bytes, n_bytes, RC_SCAN_PROTO_ST24 | RC_SCAN_PROTO_SUMD,
+					   r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS, &scan);
 
-	*st24_updated = false;
+	*st24_updated = (scan_proto == RC_SCAN_PROTO_ST24);
+	*sumd_updated = (scan_proto == RC_SCAN_PROTO_SUMD);
 
-	for (unsigned i = 0; i < n_bytes; i++) {
-		/* set updated flag if one complete packet was parsed */
-		st24_rssi = RC_INPUT_RSSI_MAX;
-		*st24_updated |= (OK == st24_decode(bytes[i], &st24_rssi, &lost_count,
-						    &st24_channel_count, r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS));
-	}
-
-	if (*st24_updated && lost_count == 0) {
+	if (*st24_updated) {
 
 		/* ensure ADC RSSI is disabled */
 		r_setup_features &= ~(PX4IO_P_SETUP_FEATURES_ADC_RSSI);
 
-		*rssi = st24_rssi;
-		r_raw_rc_count = st24_channel_count;
+		*rssi = scan.rssi;
+		r_raw_rc_count = scan.num_values;
 
 		r_status_flags |= PX4IO_P_STATUS_FLAGS_RC_ST24;
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FRAME_DROP);
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FAILSAFE);
 	}
 
-
-	/* get data from FD and attempt to parse with SUMD libs */
-	uint8_t sumd_rssi, sumd_rx_count;
-	uint16_t sumd_channel_count = 0;
-	bool sumd_failsafe_state;
-
-	*sumd_updated = false;
-
-	for (unsigned i = 0; i < n_bytes; i++) {
-		/* set updated flag if one complete packet was parsed */
-		sumd_rssi = RC_INPUT_RSSI_MAX;
-		*sumd_updated |= (OK == sumd_decode(bytes[i], &sumd_rssi, &sumd_rx_count,
-						    &sumd_channel_count, r_raw_rc_values, PX4IO_RC_INPUT_CHANNELS, &sumd_failsafe_state));
-	}
-
 	if (*sumd_updated) {
 
 		/* not setting RSSI since SUMD does not provide one */
-		r_raw_rc_count = sumd_channel_count;
+		r_raw_rc_count = scan.num_values;
 
 		r_status_flags |= PX4IO_P_STATUS_FLAGS_RC_SUMD;
 		r_raw_rc_flags &= ~(PX4IO_P_RAW_RC_FLAGS_FRAME_DROP);
 
-		if (sumd_failsafe_state) {
+		if (scan.failsafe) {
 			r_raw_rc_flags |= (PX4IO_P_RAW_RC_FLAGS_FAILSAFE);
 
 		} else {
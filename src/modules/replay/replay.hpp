@@ -146,12 +146,6 @@ private:
 	bool nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id);
 
 	static const orb_metadata *findTopic(const std::string &name);
-	/** get the array size from a type. eg. float[3] -> return float */
-	static std::string extractArraySize(const std::string &type_name_full, int &array_size);
-	/** get the size of a type that is not an array */
-	static size_t sizeOfType(const std::string &type_name);
-	/** get the size of a type that can be an array */
-	static size_t sizeOfFullType(const std::string &type_name_full);
 
 	void setUserParams(const char *filename);
 
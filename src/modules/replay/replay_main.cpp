@@ -299,41 +299,19 @@ bool Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
 
 
 	//find the timestamp offset (not necessarily the first field)
-	string fields = orb_meta->o_fields;
-	size_t prev_field_end = 0;
-	size_t field_end = fields.find(';');
-	bool timestamp_found = false;
-	subscription.timestamp_offset = 0;
-
-	while (field_end != string::npos && !timestamp_found) {
-		size_t space_pos = fields.find(' ', prev_field_end);
-
-		if (space_pos != string::npos) {
-			string type_name_full = fields.substr(prev_field_end, space_pos - prev_field_end);
-			string field_name = fields.substr(space_pos + 1, field_end - space_pos - 1);
-
-			if (field_name == "timestamp") {
-				timestamp_found = true;
-
-				if (type_name_full != "uint64_t") {
-					PX4_ERR("Unsupported timestamp type %s, ignoring the topic %s", type_name_full.c_str(),
-						orb_meta->o_name);
-					return true;
-				}
-
-			} else {
-				subscription.timestamp_offset += sizeOfFullType(type_name_full);
-			}
-		}
+	const orb_field *timestamp = orb_find_field(orb_meta, "timestamp");
 
-		prev_field_end = field_end + 1;
-		field_end = fields.find(';', prev_field_end);
+	if (!timestamp) {
+		return true;
 	}
 
-	if (!timestamp_found) {
+	if (timestamp->type != ORB_FIELD_UINT64 || timestamp->count != 1) {
+		PX4_ERR("Unsupported timestamp type, ignoring the topic %s", orb_meta->o_name);
 		return true;
 	}
 
+	subscription.timestamp_offset = timestamp->offset;
+
 
 	//find first data message (and the timestamp)
 	streampos cur_pos = file.tellg();
@@ -534,60 +512,6 @@ const orb_metadata *Replay::findTopic(const std::string &name)
 	return nullptr;
 }
 
-std::string Replay::extractArraySize(const std::string &type_name_full, int &array_size)
-{
-	size_t start_pos = type_name_full.find('[');
-	size_t end_pos = type_name_full.find(']');
-
-	if (start_pos == string::npos || end_pos == string::npos) {
-		array_size = 1;
-		return type_name_full;
-	}
-
-	array_size = atoi(type_name_full.substr(start_pos + 1, end_pos - start_pos - 1).c_str());
-	return type_name_full.substr(0, start_pos);
-}
-
-size_t Replay::sizeOfType(const std::string &type_name)
-{
-	if (type_name == "int8_t" || type_name == "uint8_t") {
-		return 1;
-
-	} else if (type_name == "int16_t" || type_name == "uint16_t") {
-		return 2;
-
-	} else if (type_name == "int32_t" || type_name == "uint32_t") {
-		return 4;
-
-	} else if (type_name == "int64_t" || type_name == "uint64_t") {
-		return 8;
-
-	} else if (type_name == "float") {
-		return 4;
-
-	} else if (type_name == "double") {
-		return 8;
-
-	} else if (type_name == "char" || type_name == "bool") {
-		return 1;
-	}
-
-	const orb_metadata *orb_meta = findTopic(type_name);
-
-	if (orb_meta) {
-		return orb_meta->o_size;
-	}
-
-	PX4_ERR("unknown type: %s", type_name.c_str());
-	return 0;
-}
-size_t Replay::sizeOfFullType(const std::string &type_name_full)
-{
-	int array_size;
-	string type_name = extractArraySize(type_name_full, array_size);
-	return sizeOfType(type_name) * array_size;
-}
-
 bool Replay::readDefinitionsAndApplyParams(std::ifstream &file)
 {
 	// log reader currently assumes little endian
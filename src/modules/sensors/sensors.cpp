@@ -76,6 +76,7 @@
 #include <systemlib/param/param.h>
 #include <systemlib/err.h>
 #include <systemlib/perf_counter.h>
+#include <systemlib/latency_trace.h>
 #include <systemlib/battery.h>
 
 #include <conversion/rotation.h>
@@ -671,8 +672,12 @@ Sensors::task_main()
 
 			_voted_sensors_update.set_relative_timestamps(raw);
 
+			raw.trace_id = latency_trace_start(raw.timestamp);
+
 			orb_publish(ORB_ID(sensor_combined), _sensor_pub, &raw);
 
+			latency_trace_hop(latency_trace_s::HOP_SENSORS, raw.trace_id);
+
 			_voted_sensors_update.check_failover();
 
 			/* If the the vehicle is disarmed calculate the length of the maximum difference between
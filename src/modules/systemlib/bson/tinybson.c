@@ -64,7 +64,44 @@ read_x(bson_decoder_t decoder, void *p, size_t s)
 	CODER_CHECK(decoder);
 
 	if (decoder->fd > -1) {
-		return (BSON_READ(decoder->fd, p, s) == (int)s) ? 0 : -1;
+		uint8_t *dst = (uint8_t *)p;
+
+		while (s > 0) {
+			if (decoder->bufpos == decoder->bufsize) {
+				/* refill the read-ahead, but not past the end of the document */
+				size_t n = BSON_FILE_BUFSIZE;
+
+				if (decoder->file_remaining >= 0 && (size_t)decoder->file_remaining < n) {
+					n = decoder->file_remaining;
+				}
+
+				int ret = (n > 0) ? BSON_READ(decoder->fd, decoder->file_buf, n) : 0;
+
+				if (ret <= 0) {
+					CODER_KILL(decoder, "read error");
+				}
+
+				if (decoder->file_remaining >= 0) {
+					decoder->file_remaining -= ret;
+				}
+
+				decoder->bufsize = ret;
+				decoder->bufpos = 0;
+			}
+
+			size_t n = decoder->bufsize - decoder->bufpos;
+
+			if (n > s) {
+				n = s;
+			}
+
+			memcpy(dst, decoder->file_buf + decoder->bufpos, n);
+			decoder->bufpos += n;
+			dst += n;
+			s -= n;
+		}
+
+		return 0;
 	}
 
 	if (decoder->buf != NULL) {
@@ -113,10 +150,13 @@ read_double(bson_decoder_t decoder, double *d)
 int
 bson_decoder_init_file(bson_decoder_t decoder, int fd, bson_decoder_callback callback, void *private)
 {
-	int32_t	junk;
+	int32_t	len;
 
 	decoder->fd = fd;
-	decoder->buf = NULL;
+	decoder->file_remaining = -1;
+	decoder->buf = decoder->file_buf;
+	decoder->bufsize = 0;
+	decoder->bufpos = 0;
 	decoder->dead = false;
 	decoder->callback = callback;
 	decoder->private = private;
@@ -124,9 +164,19 @@ bson_decoder_init_file(bson_decoder_t decoder, int fd, bson_decoder_callback cal
 	decoder->pending = 0;
 	decoder->node.type = BSON_UNDEFINED;
 
-	/* read and discard document size */
-	if (read_int32(decoder, &junk)) {
-		CODER_KILL(decoder, "failed discarding length");
+	/* read the document size, documents written to files have none */
+	if (read_int32(decoder, &len)) {
+		CODER_KILL(decoder, "failed reading length");
+	}
+
+	if (len > (int32_t)sizeof(len)) {
+		decoder->file_remaining = len - (int32_t)decoder->bufsize;
+
+		if (decoder->file_remaining < 0) {
+			/* the read-ahead already went past the document */
+			decoder->bufsize += decoder->file_remaining;
+			decoder->file_remaining = 0;
+		}
 	}
 
 	/* ready for decoding */
@@ -195,6 +245,12 @@ bson_decoder_next(bson_decoder_t decoder)
 		if (decoder->nesting == 0) {
 			/* like kill but not an error */
 			debug("nesting is zero, document is done");
+
+			/* give back what was read ahead, so the file is positioned after the document */
+			if (decoder->fd > -1 && decoder->bufpos < decoder->bufsize) {
+				lseek(decoder->fd, -(off_t)(decoder->bufsize - decoder->bufpos), SEEK_CUR);
+			}
+
 			decoder->fd = -1;
 
 			/* return end-of-file to the caller */
@@ -73,6 +73,11 @@ typedef enum bson_binary_subtype {
  */
 #define BSON_MAXNAME		32
 
+/**
+ * Read-ahead when decoding from a file, to avoid a read() per field.
+ */
+#define BSON_FILE_BUFSIZE	128
+
 /**
  * Buffer growth increment when writing to a buffer.
  */
@@ -104,8 +109,10 @@ typedef int	(* bson_decoder_callback)(bson_decoder_t decoder, void *private, bso
 struct bson_decoder_s {
 	/* file reader state */
 	int			fd;
+	int32_t			file_remaining;	/* document bytes left in the file, -1 if unknown */
+	uint8_t			file_buf[BSON_FILE_BUFSIZE];
 
-	/* buffer reader state */
+	/* buffer reader state (also the read-ahead window of the file reader) */
 	uint8_t			*buf;
 	size_t			bufsize;
 	unsigned		bufpos;
@@ -52,8 +52,14 @@
 #include <stdlib.h>
 #include <errno.h>
 #include "flashfs.h"
+
+#if defined(__PX4_NUTTX)
 #include <nuttx/compiler.h>
 #include <nuttx/progmem.h>
+#else
+#include <sys/types.h>
+#define packed_struct __attribute__((packed))
+#endif
 
 
 /****************************************************************************
@@ -75,11 +81,18 @@ typedef enum  flash_config_t {
 	BlankSig     = 0xffffffff
 } flash_config_t;
 
+/* A file is written as PendingEntry and made valid by clearing a bit once
+ * the previous version is erased, so a power loss at any point leaves one
+ * complete version. DeltaEntry records are appended after the valid entry
+ * of the same file.
+ */
 typedef enum  flash_flags_t {
 	SizeMask      = 0x0003,
 	MaskEntry     = ~SizeMask,
 	BlankEntry    = (h_flag_t)BlankSig,
 	ValidEntry    = (0xa5ac & ~SizeMask),
+	PendingEntry  = (0xa7ac & ~SizeMask),
+	DeltaEntry    = (0x5a50 & ~SizeMask),
 	ErasedEntry   = 0x0000,
 } flash_flags_t;
 
@@ -116,6 +129,95 @@ static bool working_buffer_static;
 static sector_descriptor_t *sector_map;
 static int last_erased;
 
+#if !defined(__PX4_NUTTX)
+
+/****************************************************************************
+ * RAM backed flash
+ *
+ * On POSIX the sector map describes RAM buffers. Writes can only clear bits
+ * like on flash, and parameter_flashfs_power_cut() stops all programming and
+ * erasing after a number of bytes to simulate a power loss.
+ ****************************************************************************/
+
+static int power_cut_budget = -1;
+static bool write_error = false;
+
+void parameter_flashfs_power_cut(int bytes)
+{
+	power_cut_budget = bytes;
+}
+
+bool parameter_flashfs_powered(void)
+{
+	return power_cut_budget != 0;
+}
+
+void parameter_flashfs_write_error(bool error)
+{
+	write_error = error;
+}
+
+static size_t power_cut_consume(size_t count)
+{
+	if (power_cut_budget < 0) {
+		return count;
+	}
+
+	if (count > (size_t)power_cut_budget) {
+		count = power_cut_budget;
+	}
+
+	power_cut_budget -= count;
+	return count;
+}
+
+static ssize_t up_progmem_getpage(size_t addr)
+{
+	for (int s = 0; sector_map[s].address; s++) {
+		if (addr >= sector_map[s].address && addr < sector_map[s].address + sector_map[s].size) {
+			return sector_map[s].page;
+		}
+	}
+
+	return -EFAULT;
+}
+
+static ssize_t up_progmem_erasepage(size_t page)
+{
+	if (write_error) {
+		return -EIO;
+	}
+
+	for (int s = 0; sector_map[s].address; s++) {
+		if (sector_map[s].page == page) {
+			memset((void *)sector_map[s].address, 0xff, power_cut_consume(sector_map[s].size));
+			return sector_map[s].size;
+		}
+	}
+
+	return -EFAULT;
+}
+
+static ssize_t up_progmem_write(size_t addr, const void *buf, size_t count)
+{
+	uint8_t *pd = (uint8_t *)addr;
+	const uint8_t *ps = (const uint8_t *)buf;
+
+	if (write_error) {
+		return -EIO;
+	}
+
+	size_t n = power_cut_consume(count);
+
+	for (size_t i = 0; i < n; i++) {
+		pd[i] &= ps[i];
+	}
+
+	return count;
+}
+
+#endif /* !__PX4_NUTTX */
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -299,6 +401,16 @@ static inline int valid_entry(flash_entry_header_t *fi)
 	return (fi->flag & MaskEntry) == ValidEntry;
 }
 
+static inline int pending_entry(flash_entry_header_t *fi)
+{
+	return (fi->flag & MaskEntry) == PendingEntry;
+}
+
+static inline int delta_entry(flash_entry_header_t *fi)
+{
+	return (fi->flag & MaskEntry) == DeltaEntry;
+}
+
 /****************************************************************************
  * Name: entry_size_adjust
  *
@@ -424,13 +536,45 @@ static inline data_size_t entry_crc_length(flash_entry_header_t *fi)
 }
 
 /****************************************************************************
- * Name: find_entry
+ * Name: entry_crc_valid
  *
  * Description:
- *   This helper function locates an "file" from the the file token
+ *   This helper function checks that an entry lies within its sector and
+ *   that its CRC is correct
+ *
+ * Input Parameters:
+ *   fi  - A pointer to the current file header
+ *   sm  - The sector the entry is located in
+ *
+ * Returned value:
+ *   true if the entry can be trusted
+ *
+ *
+ ****************************************************************************/
+
+static bool entry_crc_valid(flash_entry_header_t *fi, sector_descriptor_t *sm)
+{
+	uint8_t *pb = (uint8_t *) fi;
+	uint8_t *pend = (uint8_t *) sm->address + sm->size;
+
+	if (pb + sizeof(flash_entry_header_t) > pend || fi->size < sizeof(flash_entry_header_t) ||
+	    fi->size % sizeof(h_magic_t) != 0 || pb + fi->size > pend) {
+		return false;
+	}
+
+	return fi->crc == crc32(entry_crc_start(fi), entry_crc_length(fi));
+}
+
+/****************************************************************************
+ * Name: find_entry_flagged
+ *
+ * Description:
+ *   This helper function locates an "file" from the the file token and the
+ *   state of the entry
  *
  * Input Parameters:
  *   token        - A flash file token, the pseudo file name
+ *   flag         - The entry state: ValidEntry or PendingEntry
  *
  * Returned value:
  *  On Success a pointer to flash entry header or NULL on failure
@@ -438,7 +582,7 @@ static inline data_size_t entry_crc_length(flash_entry_header_t *fi)
  *
  ****************************************************************************/
 
-static flash_entry_header_t *find_entry(flash_file_token_t token)
+static flash_entry_header_t *find_entry_flagged(flash_file_token_t token, h_flag_t flag)
 {
 	for (int s = 0; sector_map[s].address; s++) {
 
@@ -446,58 +590,60 @@ static flash_entry_header_t *find_entry(flash_file_token_t token)
 		h_magic_t *pe = pmagic + (sector_map[s].size / sizeof(h_magic_t)) - 1;
 
 		/* Hunt for Magic Signature */
-cont:
 
-		while (pmagic != pe && !valid_magic(pmagic)) {
-			pmagic++;
-		}
-
-		/* Did we reach the end
-		 * if so try the next sector */
+		while (pmagic < pe) {
 
-		if (pmagic == pe) { continue; }
+			flash_entry_header_t *pf = (flash_entry_header_t *) pmagic;
 
-		/* Found a magic So assume it is a file header */
+			if (!valid_magic(pmagic) || !entry_crc_valid(pf, &sector_map[s])) {
 
-		flash_entry_header_t *pf = (flash_entry_header_t *) pmagic;
+				/* No file or an invalid CRC so keep looking */
 
-		/* Test the CRC */
-
-		if (pf->crc == crc32(entry_crc_start(pf), entry_crc_length(pf))) {
+				pmagic++;
+				continue;
+			}
 
 			/* Good CRC is it the one we are looking for ?*/
 
-			if (valid_entry(pf) && pf->file_token.t == token.t) {
-
+			if ((pf->flag & MaskEntry) == flag && pf->file_token.t == token.t) {
 				return pf;
-
-			} else {
-
-				/* Not the one we wanted but we can trust the size */
-
-				pf = next_entry(pf);
-				pmagic = (h_magic_t *) pf;
-
-				/* If the next one is erased */
-
-				if (blank_entry(pf)) {
-					continue;
-				}
 			}
 
-			goto cont;
+			/* Not the one we wanted but we can trust the size */
 
-		} else {
+			pmagic = (h_magic_t *) next_entry(pf);
 
-			/* in valid CRC so keep looking */
+			/* If the next one is blank so is the rest of the sector */
 
-			pmagic++;
+			if (pmagic < pe && blank_entry((flash_entry_header_t *) pmagic)) {
+				break;
+			}
 		}
 	}
 
 	return NULL;
 }
 
+/****************************************************************************
+ * Name: find_entry
+ *
+ * Description:
+ *   This helper function locates an "file" from the the file token
+ *
+ * Input Parameters:
+ *   token        - A flash file token, the pseudo file name
+ *
+ * Returned value:
+ *  On Success a pointer to flash entry header or NULL on failure
+ *
+ *
+ ****************************************************************************/
+
+static flash_entry_header_t *find_entry(flash_file_token_t token)
+{
+	return find_entry_flagged(token, ValidEntry);
+}
+
 /****************************************************************************
  * Name: find_free
  *
@@ -519,6 +665,7 @@ static flash_entry_header_t *find_free(data_size_t required)
 
 		h_magic_t *pmagic = (h_magic_t *) sector_map[s].address;
 		h_magic_t *pe = pmagic + (sector_map[s].size / sizeof(h_magic_t)) - 1;
+		uint8_t *pend = (uint8_t *) sector_map[s].address + sector_map[s].size;
 
 		/* Hunt for Magic Signature */
 
@@ -530,12 +677,16 @@ static flash_entry_header_t *find_free(data_size_t required)
 
 				/* Test the CRC */
 
-				if (pf->crc == crc32(entry_crc_start(pf), entry_crc_length(pf))) {
+				if (entry_crc_valid(pf, &sector_map[s])) {
 
 					/* Valid Magic and CRC look for the next record*/
 
 					pmagic = ((uint32_t *) next_entry(pf));
 
+					if (pmagic > pe) {
+						break;
+					}
+
 				} else {
 
 					pmagic++;
@@ -546,12 +697,12 @@ static flash_entry_header_t *find_free(data_size_t required)
 
 				flash_entry_header_t *pf = (flash_entry_header_t *) pmagic;
 
-				if (blank_entry(pf) && blank_check(pf, required)) {
+				if ((uint8_t *) pf + required <= pend && blank_entry(pf) && blank_check(pf, required)) {
 					return pf;
 				}
 
 			}
-		}  while (++pmagic != pe);
+		}  while (++pmagic < pe);
 	}
 
 	return NULL;
@@ -715,6 +866,143 @@ static sector_descriptor_t *check_free_space_in_sector(flash_entry_header_t
 	return sm;
 }
 
+/****************************************************************************
+ * Name: log_end
+ *
+ * Description:
+ *   Given a pointer to the valid entry of a file, this helper function
+ *   returns the location after its last delta record, where the next record
+ *   can be appended
+ *
+ * Input Parameters:
+ *   pf  - A pointer to the valid flash entry header of the file
+ *   sm  - The sector the entry is located in
+ *
+ * Returned value:
+ *  The location after the last record, or NULL if the sector is full or
+ *  the records are followed by data which is neither a delta record nor
+ *  blank, e.g. after a power loss during a write.
+ *
+ ****************************************************************************/
+
+static flash_entry_header_t *log_end(flash_entry_header_t *pf, sector_descriptor_t *sm)
+{
+	uint8_t *pend = (uint8_t *) sm->address + sm->size;
+	flash_entry_header_t *pn = next_entry(pf);
+
+	while ((uint8_t *) pn < pend) {
+
+		if (valid_magic((h_magic_t *) pn) && entry_crc_valid(pn, sm) &&
+		    delta_entry(pn) && pn->file_token.t == pf->file_token.t) {
+			pn = next_entry(pn);
+			continue;
+		}
+
+		if ((uint8_t *) pn + sizeof(flash_entry_header_t) > pend || !blank_entry(pn)) {
+			return NULL;
+		}
+
+		return pn;
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: entry_write
+ *
+ * Description:
+ *   This helper function fills in the header of the buffer allocated with
+ *   parameter_flashfs_alloc and programs the entry to the flash
+ *
+ * Input Parameters:
+ *   pf          - The flash location to write to
+ *   token       - File Token
+ *   flag        - The entry state to write
+ *   buffer      - A buffer returned by parameter_flashfs_alloc
+ *   buf_size    - Number of bytes of user data
+ *
+ * Returned value:
+ *   On success the number of bytes of user data written or a negative errno
+ *
+ ****************************************************************************/
+
+static int entry_write(flash_entry_header_t *pf, flash_file_token_t token, h_flag_t flag,
+		       uint8_t *buffer, size_t buf_size)
+{
+	size_t total_size = buf_size + sizeof(flash_entry_header_t);
+	size_t alignment = sizeof(h_magic_t) - 1;
+	size_t  size_adjust = ((total_size + alignment) & ~alignment) - total_size;
+	total_size += size_adjust;
+
+	flash_entry_header_t *pn = (flash_entry_header_t *)(buffer - sizeof(flash_entry_header_t));
+	pn->magic = MagicSig;
+	pn->file_token.t = token.t;
+	pn->flag = flag + size_adjust;
+	pn->size = total_size;
+
+	for (size_t a = 0; a < size_adjust; a++) {
+		buffer[buf_size + a] = (uint8_t)BlankSig;
+	}
+
+	pn->crc = crc32(entry_crc_start(pn), entry_crc_length(pn));
+	int rv = up_progmem_write((size_t) pf, pn, pn->size);
+	int system_bytes = (sizeof(flash_entry_header_t) + size_adjust);
+
+	if (rv >= system_bytes) {
+		rv -= system_bytes;
+	}
+
+	return rv;
+}
+
+/****************************************************************************
+ * Name: validate_entry
+ *
+ * Description:
+ *   Turns a PendingEntry into a ValidEntry, which only clears bits
+ *
+ * Input Parameters:
+ *   pf  - A pointer to the pending flash entry header
+ *
+ * Returned value:
+ *  >0 On Success or a negative errno
+ *
+ ****************************************************************************/
+
+static int validate_entry(flash_entry_header_t *pf)
+{
+	h_flag_t data = ValidEntry + entry_size_adjust(pf);
+	return up_progmem_write((size_t) &pf->flag, &data, sizeof(h_flag_t));
+}
+
+/****************************************************************************
+ * Name: recover_entry
+ *
+ * Description:
+ *   Completes a write interrupted by a power loss: a complete pending entry
+ *   replaces the valid one.
+ *
+ * Input Parameters:
+ *   token       - File Token
+ *
+ ****************************************************************************/
+
+static void recover_entry(flash_file_token_t token)
+{
+	flash_entry_header_t *pending = find_entry_flagged(token, PendingEntry);
+
+	if (pending) {
+		flash_entry_header_t *pf = find_entry(token);
+
+		if (pf) {
+			erase_entry(pf);
+		}
+
+		validate_entry(pending);
+	}
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -796,46 +1084,28 @@ parameter_flashfs_write(flash_file_token_t token, uint8_t *buffer, size_t buf_si
 		/* Is this and existing entry */
 
 		flash_entry_header_t *pf = find_entry(token);
+		flash_entry_header_t *pn;
 
 		if (!pf) {
 
 			/* No Entry exists for this token so find a place for it */
 
-			pf = find_free(total_size);
+			pn = find_free(total_size);
 
 			/* No Space */
 
-			if (pf == 0) {
+			if (pn == 0) {
 				return -ENOSPC;
 			}
 
 		} else {
 
-			/* Do we have space after the entry in the sector for the update */
-
-			sector_descriptor_t *current_sector = check_free_space_in_sector(pf,
-							      total_size);
-
+			/* Do we have space after the entry and its delta records in the sector for the update */
 
-			if (current_sector == 0) {
+			sector_descriptor_t *current_sector = get_sector_info(pf);
+			pn = log_end(pf, current_sector);
 
-				/* Mark the last entry erased */
-
-				/* todo:consider a 2 stage erase or write before erase and do a fs check
-				 * at start up
-				 */
-
-				rv = erase_entry(pf);
-
-				if (rv < 0) {
-					return rv;
-				}
-
-				/* We had space and marked the last entry erased so use the  Next Free */
-
-				pf = next_entry(pf);
-
-			} else {
+			if (pn == NULL || check_free_space_in_sector(pn, total_size) != 0) {
 
 				/*
 				 * We did not have space in the current sector so select the next sector
@@ -849,42 +1119,142 @@ parameter_flashfs_write(flash_file_token_t token, uint8_t *buffer, size_t buf_si
 					return -ENOSPC;
 				}
 
-				/* Mark the last entry erased */
+				pn = (flash_entry_header_t *) current_sector->address;
 
-				/* todo:consider a 2 stage erase or write before erase and do a fs check
-				 * at start up
-				 */
+				/* Anything left in it is outdated, delta records are appended after the new entry */
 
-				rv = erase_entry(pf);
+				if (!blank_check(pn, current_sector->size)) {
+					rv = erase_sector(current_sector, pn);
 
-				if (rv < 0) {
-					return rv;
+					if (rv < 0) {
+						return rv;
+					}
 				}
-
-				pf = (flash_entry_header_t *) current_sector->address;
 			}
+		}
+
+		/* Write the new entry as pending, the old one stays valid until it is complete */
 
-			if (!blank_check(pf, total_size)) {
-				rv = erase_sector(current_sector, pf);
+		rv = entry_write(pn, token, PendingEntry, buffer, buf_size);
+
+		if (rv < 0) {
+			return rv;
+		}
+
+		if (pf) {
+			int erv = erase_entry(pf);
+
+			if (erv < 0) {
+				return erv;
 			}
 		}
 
-		flash_entry_header_t *pn = (flash_entry_header_t *)(buffer - sizeof(flash_entry_header_t));
-		pn->magic = MagicSig;
-		pn->file_token.t = token.t;
-		pn->flag = ValidEntry + size_adjust;
-		pn->size = total_size;
+		int vrv = validate_entry(pn);
+
+		if (vrv < 0) {
+			return vrv;
+		}
+	}
+
+	return rv;
+}
+
+/****************************************************************************
+ * Name: parameter_flashfs_append
+ *
+ * Description:
+ *   This function appends a delta record to an existing "file". The record
+ *   is written after the file and the records appended before, in the same
+ *   sector, so no erase is needed. When there is no space left the caller
+ *   writes the complete file with parameter_flashfs_write, which moves it to
+ *   the next sector.
+ *
+ * Input Parameters:
+ *   token       - File Token
+ *   buffer      - A pointer to a buffer with buf_size bytes to be written
+ *                 to the flash. This buffer must be allocated
+ *                 with a previous call to parameter_flashfs_alloc
+ *   buf_size    - Number of bytes to write
+ *
+ * Returned value:
+ *   On success the number of bytes written, -ENOENT if the file does not
+ *   exist and -ENOSPC if the record does not fit, or a negative value of errno
+ *
+ ****************************************************************************/
+
+int
+parameter_flashfs_append(flash_file_token_t token, uint8_t *buffer, size_t buf_size)
+{
+	int rv = -ENXIO;
 
-		for (size_t a = 0; a < size_adjust; a++) {
-			buffer[buf_size + a] = (uint8_t)BlankSig;
+	if (sector_map) {
+
+		flash_entry_header_t *pf = find_entry(token);
+
+		if (!pf) {
+			return -ENOENT;
 		}
 
-		pn->crc = crc32(entry_crc_start(pn), entry_crc_length(pn));
-		rv = up_progmem_write((size_t) pf, pn, pn->size);
-		int system_bytes = (sizeof(flash_entry_header_t) + size_adjust);
+		size_t total_size = buf_size + sizeof(flash_entry_header_t);
+		size_t alignment = sizeof(h_magic_t) - 1;
+		total_size = (total_size + alignment) & ~alignment;
 
-		if (rv >= system_bytes) {
-			rv -= system_bytes;
+		flash_entry_header_t *pn = log_end(pf, get_sector_info(pf));
+
+		if (pn == NULL || check_free_space_in_sector(pn, total_size) != 0 || !blank_check(pn, total_size)) {
+			return -ENOSPC;
+		}
+
+		rv = entry_write(pn, token, DeltaEntry, buffer, buf_size);
+	}
+
+	return rv;
+}
+
+/****************************************************************************
+ * Name: parameter_flashfs_read_delta
+ *
+ * Description:
+ *   This function iterates over the delta records appended to a "file",
+ *   oldest first.
+ *
+ * Input Parameters:
+ *   token       - File Token File to read
+ *   buffer      - In: NULL for the first record or the data of the previous
+ *                 one. Out: the address in flash of the data of the record
+ *   buf_size    - A pointer to receive the number of bytes in the record
+ *
+ * Returned value:
+ *   On success number of bytes read, -ENOENT after the last record or a
+ *   negative errno value,
+ *
+ ****************************************************************************/
+
+int parameter_flashfs_read_delta(flash_file_token_t token, uint8_t **buffer, size_t *buf_size)
+{
+	int rv = -ENXIO;
+
+	if (sector_map) {
+
+		rv = -ENOENT;
+		flash_entry_header_t *pf = find_entry(token);
+
+		if (pf) {
+			sector_descriptor_t *sm = get_sector_info(pf);
+			uint8_t *pend = (uint8_t *) sm->address + sm->size;
+
+			if (*buffer) {
+				pf = (flash_entry_header_t *)(*buffer - sizeof(flash_entry_header_t));
+			}
+
+			flash_entry_header_t *pn = next_entry(pf);
+
+			if ((uint8_t *) pn < pend && valid_magic((h_magic_t *) pn) && entry_crc_valid(pn, sm) &&
+			    delta_entry(pn) && pn->file_token.t == token.t) {
+				(*buffer) = entry_data(pn);
+				rv = entry_data_length(pn);
+				*buf_size = rv;
+			}
 		}
 	}
 
@@ -1026,6 +1396,10 @@ int parameter_flashfs_init(sector_descriptor_t *fconfig, uint8_t *buffer, uint16
 	working_buffer_size = size;
 	last_erased = -1;
 
+	/* Complete a write interrupted by a power loss */
+
+	recover_entry(parameters_token);
+
 	/* Sanity check */
 
 	flash_entry_header_t *pf = find_entry(parameters_token);
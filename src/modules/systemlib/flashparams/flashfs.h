@@ -100,7 +100,7 @@ __EXPORT extern const flash_file_token_t parameters_token;
 typedef struct sector_descriptor_t {
 	uint8_t       page;
 	uint16_t      size;
-	uint32_t      address;
+	uintptr_t     address;
 } sector_descriptor_t;
 
 
@@ -177,6 +177,52 @@ __EXPORT int parameter_flashfs_read(flash_file_token_t ft, uint8_t **buffer, siz
 
 __EXPORT int parameter_flashfs_write(flash_file_token_t ft, uint8_t *buffer, size_t buf_size);
 
+/****************************************************************************
+ * Name: parameter_flashfs_append
+ *
+ * Description:
+ *   This function appends a delta record to an existing "file" from the
+ *   buffer allocated with a previous call to parameter_flashfs_alloc. Records
+ *   are written after the file in the same sector, without an erase. Writing
+ *   the file with parameter_flashfs_write drops all records.
+ *
+ * Input Parameters:
+ *   token      - File Token
+ *   buffer      - A pointer to a buffer with buf_size bytes to be written
+ *                 to the flash. This buffer must be allocated
+ *                 with a previous call to parameter_flashfs_alloc
+ *   buf_size    - Number of bytes to write
+ *
+ * Returned value:
+ *   On success the number of bytes written, -ENOENT if the file does not
+ *   exist, -ENOSPC if the sector is full and the file needs to be written
+ *   again with parameter_flashfs_write, or a negative value of errno
+ *
+ ****************************************************************************/
+
+__EXPORT int parameter_flashfs_append(flash_file_token_t ft, uint8_t *buffer, size_t buf_size);
+
+/****************************************************************************
+ * Name: parameter_flashfs_read_delta
+ *
+ * Description:
+ *   This function iterates over the delta records appended to a "file",
+ *   oldest first.
+ *
+ * Input Parameters:
+ *   token       - File Token File to read
+ *   buffer      - In: NULL for the first record or the data of the previous
+ *                 one. Out: the address in flash of the data of the record
+ *   buf_size    - A pointer to receive the number of bytes in the record
+ *
+ * Returned value:
+ *   On success number of bytes read, -ENOENT after the last record or a
+ *   negative errno value,
+ *
+ ****************************************************************************/
+
+__EXPORT int parameter_flashfs_read_delta(flash_file_token_t ft, uint8_t **buffer, size_t *buf_size);
+
 /****************************************************************************
  * Name: parameter_flashfs_erase
  *
@@ -227,5 +273,41 @@ __EXPORT int parameter_flashfs_alloc(flash_file_token_t ft, uint8_t **buffer, si
 
 __EXPORT void parameter_flashfs_free(void);
 
+#if !defined(__PX4_NUTTX)
+/****************************************************************************
+ * Name: parameter_flashfs_power_cut
+ *
+ * Description:
+ *   On POSIX the sectors are RAM buffers. This stops all flash programming
+ *   and erasing after the given number of bytes to simulate a power loss,
+ *   -1 restores the power.
+ *
+ ****************************************************************************/
+
+__EXPORT void parameter_flashfs_power_cut(int bytes);
+
+/****************************************************************************
+ * Name: parameter_flashfs_powered
+ *
+ * Description:
+ *   Returns false once a power cut set with parameter_flashfs_power_cut
+ *   happened.
+ *
+ ****************************************************************************/
+
+__EXPORT bool parameter_flashfs_powered(void);
+
+/****************************************************************************
+ * Name: parameter_flashfs_write_error
+ *
+ * Description:
+ *   On POSIX, makes all flash programming and erasing fail with -EIO while
+ *   set, like a worn out sector.
+ *
+ ****************************************************************************/
+
+__EXPORT void parameter_flashfs_write_error(bool error);
+#endif
+
 __END_DECLS
 #endif /* _SYSTEMLIB_FLASHPARAMS_NUTTX_PARAM_H */
@@ -70,6 +70,9 @@ struct param_wbuf_s {
 };
 
 
+/** param_values_removed when the parameters were last written completely */
+static unsigned saved_values_removed;
+
 /** lock the parameter store */
 static void
 param_lock(void)
@@ -85,12 +88,51 @@ param_unlock(void)
 }
 
 
+/**
+ * Clear the unsaved flag of the values not modified after epoch, once they
+ * have been written.
+ */
+static void
+param_mark_saved(uint32_t epoch)
+{
+	struct param_wbuf_s *s = NULL;
+
+	/* after the epoch counter ran out they are just saved again next time */
+	if (!param_epoch_current_boot(epoch)) {
+		return;
+	}
+
+	param_lock();
+
+	if (param_values != NULL) {
+		while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
+			if (param_get_epoch(s->param) <= epoch) {
+				s->unsaved = false;
+			}
+		}
+	}
+
+	param_unlock();
+}
+
+/**
+ * Write the parameters to flash.
+ *
+ * @param only_unsaved	Append the values changed since the last save as a delta
+ *			record instead of writing all of them.
+ * @return		0 on success, -ENOSPC or -ENOENT if a delta record cannot
+ *			be appended, or another negative errno.
+ */
 static int
 param_export_internal(bool only_unsaved)
 {
 	struct param_wbuf_s *s = NULL;
 	struct bson_encoder_s encoder;
 	int     result = -1;
+	unsigned encoded = 0;
+
+	/* values modified while encoding or writing stay unsaved */
+	const uint32_t epoch = param_epoch();
 
 	param_lock();
 
@@ -117,7 +159,7 @@ param_export_internal(bool only_unsaved)
 			continue;
 		}
 
-		s->unsaved = false;
+		encoded++;
 
 		/* append the appropriate BSON type object */
 
@@ -172,6 +214,13 @@ out:
 
 		bson_encoder_fini(&encoder);
 
+		/* Nothing changed since the last save */
+
+		if (only_unsaved && encoded == 0) {
+			free(bson_encoder_buf_data(&encoder));
+			return OK;
+		}
+
 		/* Get requiered space */
 
 		size_t buf_size = bson_encoder_buf_size(&encoder);
@@ -181,17 +230,31 @@ out:
 		uint8_t *buffer;
 		result = parameter_flashfs_alloc(parameters_token, &buffer, &buf_size);
 
-		if (result == OK) {
+		if (result == OK && only_unsaved) {
 
-			/* Check for a write that has no changes */
+			memcpy(buffer, bson_encoder_buf_data(&encoder), buf_size);
+			result = parameter_flashfs_append(parameters_token, buffer, buf_size);
+			result = result < 0 ? result : result == buf_size ? OK : -EFBIG;
+
+			free(bson_encoder_buf_data(&encoder));
+			parameter_flashfs_free();
+
+		} else if (result == OK) {
+
+			/* Check for a write that has no changes, delta records saved since are dropped by a write */
 
 			uint8_t *was_buffer;
 			size_t was_buf_size;
 			int was_result = parameter_flashfs_read(parameters_token, &was_buffer, &was_buf_size);
 
+			uint8_t *delta = NULL;
+			size_t delta_size;
+			bool has_delta = parameter_flashfs_read_delta(parameters_token, &delta, &delta_size) >= 0;
+
 			void *enc_buff = bson_encoder_buf_data(&encoder);
 
-			bool commit = was_result < OK || was_buf_size != buf_size || 0 != memcmp(was_buffer, enc_buff, was_buf_size);
+			bool commit = was_result < OK || has_delta || was_buf_size != buf_size ||
+				      0 != memcmp(was_buffer, enc_buff, was_buf_size);
 
 			if (commit) {
 
@@ -206,6 +269,10 @@ out:
 		}
 	}
 
+	if (result == OK) {
+		param_mark_saved(epoch);
+	}
+
 	return result;
 }
 
@@ -323,29 +390,45 @@ out:
 }
 
 static int
-param_import_internal(bool mark_saved)
+param_import_buf(uint8_t *buffer, size_t buf_size, struct param_import_state *state)
 {
 	struct bson_decoder_s decoder;
 	int result = -1;
+
+	if (bson_decoder_init_buf(&decoder, buffer, buf_size, param_import_callback, state)) {
+		debug("decoder init failed");
+		return result;
+	}
+
+	do {
+		result = bson_decoder_next(&decoder);
+
+	} while (result > 0);
+
+	return result;
+}
+
+static int
+param_import_internal(bool mark_saved)
+{
+	int result = -1;
 	struct param_import_state state;
 
 	uint8_t *buffer = 0;
 	size_t buf_size;
 	parameter_flashfs_read(parameters_token, &buffer, &buf_size);
 
-	if (bson_decoder_init_buf(&decoder, buffer, buf_size, param_import_callback, &state)) {
-		debug("decoder init failed");
-		goto out;
-	}
-
 	state.mark_saved = mark_saved;
 
-	do {
-		result = bson_decoder_next(&decoder);
+	result = param_import_buf(buffer, buf_size, &state);
 
-	} while (result > 0);
+	/* apply the changes saved since, oldest first */
 
-out:
+	uint8_t *delta = NULL;
+
+	while (result >= 0 && parameter_flashfs_read_delta(parameters_token, &delta, &buf_size) >= 0) {
+		result = param_import_buf(delta, buf_size, &state);
+	}
 
 	if (result < 0) {
 		debug("BSON error decoding parameters");
@@ -356,20 +439,36 @@ out:
 
 int flash_param_save(void)
 {
-	return param_export_internal(false);
+	/*
+	 * Append the changed values without an erase. A reset value can only be
+	 * dropped by writing all of them, as well as a full sector.
+	 */
+	if (param_values_removed == saved_values_removed && param_export_internal(true) == OK) {
+		return OK;
+	}
+
+	int result = param_export_internal(false);
+
+	if (result == OK) {
+		saved_values_removed = param_values_removed;
+	}
+
+	return result;
 }
 
 
 int flash_param_save_default(void)
 {
-	return param_export_internal(false);
+	return flash_param_save();
 }
 
 
 int flash_param_load(void)
 {
 	param_reset_all();
-	return param_import_internal(true);
+	int result = param_import_internal(true);
+	saved_values_removed = param_values_removed;
+	return result;
 }
 
 int flash_param_import(void)
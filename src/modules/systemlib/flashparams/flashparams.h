@@ -61,6 +61,7 @@ __BEGIN_DECLS
 #define FLASH_PARAMS_EXPOSE __EXPORT
 
 __EXPORT extern UT_array        *param_values;
+__EXPORT extern unsigned        param_values_removed;
 __EXPORT int param_set_external(param_t param, const void *val, bool mark_saved, bool notify_changes, bool is_saved);
 __EXPORT const void *param_get_value_ptr_external(param_t param);
 
@@ -0,0 +1,237 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file latency_trace.c
+ * Sensor to actuator latency tracing.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <drivers/drv_hrt.h>
+#include <uORB/uORB.h>
+#include "latency_trace.h"
+
+#ifdef __PX4_QURT
+// There is presumably no dprintf on QURT. Therefore use the usual output to mini-dm.
+#define dprintf(_fd, _text, ...) ((_fd) == 1 ? PX4_INFO((_text), ##__VA_ARGS__) : (void)(_fd))
+#endif
+
+/* Traces that can be in flight at once. A trace that is not complete when its slot is
+ * reused is dropped, with the default interval this is several hundred ms. */
+#define TRACE_SLOTS	8
+
+#define LATENCY_BUCKET_COUNT	8
+
+/**
+ * One trace in flight. Each hop is recorded by a different module, the slot is
+ * (re-)initialized only by latency_trace_start().
+ */
+struct trace_slot {
+	volatile uint32_t	trace_id;
+	uint64_t		timestamp_sample;
+	uint64_t		hop_time[NUM_HOPS];
+	volatile bool		done;
+};
+
+static const uint16_t latency_buckets[LATENCY_BUCKET_COUNT] = { 100, 200, 500, 1000, 2000, 5000, 10000, 20000 };
+
+/* one histogram per hop and one for the whole path, the last bucket counts overflows */
+static uint32_t latency_counters[NUM_HOPS + 1][LATENCY_BUCKET_COUNT + 1];
+static uint32_t latency_max[NUM_HOPS + 1];
+static uint32_t traces_completed;
+
+static struct trace_slot trace_slots[TRACE_SLOTS];
+static volatile uint32_t trace_interval;
+static uint32_t next_trace_id = 1;
+static uint64_t last_trace_start;
+static orb_advert_t latency_trace_pub;
+
+static void
+count_latency(unsigned histogram, uint32_t latency)
+{
+	unsigned bucket = 0;
+
+	while (bucket < LATENCY_BUCKET_COUNT && latency > latency_buckets[bucket]) {
+		bucket++;
+	}
+
+	latency_counters[histogram][bucket]++;
+
+	if (latency > latency_max[histogram]) {
+		latency_max[histogram] = latency;
+	}
+}
+
+static void
+complete_trace(struct trace_slot *slot)
+{
+	struct latency_trace_s report;
+	memset(&report, 0, sizeof(report));
+	report.timestamp = slot->hop_time[HOP_OUTPUT];
+	report.timestamp_sample = slot->timestamp_sample;
+	report.trace_id = slot->trace_id;
+
+	/* hops that were not seen (e.g. no estimator hop on a custom path) count towards the next one */
+	uint64_t previous = slot->timestamp_sample;
+
+	for (unsigned hop = 0; hop < NUM_HOPS; hop++) {
+		if (slot->hop_time[hop] == 0 || slot->hop_time[hop] < previous) {
+			continue;
+		}
+
+		report.hop_latency[hop] = slot->hop_time[hop] - previous;
+		count_latency(hop, report.hop_latency[hop]);
+		previous = slot->hop_time[hop];
+	}
+
+	report.total_latency = slot->hop_time[HOP_OUTPUT] - slot->timestamp_sample;
+	count_latency(NUM_HOPS, report.total_latency);
+	traces_completed++;
+
+	orb_publish(ORB_ID(latency_trace), latency_trace_pub, &report);
+}
+
+int
+latency_trace_set_interval(uint32_t interval_us)
+{
+	/* advertise before the first trace can start, so the output drivers only publish */
+	if (interval_us != 0 && latency_trace_pub == NULL) {
+		struct latency_trace_s report;
+		memset(&report, 0, sizeof(report));
+		latency_trace_pub = orb_advertise(ORB_ID(latency_trace), &report);
+
+		if (latency_trace_pub == NULL) {
+			return -1;
+		}
+	}
+
+	trace_interval = interval_us;
+	return 0;
+}
+
+uint32_t
+latency_trace_get_interval(void)
+{
+	return trace_interval;
+}
+
+uint32_t
+latency_trace_start(uint64_t timestamp_sample)
+{
+	uint32_t interval = trace_interval;
+
+	if (interval == 0 || timestamp_sample - last_trace_start < interval) {
+		return 0;
+	}
+
+	last_trace_start = timestamp_sample;
+
+	uint32_t trace_id = next_trace_id++;
+
+	if (next_trace_id == 0) {
+		next_trace_id = 1;
+	}
+
+	struct trace_slot *slot = &trace_slots[trace_id % TRACE_SLOTS];
+
+	/* invalidate the slot before reusing it, so late hops of the old trace are ignored */
+	slot->trace_id = 0;
+	slot->timestamp_sample = timestamp_sample;
+	memset(slot->hop_time, 0, sizeof(slot->hop_time));
+	slot->done = false;
+	slot->trace_id = trace_id;
+
+	return trace_id;
+}
+
+void
+latency_trace_hop(uint8_t hop, uint32_t trace_id)
+{
+	if (trace_id == 0 || hop >= NUM_HOPS) {
+		return;
+	}
+
+	struct trace_slot *slot = &trace_slots[trace_id % TRACE_SLOTS];
+
+	if (slot->trace_id != trace_id || slot->done) {
+		return;
+	}
+
+	/* only the first module publishing a hop counts */
+	if (slot->hop_time[hop] == 0) {
+		slot->hop_time[hop] = hrt_absolute_time();
+	}
+
+	if (hop == HOP_OUTPUT) {
+		slot->done = true;
+		complete_trace(slot);
+	}
+}
+
+void
+latency_trace_print(int fd)
+{
+	static const char *names[NUM_HOPS + 1] = { "sample->sensors", "sensors->estimator", "estimator->control",
+						    "control->output", "sample->output"
+						  };
+
+	dprintf(fd, "tracing: %s, interval %u us, %u traces\n", trace_interval ? "on" : "off",
+		(unsigned)trace_interval, (unsigned)traces_completed);
+
+	dprintf(fd, "%-20s", "latency [us]");
+
+	for (unsigned i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+		dprintf(fd, " %7u", latency_buckets[i]);
+	}
+
+	dprintf(fd, "  >%5u      max\n", latency_buckets[LATENCY_BUCKET_COUNT - 1]);
+
+	for (unsigned h = 0; h <= NUM_HOPS; h++) {
+		dprintf(fd, "%-20s", names[h]);
+
+		for (unsigned i = 0; i <= LATENCY_BUCKET_COUNT; i++) {
+			dprintf(fd, " %7u", (unsigned)latency_counters[h][i]);
+		}
+
+		dprintf(fd, " %8u\n", (unsigned)latency_max[h]);
+	}
+}
+
+void
+latency_trace_reset(void)
+{
+	memset(latency_counters, 0, sizeof(latency_counters));
+	memset(latency_max, 0, sizeof(latency_max));
+	traces_completed = 0;
+}
@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file latency_trace.h
+ * Sensor to actuator latency tracing.
+ *
+ * While tracing is enabled, sensors picks an IMU sample every interval and gives it a
+ * trace id. The id and the sample timestamp are passed along in sensor_combined,
+ * control_state / vehicle_attitude, actuator_controls and actuator_outputs, and every
+ * module on the path records when it published data based on the sample. When the
+ * outputs are written the trace is complete: the per hop latencies are added to
+ * histograms and published as latency_trace.
+ */
+
+#ifndef _SYSTEMLIB_LATENCY_TRACE_H
+#define _SYSTEMLIB_LATENCY_TRACE_H
+
+#include <stdint.h>
+#include <px4_defines.h>
+#include <uORB/topics/latency_trace.h>
+
+__BEGIN_DECLS
+
+/**
+ * Enable or disable tracing. Enabling tracing the first time advertises latency_trace
+ * with an empty report (trace id 0).
+ *
+ * @param interval_us		time between two traced samples, 0 disables tracing
+ * @return			0 on success, -1 if latency_trace could not be advertised
+ */
+__EXPORT extern int		latency_trace_set_interval(uint32_t interval_us);
+
+/**
+ * Current trace interval in microseconds, 0 if tracing is disabled.
+ */
+__EXPORT extern uint32_t	latency_trace_get_interval(void);
+
+/**
+ * Decide if a sample is traced. Must only be called by the module producing the samples.
+ *
+ * @param timestamp_sample	timestamp of the sample
+ * @return			trace id to pass along with the sample, 0 if it is not traced
+ */
+__EXPORT extern uint32_t	latency_trace_start(uint64_t timestamp_sample);
+
+/**
+ * Record that data based on a traced sample was published. Does nothing if trace_id is 0
+ * or the trace is too old. Recording the output hop completes the trace.
+ *
+ * @param hop			one of latency_trace_s::HOP_*
+ * @param trace_id		trace id passed along with the data
+ */
+__EXPORT extern void		latency_trace_hop(uint8_t hop, uint32_t trace_id);
+
+/**
+ * Print the latency histograms.
+ */
+__EXPORT extern void		latency_trace_print(int fd);
+
+/**
+ * Clear the latency histograms.
+ */
+__EXPORT extern void		latency_trace_reset(void);
+
+__END_DECLS
+
+#endif
@@ -54,6 +54,7 @@
 #include <systemlib/err.h>
 #include <errno.h>
 #include <semaphore.h>
+#include <pthread.h>
 #include <math.h>
 
 #include <sys/stat.h>
@@ -69,11 +70,8 @@
 # include "uORB/topics/parameter_update.h"
 #endif
 
-#if !defined(FLASH_BASED_PARAMS)
-#  define FLASH_PARAMS_EXPOSE
-#else
-#  include "systemlib/flashparams/flashparams.h"
-#endif
+/* the flash store is built on POSIX too, for its test */
+#include "systemlib/flashparams/flashparams.h"
 
 #include "px4_parameters.h"
 #include <crc32.h>
@@ -120,6 +118,42 @@ uint8_t  *param_changed_storage = 0;
 int size_param_changed_storage_bytes = 0;
 const int bits_per_allocation_unit  = (sizeof(*param_changed_storage) * 8);
 
+/**
+ * Protects the used bits, the tables derived from them and param_hash.
+ * param_lock() does not lock, and the tables are rebuilt in place.
+ */
+static pthread_mutex_t param_used_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Number of used params before each allocation unit of param_changed_storage,
+ * rebuilt on the next lookup after a param got marked as used.
+ */
+static uint16_t *param_used_prefix = NULL;
+static unsigned param_used_count = 0;
+static bool param_used_prefix_dirty = true;
+
+/**
+ * Bytes hashed by param_hash_check() (name and value of each used param) before
+ * each allocation unit, and in total.
+ */
+static uint32_t *param_used_length_prefix = NULL;
+static uint32_t param_used_length = 0;
+
+/** param_hash_check() result, kept up to date on single changes and recomputed after bulk ones */
+static uint32_t param_hash = 0;
+static bool param_hash_dirty = true;
+
+/** counts changes, a recompute only stores its result if nothing changed while it ran */
+static uint32_t param_hash_generation = 0;
+
+/**
+ * param_epoch() and the epoch of the last modification of each param. The
+ * high bits of an epoch are a per boot nonce, the low bits count modifications.
+ */
+#define PARAM_EPOCH_COUNTER_MASK	0x000fffffu
+static volatile uint32_t param_epoch_value = 0;
+static uint32_t *param_epochs = NULL;
+
 
 static unsigned
 get_param_info_count(void)
@@ -128,11 +162,23 @@ get_param_info_count(void)
 	if (!param_changed_storage) {
 		size_param_changed_storage_bytes  = (param_info_count / bits_per_allocation_unit) + 1;
 		param_changed_storage = calloc(size_param_changed_storage_bytes, 1);
+		param_used_prefix = calloc(size_param_changed_storage_bytes, sizeof(*param_used_prefix));
+		param_used_length_prefix = calloc(size_param_changed_storage_bytes, sizeof(*param_used_length_prefix));
+		param_epochs = calloc(param_info_count, sizeof(*param_epochs));
 
 		/* If the allocation fails we need to indicate failure in the
 		 * API by returning PARAM_INVALID
 		 */
-		if (param_changed_storage == NULL) {
+		if (param_changed_storage == NULL || param_used_prefix == NULL || param_used_length_prefix == NULL ||
+		    param_epochs == NULL) {
+			free(param_changed_storage);
+			free(param_used_prefix);
+			free(param_used_length_prefix);
+			free(param_epochs);
+			param_changed_storage = NULL;
+			param_used_prefix = NULL;
+			param_used_length_prefix = NULL;
+			param_epochs = NULL;
 			return 0;
 		}
 	}
@@ -140,12 +186,60 @@ get_param_info_count(void)
 	return param_info_count;
 }
 
+static unsigned
+count_bits(uint8_t bits)
+{
+	unsigned count = 0;
+
+	for (; bits; bits &= bits - 1) {
+		count++;
+	}
+
+	return count;
+}
+
+/**
+ * Make param_used_prefix and param_used_count consistent with param_changed_storage.
+ * Call with param_used_mutex held.
+ */
+static void
+param_used_prefix_update(void)
+{
+	if (!param_used_prefix_dirty) {
+		return;
+	}
+
+	param_used_prefix_dirty = false;
+
+	unsigned count = 0;
+	uint32_t length = 0;
+
+	for (int i = 0; i < size_param_changed_storage_bytes; i++) {
+		param_used_prefix[i] = count;
+		param_used_length_prefix[i] = length;
+		count += count_bits(param_changed_storage[i]);
+
+		for (int j = 0; j < bits_per_allocation_unit; j++) {
+			if (param_changed_storage[i] & (1 << j)) {
+				param_t param = i * bits_per_allocation_unit + j;
+				length += strlen(param_name(param)) + param_size(param);
+			}
+		}
+	}
+
+	param_used_count = count;
+	param_used_length = length;
+}
+
 /** flexible array holding modified parameter values */
 FLASH_PARAMS_EXPOSE UT_array        *param_values;
 
 /** array info for the modified parameters array */
 FLASH_PARAMS_EXPOSE const UT_icd    param_icd = {sizeof(struct param_wbuf_s), NULL, NULL, NULL};
 
+/** number of resets removing values from param_values, these cannot be saved incrementally */
+FLASH_PARAMS_EXPOSE unsigned        param_values_removed = 0;
+
 #if !defined(PARAM_NO_ORB)
 
 /** parameter update topic handle */
@@ -212,6 +306,34 @@ param_compare_values(const void *a, const void *b)
 	return 0;
 }
 
+/**
+ * Binary search for a parameter in the first count entries of param_values,
+ * which are kept sorted by param_compare_values (bsearch is not available).
+ */
+static struct param_wbuf_s *
+param_find_changed_in(param_t param, unsigned count)
+{
+	int low = 0;
+	int high = (int)count - 1;
+
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		struct param_wbuf_s *s = (struct param_wbuf_s *)utarray_eltptr(param_values, (unsigned)mid);
+
+		if (s->param == param) {
+			return s;
+
+		} else if (s->param < param) {
+			low = mid + 1;
+
+		} else {
+			high = mid - 1;
+		}
+	}
+
+	return NULL;
+}
+
 /**
  * Locate the modified parameter structure for a parameter, if it exists.
  *
@@ -227,19 +349,7 @@ param_find_changed(param_t param)
 	param_assert_locked();
 
 	if (param_values != NULL) {
-#if 0	/* utarray_find requires bsearch, not available */
-		struct param_wbuf_s key;
-		key.param = param;
-		s = utarray_find(param_values, &key, param_compare_values);
-#else
-
-		while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
-			if (s->param == param) {
-				break;
-			}
-		}
-
-#endif
+		s = param_find_changed_in(param, utarray_len(param_values));
 	}
 
 	return s;
@@ -271,17 +381,26 @@ param_notify_changes(bool is_saved)
 param_t
 param_find_internal(const char *name, bool notification)
 {
-	param_t param;
+	/* the parameters are sorted by name (see Tools/px_generate_params.py) */
+	int low = 0;
+	int high = (int)get_param_info_count() - 1;
 
-	/* perform a linear search of the known parameters */
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		int cmp = strcmp(name, param_info_base[mid].name);
 
-	for (param = 0; handle_in_range(param); param++) {
-		if (!strcmp(param_info_base[param].name, name)) {
+		if (cmp == 0) {
 			if (notification) {
-				param_set_used_internal(param);
+				param_set_used_internal((param_t)mid);
 			}
 
-			return param;
+			return (param_t)mid;
+
+		} else if (cmp < 0) {
+			high = mid - 1;
+
+		} else {
+			low = mid + 1;
 		}
 	}
 
@@ -310,20 +429,16 @@ param_count(void)
 unsigned
 param_count_used(void)
 {
-	unsigned count = 0;
-
 	// ensure the allocation has been done
-	if (get_param_info_count()) {
-
-		for (unsigned i = 0; i < size_param_changed_storage_bytes; i++) {
-			for (unsigned j = 0; j < bits_per_allocation_unit; j++) {
-				if (param_changed_storage[i] & (1 << j)) {
-					count++;
-				}
-			}
-		}
+	if (!get_param_info_count()) {
+		return 0;
 	}
 
+	pthread_mutex_lock(&param_used_mutex);
+	param_used_prefix_update();
+	const unsigned count = param_used_count;
+	pthread_mutex_unlock(&param_used_mutex);
+
 	return count;
 }
 
@@ -342,30 +457,51 @@ param_for_index(unsigned index)
 param_t
 param_for_used_index(unsigned index)
 {
-	int count = get_param_info_count();
+	if (!get_param_info_count()) {
+		return PARAM_INVALID;
+	}
 
-	if (count && index < count) {
-		/* walk all params and count used params */
-		unsigned used_count = 0;
+	param_t result = PARAM_INVALID;
+
+	pthread_mutex_lock(&param_used_mutex);
+	param_used_prefix_update();
 
-		for (unsigned i = 0; i < (unsigned)size_param_changed_storage_bytes; i++) {
-			for (unsigned j = 0; j < bits_per_allocation_unit; j++) {
-				if (param_changed_storage[i] & (1 << j)) {
+	if (index >= param_used_count) {
+		pthread_mutex_unlock(&param_used_mutex);
+		return PARAM_INVALID;
+	}
 
-					/* we found the right used count,
-					 * return the param value
-					 */
-					if (index == used_count) {
-						return (param_t)(i * bits_per_allocation_unit + j);
-					}
+	/* find the last allocation unit with at most index used params before it */
+	int low = 0;
+	int high = size_param_changed_storage_bytes - 1;
 
-					used_count++;
-				}
+	while (low < high) {
+		int mid = (low + high + 1) / 2;
+
+		if (param_used_prefix[mid] <= index) {
+			low = mid;
+
+		} else {
+			high = mid - 1;
+		}
+	}
+
+	unsigned used_count = param_used_prefix[low];
+
+	for (unsigned j = 0; j < bits_per_allocation_unit; j++) {
+		if (param_changed_storage[low] & (1 << j)) {
+			if (index == used_count) {
+				result = (param_t)(low * bits_per_allocation_unit + j);
+				break;
 			}
+
+			used_count++;
 		}
 	}
 
-	return PARAM_INVALID;
+	pthread_mutex_unlock(&param_used_mutex);
+
+	return result;
 }
 
 int
@@ -386,23 +522,16 @@ param_get_used_index(param_t param)
 		return -1;
 	}
 
-	/* walk all params and count, now knowing that it has a valid index */
-	int used_count = 0;
+	/* used params before this allocation unit plus the ones before it within the unit */
+	unsigned i = (unsigned)param / bits_per_allocation_unit;
+	unsigned j = (unsigned)param % bits_per_allocation_unit;
 
-	for (unsigned i = 0; i < (unsigned)size_param_changed_storage_bytes; i++) {
-		for (unsigned j = 0; j < bits_per_allocation_unit; j++) {
-			if (param_changed_storage[i] & (1 << j)) {
-
-				if ((unsigned)param == i * bits_per_allocation_unit + j) {
-					return used_count;
-				}
-
-				used_count++;
-			}
-		}
-	}
+	pthread_mutex_lock(&param_used_mutex);
+	param_used_prefix_update();
+	const int index = param_used_prefix[i] + count_bits(param_changed_storage[i] & ((1 << j) - 1));
+	pthread_mutex_unlock(&param_used_mutex);
 
-	return -1;
+	return index;
 }
 
 const char *
@@ -514,6 +643,186 @@ param_get(param_t param, void *val)
 	return result;
 }
 
+/**
+ * Multiply a and b modulo the CRC32 polynomial, in the bit order of crc32part().
+ */
+static uint32_t
+crc32_multmodp(uint32_t a, uint32_t b)
+{
+	uint32_t m = 1u << 31;
+	uint32_t p = 0;
+
+	for (;;) {
+		if (a & m) {
+			p ^= b;
+
+			if ((a & (m - 1)) == 0) {
+				break;
+			}
+		}
+
+		m >>= 1;
+		b = (b & 1) ? (b >> 1) ^ 0xedb88320u : b >> 1;
+	}
+
+	return p;
+}
+
+/**
+ * The CRC state after feeding length zero bytes to crc32part() in O(log length).
+ */
+static uint32_t
+crc32_shift(uint32_t crc, uint32_t length)
+{
+	uint32_t x2n = 1u << 23;	/* x^8: one byte */
+	uint32_t p = 1u << 31;		/* x^0 */
+
+	for (; length; length >>= 1) {
+		if (length & 1) {
+			p = crc32_multmodp(x2n, p);
+		}
+
+		x2n = crc32_multmodp(x2n, x2n);
+	}
+
+	return crc32_multmodp(p, crc);
+}
+
+static uint32_t
+param_value_crc(param_t param)
+{
+	const void *val = param_get_value_ptr(param);
+	return val ? crc32part(val, param_size(param), 0) : 0;
+}
+
+/**
+ * Update param_hash for a changed value of param. Call with param_used_mutex
+ * held since before the old value was read.
+ *
+ * crc32part() has no pre- or post-inversion, so it is linear: changing the value
+ * changes the hash by the CRC of the difference, advanced over the bytes hashed
+ * after the value.
+ */
+static void
+param_hash_update(param_t param, uint32_t crc_old, uint32_t crc_new)
+{
+	param_hash_generation++;
+
+	if (param_hash_dirty || crc_old == crc_new) {
+		return;
+	}
+
+	param_used_prefix_update();
+
+	unsigned i = (unsigned)param / bits_per_allocation_unit;
+	uint32_t length = param_used_length_prefix[i];
+
+	for (unsigned j = 0; j <= (unsigned)param % bits_per_allocation_unit; j++) {
+		if (param_changed_storage[i] & (1 << j)) {
+			param_t p = i * bits_per_allocation_unit + j;
+			length += strlen(param_name(p)) + param_size(p);
+		}
+	}
+
+	param_hash ^= crc32_shift(crc_old ^ crc_new, param_used_length - length);
+}
+
+/**
+ * Have the next param_hash_check() recompute the hash, after a bulk change.
+ */
+static void
+param_hash_invalidate(void)
+{
+	pthread_mutex_lock(&param_used_mutex);
+	param_hash_dirty = true;
+	param_hash_generation++;
+	pthread_mutex_unlock(&param_used_mutex);
+}
+
+/**
+ * A new epoch nonce. There is no random source on all boards, but the time of
+ * the first modification varies by some microseconds from boot to boot.
+ */
+static uint32_t
+param_epoch_nonce(void)
+{
+	struct {
+		hrt_abstime now;
+		struct timespec ts;
+	} seed;
+
+	memset(&seed, 0, sizeof(seed));
+	seed.now = hrt_absolute_time();
+	px4_clock_gettime(CLOCK_REALTIME, &seed.ts);
+
+	uint32_t nonce = crc32part((const uint8_t *)&seed, sizeof(seed), 0) & ~PARAM_EPOCH_COUNTER_MASK;
+
+	/* 0 is the epoch of unknown caches */
+	return nonce != 0 ? nonce : PARAM_EPOCH_COUNTER_MASK + 1;
+}
+
+/**
+ * Advance the epoch, safe without the param lock (param_set_used_internal()).
+ */
+static uint32_t
+param_epoch_next(void)
+{
+	uint32_t epoch;
+	uint32_t next;
+
+	do {
+		epoch = param_epoch_value;
+		next = epoch + 1;
+
+		if (epoch == 0 || (next & PARAM_EPOCH_COUNTER_MASK) == 0) {
+			/* first modification, or the counter ran out: continue as after a reboot */
+			next = param_epoch_nonce() | 1;
+		}
+
+	} while (!__sync_bool_compare_and_swap(&param_epoch_value, epoch, next));
+
+	return next;
+}
+
+/**
+ * Tag param with a new modification epoch.
+ */
+static void
+param_mark_modified(param_t param)
+{
+	param_epochs[param] = param_epoch_next();
+}
+
+uint32_t
+param_epoch(void)
+{
+	if (param_epoch_value == 0) {
+		/* nothing modified yet, but the nonce must already differ from other boots */
+		__sync_bool_compare_and_swap(&param_epoch_value, 0, param_epoch_nonce());
+	}
+
+	return param_epoch_value;
+}
+
+bool
+param_epoch_current_boot(uint32_t epoch)
+{
+	const uint32_t current = param_epoch();
+
+	return epoch != 0 && (epoch & ~PARAM_EPOCH_COUNTER_MASK) == (current & ~PARAM_EPOCH_COUNTER_MASK)
+	       && epoch <= current;
+}
+
+uint32_t
+param_get_epoch(param_t param)
+{
+	if (handle_in_range(param)) {
+		return param_epochs[param];
+	}
+
+	return 0;
+}
+
 static int
 param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_changes, bool is_saved)
 {
@@ -522,6 +831,13 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 
 	param_lock();
 
+	/* the old and new value must be hashed without another change in between */
+	pthread_mutex_lock(&param_used_mutex);
+
+	/* only used params are part of the hash */
+	const bool hash_tracked = !param_hash_dirty && param_used(param);
+	const uint32_t crc_old = hash_tracked ? param_value_crc(param) : 0;
+
 	if (param_values == NULL) {
 		utarray_new(param_values, &param_icd);
 	}
@@ -589,6 +905,20 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 	}
 
 out:
+
+	if (hash_tracked) {
+		param_hash_update(param, crc_old, param_value_crc(param));
+
+	} else {
+		param_hash_generation++;
+	}
+
+	pthread_mutex_unlock(&param_used_mutex);
+
+	if (params_changed) {
+		param_mark_modified(param);
+	}
+
 	param_unlock();
 
 	/*
@@ -602,7 +932,6 @@ out:
 	return result;
 }
 
-#if defined(FLASH_BASED_PARAMS)
 int param_set_external(param_t param, const void *val, bool mark_saved, bool notify_changes, bool is_saved)
 {
 	return param_set_internal(param, val, mark_saved, notify_changes, is_saved);
@@ -613,8 +942,6 @@ const void *param_get_value_ptr_external(param_t param)
 	return param_get_value_ptr(param);
 }
 
-#endif
-
 int
 param_set(param_t param, const void *val)
 {
@@ -654,8 +981,28 @@ void param_set_used_internal(param_t param)
 		return;
 	}
 
-	param_changed_storage[param_index / bits_per_allocation_unit] |=
-		(1 << param_index % bits_per_allocation_unit);
+	const uint8_t bit = 1 << param_index % bits_per_allocation_unit;
+
+	if (param_changed_storage[param_index / bits_per_allocation_unit] & bit) {
+		return;
+	}
+
+	pthread_mutex_lock(&param_used_mutex);
+	const bool newly_used = !(param_changed_storage[param_index / bits_per_allocation_unit] & bit);
+
+	if (newly_used) {
+		param_changed_storage[param_index / bits_per_allocation_unit] |= bit;
+		param_used_prefix_dirty = true;
+		param_hash_dirty = true;
+		param_hash_generation++;
+	}
+
+	pthread_mutex_unlock(&param_used_mutex);
+
+	if (newly_used) {
+		/* the ground station does not know about it yet */
+		param_mark_modified(param);
+	}
 }
 
 int
@@ -673,8 +1020,25 @@ param_reset(param_t param)
 
 		/* if we found one, erase it */
 		if (s != NULL) {
+			pthread_mutex_lock(&param_used_mutex);
+
+			const bool hash_tracked = !param_hash_dirty && param_used(param);
+			const uint32_t crc_old = hash_tracked ? param_value_crc(param) : 0;
+
 			int pos = utarray_eltidx(param_values, s);
 			utarray_erase(param_values, pos, 1);
+
+			if (hash_tracked) {
+				param_hash_update(param, crc_old, param_value_crc(param));
+
+			} else {
+				param_hash_generation++;
+			}
+
+			pthread_mutex_unlock(&param_used_mutex);
+
+			param_mark_modified(param);
+			param_values_removed++;
 		}
 
 		param_found = true;
@@ -695,11 +1059,19 @@ param_reset_all(void)
 	param_lock();
 
 	if (param_values != NULL) {
+		struct param_wbuf_s *s = NULL;
+
+		while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != NULL) {
+			param_mark_modified(s->param);
+		}
+
 		utarray_free(param_values);
+		param_values_removed++;
 	}
 
 	/* mark as reset / deleted */
 	param_values = NULL;
+	param_hash_invalidate();
 
 	param_unlock();
 
@@ -977,16 +1349,17 @@ out:
 
 struct param_import_state {
 	bool mark_saved;
+	UT_array *values;	///< decoded values in file order, applied in one go at the end
 };
 
 static int
 param_import_callback(bson_decoder_t decoder, void *private, bson_node_t node)
 {
-	float f;
-	int32_t i;
-	void *v, *tmp = NULL;
-	int result = -1;
 	struct param_import_state *state = (struct param_import_state *)private;
+	struct param_wbuf_s buf = {
+		.val.p = NULL,
+		.unsaved = !state->mark_saved
+	};
 
 	/*
 	 * EOO means the end of the parameter object. (Currently not supporting
@@ -1001,90 +1374,148 @@ param_import_callback(bson_decoder_t decoder, void *private, bson_node_t node)
 	 * Find the parameter this node represents.  If we don't know it,
 	 * ignore the node.
 	 */
-	param_t param = param_find_no_notification(node->name);
+	buf.param = param_find_no_notification(node->name);
 
-	if (param == PARAM_INVALID) {
+	if (buf.param == PARAM_INVALID) {
 		debug("ignoring unrecognised parameter '%s'", node->name);
 		return 1;
 	}
 
 	/*
-	 * Handle setting the parameter from the node
+	 * Decode the value of the node
 	 */
 
 	switch (node->type) {
 	case BSON_INT32:
-		if (param_type(param) != PARAM_TYPE_INT32) {
+		if (param_type(buf.param) != PARAM_TYPE_INT32) {
 			debug("unexpected type for '%s", node->name);
-			goto out;
+			return -1;
 		}
 
-		i = node->i;
-		v = &i;
+		buf.val.i = node->i;
 		break;
 
 	case BSON_DOUBLE:
-		if (param_type(param) != PARAM_TYPE_FLOAT) {
+		if (param_type(buf.param) != PARAM_TYPE_FLOAT) {
 			debug("unexpected type for '%s", node->name);
-			goto out;
+			return -1;
 		}
 
-		f = node->d;
-		v = &f;
+		buf.val.f = node->d;
 		break;
 
 	case BSON_BINDATA:
 		if (node->subtype != BSON_BIN_BINARY) {
 			debug("unexpected subtype for '%s", node->name);
-			goto out;
+			return -1;
 		}
 
-		if (bson_decoder_data_pending(decoder) != param_size(param)) {
+		if (bson_decoder_data_pending(decoder) != param_size(buf.param)) {
 			debug("bad size for '%s'", node->name);
-			goto out;
+			return -1;
 		}
 
 		/* XXX check actual file data size? */
-		tmp = malloc(param_size(param));
+		buf.val.p = malloc(param_size(buf.param));
 
-		if (tmp == NULL) {
+		if (buf.val.p == NULL) {
 			debug("failed allocating for '%s'", node->name);
-			goto out;
+			return -1;
 		}
 
-		if (bson_decoder_copy_data(decoder, tmp)) {
+		if (bson_decoder_copy_data(decoder, buf.val.p)) {
 			debug("failed copying data for '%s'", node->name);
-			goto out;
+			free(buf.val.p);
+			return -1;
 		}
 
-		v = tmp;
 		break;
 
 	default:
 		debug("unrecognised node type");
-		goto out;
+		return -1;
 	}
 
-	if (param_set_internal(param, v, state->mark_saved, true, false)) {
-		debug("error setting value for '%s'", node->name);
-		goto out;
+	utarray_push_back(state->values, &buf);
+
+	/* don't return zero, that means EOF */
+	return 1;
+}
+
+/**
+ * Apply the decoded values to param_values: existing entries are found with a
+ * binary search, new ones are appended and the array is sorted once at the end.
+ *
+ * @return		True if any parameter was set.
+ */
+static bool
+param_import_apply(UT_array *values)
+{
+	struct param_wbuf_s *buf = NULL;
+	unsigned num_added = 0;
+	uint8_t *seen = NULL;
+
+	if (utarray_len(values) == 0) {
+		return false;
 	}
 
-	if (tmp != NULL) {
-		free(tmp);
-		tmp = NULL;
+	param_lock();
+
+	if (param_values == NULL) {
+		utarray_new(param_values, &param_icd);
 	}
 
-	/* don't return zero, that means EOF */
-	result = 1;
+	const unsigned num_existing = utarray_len(param_values);
 
-out:
+	/* a file written by param_export() has no duplicates, but don't rely on it */
+	seen = calloc(get_param_info_count() / 8 + 1, 1);
+
+	while ((buf = (struct param_wbuf_s *)utarray_next(values, buf)) != NULL) {
+		struct param_wbuf_s *s = param_find_changed_in(buf->param, num_existing);
+
+		if (s == NULL && (seen == NULL || (seen[buf->param / 8] & (1 << (buf->param % 8))))) {
+			/* duplicate in the file: look among the entries appended so far */
+			for (unsigned i = num_existing; i < utarray_len(param_values) && s == NULL; i++) {
+				struct param_wbuf_s *t = (struct param_wbuf_s *)utarray_eltptr(param_values, i);
+
+				if (t->param == buf->param) {
+					s = t;
+				}
+			}
+		}
+
+		if (seen != NULL) {
+			seen[buf->param / 8] |= 1 << (buf->param % 8);
+		}
+
+		param_mark_modified(buf->param);
+
+		if (s == NULL) {
+			utarray_push_back(param_values, buf);
+			num_added++;
+			continue;
+		}
+
+		if (param_type(buf->param) >= PARAM_TYPE_STRUCT && param_type(buf->param) <= PARAM_TYPE_STRUCT_MAX) {
+			/* hand over the buffer allocated while decoding */
+			free(s->val.p);
+		}
 
-	if (tmp != NULL) {
-		free(tmp);
+		s->val = buf->val;
+		s->unsaved = buf->unsaved;
 	}
 
-	return result;
+	free(seen);
+
+	if (num_added > 0) {
+		utarray_sort(param_values, param_compare_values);
+	}
+
+	param_hash_invalidate();
+
+	param_unlock();
+
+	return true;
 }
 
 static int
@@ -1094,6 +1525,14 @@ param_import_internal(int fd, bool mark_saved)
 	int result = -1;
 	struct param_import_state state;
 
+	state.mark_saved = mark_saved;
+	utarray_new(state.values, &param_icd);
+
+	if (state.values == NULL) {
+		debug("failed to allocate import array");
+		return -1;
+	}
+
 	param_bus_lock(true);
 
 	if (bson_decoder_init_file(&decoder, fd, param_import_callback, &state)) {
@@ -1104,12 +1543,17 @@ param_import_internal(int fd, bool mark_saved)
 
 	param_bus_lock(false);
 
-	state.mark_saved = mark_saved;
+	unsigned num_nodes = 0;
 
 	do {
 		param_bus_lock(true);
 		result = bson_decoder_next(&decoder);
-		usleep(1);
+
+		/* the decoder reads ahead, most nodes don't touch the bus: only yield now and then */
+		if (++num_nodes % 16 == 0) {
+			usleep(1);
+		}
+
 		param_bus_lock(false);
 
 	} while (result > 0);
@@ -1120,6 +1564,13 @@ out:
 		debug("BSON error decoding parameters");
 	}
 
+	/* like before, the values decoded up to an error are kept */
+	if (param_import_apply(state.values)) {
+		param_notify_changes(false);
+	}
+
+	utarray_free(state.values);
+
 	return result;
 }
 
@@ -1158,23 +1609,42 @@ param_foreach(void (*func)(void *arg, param_t param), void *arg, bool only_chang
 
 uint32_t param_hash_check(void)
 {
-	uint32_t param_hash = 0;
-
 	param_lock();
 
-	/* compute the CRC32 over all string param names and 4 byte values */
-	for (param_t param = 0; handle_in_range(param); param++) {
-		if (!param_used(param)) {
-			continue;
+	pthread_mutex_lock(&param_used_mutex);
+	const bool dirty = param_hash_dirty;
+	const uint32_t generation = param_hash_generation;
+	uint32_t hash = param_hash;
+	pthread_mutex_unlock(&param_used_mutex);
+
+	if (dirty) {
+		/* recompute without holding the mutex, param_set() is not blocked meanwhile */
+		hash = 0;
+
+		/* compute the CRC32 over all string param names and 4 byte values */
+		for (param_t param = 0; handle_in_range(param); param++) {
+			if (!param_used(param)) {
+				continue;
+			}
+
+			const char *name = param_name(param);
+			const void *val = param_get_value_ptr(param);
+			hash = crc32part((const uint8_t *)name, strlen(name), hash);
+			hash = crc32part(val, param_size(param), hash);
 		}
 
-		const char *name = param_name(param);
-		const void *val = param_get_value_ptr(param);
-		param_hash = crc32part((const uint8_t *)name, strlen(name), param_hash);
-		param_hash = crc32part(val, param_size(param), param_hash);
+		/* a change meanwhile may or may not be part of the result, only keep it if there was none */
+		pthread_mutex_lock(&param_used_mutex);
+
+		if (param_hash_generation == generation) {
+			param_hash = hash;
+			param_hash_dirty = false;
+		}
+
+		pthread_mutex_unlock(&param_used_mutex);
 	}
 
 	param_unlock();
 
-	return param_hash;
+	return hash;
 }
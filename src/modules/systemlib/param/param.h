@@ -355,6 +355,35 @@ __EXPORT int 		param_load_default(void);
  */
 __EXPORT uint32_t	param_hash_check(void);
 
+/**
+ * The current modification epoch.
+ *
+ * The epoch counts parameter modifications since boot: every set or reset that
+ * changes a value, every import and every parameter that becomes used advances
+ * it and tags the parameter with the new value. The high bits are a nonce
+ * which changes on every boot, so epochs of different boots do not compare.
+ *
+ * @return		The epoch of the latest modification, 0 if the platform does
+ *			not track modifications.
+ */
+__EXPORT uint32_t	param_epoch(void);
+
+/**
+ * Check if an epoch was returned by param_epoch() since boot.
+ *
+ * @param epoch		An epoch, e.g. from a ground station cache.
+ * @return		true if params modified after it are tagged with a later epoch.
+ */
+__EXPORT bool		param_epoch_current_boot(uint32_t epoch);
+
+/**
+ * The modification epoch of a parameter.
+ *
+ * @param param		A handle returned by param_find or passed by param_foreach.
+ * @return		The epoch of its last modification, 0 if it was not modified since boot.
+ */
+__EXPORT uint32_t	param_get_epoch(param_t param);
+
 /*
  * Macros creating static parameter definitions.
  *
@@ -266,16 +266,26 @@ param_notify_changes(bool is_saved)
 param_t
 param_find_internal(const char *name, bool notification)
 {
-	param_t param;
+	/* the parameters are sorted by name (see Tools/px_generate_params.py) */
+	int low = 0;
+	int high = (int)get_param_info_count() - 1;
 
-	/* perform a linear search of the known parameters */
-	for (param = 0; handle_in_range(param); param++) {
-		if (!strcmp(param_info_base[param].name, name)) {
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		int cmp = strcmp(name, param_info_base[mid].name);
+
+		if (cmp == 0) {
 			if (notification) {
-				param_set_used_internal(param);
+				param_set_used_internal((param_t)mid);
 			}
 
-			return param;
+			return (param_t)mid;
+
+		} else if (cmp < 0) {
+			high = mid - 1;
+
+		} else {
+			low = mid + 1;
 		}
 	}
 
@@ -1255,3 +1265,23 @@ void init_params(void)
 #endif
 }
 
+
+/*
+ * Values also change through the shared memory of the other processor, so
+ * modifications cannot be tracked here: epoch 0 makes ground stations fall back
+ * to the full parameter list.
+ */
+uint32_t param_epoch(void)
+{
+	return 0;
+}
+
+uint32_t param_get_epoch(param_t param)
+{
+	return 0;
+}
+
+bool param_epoch_current_boot(uint32_t epoch)
+{
+	return false;
+}
@@ -75,7 +75,9 @@ SubscriptionBase::SubscriptionBase(const struct orb_metadata *meta,
 				   unsigned interval, unsigned instance) :
 	_meta(meta),
 	_instance(instance),
-	_handle()
+	_handle(),
+	_generation(nullptr),
+	_last_generation(0)
 {
 	if (_instance > 0) {
 		_handle =  orb_subscribe_multi(
@@ -89,16 +91,34 @@ SubscriptionBase::SubscriptionBase(const struct orb_metadata *meta,
 
 	if (interval > 0) {
 		orb_set_interval(getHandle(), interval);
+
+	} else if (_handle >= 0 && orb_get_generation(_handle, &_generation) == PX4_OK) {
+		/* differ from the current generation, so that the first check goes to the topic */
+		_last_generation = *_generation - 1;
+
+	} else {
+		_generation = nullptr;
 	}
 }
 
 bool SubscriptionBase::updated()
 {
+	/* nothing was published since orb_check() last reported no update, skip the ioctl */
+	const unsigned generation = _generation ? *_generation : 0;
+
+	if (_generation && generation == _last_generation) {
+		return false;
+	}
+
 	bool isUpdated = false;
 	int ret = orb_check(_handle, &isUpdated);
 
 	if (ret != PX4_OK) { PX4_ERR("orb check failed"); }
 
+	if (!isUpdated) {
+		_last_generation = generation;
+	}
+
 	return isUpdated;
 }
 
@@ -101,6 +101,8 @@ protected:
 	const struct orb_metadata *_meta;
 	int _instance;
 	int _handle;
+	const volatile unsigned *_generation; ///< generation counter of the topic, nullptr if not used
+	unsigned _last_generation; ///< generation at which orb_check() last reported no update
 private:
 	// disallow copy
 	SubscriptionBase(const SubscriptionBase &other);
@@ -40,6 +40,10 @@
 #include "uORBManager.hpp"
 #include "uORBCommon.hpp"
 
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
 orb_advert_t orb_advertise(const struct orb_metadata *meta, const void *data)
 {
 	return uORB::Manager::get_instance()->orb_advertise(meta, data);
@@ -149,3 +153,151 @@ int orb_get_interval(int handle, unsigned *interval)
 {
 	return uORB::Manager::get_instance()->orb_get_interval(handle, interval);
 }
+
+int orb_get_generation(int handle, const volatile unsigned **generation)
+{
+	return uORB::Manager::get_instance()->orb_get_generation(handle, generation);
+}
+
+size_t orb_field_size(const struct orb_field *field)
+{
+	switch (field->type) {
+	case ORB_FIELD_INT8:
+	case ORB_FIELD_UINT8:
+	case ORB_FIELD_BOOL:
+	case ORB_FIELD_CHAR:
+		return 1;
+
+	case ORB_FIELD_INT16:
+	case ORB_FIELD_UINT16:
+		return 2;
+
+	case ORB_FIELD_INT32:
+	case ORB_FIELD_UINT32:
+	case ORB_FIELD_FLOAT:
+		return 4;
+
+	case ORB_FIELD_INT64:
+	case ORB_FIELD_UINT64:
+	case ORB_FIELD_DOUBLE:
+		return 8;
+
+	case ORB_FIELD_NESTED:
+		return field->nested != nullptr ? field->nested->o_size : 0;
+	}
+
+	return 0;
+}
+
+const struct orb_field *orb_find_field(const struct orb_metadata *meta, const char *name)
+{
+	for (unsigned i = 0; i < meta->o_num_fields; i++) {
+		if (strcmp(meta->o_field_list[i].name, name) == 0) {
+			return &meta->o_field_list[i];
+		}
+	}
+
+	return nullptr;
+}
+
+static void print_field_value(const struct orb_field *field, const uint8_t *value)
+{
+	switch (field->type) {
+	case ORB_FIELD_INT8:
+		printf("%d", (int) * (const int8_t *)value);
+		break;
+
+	case ORB_FIELD_UINT8:
+		printf("%u", (unsigned) * value);
+		break;
+
+	case ORB_FIELD_INT16:
+		printf("%d", (int) * (const int16_t *)value);
+		break;
+
+	case ORB_FIELD_UINT16:
+		printf("%u", (unsigned) * (const uint16_t *)value);
+		break;
+
+	case ORB_FIELD_INT32:
+		printf("%" PRId32, *(const int32_t *)value);
+		break;
+
+	case ORB_FIELD_UINT32:
+		printf("%" PRIu32, *(const uint32_t *)value);
+		break;
+
+	case ORB_FIELD_INT64:
+		printf("%" PRId64, *(const int64_t *)value);
+		break;
+
+	case ORB_FIELD_UINT64:
+		printf("%" PRIu64, *(const uint64_t *)value);
+		break;
+
+	case ORB_FIELD_FLOAT:
+		printf("%8.4f", (double) * (const float *)value);
+		break;
+
+	case ORB_FIELD_DOUBLE:
+		printf("%8.4f", *(const double *)value);
+		break;
+
+	case ORB_FIELD_BOOL:
+		printf("%s", *value ? "True" : "False");
+		break;
+
+	case ORB_FIELD_CHAR:
+		printf("%c", *(const char *)value);
+		break;
+	}
+}
+
+static void print_fields(const struct orb_metadata *meta, const uint8_t *data, const char *prefix)
+{
+	for (unsigned i = 0; i < meta->o_num_fields; i++) {
+		const struct orb_field *field = &meta->o_field_list[i];
+
+		if (strncmp(field->name, "_padding", 8) == 0) {
+			continue;
+		}
+
+		const size_t size = orb_field_size(field);
+
+		if (field->type == ORB_FIELD_NESTED) {
+			if (field->nested == nullptr || field->nested->o_field_list == nullptr) {
+				continue;
+			}
+
+			for (unsigned j = 0; j < field->count; j++) {
+				char nested_prefix[64];
+				snprintf(nested_prefix, sizeof(nested_prefix), "%s%s[%u].", prefix, field->name, j);
+				print_fields(field->nested, data + field->offset + j * size, nested_prefix);
+			}
+
+			continue;
+		}
+
+		printf("%s%s: ", prefix, field->name);
+
+		if (field->type == ORB_FIELD_CHAR && field->count > 1) {
+			printf("%.*s\n", (int)field->count, (const char *)(data + field->offset));
+			continue;
+		}
+
+		for (unsigned j = 0; j < field->count; j++) {
+			print_field_value(field, data + field->offset + j * size);
+			printf(j + 1 < field->count ? " " : "\n");
+		}
+	}
+}
+
+void orb_print_message(const struct orb_metadata *meta, const void *data)
+{
+	if (meta->o_field_list == nullptr) {
+		printf("%s: no field information\n", meta->o_name);
+		return;
+	}
+
+	print_fields(meta, (const uint8_t *)data, "");
+}
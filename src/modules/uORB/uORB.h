@@ -46,6 +46,39 @@
 // Hack until everything is using this header
 #include <systemlib/visibility.h>
 
+/**
+ * Type of a topic field.
+ */
+enum orb_field_type {
+	ORB_FIELD_INT8 = 0,
+	ORB_FIELD_UINT8,
+	ORB_FIELD_INT16,
+	ORB_FIELD_UINT16,
+	ORB_FIELD_INT32,
+	ORB_FIELD_UINT32,
+	ORB_FIELD_INT64,
+	ORB_FIELD_UINT64,
+	ORB_FIELD_FLOAT,
+	ORB_FIELD_DOUBLE,
+	ORB_FIELD_BOOL,
+	ORB_FIELD_CHAR,
+	ORB_FIELD_NESTED		/**< embedded message, see orb_field::nested */
+};
+
+struct orb_metadata;
+
+/**
+ * Field of a topic, generated from the message definition together with
+ * the struct so that the layout never needs to be parsed from o_fields.
+ */
+struct orb_field {
+	const char *name;			/**< field name as in the message definition */
+	const struct orb_metadata *nested;	/**< type of an ORB_FIELD_NESTED field, NULL otherwise */
+	uint16_t offset;			/**< offset in the struct in bytes */
+	uint16_t count;				/**< array length, 1 for plain fields */
+	uint8_t type;				/**< enum orb_field_type */
+};
+
 /**
  * Object metadata.
  */
@@ -54,6 +87,8 @@ struct orb_metadata {
 	const size_t o_size;		/**< object size */
 	const size_t o_size_no_padding;	/**< object size w/o padding at the end (for logger) */
 	const char *o_fields;		/**< semicolon separated list of fields (with type) */
+	const struct orb_field *o_field_list;	/**< the fields of o_fields in the same order, NULL if not generated */
+	const uint16_t o_num_fields;	/**< number of entries in o_field_list */
 };
 
 typedef const struct orb_metadata *orb_id_t;
@@ -112,13 +147,17 @@ enum ORB_PRIO {
  * @param _struct	The structure the topic provides.
  * @param _size_no_padding	Struct size w/o padding at the end
  * @param _fields	All fields in a semicolon separated list e.g: "float[3] position;bool armed"
+ * @param _field_list	Array of struct orb_field describing _fields, or NULL
+ * @param _num_fields	Number of entries in _field_list
  */
-#define ORB_DEFINE(_name, _struct, _size_no_padding, _fields)		\
+#define ORB_DEFINE(_name, _struct, _size_no_padding, _fields, _field_list, _num_fields)	\
 	const struct orb_metadata __orb_##_name = {	\
 		#_name,					\
 		sizeof(_struct),		\
 		_size_no_padding,			\
-		_fields					\
+		_fields,				\
+		_field_list,				\
+		_num_fields				\
 	}; struct hack
 
 __BEGIN_DECLS
@@ -237,6 +276,36 @@ extern int	orb_set_interval(int handle, unsigned interval) __EXPORT;
  */
 extern int	orb_get_interval(int handle, unsigned *interval) __EXPORT;
 
+/**
+ * @see uORB::Manager::orb_get_generation()
+ */
+extern int	orb_get_generation(int handle, const volatile unsigned **generation) __EXPORT;
+
+/**
+ * Size of one element of a field.
+ *
+ * @param field   Field of a topic.
+ * @return        Size in bytes, the size of the nested struct for ORB_FIELD_NESTED.
+ */
+extern size_t	orb_field_size(const struct orb_field *field) __EXPORT;
+
+/**
+ * Look up a field of a topic by name.
+ *
+ * @param meta    ORB topic metadata.
+ * @param name    Field name, e.g. "timestamp".
+ * @return        The field or NULL if the topic has no such field.
+ */
+extern const struct orb_field *orb_find_field(const struct orb_metadata *meta, const char *name) __EXPORT;
+
+/**
+ * Print all fields of a message to the console, embedded messages included.
+ *
+ * @param meta    ORB topic metadata.
+ * @param data    Message as copied with orb_copy().
+ */
+extern void	orb_print_message(const struct orb_metadata *meta, const void *data) __EXPORT;
+
 __END_DECLS
 
 /* Diverse uORB header defines */ //XXX: move to better location
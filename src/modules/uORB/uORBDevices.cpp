@@ -412,6 +412,10 @@ uORB::DeviceNode::ioctl(device::file_t *filp, int cmd, unsigned long arg)
 
 		return OK;
 
+	case ORBIOCGENERATION:
+		*(const volatile unsigned **)arg = &_generation;
+		return OK;
+
 	default:
 		/* give it to the superclass */
 		return VDev::ioctl(filp, cmd, arg);
@@ -1131,9 +1135,9 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 			printf("\033[H"); // move cursor home and clear screen
 			printf(CLEAR_LINE "update: 1s, num topics: %i\n", num_topics);
 #ifdef __PX4_NUTTX
-			printf(CLEAR_LINE "%*-s INST #SUB #MSG #LOST #QSIZE\n", (int)max_topic_name_length - 2, "TOPIC NAME");
+			printf(CLEAR_LINE "%*-s INST #SUB #MSG #LOST #QSIZE  BYTES/S\n", (int)max_topic_name_length - 2, "TOPIC NAME");
 #else
-			printf(CLEAR_LINE "%*s INST #SUB #MSG #LOST #QSIZE\n", -(int)max_topic_name_length + 2, "TOPIC NAME");
+			printf(CLEAR_LINE "%*s INST #SUB #MSG #LOST #QSIZE  BYTES/S\n", -(int)max_topic_name_length + 2, "TOPIC NAME");
 #endif
 			cur_node = first_node;
 
@@ -1141,13 +1145,14 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 
 				if (!print_active_only || cur_node->pub_msg_delta > 0) {
 #ifdef __PX4_NUTTX
-					printf(CLEAR_LINE "%*-s %2i %4i %4i %5i %i\n", (int)max_topic_name_length,
+					printf(CLEAR_LINE "%*-s %2i %4i %4i %5i %6i %8u\n", (int)max_topic_name_length,
 #else
-					printf(CLEAR_LINE "%*s %2i %4i %4i %5i %i\n", -(int)max_topic_name_length,
+					printf(CLEAR_LINE "%*s %2i %4i %4i %5i %6i %8u\n", -(int)max_topic_name_length,
 #endif
 					       cur_node->node->get_meta()->o_name, (int)cur_node->instance,
 					       (int)cur_node->node->subscriber_count(), cur_node->pub_msg_delta,
-					       (int)cur_node->lost_msg_delta, cur_node->node->get_queue_size());
+					       (int)cur_node->lost_msg_delta, cur_node->node->get_queue_size(),
+					       (unsigned)(cur_node->pub_msg_delta * cur_node->node->get_meta()->o_size));
 				}
 
 				cur_node = cur_node->next;
@@ -292,7 +292,8 @@ public:
 	void printStatistics(bool reset);
 
 	/**
-	 * Continuously print statistics, like the unix top command for processes.
+	 * Continuously print statistics, like the unix top command for processes: publication rate,
+	 * number of subscribers, lost messages and bandwidth of each topic instance.
 	 * Exited when the user presses the enter key.
 	 * @param topic_filter list of topic filters: if set, each string can be a substring for topics to match.
 	 *        Or it can be '-a', which means to print all topics instead of only currently publishing ones.
@@ -298,6 +298,11 @@ int uORB::Manager::orb_get_interval(int handle, unsigned *interval)
 	return ret;
 }
 
+int uORB::Manager::orb_get_generation(int handle, const volatile unsigned **generation)
+{
+	return px4_ioctl(handle, ORBIOCGENERATION, (unsigned long)(uintptr_t)generation);
+}
+
 
 int uORB::Manager::node_advertise
 (
@@ -351,6 +351,21 @@ public:
 	 */
 	int	orb_get_interval(int handle, unsigned *interval);
 
+	/**
+	 * Get a pointer to the generation counter of a topic.
+	 *
+	 * The counter is incremented on every publication. It can be read without
+	 * any locking or system call, so a subscriber can cheaply skip a topic that did
+	 * not change since it last looked at it, and only then use orb_check() or
+	 * orb_copy(). The pointer stays valid after unsubscribing, topics are never
+	 * deleted.
+	 *
+	 * @param handle  A handle returned from orb_subscribe.
+	 * @param generation  The returned pointer to the generation counter.
+	 * @return    OK on success, ERROR otherwise with ERRNO set accordingly.
+	 */
+	int	orb_get_generation(int handle, const volatile unsigned **generation);
+
 	/**
 	 * Method to set the uORBCommunicator::IChannel instance.
 	 * @param comm_channel
@@ -33,26 +33,30 @@
 
 #include "uORBTest_UnitTest.hpp"
 #include "../uORBCommon.hpp"
+#include "../uORBTopics.h"
+#include <drivers/drv_hrt.h>
 #include <px4_config.h>
 #include <px4_time.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 #include <poll.h>
 
-ORB_DEFINE(orb_test, struct orb_test, sizeof(orb_test), "ORB_TEST:int val;hrt_abstime time;");
-ORB_DEFINE(orb_multitest, struct orb_test, sizeof(orb_test), "ORB_MULTITEST:int val;hrt_abstime time;");
+ORB_DEFINE(orb_test, struct orb_test, sizeof(orb_test), "ORB_TEST:int val;hrt_abstime time;", nullptr, 0);
+ORB_DEFINE(orb_multitest, struct orb_test, sizeof(orb_test), "ORB_MULTITEST:int val;hrt_abstime time;", nullptr, 0);
 
 ORB_DEFINE(orb_test_medium, struct orb_test_medium, sizeof(orb_test_medium),
-	   "ORB_TEST_MEDIUM:int val;hrt_abstime time;char[64] junk;");
+	   "ORB_TEST_MEDIUM:int val;hrt_abstime time;char[64] junk;", nullptr, 0);
 ORB_DEFINE(orb_test_medium_multi, struct orb_test_medium, sizeof(orb_test_medium),
-	   "ORB_TEST_MEDIUM_MULTI:int val;hrt_abstime time;char[64] junk;");
+	   "ORB_TEST_MEDIUM_MULTI:int val;hrt_abstime time;char[64] junk;", nullptr, 0);
 ORB_DEFINE(orb_test_medium_queue, struct orb_test_medium, sizeof(orb_test_medium),
-	   "ORB_TEST_MEDIUM_MULTI:int val;hrt_abstime time;char[64] junk;");
+	   "ORB_TEST_MEDIUM_MULTI:int val;hrt_abstime time;char[64] junk;", nullptr, 0);
 ORB_DEFINE(orb_test_medium_queue_poll, struct orb_test_medium, sizeof(orb_test_medium),
-	   "ORB_TEST_MEDIUM_MULTI:int val;hrt_abstime time;char[64] junk;");
+	   "ORB_TEST_MEDIUM_MULTI:int val;hrt_abstime time;char[64] junk;", nullptr, 0);
 
 ORB_DEFINE(orb_test_large, struct orb_test_large, sizeof(orb_test_large),
-	   "ORB_TEST_LARGE:int val;hrt_abstime time;char[512] junk;");
+	   "ORB_TEST_LARGE:int val;hrt_abstime time;char[512] junk;", nullptr, 0);
 
 uORBTest::UnitTest &uORBTest::UnitTest::instance()
 {
@@ -157,7 +161,19 @@ int uORBTest::UnitTest::pubsublatency_main(void)
 
 int uORBTest::UnitTest::test()
 {
-	int ret = test_single();
+	int ret = test_field_list();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	ret = test_single();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	ret = test_generation();
 
 	if (ret != OK) {
 		return ret;
@@ -234,6 +250,88 @@ int uORBTest::UnitTest::info()
 	return OK;
 }
 
+static const char *const field_type_names[] = {
+	"int8_t", "uint8_t", "int16_t", "uint16_t", "int32_t", "uint32_t", "int64_t", "uint64_t",
+	"float", "double", "bool", "char"
+};
+
+int uORBTest::UnitTest::test_field_list()
+{
+	test_note("check the generated field lists against the format strings");
+
+	const orb_metadata *const *topics = orb_get_topics();
+	hrt_abstime time_parse = 0;
+	hrt_abstime time_lookup = 0;
+
+	for (size_t i = 0; i < orb_topics_count(); i++) {
+		const orb_metadata *meta = topics[i];
+
+		if (meta->o_field_list == nullptr) {
+			return test_fail("%s has no field list", meta->o_name);
+		}
+
+		/* walk the format string like the logger and replay used to, checking each field */
+		hrt_abstime t0 = hrt_absolute_time();
+		const char *format = meta->o_fields;
+		unsigned index = 0;
+		size_t offset = 0;
+		size_t timestamp_offset = 0;
+
+		while (*format != '\0') {
+			const char *space = strchr(format, ' ');
+			const char *end = strchr(format, ';');
+
+			if (space == nullptr || end == nullptr || space > end || index >= meta->o_num_fields) {
+				return test_fail("%s: malformed or longer format %s", meta->o_name, meta->o_fields);
+			}
+
+			const orb_field &field = meta->o_field_list[index];
+			const char *bracket = (const char *)memchr(format, '[', space - format);
+			const size_t type_len = (bracket != nullptr ? bracket : space) - format;
+			const unsigned count = bracket != nullptr ? strtoul(bracket + 1, nullptr, 10) : 1;
+			const char *type_name = field.type == ORB_FIELD_NESTED ? field.nested->o_name : field_type_names[field.type];
+
+			if (strncmp(field.name, space + 1, end - space - 1) != 0 || field.name[end - space - 1] != '\0'
+			    || strncmp(type_name, format, type_len) != 0 || type_name[type_len] != '\0' || field.count != count) {
+				return test_fail("%s: field %u is %s %s[%u], format says %.*s", meta->o_name, index, type_name, field.name,
+						 field.count, (int)(end - format), format);
+			}
+
+			if (field.offset != offset) {
+				return test_fail("%s: %s at offset %u, expected %u", meta->o_name, field.name, field.offset, (unsigned)offset);
+			}
+
+			if (strcmp(field.name, "timestamp") == 0) {
+				timestamp_offset = offset;
+			}
+
+			offset += orb_field_size(&field) * field.count;
+			format = end + 1;
+			index++;
+		}
+
+		time_parse += hrt_absolute_time() - t0;
+
+		if (index != meta->o_num_fields || offset != meta->o_size) {
+			return test_fail("%s: %u of %u fields, size %u of %u", meta->o_name, index, meta->o_num_fields,
+					 (unsigned)offset, (unsigned)meta->o_size);
+		}
+
+		t0 = hrt_absolute_time();
+		const orb_field *timestamp = orb_find_field(meta, "timestamp");
+		time_lookup += hrt_absolute_time() - t0;
+
+		if (timestamp == nullptr || timestamp->offset != timestamp_offset || timestamp->type != ORB_FIELD_UINT64) {
+			return test_fail("%s: timestamp field lookup failed", meta->o_name);
+		}
+	}
+
+	test_note("%u topics: format parsing %u us, field lookup %u us", (unsigned)orb_topics_count(),
+		  (unsigned)time_parse, (unsigned)time_lookup);
+
+	return test_note("PASS field lists");
+}
+
 int uORBTest::UnitTest::test_single()
 {
 	test_note("try single-topic support");
@@ -310,6 +408,82 @@ int uORBTest::UnitTest::test_single()
 	return test_note("PASS single-topic test");
 }
 
+int uORBTest::UnitTest::test_generation()
+{
+	test_note("try generation counter");
+
+	struct orb_test t;
+	t.val = 0;
+	orb_advert_t ptopic = orb_advertise(ORB_ID(orb_test), &t);
+
+	if (ptopic == nullptr) {
+		return test_fail("advertise failed: %d", errno);
+	}
+
+	int sfd = orb_subscribe(ORB_ID(orb_test));
+
+	if (sfd < 0) {
+		return test_fail("subscribe failed: %d", errno);
+	}
+
+	const volatile unsigned *generation = nullptr;
+
+	if (PX4_OK != orb_get_generation(sfd, &generation) || generation == nullptr) {
+		return test_fail("get generation failed");
+	}
+
+	orb_copy(ORB_ID(orb_test), sfd, &t);
+	unsigned last_generation = *generation;
+
+	for (int i = 1; i <= 3; ++i) {
+		t.val = i;
+		orb_publish(ORB_ID(orb_test), ptopic, &t);
+
+		if (*generation != last_generation + 1) {
+			return test_fail("generation %u, expected %u", *generation, last_generation + 1);
+		}
+
+		last_generation = *generation;
+	}
+
+	/* what a subscriber pays to find out that nothing changed */
+	const int num_checks = 10000;
+	bool updated;
+	orb_copy(ORB_ID(orb_test), sfd, &t);
+
+	hrt_abstime t0 = hrt_absolute_time();
+
+	for (int i = 0; i < num_checks; ++i) {
+		orb_check(sfd, &updated);
+	}
+
+	hrt_abstime t1 = hrt_absolute_time();
+	int unchanged = 0;
+
+	for (int i = 0; i < num_checks; ++i) {
+		unchanged += (*generation == last_generation);
+	}
+
+	hrt_abstime t2 = hrt_absolute_time();
+
+	if (updated || unchanged != num_checks) {
+		return test_fail("spurious update");
+	}
+
+	test_note("orb_check: %.3f us, generation compare: %.3f us", (double)(t1 - t0) / num_checks,
+		  (double)(t2 - t1) / num_checks);
+
+	orb_unsubscribe(sfd);
+
+	int ret = orb_unadvertise(ptopic);
+
+	if (ret != PX4_OK) {
+		return test_fail("orb_unadvertise failed: %i", ret);
+	}
+
+	return test_note("PASS generation test");
+}
+
 int uORBTest::UnitTest::test_multi()
 {
 	/* this routine tests the multi-topic support */
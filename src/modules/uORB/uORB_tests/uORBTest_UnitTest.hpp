@@ -98,8 +98,12 @@ private:
 
 	orb_advert_t _pfd[4]; ///< used for test_multi and test_multi_reversed
 
+	int test_field_list();
+
 	int test_single();
 
+	int test_generation();
+
 	/* These 3 depend on each other and must be called in this order */
 	int test_multi();
 	int test_multi_reversed();
@@ -0,0 +1,382 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file tapescsim.cpp
+ * TAP ESC stand-in: emulates a chain of TAP ESCs on a pseudo terminal, so the
+ * tap_esc driver can be run and its output rate measured on POSIX.
+ *
+ * Usage:
+ *   tapescsim start -n 4 -d /tmp/ttyESC
+ *   tap_esc start -d /tmp/ttyESC -n 4
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+#include <px4_getopt.h>
+#include <px4_tasks.h>
+#include <px4_posix.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
+
+#include <drivers/tap_esc/tap_esc_common.h>
+
+extern "C" __EXPORT int tapescsim_main(int argc, char *argv[]);
+
+namespace tapescsim
+{
+
+/* wire time of one byte at 250000 baud, 8N1 */
+static const unsigned byte_time_ns = 40000;
+
+static volatile bool _task_should_exit = false;
+static bool _is_running = false;
+static px4_task_t _task_handle = -1;
+
+static int _master_fd = -1;
+static int _slave_fd = -1;			///< kept open so the raw terminal settings persist
+static char _slave_path[64] = {};
+static char _link_path[64] = {};
+static uint8_t _channels_count = 4;
+
+static ConfigInfoBasicRequest _config = {};
+static ESC_UART_BUF _rx_buf = {};
+static tap_esc_common::EscParser _parser = {};
+
+static perf_counter_t _perf_run = nullptr;	///< interval between received RUN frames
+static uint32_t _feedback_requests[TAP_ESC_MAX_MOTOR_NUM] = {};
+static uint32_t _rx_frames = 0;
+static uint8_t _run_frame_len = 0;
+static uint8_t _feedback_frame_len = 0;
+
+int open_pty();
+void close_pty();
+void send_reply(EscPacket &packet);
+void handle_packet(const EscPacket &packet);
+void task_main(int argc, char *argv[]);
+void start();
+void stop();
+void status();
+void usage();
+
+int open_pty()
+{
+	_master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+	if (_master_fd < 0 || grantpt(_master_fd) < 0 || unlockpt(_master_fd) < 0) {
+		PX4_ERR("failed to create pseudo terminal (%i)", errno);
+		close_pty();
+		return -1;
+	}
+
+	strncpy(_slave_path, ptsname(_master_fd), sizeof(_slave_path) - 1);
+
+	/* the driver only clears ONLCR, so put the line into raw mode for it */
+	_slave_fd = open(_slave_path, O_RDWR | O_NOCTTY);
+
+	if (_slave_fd < 0) {
+		PX4_ERR("failed to open %s (%i)", _slave_path, errno);
+		close_pty();
+		return -1;
+	}
+
+	struct termios config;
+	tcgetattr(_slave_fd, &config);
+	cfmakeraw(&config);
+	tcsetattr(_slave_fd, TCSANOW, &config);
+
+	int flags = fcntl(_master_fd, F_GETFL, 0);
+	fcntl(_master_fd, F_SETFL, flags | O_NONBLOCK);
+
+	if (_link_path[0] != '\0') {
+		unlink(_link_path);
+
+		if (symlink(_slave_path, _link_path) < 0) {
+			PX4_WARN("failed to link %s to %s", _link_path, _slave_path);
+			_link_path[0] = '\0';
+		}
+	}
+
+	return 0;
+}
+
+void close_pty()
+{
+	if (_link_path[0] != '\0') {
+		unlink(_link_path);
+	}
+
+	if (_slave_fd >= 0) {
+		close(_slave_fd);
+		_slave_fd = -1;
+	}
+
+	if (_master_fd >= 0) {
+		close(_master_fd);
+		_master_fd = -1;
+	}
+}
+
+void send_reply(EscPacket &packet)
+{
+	int len = tap_esc_common::crc_packet(packet);
+
+	if (::write(_master_fd, &packet.head, len) != len) {
+		PX4_WARN("reply dropped");
+	}
+}
+
+void handle_packet(const EscPacket &packet)
+{
+	_rx_frames++;
+
+	switch (packet.msg_id) {
+	case ESCBUS_MSG_ID_CONFIG_BASIC:
+		memcpy(&_config, &packet.d.reqConfigInfoBasic, sizeof(_config));
+		break;
+
+	case ESCBUS_MSG_ID_REQUEST_INFO:
+		if (packet.d.reqInfo.requestInfoType == REQEST_INFO_BASIC) {
+			EscPacket reply = {0xfe, sizeof(ConfigInfoBasicResponse), ESCBUS_MSG_ID_CONFIG_INFO_BASIC};
+			reply.d.rspConfigInfoBasic.channelID = packet.d.reqInfo.channelID;
+			memcpy(&reply.d.rspConfigInfoBasic.resp, &_config, sizeof(_config));
+			send_reply(reply);
+		}
+
+		break;
+
+	case ESCBUS_MSG_ID_RUN: {
+			perf_count(_perf_run);
+			_run_frame_len = packet.len + offsetof(EscPacket, d) + 1;
+
+			const unsigned channels = packet.len / sizeof(packet.d.reqRun.rpm_flags[0]);
+
+			for (unsigned i = 0; i < channels && i < TAP_ESC_MAX_MOTOR_NUM; i++) {
+				const uint16_t rpm_flags = packet.d.reqRun.rpm_flags[i];
+
+				if (rpm_flags & RUN_FEEDBACK_ENABLE_MASK) {
+					_feedback_requests[i]++;
+
+					EscPacket reply = {0xfe, sizeof(RunInfoRepsonse), ESCBUS_MSG_ID_RUN_INFO};
+					memset(&reply.d.rspRunInfo, 0, sizeof(reply.d.rspRunInfo));
+					reply.d.rspRunInfo.channelID = i;
+					reply.d.rspRunInfo.ESCStatus = ESC_STATUS_HEALTHY;
+					reply.d.rspRunInfo.speed = rpm_flags & RUN_CHANNEL_VALUE_MASK;
+					_feedback_frame_len = reply.len + offsetof(EscPacket, d) + 1;
+					send_reply(reply);
+				}
+			}
+
+			break;
+		}
+
+	default:
+		break;
+	}
+}
+
+void task_main(int argc, char *argv[])
+{
+	_is_running = true;
+
+	tap_esc_common::reset(&_rx_buf, &_parser);
+
+	pollfd fds[1];
+	fds[0].fd = _master_fd;
+	fds[0].events = POLLIN;
+
+	EscPacket packet;
+
+	while (!_task_should_exit) {
+
+		int ret = ::poll(fds, 1, 100);
+
+		if (ret <= 0 || !(fds[0].revents & POLLIN)) {
+			continue;
+		}
+
+		if (tap_esc_common::read_data_from_uart(_master_fd, &_rx_buf) < 0) {
+			/* the driver closed the line */
+			usleep(10000);
+			continue;
+		}
+
+		while (tap_esc_common::parse_tap_esc_feedback(&_rx_buf, &_parser, &packet)) {
+			handle_packet(packet);
+		}
+	}
+
+	_is_running = false;
+}
+
+void start()
+{
+	if (open_pty() < 0) {
+		return;
+	}
+
+	_perf_run = perf_alloc(PC_INTERVAL, "tapescsim: RUN frames");
+	_task_should_exit = false;
+
+	_task_handle = px4_task_spawn_cmd("tapescsim",
+					  SCHED_DEFAULT,
+					  SCHED_PRIORITY_DEFAULT,
+					  1200,
+					  (px4_main_t)&task_main,
+					  nullptr);
+
+	if (_task_handle < 0) {
+		PX4_ERR("task start failed");
+		_task_handle = -1;
+		close_pty();
+		perf_free(_perf_run);
+		_perf_run = nullptr;
+		return;
+	}
+
+	PX4_INFO("emulating %u ESCs on %s", _channels_count, _link_path[0] != '\0' ? _link_path : _slave_path);
+}
+
+void stop()
+{
+	_task_should_exit = true;
+
+	while (_is_running) {
+		usleep(100000);
+	}
+
+	close_pty();
+	perf_free(_perf_run);
+	_perf_run = nullptr;
+	_task_handle = -1;
+}
+
+void status()
+{
+	PX4_INFO("line: %s -> %s", _link_path[0] != '\0' ? _link_path : "-", _slave_path);
+	PX4_INFO("frames: %u, crc errors: %u", (unsigned)_rx_frames, (unsigned)_parser.crc_errors);
+	perf_print_counter(_perf_run);
+
+	for (unsigned i = 0; i < _channels_count; i++) {
+		PX4_INFO("esc %u: %u feedback requests", i, (unsigned)_feedback_requests[i]);
+	}
+
+	/* every exchange carries one RUN frame and one feedback frame on the bus */
+	const unsigned exchange_bytes = _run_frame_len + _feedback_frame_len;
+
+	if (exchange_bytes > 0) {
+		PX4_INFO("%u bytes per exchange, bus limit %u Hz at 250000 baud", exchange_bytes,
+			 (unsigned)(1000000000ULL / (exchange_bytes * byte_time_ns)));
+	}
+}
+
+void usage()
+{
+	PX4_INFO("usage: tapescsim start [-n <1-8>] [-d <link path>]");
+	PX4_INFO("       tapescsim stop");
+	PX4_INFO("       tapescsim status");
+}
+
+} // namespace tapescsim
+
+int tapescsim_main(int argc, char *argv[])
+{
+	int ch;
+	int myoptind = 1;
+	const char *myoptarg = nullptr;
+
+	if (argc < 2) {
+		tapescsim::usage();
+		return 1;
+	}
+
+	const char *verb = argv[1];
+
+	while ((ch = px4_getopt(argc, argv, "d:n:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'd':
+			strncpy(tapescsim::_link_path, myoptarg, sizeof(tapescsim::_link_path) - 1);
+			break;
+
+		case 'n':
+			tapescsim::_channels_count = atoi(myoptarg);
+			break;
+		}
+	}
+
+	if (tapescsim::_channels_count < 1 || tapescsim::_channels_count > TAP_ESC_MAX_MOTOR_NUM) {
+		tapescsim::usage();
+		return 1;
+	}
+
+	if (!strcmp(verb, "start")) {
+		if (tapescsim::_is_running) {
+			PX4_WARN("already running");
+			return 1;
+		}
+
+		tapescsim::start();
+
+	} else if (!strcmp(verb, "stop")) {
+		if (!tapescsim::_is_running) {
+			PX4_WARN("not running");
+			return 1;
+		}
+
+		tapescsim::stop();
+
+	} else if (!strcmp(verb, "status")) {
+		if (!tapescsim::_is_running) {
+			PX4_INFO("not running");
+			return 0;
+		}
+
+		tapescsim::status();
+
+	} else {
+		tapescsim::usage();
+		return 1;
+	}
+
+	return 0;
+}
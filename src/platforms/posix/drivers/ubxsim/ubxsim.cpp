@@ -0,0 +1,614 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ubxsim.cpp
+ * u-blox receiver stand-in: acknowledges the UBX configuration of the gps
+ * driver on a pseudo terminal and then sends NAV-PVT fixes at a fixed rate.
+ * It measures the time from writing a fix until the driver publishes it, and
+ * can feed RTCM data through the gps_inject_data topic.
+ *
+ * Usage:
+ *   ubxsim start -d /tmp/ttyGPS -r 10 -c 600
+ *   gps start -d /tmp/ttyGPS -p ubx
+ */
+
+#include <px4_config.h>
+#include <px4_defines.h>
+#include <px4_getopt.h>
+#include <px4_tasks.h>
+#include <px4_posix.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <systemlib/perf_counter.h>
+#include <uORB/uORB.h>
+#include <uORB/topics/vehicle_gps_position.h>
+#include <uORB/topics/gps_inject_data.h>
+
+extern "C" __EXPORT int ubxsim_main(int argc, char *argv[]);
+
+namespace ubxsim
+{
+
+#define UBX_SYNC1		0xB5
+#define UBX_SYNC2		0x62
+#define UBX_CLASS_NAV		0x01
+#define UBX_CLASS_ACK		0x05
+#define UBX_CLASS_CFG		0x06
+#define UBX_ID_NAV_PVT		0x07
+#define UBX_ID_ACK_ACK		0x01
+#define RTCM3_PREAMBLE		0xD3
+
+/* same queue length as mavlink uses for the RTCM stream */
+static const unsigned inject_queue_size = 6;
+
+#pragma pack(push, 1)
+struct ubx_nav_pvt_t {
+	uint32_t iTOW;
+	uint16_t year;
+	uint8_t month;
+	uint8_t day;
+	uint8_t hour;
+	uint8_t min;
+	uint8_t sec;
+	uint8_t valid;
+	uint32_t tAcc;
+	int32_t nano;
+	uint8_t fixType;
+	uint8_t flags;
+	uint8_t reserved1;
+	uint8_t numSV;
+	int32_t lon;
+	int32_t lat;
+	int32_t height;
+	int32_t hMSL;
+	uint32_t hAcc;
+	uint32_t vAcc;
+	int32_t velN;
+	int32_t velE;
+	int32_t velD;
+	int32_t gSpeed;
+	int32_t headMot;
+	uint32_t sAcc;
+	uint32_t headAcc;
+	uint16_t pDOP;
+	uint8_t reserved2[6];
+	int32_t headVeh;
+	uint8_t reserved3[4];
+};
+#pragma pack(pop)
+
+enum class RxState {
+	idle,
+	ubx_sync2,
+	ubx_header,
+	ubx_payload,
+	rtcm_length,
+	rtcm_payload
+};
+
+static volatile bool _task_should_exit = false;
+static bool _is_running = false;
+static px4_task_t _task_handle = -1;
+
+static int _master_fd = -1;
+static int _slave_fd = -1;			///< kept open so the raw terminal settings persist
+static char _slave_path[64] = {};
+static char _link_path[64] = {};
+static unsigned _rate = 10;			///< fixes per second
+static unsigned _rtcm_bytes = 0;		///< RTCM bytes injected per fix
+
+static RxState _rx_state = RxState::idle;
+static uint8_t _rx_header[4];
+static unsigned _rx_index = 0;
+static unsigned _rx_length = 0;
+
+static bool _configured = false;
+static uint32_t _cfg_acked = 0;
+static uint32_t _fixes_sent = 0;
+static uint32_t _fixes_published = 0;
+static int32_t _fix_lon = 0;
+static hrt_abstime _fix_sent_time = 0;
+
+static uint32_t _rtcm_bytes_sent = 0;
+static uint32_t _rtcm_bytes_received = 0;
+static uint32_t _rtcm_frames_received = 0;
+static orb_advert_t _inject_pub = nullptr;
+
+static perf_counter_t _perf_latency = nullptr;	///< from writing a fix to the pty until it is published
+
+int open_pty();
+void close_pty();
+void send_ubx(uint8_t msg_class, uint8_t msg_id, const void *payload, uint16_t length);
+void send_fix();
+void inject_rtcm();
+void handle_ubx(uint8_t msg_class, uint8_t msg_id);
+bool parse_byte(uint8_t b);
+void task_main(int argc, char *argv[]);
+void start();
+void stop();
+void status();
+void usage();
+
+int open_pty()
+{
+	_master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+	if (_master_fd < 0 || grantpt(_master_fd) < 0 || unlockpt(_master_fd) < 0) {
+		PX4_ERR("failed to create pseudo terminal (%i)", errno);
+		close_pty();
+		return -1;
+	}
+
+	strncpy(_slave_path, ptsname(_master_fd), sizeof(_slave_path) - 1);
+
+	_slave_fd = open(_slave_path, O_RDWR | O_NOCTTY);
+
+	if (_slave_fd < 0) {
+		PX4_ERR("failed to open %s (%i)", _slave_path, errno);
+		close_pty();
+		return -1;
+	}
+
+	struct termios config;
+	tcgetattr(_slave_fd, &config);
+	cfmakeraw(&config);
+	tcsetattr(_slave_fd, TCSANOW, &config);
+
+	int flags = fcntl(_master_fd, F_GETFL, 0);
+	fcntl(_master_fd, F_SETFL, flags | O_NONBLOCK);
+
+	if (_link_path[0] != '\0') {
+		unlink(_link_path);
+
+		if (symlink(_slave_path, _link_path) < 0) {
+			PX4_WARN("failed to link %s to %s", _link_path, _slave_path);
+			_link_path[0] = '\0';
+		}
+	}
+
+	return 0;
+}
+
+void close_pty()
+{
+	if (_link_path[0] != '\0') {
+		unlink(_link_path);
+	}
+
+	if (_slave_fd >= 0) {
+		close(_slave_fd);
+		_slave_fd = -1;
+	}
+
+	if (_master_fd >= 0) {
+		close(_master_fd);
+		_master_fd = -1;
+	}
+}
+
+void send_ubx(uint8_t msg_class, uint8_t msg_id, const void *payload, uint16_t length)
+{
+	uint8_t frame[6 + sizeof(ubx_nav_pvt_t) + 2];
+
+	if (length > sizeof(ubx_nav_pvt_t)) {
+		return;
+	}
+
+	frame[0] = UBX_SYNC1;
+	frame[1] = UBX_SYNC2;
+	frame[2] = msg_class;
+	frame[3] = msg_id;
+	frame[4] = length & 0xff;
+	frame[5] = length >> 8;
+	memcpy(&frame[6], payload, length);
+
+	/* 8-bit Fletcher checksum over class, id, length and payload */
+	uint8_t ck_a = 0;
+	uint8_t ck_b = 0;
+
+	for (unsigned i = 2; i < 6u + length; i++) {
+		ck_a += frame[i];
+		ck_b += ck_a;
+	}
+
+	frame[6 + length] = ck_a;
+	frame[7 + length] = ck_b;
+
+	const int len = 8 + length;
+
+	if (::write(_master_fd, frame, len) != len) {
+		PX4_WARN("frame dropped");
+	}
+}
+
+void send_fix()
+{
+	ubx_nav_pvt_t pvt = {};
+
+	pvt.iTOW = (uint32_t)(hrt_absolute_time() / 1000);
+	pvt.year = 2016;
+	pvt.month = 10;
+	pvt.day = 1;
+	pvt.valid = 0x03;
+	pvt.fixType = 3;
+	pvt.flags = 0x01;
+	pvt.numSV = 12;
+	pvt.lat = 473977420;
+	/* the fix number in the longitude identifies the fix when it is published */
+	pvt.lon = 85455940 + (int32_t)(_fixes_sent % 1000);
+	pvt.height = 488000;
+	pvt.hMSL = 440000;
+	pvt.hAcc = 800;
+	pvt.vAcc = 1200;
+	pvt.sAcc = 200;
+	pvt.headAcc = 1000000;
+	pvt.pDOP = 120;
+
+	_fix_lon = pvt.lon;
+	_fix_sent_time = hrt_absolute_time();
+	_fixes_sent++;
+
+	send_ubx(UBX_CLASS_NAV, UBX_ID_NAV_PVT, &pvt, sizeof(pvt));
+}
+
+void inject_rtcm()
+{
+	gps_inject_data_s msg = {};
+	const unsigned fragment_size = 180;
+	unsigned remaining = _rtcm_bytes;
+	unsigned offset = 0;
+
+	while (remaining > 0) {
+		msg.len = (remaining > fragment_size) ? fragment_size : remaining;
+		msg.flags = (_rtcm_bytes > fragment_size) ? 1 : 0;
+
+		for (unsigned i = 0; i < msg.len; i++) {
+			msg.data[i] = (uint8_t)(offset + i);
+		}
+
+		/* one RTCM3 frame per fix: preamble, 10 bit length, payload and 3 CRC bytes (not checked) */
+		if (offset == 0) {
+			const unsigned payload = _rtcm_bytes - 6;
+			msg.data[0] = RTCM3_PREAMBLE;
+			msg.data[1] = (payload >> 8) & 0x03;
+			msg.data[2] = payload & 0xff;
+		}
+
+		if (_inject_pub == nullptr) {
+			_inject_pub = orb_advertise_queue(ORB_ID(gps_inject_data), &msg, inject_queue_size);
+
+		} else {
+			orb_publish(ORB_ID(gps_inject_data), _inject_pub, &msg);
+		}
+
+		_rtcm_bytes_sent += msg.len;
+		offset += msg.len;
+		remaining -= msg.len;
+	}
+}
+
+void handle_ubx(uint8_t msg_class, uint8_t msg_id)
+{
+	if (msg_class != UBX_CLASS_CFG) {
+		/* polls such as MON-VER are not answered, the driver does not wait for them */
+		return;
+	}
+
+	/* accept every configuration, like a receiver that supports all requested messages */
+	const uint8_t ack[2] = {msg_class, msg_id};
+	send_ubx(UBX_CLASS_ACK, UBX_ID_ACK_ACK, ack, sizeof(ack));
+
+	_cfg_acked++;
+	_configured = true;
+}
+
+/**
+ * Feed one byte from the driver into the UBX/RTCM3 frame decoder.
+ * @return true if the byte belongs to an RTCM3 frame
+ */
+bool parse_byte(uint8_t b)
+{
+	switch (_rx_state) {
+	case RxState::idle:
+		if (b == UBX_SYNC1) {
+			_rx_state = RxState::ubx_sync2;
+
+		} else if (b == RTCM3_PREAMBLE) {
+			_rx_state = RxState::rtcm_length;
+			_rx_index = 0;
+			return true;
+		}
+
+		break;
+
+	case RxState::ubx_sync2:
+		_rx_state = (b == UBX_SYNC2) ? RxState::ubx_header : RxState::idle;
+		_rx_index = 0;
+		break;
+
+	case RxState::ubx_header:
+		_rx_header[_rx_index++] = b;
+
+		if (_rx_index == sizeof(_rx_header)) {
+			/* payload and checksum */
+			_rx_length = (_rx_header[2] | (_rx_header[3] << 8)) + 2;
+			_rx_index = 0;
+			_rx_state = RxState::ubx_payload;
+		}
+
+		break;
+
+	case RxState::ubx_payload:
+		if (++_rx_index == _rx_length) {
+			handle_ubx(_rx_header[0], _rx_header[1]);
+			_rx_state = RxState::idle;
+		}
+
+		break;
+
+	case RxState::rtcm_length:
+		_rx_header[_rx_index++] = b;
+
+		if (_rx_index == 2) {
+			/* payload and CRC */
+			_rx_length = (((_rx_header[0] & 0x03) << 8) | _rx_header[1]) + 3;
+			_rx_index = 0;
+			_rx_state = RxState::rtcm_payload;
+		}
+
+		return true;
+
+	case RxState::rtcm_payload:
+		if (++_rx_index == _rx_length) {
+			_rtcm_frames_received++;
+			_rx_state = RxState::idle;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void task_main(int argc, char *argv[])
+{
+	_is_running = true;
+
+	/* the first gps publishes instance 0, a second one (or gpssim) instance 1 */
+	int gps_sub[2];
+	gps_sub[0] = orb_subscribe_multi(ORB_ID(vehicle_gps_position), 0);
+	gps_sub[1] = orb_subscribe_multi(ORB_ID(vehicle_gps_position), 1);
+
+	px4_pollfd_struct_t fds[2] = {};
+	fds[0].fd = gps_sub[0];
+	fds[0].events = POLLIN;
+	fds[1].fd = gps_sub[1];
+	fds[1].events = POLLIN;
+
+	const hrt_abstime interval = 1000000 / _rate;
+	hrt_abstime next_fix = 0;
+	uint8_t buf[256];
+
+	while (!_task_should_exit) {
+
+		const hrt_abstime now = hrt_absolute_time();
+
+		if (_configured && now >= next_fix) {
+			next_fix = (next_fix == 0 || now - next_fix > interval) ? now + interval : next_fix + interval;
+			send_fix();
+
+			if (_rtcm_bytes > 0) {
+				inject_rtcm();
+			}
+		}
+
+		int n;
+
+		while ((n = ::read(_master_fd, buf, sizeof(buf))) > 0) {
+			for (int i = 0; i < n; i++) {
+				if (parse_byte(buf[i])) {
+					_rtcm_bytes_received++;
+				}
+			}
+		}
+
+		/* the pty is serviced every millisecond, the gps topics wake us up right away */
+		if (px4_poll(fds, 2, 1) <= 0) {
+			continue;
+		}
+
+		for (unsigned i = 0; i < 2; i++) {
+			if (fds[i].revents & POLLIN) {
+				vehicle_gps_position_s pos;
+				orb_copy(ORB_ID(vehicle_gps_position), gps_sub[i], &pos);
+
+				if (_fix_sent_time != 0 && pos.lon == _fix_lon) {
+					perf_set_elapsed(_perf_latency, hrt_elapsed_time(&_fix_sent_time));
+					_fix_sent_time = 0;
+					_fixes_published++;
+				}
+			}
+		}
+	}
+
+	orb_unsubscribe(gps_sub[0]);
+	orb_unsubscribe(gps_sub[1]);
+
+	if (_inject_pub != nullptr) {
+		orb_unadvertise(_inject_pub);
+		_inject_pub = nullptr;
+	}
+
+	_is_running = false;
+}
+
+void start()
+{
+	if (open_pty() < 0) {
+		return;
+	}
+
+	_perf_latency = perf_alloc(PC_ELAPSED, "ubxsim: fix to publish");
+	_task_should_exit = false;
+
+	_task_handle = px4_task_spawn_cmd("ubxsim",
+					  SCHED_DEFAULT,
+					  SCHED_PRIORITY_DEFAULT,
+					  1500,
+					  (px4_main_t)&task_main,
+					  nullptr);
+
+	if (_task_handle < 0) {
+		PX4_ERR("task start failed");
+		_task_handle = -1;
+		close_pty();
+		perf_free(_perf_latency);
+		_perf_latency = nullptr;
+		return;
+	}
+
+	PX4_INFO("u-blox receiver on %s, %u Hz", _link_path[0] != '\0' ? _link_path : _slave_path, _rate);
+}
+
+void stop()
+{
+	_task_should_exit = true;
+
+	while (_is_running) {
+		usleep(100000);
+	}
+
+	close_pty();
+	perf_free(_perf_latency);
+	_perf_latency = nullptr;
+	_task_handle = -1;
+}
+
+void status()
+{
+	PX4_INFO("line: %s -> %s", _link_path[0] != '\0' ? _link_path : "-", _slave_path);
+	PX4_INFO("configured: %s (%u CFG messages acked)", _configured ? "yes" : "no", (unsigned)_cfg_acked);
+	PX4_INFO("fixes sent: %u, published: %u", (unsigned)_fixes_sent, (unsigned)_fixes_published);
+	perf_print_counter(_perf_latency);
+
+	if (_rtcm_bytes > 0) {
+		PX4_INFO("RTCM: %u bytes injected, %u bytes in %u frames received",
+			 (unsigned)_rtcm_bytes_sent, (unsigned)_rtcm_bytes_received, (unsigned)_rtcm_frames_received);
+	}
+}
+
+void usage()
+{
+	PX4_INFO("usage: ubxsim start [-d <link path>] [-r <fix rate Hz>] [-c <RTCM bytes per fix>]");
+	PX4_INFO("       ubxsim stop");
+	PX4_INFO("       ubxsim status");
+}
+
+} // namespace ubxsim
+
+int ubxsim_main(int argc, char *argv[])
+{
+	int ch;
+	int myoptind = 1;
+	const char *myoptarg = nullptr;
+
+	if (argc < 2) {
+		ubxsim::usage();
+		return 1;
+	}
+
+	const char *verb = argv[1];
+
+	while ((ch = px4_getopt(argc, argv, "d:r:c:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'd':
+			strncpy(ubxsim::_link_path, myoptarg, sizeof(ubxsim::_link_path) - 1);
+			break;
+
+		case 'r':
+			ubxsim::_rate = atoi(myoptarg);
+			break;
+
+		case 'c':
+			ubxsim::_rtcm_bytes = atoi(myoptarg);
+			break;
+		}
+	}
+
+	/* an RTCM3 frame has 6 bytes of framing and up to 1023 bytes of payload */
+	if (ubxsim::_rate < 1 || ubxsim::_rate > 50
+	    || (ubxsim::_rtcm_bytes > 0 && ubxsim::_rtcm_bytes < 6) || ubxsim::_rtcm_bytes > 1029) {
+		ubxsim::usage();
+		return 1;
+	}
+
+	if (!strcmp(verb, "start")) {
+		if (ubxsim::_is_running) {
+			PX4_WARN("already running");
+			return 1;
+		}
+
+		ubxsim::start();
+
+	} else if (!strcmp(verb, "stop")) {
+		if (!ubxsim::_is_running) {
+			PX4_WARN("not running");
+			return 1;
+		}
+
+		ubxsim::stop();
+
+	} else if (!strcmp(verb, "status")) {
+		if (!ubxsim::_is_running) {
+			PX4_INFO("not running");
+			return 0;
+		}
+
+		ubxsim::status();
+
+	} else {
+		ubxsim::usage();
+		return 1;
+	}
+
+	return 0;
+}
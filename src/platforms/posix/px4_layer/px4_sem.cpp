@@ -106,6 +106,11 @@ int px4_sem_timedwait(px4_sem_t *s, const struct timespec *abstime)
 
 	int err = ret;
 
+	if (err == ETIMEDOUT) {
+		/* we were not posted, give back the count taken above */
+		s->value++;
+	}
+
 	if (err != 0 && err != ETIMEDOUT) {
 		setbuf(stdout, NULL);
 		setbuf(stderr, NULL);
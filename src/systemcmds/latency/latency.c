@@ -0,0 +1,97 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2016 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file latency.c
+ * Enable sensor to actuator latency tracing and print the latency histograms.
+ */
+
+#include <px4_config.h>
+#include <px4_log.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <systemlib/latency_trace.h>
+
+__EXPORT int latency_main(int argc, char *argv[]);
+
+static void
+usage(void)
+{
+	printf("Usage: latency start [interval ms] | stop | status | reset\n"
+	       "  start: trace one IMU sample every interval (default 100 ms). The\n"
+	       "         path ends at the output driver, which only mixes while armed\n"
+	       "         in SITL (pwm_out_sim)\n");
+}
+
+int
+latency_main(int argc, char *argv[])
+{
+	if (argc < 2 || strcmp(argv[1], "status") == 0) {
+		latency_trace_print(1 /* stdout */);
+		fflush(stdout);
+		return 0;
+	}
+
+	if (strcmp(argv[1], "start") == 0) {
+		int interval_ms = 100;
+
+		if (argc > 2) {
+			interval_ms = strtol(argv[2], NULL, 0);
+		}
+
+		if (interval_ms <= 0) {
+			usage();
+			return 1;
+		}
+
+		if (latency_trace_set_interval(interval_ms * 1000) != 0) {
+			PX4_ERR("advertising latency_trace failed");
+			return 1;
+		}
+
+		return 0;
+
+	} else if (strcmp(argv[1], "stop") == 0) {
+		latency_trace_set_interval(0);
+		return 0;
+
+	} else if (strcmp(argv[1], "reset") == 0) {
+		latency_trace_reset();
+		return 0;
+	}
+
+	usage();
+	return 1;
+}
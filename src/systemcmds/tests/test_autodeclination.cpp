@@ -2,28 +2,387 @@
 
 #include <drivers/drv_hrt.h>
 #include <geo/geo.h>
-#include <px4iofirmware/px4io.h>
+#include <px4_defines.h>
+#include <px4_log.h>
 #include <systemlib/err.h>
-#include <systemlib/mixer/mixer.h>
 
 #include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
+#if defined(__PX4_POSIX) && !defined(__PX4_QURT)
+#define TEST_MAG_GRID_FILE
+#endif
+
 class AutoDeclinationTest : public UnitTest
 {
 public:
 	virtual bool run_tests(void);
 
 private:
+	struct field_error_s {
+		float declination_max;
+		float declination_rms;
+		float inclination_max;
+		float intensity_max;
+	};
+
 	bool autodeclination_check();
+	bool embedded_grid_accuracy();
+	bool grid_file_check();
+	bool benchmark();
+
+	void compare_with_reference(field_error_s &error, float max_lat);
+};
+
+/* year the grids are generated for by Tools/generate_mag_grid.py */
+static constexpr double grid_year = 2017.0;
+
+/* WMM2015: n, m, g, h, secular variation of g and h (nT, nT/year) */
+static const struct {
+	int n;
+	int m;
+	float g;
+	float h;
+	float g_dot;
+	float h_dot;
+} wmm_coefficients[] = {
+	{  1,  0,  -29438.5f,      0.0f,   10.7f,    0.0f },
+	{  1,  1,   -1501.1f,   4796.2f,   17.9f,  -26.8f },
+	{  2,  0,   -2445.3f,      0.0f,   -8.6f,    0.0f },
+	{  2,  1,    3012.5f,  -2845.6f,   -3.3f,  -27.1f },
+	{  2,  2,    1676.6f,   -642.0f,    2.4f,  -13.3f },
+	{  3,  0,    1351.1f,      0.0f,    3.1f,    0.0f },
+	{  3,  1,   -2352.3f,   -115.3f,   -6.2f,    8.4f },
+	{  3,  2,    1225.6f,    245.0f,   -0.4f,   -0.4f },
+	{  3,  3,     581.9f,   -538.3f,  -10.4f,    2.3f },
+	{  4,  0,     907.2f,      0.0f,   -0.4f,    0.0f },
+	{  4,  1,     813.7f,    283.4f,    0.8f,   -0.6f },
+	{  4,  2,     120.3f,   -188.6f,   -9.2f,    5.3f },
+	{  4,  3,    -335.0f,    180.9f,    4.0f,    3.0f },
+	{  4,  4,      70.3f,   -329.5f,   -4.2f,   -5.3f },
+	{  5,  0,    -232.6f,      0.0f,   -0.2f,    0.0f },
+	{  5,  1,     360.1f,     47.4f,    0.1f,    0.4f },
+	{  5,  2,     192.4f,    196.9f,   -1.4f,    1.6f },
+	{  5,  3,    -141.0f,   -119.4f,    0.0f,   -1.1f },
+	{  5,  4,    -157.4f,     16.1f,    1.3f,    3.3f },
+	{  5,  5,       4.3f,    100.1f,    3.8f,    0.1f },
+	{  6,  0,      69.5f,      0.0f,   -0.5f,    0.0f },
+	{  6,  1,      67.4f,    -20.7f,   -0.2f,    0.0f },
+	{  6,  2,      72.8f,     33.2f,   -0.6f,   -2.2f },
+	{  6,  3,    -129.8f,     58.8f,    2.4f,   -0.7f },
+	{  6,  4,     -29.0f,    -66.5f,   -1.1f,    0.1f },
+	{  6,  5,      13.2f,      7.3f,    0.3f,    1.0f },
+	{  6,  6,     -70.9f,     62.5f,    1.5f,    1.3f },
+	{  7,  0,      81.6f,      0.0f,    0.2f,    0.0f },
+	{  7,  1,     -76.1f,    -54.1f,   -0.2f,    0.7f },
+	{  7,  2,      -6.8f,    -19.4f,   -0.4f,    0.5f },
+	{  7,  3,      51.9f,      5.6f,    1.3f,   -0.2f },
+	{  7,  4,      15.0f,     24.4f,    0.2f,   -0.1f },
+	{  7,  5,       9.3f,      3.3f,   -0.4f,   -0.7f },
+	{  7,  6,      -2.8f,    -27.5f,   -0.9f,    0.1f },
+	{  7,  7,       6.7f,     -2.3f,    0.3f,    0.1f },
+	{  8,  0,      24.0f,      0.0f,    0.0f,    0.0f },
+	{  8,  1,       8.6f,     10.2f,    0.1f,   -0.3f },
+	{  8,  2,     -16.9f,    -18.1f,   -0.5f,    0.3f },
+	{  8,  3,      -3.2f,     13.2f,    0.5f,    0.3f },
+	{  8,  4,     -20.6f,    -14.6f,   -0.2f,    0.6f },
+	{  8,  5,      13.3f,     16.2f,    0.4f,   -0.1f },
+	{  8,  6,      11.7f,      5.7f,    0.2f,   -0.2f },
+	{  8,  7,     -16.0f,     -9.1f,   -0.4f,    0.3f },
+	{  8,  8,      -2.0f,      2.2f,    0.3f,    0.0f },
+	{  9,  0,       5.4f,      0.0f,    0.0f,    0.0f },
+	{  9,  1,       8.8f,    -21.6f,   -0.1f,   -0.2f },
+	{  9,  2,       3.1f,     10.8f,   -0.1f,   -0.1f },
+	{  9,  3,      -3.1f,     11.7f,    0.4f,   -0.2f },
+	{  9,  4,       0.6f,     -6.8f,   -0.5f,    0.1f },
+	{  9,  5,     -13.3f,     -6.9f,   -0.2f,    0.1f },
+	{  9,  6,      -0.1f,      7.8f,    0.1f,    0.0f },
+	{  9,  7,       8.7f,      1.0f,    0.0f,   -0.2f },
+	{  9,  8,      -9.1f,     -3.9f,   -0.2f,    0.4f },
+	{  9,  9,     -10.5f,      8.5f,   -0.1f,    0.3f },
+	{ 10,  0,      -1.9f,      0.0f,    0.0f,    0.0f },
+	{ 10,  1,      -6.5f,      3.3f,    0.0f,    0.0f },
+	{ 10,  2,       0.2f,     -0.3f,   -0.1f,    0.0f },
+	{ 10,  3,       0.6f,      4.6f,    0.3f,    0.0f },
+	{ 10,  4,      -0.6f,      4.4f,   -0.1f,    0.0f },
+	{ 10,  5,       1.7f,     -7.9f,   -0.1f,   -0.2f },
+	{ 10,  6,      -0.7f,     -0.6f,   -0.1f,    0.1f },
+	{ 10,  7,       2.1f,     -4.1f,    0.0f,   -0.1f },
+	{ 10,  8,       2.3f,     -2.8f,   -0.2f,   -0.2f },
+	{ 10,  9,      -1.8f,     -1.1f,   -0.1f,    0.1f },
+	{ 10, 10,      -3.6f,     -8.7f,   -0.2f,   -0.1f },
+	{ 11,  0,       3.1f,      0.0f,    0.0f,    0.0f },
+	{ 11,  1,      -1.5f,     -0.1f,    0.0f,    0.0f },
+	{ 11,  2,      -2.3f,      2.1f,   -0.1f,    0.1f },
+	{ 11,  3,       2.1f,     -0.7f,    0.1f,    0.0f },
+	{ 11,  4,      -0.9f,     -1.1f,    0.0f,    0.1f },
+	{ 11,  5,       0.6f,      0.7f,    0.0f,    0.0f },
+	{ 11,  6,      -0.7f,     -0.2f,    0.0f,    0.0f },
+	{ 11,  7,       0.2f,     -2.1f,    0.0f,    0.1f },
+	{ 11,  8,       1.7f,     -1.5f,    0.0f,    0.0f },
+	{ 11,  9,      -0.2f,     -2.5f,    0.0f,   -0.1f },
+	{ 11, 10,       0.4f,     -2.0f,   -0.1f,   -0.1f },
+	{ 11, 11,       3.5f,     -2.3f,   -0.1f,   -0.1f },
+	{ 12,  0,      -2.0f,      0.0f,    0.1f,    0.0f },
+	{ 12,  1,      -0.3f,     -1.0f,    0.0f,    0.0f },
+	{ 12,  2,       0.4f,      0.5f,    0.0f,    0.0f },
+	{ 12,  3,       1.3f,      1.8f,    0.1f,   -0.1f },
+	{ 12,  4,      -0.9f,     -2.2f,   -0.1f,    0.0f },
+	{ 12,  5,       0.9f,      0.3f,    0.0f,    0.0f },
+	{ 12,  6,       0.1f,      0.7f,    0.1f,    0.0f },
+	{ 12,  7,       0.5f,     -0.1f,    0.0f,    0.0f },
+	{ 12,  8,      -0.4f,      0.3f,    0.0f,    0.0f },
+	{ 12,  9,      -0.4f,      0.2f,    0.0f,    0.0f },
+	{ 12, 10,       0.2f,     -0.9f,    0.0f,    0.0f },
+	{ 12, 11,      -0.9f,     -0.2f,    0.0f,    0.0f },
+	{ 12, 12,       0.0f,      0.7f,    0.0f,    0.0f },
 };
 
+/**
+ * Reference evaluation of the World Magnetic Model at sea level.
+ * @param declination degrees
+ * @param inclination degrees
+ * @param intensity gauss
+ */
+static void wmm_reference(double lat, double lon, double year, double &declination, double &inclination,
+			  double &intensity)
+{
+	static constexpr int N = 12;
+	const double a = 6378.137;
+	const double f = 1.0 / 298.257223563;
+	const double e2 = f * (2.0 - f);
+	const double re = 6371.2;
+
+	/* north is undefined at the poles, use the limit along the meridian */
+	lat = fmax(-89.9999, fmin(89.9999, lat));
+
+	/* geodetic to geocentric */
+	const double phi = lat * M_PI / 180.0;
+	const double lam = lon * M_PI / 180.0;
+	const double rc = a / sqrt(1.0 - e2 * sin(phi) * sin(phi));
+	const double p = rc * cos(phi);
+	const double z = rc * (1.0 - e2) * sin(phi);
+	const double r = sqrt(p * p + z * z);
+	const double phi_c = asin(z / r);
+	const double ct = sin(phi_c);
+	const double st = cos(phi_c);
+
+	/* Schmidt semi-normalized associated Legendre functions and their derivatives */
+	double P[N + 1][N + 1] = {};
+	double dP[N + 1][N + 1] = {};
+	P[0][0] = 1.0;
+
+	for (int n = 1; n <= N; n++) {
+		for (int m = 0; m <= n; m++) {
+			if (n == m) {
+				const double k = (n == 1) ? 1.0 : sqrt((2.0 * n - 1.0) / (2.0 * n));
+				P[n][n] = k * st * P[n - 1][n - 1];
+				dP[n][n] = k * (ct * P[n - 1][n - 1] + st * dP[n - 1][n - 1]);
+
+			} else {
+				const double k1 = (2.0 * n - 1.0) / sqrt((double)(n * n - m * m));
+				P[n][m] = k1 * ct * P[n - 1][m];
+				dP[n][m] = k1 * (ct * dP[n - 1][m] - st * P[n - 1][m]);
+
+				if (n > 1) {
+					const double k2 = sqrt(((n - 1.0) * (n - 1.0) - m * m) / (n * n - m * m));
+					P[n][m] -= k2 * P[n - 2][m];
+					dP[n][m] -= k2 * dP[n - 2][m];
+				}
+			}
+		}
+	}
+
+	const double dt = year - 2015.0;
+	double x = 0.0;
+	double y = 0.0;
+	double zz = 0.0;
+
+	for (unsigned k = 0; k < sizeof(wmm_coefficients) / sizeof(wmm_coefficients[0]); k++) {
+		const int n = wmm_coefficients[k].n;
+		const int m = wmm_coefficients[k].m;
+		const double ar = pow(re / r, n + 2);
+		const double g = wmm_coefficients[k].g + dt * wmm_coefficients[k].g_dot;
+		const double h = wmm_coefficients[k].h + dt * wmm_coefficients[k].h_dot;
+		const double cm = cos(m * lam);
+		const double sm = sin(m * lam);
+
+		x += ar * (g * cm + h * sm) * dP[n][m];
+		y += ar * m * (g * sm - h * cm) * P[n][m] / st;
+		zz -= (n + 1) * ar * (g * cm + h * sm) * P[n][m];
+	}
+
+	/* back to the geodetic frame */
+	const double psi = phi_c - phi;
+	const double x_g = x * cos(psi) - zz * sin(psi);
+	const double z_g = x * sin(psi) + zz * cos(psi);
+	const double horizontal = sqrt(x_g * x_g + y * y);
+
+	declination = atan2(y, x_g) * 180.0 / M_PI;
+	inclination = atan2(z_g, horizontal) * 180.0 / M_PI;
+	intensity = sqrt(horizontal * horizontal + z_g * z_g) * 1e-5;
+}
+
+void AutoDeclinationTest::compare_with_reference(field_error_s &error, float max_lat)
+{
+	memset(&error, 0, sizeof(error));
+	double declination_sum = 0.0;
+	unsigned num_samples = 0;
+
+	/* sample grid offset against the grid points of any resolution */
+	for (float lat = -max_lat; lat <= max_lat; lat += 3.7f) {
+		for (float lon = -180.0f; lon <= 180.0f; lon += 4.3f) {
+			double declination, inclination, intensity;
+			wmm_reference(lat, lon, grid_year, declination, inclination, intensity);
+
+			const float declination_error = fabsf(_wrap_180(get_mag_declination(lat, lon) - (float)declination));
+			error.declination_max = fmaxf(error.declination_max, declination_error);
+			error.inclination_max = fmaxf(error.inclination_max, fabsf(get_mag_inclination(lat, lon) - (float)inclination));
+			error.intensity_max = fmaxf(error.intensity_max, fabsf(get_mag_strength(lat, lon) - (float)intensity));
+			declination_sum += declination_error * declination_error;
+			num_samples++;
+		}
+	}
+
+	error.declination_rms = sqrt(declination_sum / num_samples);
+}
+
 bool AutoDeclinationTest::autodeclination_check(void)
 {
-	ut_assert("declination differs more than 1 degree", get_mag_declination(47.0, 8.0) - 0.6f < 0.5f);
+	ut_assert("declination differs more than 0.5 degree", fabsf(get_mag_declination(47.0, 8.0) - 2.1f) < 0.5f);
+
+	double declination, inclination, intensity;
+	wmm_reference(47.0, 8.0, grid_year, declination, inclination, intensity);
+	ut_assert("declination", fabsf(get_mag_declination(47.0f, 8.0f) - (float)declination) < 0.5f);
+	ut_assert("inclination", fabsf(get_mag_inclination(47.0f, 8.0f) - (float)inclination) < 0.5f);
+	ut_assert("intensity", fabsf(get_mag_strength(47.0f, 8.0f) - (float)intensity) < 0.005f);
+
+	/* WMM2015 test values: 80N 0E at 2015.0 */
+	wmm_reference(80.0, 0.0, 2015.0, declination, inclination, intensity);
+	ut_assert("reference declination", fabs(declination - (-3.85)) < 0.01);
+	ut_assert("reference inclination", fabs(inclination - 83.04) < 0.01);
+	ut_assert("reference intensity", fabs(intensity - 0.548360) < 0.00001);
+
+	return true;
+}
+
+bool AutoDeclinationTest::embedded_grid_accuracy(void)
+{
+	/* use the grid compiled into the firmware even if a grid file is present */
+	geo_mag_grid_unload();
+
+	field_error_s error;
+	compare_with_reference(error, 60.0f);
+
+	PX4_INFO("embedded grid, +-60 deg: declination max %.2f rms %.2f deg, inclination max %.2f deg, intensity max %.4f G",
+		 (double)error.declination_max, (double)error.declination_rms, (double)error.inclination_max,
+		 (double)error.intensity_max);
+
+	/* the largest errors are close to the south magnetic pole, boards with little flash have a 10 degree grid */
+	const bool coarse = geo_mag_grid_resolution() > 5.0f;
+	ut_assert("declination error", error.declination_max < (coarse ? 10.0f : 4.0f)
+		  && error.declination_rms < (coarse ? 1.0f : 0.5f));
+	ut_assert("inclination error", error.inclination_max < (coarse ? 4.0f : 2.0f));
+	ut_assert("intensity error", error.intensity_max < (coarse ? 0.02f : 0.01f));
+
+	compare_with_reference(error, 88.0f);
+
+	PX4_INFO("embedded grid, +-88 deg: declination max %.2f rms %.2f deg, inclination max %.2f deg, intensity max %.4f G",
+		 (double)error.declination_max, (double)error.declination_rms, (double)error.inclination_max,
+		 (double)error.intensity_max);
+
+	return true;
+}
+
+bool AutoDeclinationTest::grid_file_check(void)
+{
+#ifdef TEST_MAG_GRID_FILE
+	static constexpr const char *filename = PX4_ROOTFSDIR"/fs/microsd/mag_grid_test.bin";
+	static constexpr float res = 2.0f;
+	static constexpr unsigned num_lat = 91;
+	static constexpr unsigned num_lon = 181;
+
+	ut_assert("invalid file rejected", geo_mag_grid_load(__FILE__) != 0);
+
+	/* write a grid file the way Tools/generate_mag_grid.py does */
+	FILE *file = fopen(filename, "wb");
+	ut_assert("file open", file != nullptr);
+
+	const struct {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t reserved;
+		float epoch;
+		float lat_min;
+		float lon_min;
+		float res;
+		uint16_t num_lat;
+		uint16_t num_lon;
+	} header = { 0x474d5850, 1, 0, (float)grid_year, -90.0f, -180.0f, res, num_lat, num_lon };
+
+	bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+	for (unsigned i = 0; i < num_lat && ok; i++) {
+		for (unsigned j = 0; j < num_lon && ok; j++) {
+			double declination, inclination, intensity;
+			wmm_reference(-90.0 + i * res, -180.0 + j * res, grid_year, declination, inclination, intensity);
+			const int16_t values[3] = {
+				(int16_t)lround(declination * 100.0),
+				(int16_t)lround(inclination * 100.0),
+				(int16_t)lround(intensity * 1e4)
+			};
+			ok = fwrite(values, sizeof(values), 1, file) == 1;
+		}
+	}
+
+	fclose(file);
+	ut_assert("file write", ok);
+
+	field_error_s error_embedded;
+	geo_mag_grid_unload();
+	compare_with_reference(error_embedded, 60.0f);
+
+	ut_assert("grid file load", geo_mag_grid_load(filename) == 0);
+
+	field_error_s error;
+	compare_with_reference(error, 60.0f);
+	geo_mag_grid_unload();
+	unlink(filename);
+
+	PX4_INFO("%.0f deg grid file, +-60 deg: declination max %.2f rms %.3f deg, inclination max %.2f deg, intensity max %.4f G",
+		 (double)res, (double)error.declination_max, (double)error.declination_rms, (double)error.inclination_max,
+		 (double)error.intensity_max);
+
+	ut_assert("finer grid is more accurate", error.declination_rms < error_embedded.declination_rms);
+	ut_assert("declination error", error.declination_max < 0.5f);
+	ut_assert("inclination error", error.inclination_max < 0.5f);
+	ut_assert("intensity error", error.intensity_max < 0.002f);
+#endif
+
+	return true;
+}
+
+bool AutoDeclinationTest::benchmark(void)
+{
+	static constexpr unsigned NUM_LOOKUPS = 10000;
+	float sum = 0.0f;
+
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < NUM_LOOKUPS; i++) {
+		const float lat = -80.0f + 160.0f * i / NUM_LOOKUPS;
+		const float lon = -180.0f + 360.0f * ((i * 7919) % NUM_LOOKUPS) / NUM_LOOKUPS;
+		sum += get_mag_declination(lat, lon) + get_mag_inclination(lat, lon) + get_mag_strength(lat, lon);
+	}
+
+	hrt_abstime elapsed = hrt_absolute_time() - start;
+
+	PX4_INFO("declination + inclination + intensity lookup: %.3f us (%.1f)", (double)elapsed / NUM_LOOKUPS,
+		 (double)sum);
 
 	return true;
 }
@@ -31,6 +390,9 @@ bool AutoDeclinationTest::autodeclination_check(void)
 bool AutoDeclinationTest::run_tests(void)
 {
 	ut_run_test(autodeclination_check);
+	ut_run_test(embedded_grid_accuracy);
+	ut_run_test(grid_file_check);
+	ut_run_test(benchmark);
 
 	return (_tests_failed == 0);
 }
@@ -45,6 +45,8 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <systemlib/err.h>
 #include <systemlib/bson/tinybson.h>
@@ -57,7 +59,8 @@ static const int64_t sample_big_int = (int64_t)INT_MAX + 123LL;
 static const double sample_double = 2.5f;
 static const char *sample_string = "this is a test";
 static const uint8_t sample_data[256] = {0};
-//static const char *sample_filename = "/fs/microsd/bson.test";
+static const char *sample_filename = PX4_ROOTFSDIR"/fs/microsd/bson.test";
+static const uint8_t sample_trailer = 0x5a;
 
 static int
 encode(bson_encoder_t encoder)
@@ -102,6 +105,11 @@ decode_callback(bson_decoder_t decoder, void *private, bson_node_t node)
 {
 	unsigned len;
 
+	if (private != NULL) {
+		/* count the nodes */
+		(*(int *)private)++;
+	}
+
 	if (!strcmp(node->name, "bool1")) {
 		if (node->type != BSON_BOOL) {
 			PX4_ERR("FAIL: decoder: bool1 type %d, expected %d", node->type, BSON_BOOL);
@@ -259,6 +267,64 @@ decode(bson_decoder_t decoder)
 	} while (result > 0);
 }
 
+/**
+ * Decode a document from a file, followed by a trailer byte that the
+ * decoder must leave in the file.
+ */
+static int
+decode_file(const void *buf, int len)
+{
+	struct bson_encoder_s encoder;
+	struct bson_decoder_s decoder;
+	int count = 0;
+	uint8_t trailer = 0;
+
+	int fd = open(sample_filename, O_RDWR | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("FAIL: open %s", sample_filename);
+		return 1;
+	}
+
+	if (buf != NULL) {
+		/* a document encoded in memory, which has its length set */
+		write(fd, buf, len);
+
+	} else {
+		/* a document encoded to a file has no length */
+		bson_encoder_init_file(&encoder, fd);
+		encode(&encoder);
+	}
+
+	write(fd, &sample_trailer, sizeof(sample_trailer));
+	lseek(fd, 0, SEEK_SET);
+
+	if (bson_decoder_init_file(&decoder, fd, decode_callback, &count)) {
+		PX4_ERR("FAIL: bson_decoder_init_file");
+		close(fd);
+		return 1;
+	}
+
+	decode(&decoder);
+
+	int ret = read(fd, &trailer, sizeof(trailer));
+	close(fd);
+	unlink(sample_filename);
+
+	/* 6 nodes and EOO */
+	if (count != 7) {
+		PX4_ERR("FAIL: decoder: %d nodes from file, expected 7", count);
+		return 1;
+	}
+
+	if (ret != sizeof(trailer) || trailer != sample_trailer) {
+		PX4_ERR("FAIL: decoder: file not positioned after the document");
+		return 1;
+	}
+
+	return 0;
+}
+
 int
 test_bson(int argc, char *argv[])
 {
@@ -295,6 +361,13 @@ test_bson(int argc, char *argv[])
 	}
 
 	decode(&decoder);
+
+	/* and from files, with and without document length */
+	if (decode_file(buf, len) || decode_file(NULL, 0)) {
+		free(buf);
+		return 1;
+	}
+
 	free(buf);
 
 	return PX4_OK;
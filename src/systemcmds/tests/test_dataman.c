@@ -43,6 +43,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -151,11 +152,63 @@ fail:
 	return -1;
 }
 
+/*
+ * Time writes and reads through the running data manager backend. Run it once after
+ * "dataman start -f <file>" (memory mapped on POSIX) and once after "dataman start -f <file> -s"
+ * (seek based file I/O) or "dataman start -r" (RAM) to compare the backends.
+ */
+static int
+benchmark(unsigned rounds)
+{
+	char buffer[DM_MAX_DATA_SIZE];
+	hrt_abstime wtime = 0, rtime = 0;
+	const unsigned len = DM_MAX_DATA_SIZE / 2;
+
+	memset(buffer, 0x55, sizeof(buffer));
+
+	for (unsigned r = 0; r < rounds; r++) {
+		hrt_abstime start = hrt_absolute_time();
+
+		for (unsigned i = 0; i < NUM_MISSIONS_SUPPORTED; i++) {
+			buffer[0] = i;
+
+			if (dm_write(DM_KEY_WAYPOINTS_OFFBOARD_1, i, DM_PERSIST_IN_FLIGHT_RESET, buffer, len) != len) {
+				warnx("bench write failed, index %d", i);
+				return -1;
+			}
+		}
+
+		hrt_abstime mid = hrt_absolute_time();
+
+		for (unsigned i = 0; i < NUM_MISSIONS_SUPPORTED; i++) {
+			if (dm_read(DM_KEY_WAYPOINTS_OFFBOARD_1, i, buffer, sizeof(buffer)) != len ||
+			    buffer[0] != (char)i) {
+				warnx("bench read failed, index %d", i);
+				return -1;
+			}
+		}
+
+		wtime += mid - start;
+		rtime += hrt_absolute_time() - mid;
+	}
+
+	const unsigned ops = rounds * NUM_MISSIONS_SUPPORTED;
+	warnx("Bench %u ops of %u bytes, write %lluus/op, read %lluus/op",
+	      ops, len, (unsigned long long)(wtime / ops), (unsigned long long)(rtime / ops));
+
+	dm_clear(DM_KEY_WAYPOINTS_OFFBOARD_1);
+	return 0;
+}
+
 int test_dataman(int argc, char *argv[])
 {
 	int i, num_tasks = 4;
 	char buffer[DM_MAX_DATA_SIZE];
 
+	if (argc > 1 && !strcmp(argv[1], "bench")) {
+		return benchmark((argc > 2) ? atoi(argv[2]) : 10);
+	}
+
 	if (argc > 1) {
 		num_tasks = atoi(argv[1]);
 	}
@@ -198,6 +251,14 @@ int test_dataman(int argc, char *argv[])
 
 	}
 
+	/* slot IDs from topics are not trusted, out of range ones must not alias other item types */
+	if (DM_KEY_WAYPOINTS_OFFBOARD(-1) != DM_KEY_NUM_KEYS ||
+	    DM_KEY_WAYPOINTS_OFFBOARD(DM_NUM_OFFBOARD_MISSIONS) != DM_KEY_NUM_KEYS ||
+	    dm_read(DM_KEY_WAYPOINTS_OFFBOARD(-1), 0, buffer, sizeof(buffer)) >= 0) {
+		warnx("invalid offboard slot accepted");
+		return -1;
+	}
+
 	dm_restart(DM_INIT_REASON_POWER_ON);
 
 	for (i = 0; i < NUM_MISSIONS_SUPPORTED; i++) {
@@ -0,0 +1,337 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2017 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_flashfs.c
+ *
+ * Power loss test of the flash parameter store on RAM backed sectors, and
+ * of flash_param_save() on top of it.
+ */
+
+#include <px4_defines.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include <systemlib/err.h>
+#include <systemlib/param/param.h>
+#include <systemlib/flashparams/flashfs.h>
+#include <systemlib/flashparams/flashparams.h>
+
+#include "tests_main.h"
+
+#define FLASHFS_TEST_SECTOR_SIZE 1024
+#define FLASHFS_TEST_VALUES 32
+#define FLASHFS_TEST_SAVES 3000
+
+/* all parameters of a SITL airframe have to fit into a full write */
+#define FLASHFS_PARAM_SECTOR_SIZE 16384
+
+/**
+ * @group Testing
+ */
+PARAM_DEFINE_INT32(TEST_FLASHFS, 0);
+
+static uint32_t test_sectors[2][FLASHFS_TEST_SECTOR_SIZE / sizeof(uint32_t)];
+
+static sector_descriptor_t test_sector_map[3];
+
+static uint32_t param_sectors[2][FLASHFS_PARAM_SECTOR_SIZE / sizeof(uint32_t)];
+
+static sector_descriptor_t param_sector_map[3];
+
+/** a change in a delta record */
+struct test_delta_s {
+	uint16_t index;
+	uint32_t value;
+};
+
+/**
+ * Reconstruct the values from the complete record and the delta records.
+ */
+static void
+load(uint32_t *values)
+{
+	uint8_t *buffer = NULL;
+	size_t buf_size;
+
+	memset(values, 0, FLASHFS_TEST_VALUES * sizeof(uint32_t));
+
+	if (parameter_flashfs_read(parameters_token, &buffer, &buf_size) == FLASHFS_TEST_VALUES * sizeof(uint32_t)) {
+		memcpy(values, buffer, buf_size);
+	}
+
+	buffer = NULL;
+
+	while (parameter_flashfs_read_delta(parameters_token, &buffer, &buf_size) >= 0) {
+		for (size_t i = 0; i + sizeof(struct test_delta_s) <= buf_size; i += sizeof(struct test_delta_s)) {
+			struct test_delta_s d;
+			memcpy(&d, &buffer[i], sizeof(d));
+
+			if (d.index < FLASHFS_TEST_VALUES) {
+				values[d.index] = d.value;
+			}
+		}
+	}
+}
+
+/**
+ * Save like flash_param_save(): append the changes, write everything if
+ * that is not possible.
+ *
+ * @return 1 if all values were written, 0 for a delta record, -1 on error
+ */
+static int
+save(const uint32_t *values, const struct test_delta_s *changes, unsigned num_changes)
+{
+	uint8_t *buffer;
+	size_t buf_size = num_changes * sizeof(struct test_delta_s);
+
+	if (parameter_flashfs_alloc(parameters_token, &buffer, &buf_size) == 0) {
+		memcpy(buffer, changes, num_changes * sizeof(struct test_delta_s));
+		int result = parameter_flashfs_append(parameters_token, buffer, num_changes * sizeof(struct test_delta_s));
+		parameter_flashfs_free();
+
+		if (result >= 0) {
+			return 0;
+		}
+
+		if (result != -ENOSPC && result != -ENOENT) {
+			return -1;
+		}
+	}
+
+	buf_size = FLASHFS_TEST_VALUES * sizeof(uint32_t);
+
+	if (parameter_flashfs_alloc(parameters_token, &buffer, &buf_size) != 0) {
+		return -1;
+	}
+
+	memcpy(buffer, values, FLASHFS_TEST_VALUES * sizeof(uint32_t));
+	int result = parameter_flashfs_write(parameters_token, buffer, FLASHFS_TEST_VALUES * sizeof(uint32_t));
+	parameter_flashfs_free();
+
+	return result < 0 ? -1 : 1;
+}
+
+/**
+ * flash_param_save() appends the changed values as a delta record and falls
+ * back to writing all of them. A value that neither write stored must be
+ * part of the next save.
+ */
+static int
+test_flash_param_save(void)
+{
+	param_t param = param_find("TEST_FLASHFS");
+	int32_t value = 1;
+	uint8_t *buffer;
+	uint8_t *delta = NULL;
+	size_t buf_size;
+	int result = 0;
+
+	for (int s = 0; s < 2; s++) {
+		param_sector_map[s].page = s + 1;
+		param_sector_map[s].size = FLASHFS_PARAM_SECTOR_SIZE;
+		param_sector_map[s].address = (uintptr_t)param_sectors[s];
+	}
+
+	memset(&param_sector_map[2], 0, sizeof(param_sector_map[2]));
+	memset(param_sectors, 0xff, sizeof(param_sectors));
+
+	parameter_flashfs_power_cut(-1);
+	param_set_no_notification(param, &value);
+
+	/* nothing to append to, all values are written */
+	if (parameter_flashfs_init(param_sector_map, NULL, 0) < 0 || flash_param_save() != 0
+	    || parameter_flashfs_read(parameters_token, &buffer, &buf_size) < 0
+	    || parameter_flashfs_read_delta(parameters_token, &delta, &buf_size) >= 0) {
+		warnx("FAIL: flash_param_save: complete write");
+		return 1;
+	}
+
+	/* a single change is appended */
+	delta = NULL;
+	value = 2;
+	param_set_no_notification(param, &value);
+
+	if (flash_param_save() != 0 || parameter_flashfs_read_delta(parameters_token, &delta, &buf_size) < 0) {
+		warnx("FAIL: flash_param_save: delta record");
+		return 1;
+	}
+
+	/* the delta record and the complete write it falls back to fail */
+	value = 3;
+	param_set_no_notification(param, &value);
+	parameter_flashfs_write_error(true);
+
+	if (flash_param_save() == 0) {
+		warnx("FAIL: flash_param_save: write error not reported");
+		result = 1;
+	}
+
+	parameter_flashfs_write_error(false);
+
+	/* the value is still unsaved and goes into the next delta record */
+	value = 0;
+
+	if (result == 0 && (flash_param_save() != 0 || flash_param_load() != 0
+			    || param_get(param, &value) != 0 || value != 3)) {
+		warnx("FAIL: flash_param_save: value lost after a failed write (%d)", (int)value);
+		result = 1;
+	}
+
+	/* delta records are appended until the sector is full, then all values are written */
+	for (int32_t n = 4; result == 0; n++) {
+		param_set_no_notification(param, &n);
+		delta = NULL;
+
+		if (flash_param_save() != 0 || n > 100000) {
+			warnx("FAIL: flash_param_save: delta %d", (int)n);
+			result = 1;
+
+		} else if (parameter_flashfs_read_delta(parameters_token, &delta, &buf_size) < 0) {
+			if (flash_param_load() != 0 || param_get(param, &value) != 0 || value != n) {
+				warnx("FAIL: flash_param_save: complete write after %d deltas", (int)n);
+				result = 1;
+			}
+
+			break;
+		}
+	}
+
+	value = 0;
+	param_set_no_notification(param, &value);
+
+	return result;
+}
+
+int
+test_flashfs(int argc, char *argv[])
+{
+	uint32_t saved[FLASHFS_TEST_VALUES];
+	uint32_t values[FLASHFS_TEST_VALUES];
+	uint32_t loaded[FLASHFS_TEST_VALUES];
+	unsigned full_writes = 0;
+	unsigned power_cuts = 0;
+
+	for (int s = 0; s < 2; s++) {
+		test_sector_map[s].page = s + 1;
+		test_sector_map[s].size = FLASHFS_TEST_SECTOR_SIZE;
+		test_sector_map[s].address = (uintptr_t)test_sectors[s];
+	}
+
+	memset(&test_sector_map[2], 0, sizeof(test_sector_map[2]));
+	memset(test_sectors, 0xff, sizeof(test_sectors));
+	srand(1234);
+
+	parameter_flashfs_power_cut(-1);
+
+	if (parameter_flashfs_init(test_sector_map, NULL, 0) < 0) {
+		warnx("FAIL: init");
+		return 1;
+	}
+
+	load(saved);
+
+	for (unsigned n = 0; n < FLASHFS_TEST_SAVES; n++) {
+		struct test_delta_s changes[3];
+		unsigned num_changes = 1 + rand() % 3;
+
+		memcpy(values, saved, sizeof(values));
+
+		for (unsigned i = 0; i < num_changes; i++) {
+			changes[i].index = rand() % FLASHFS_TEST_VALUES;
+			changes[i].value = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+			values[changes[i].index] = changes[i].value;
+		}
+
+		/* cut the power somewhere in every 4th save, or while recovering from it */
+		bool cut = rand() % 4 == 0;
+		parameter_flashfs_power_cut(cut ? rand() % (FLASHFS_TEST_SECTOR_SIZE + 200) : -1);
+
+		int result = save(values, changes, num_changes);
+
+		if (result < 0 && parameter_flashfs_powered()) {
+			warnx("FAIL: save %u", n);
+			return 1;
+		}
+
+		full_writes += result > 0;
+
+		if (!parameter_flashfs_powered()) {
+			/* reboot, possibly with another power loss while completing the write */
+			power_cuts++;
+			parameter_flashfs_power_cut(rand() % 2 ? rand() % 8 : -1);
+			parameter_flashfs_init(test_sector_map, NULL, 0);
+			parameter_flashfs_power_cut(-1);
+			parameter_flashfs_init(test_sector_map, NULL, 0);
+
+			load(loaded);
+
+			/* either the save happened or it did not */
+			if (memcmp(loaded, saved, sizeof(loaded)) != 0 && memcmp(loaded, values, sizeof(loaded)) != 0) {
+				warnx("FAIL: save %u: values corrupted by a power loss", n);
+				return 1;
+			}
+
+			memcpy(saved, loaded, sizeof(saved));
+			continue;
+		}
+
+		parameter_flashfs_power_cut(-1);
+
+		if (cut || rand() % 16 == 0) {
+			parameter_flashfs_init(test_sector_map, NULL, 0);
+		}
+
+		load(loaded);
+
+		if (memcmp(loaded, values, sizeof(loaded)) != 0) {
+			warnx("FAIL: save %u: values not saved", n);
+			return 1;
+		}
+
+		memcpy(saved, values, sizeof(saved));
+	}
+
+	warnx("%u saves: %u complete writes, %u power losses", FLASHFS_TEST_SAVES, full_writes, power_cuts);
+
+	if (test_flash_param_save() != 0) {
+		return 1;
+	}
+
+	warnx("flashfs test PASS");
+
+	return 0;
+}
@@ -0,0 +1,210 @@
+#include <unit_test/unit_test.h>
+
+#include <drivers/drv_hrt.h>
+#include <geo/geo.h>
+#include <px4_log.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+class GeoTest : public UnitTest
+{
+public:
+	virtual bool run_tests(void);
+
+private:
+	static constexpr unsigned NUM_POINTS = 256;
+	static constexpr unsigned NUM_RUNS = 20;
+
+	bool project_batch_check();
+	bool waypoint_batch_check();
+	bool benchmark();
+
+	void generate_points(double lat_0, double lon_0, double extent_deg);
+
+	double _lat[NUM_POINTS];
+	double _lon[NUM_POINTS];
+	float _x[NUM_POINTS];
+	float _y[NUM_POINTS];
+	float _out[NUM_POINTS];
+};
+
+static const double test_refs[][2] = {
+	{ 47.397742, 8.545594 },	// Zurich
+	{ -33.868820, 151.209296 },	// Sydney
+	{ 78.223172, 15.626723 },	// Svalbard
+	{ 0.000000, 179.990000 },	// antimeridian, exercises the fallback
+};
+
+void GeoTest::generate_points(double lat_0, double lon_0, double extent_deg)
+{
+	for (unsigned i = 0; i < NUM_POINTS; i++) {
+		_lat[i] = lat_0 + extent_deg * ((double)rand() / RAND_MAX - 0.5);
+		_lon[i] = lon_0 + extent_deg * ((double)rand() / RAND_MAX - 0.5);
+	}
+}
+
+bool GeoTest::project_batch_check(void)
+{
+	struct map_projection_reference_s ref;
+
+	for (unsigned r = 0; r < sizeof(test_refs) / sizeof(test_refs[0]); r++) {
+		map_projection_init(&ref, test_refs[r][0], test_refs[r][1]);
+
+		for (double extent = 0.1; extent < 20.0; extent *= 10.0) {
+			generate_points(test_refs[r][0], test_refs[r][1], extent);
+
+			ut_assert("project_n failed", map_projection_project_n(&ref, _lat, _lon, _x, _y, NUM_POINTS) == 0);
+
+			float err_max = 0.0f;
+
+			for (unsigned i = 0; i < NUM_POINTS; i++) {
+				float x, y;
+				map_projection_project(&ref, _lat[i], _lon[i], &x, &y);
+				err_max = fmaxf(err_max, fabsf(x - _x[i]) + fabsf(y - _y[i]));
+			}
+
+			ut_assert("project_n differs from project", err_max < 1e-6f);
+
+			ut_assert("project_n_fast failed", map_projection_project_n_fast(&ref, _lat, _lon, _x, _y, NUM_POINTS) == 0);
+
+			err_max = 0.0f;
+
+			for (unsigned i = 0; i < NUM_POINTS; i++) {
+				float x, y;
+				map_projection_project(&ref, _lat[i], _lon[i], &x, &y);
+				err_max = fmaxf(err_max, sqrtf((x - _x[i]) * (x - _x[i]) + (y - _y[i]) * (y - _y[i])));
+			}
+
+			PX4_INFO("project_n_fast ref %u extent %.1f deg: max error %.4f m", r, extent, (double)err_max);
+
+			/* float rounding of the output dominates, about 1e-7 relative to the extent */
+			ut_assert("project_n_fast error too large", err_max < 0.05f + 3e-7f * (float)(extent * 111e3));
+
+			double lat[NUM_POINTS];
+			double lon[NUM_POINTS];
+			ut_assert("reproject_n failed", map_projection_reproject_n(&ref, _x, _y, lat, lon, NUM_POINTS) == 0);
+
+			for (unsigned i = 0; i < NUM_POINTS; i++) {
+				ut_assert("reproject_n round trip", get_distance_to_next_waypoint(lat[i], lon[i], _lat[i], _lon[i]) < 1.0f);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool GeoTest::waypoint_batch_check(void)
+{
+	struct map_projection_reference_s ref;
+
+	for (unsigned r = 0; r < sizeof(test_refs) / sizeof(test_refs[0]); r++) {
+		map_projection_init(&ref, test_refs[r][0], test_refs[r][1]);
+
+		for (double extent = 0.1; extent < 20.0; extent *= 10.0) {
+			generate_points(test_refs[r][0], test_refs[r][1], extent);
+
+			ut_assert("distance_n failed", get_distance_to_next_waypoint_n(&ref, _lat, _lon, _out, NUM_POINTS) == 0);
+
+			float err_max = 0.0f;
+
+			for (unsigned i = 0; i < NUM_POINTS; i++) {
+				float dist = get_distance_to_next_waypoint(test_refs[r][0], test_refs[r][1], _lat[i], _lon[i]);
+				err_max = fmaxf(err_max, fabsf(dist - _out[i]));
+			}
+
+			PX4_INFO("distance_n ref %u extent %.1f deg: max error %.4f m", r, extent, (double)err_max);
+			ut_assert("distance_n error too large", err_max < 0.05f + 3e-7f * (float)(extent * 111e3));
+
+			ut_assert("bearing_n failed", get_bearing_to_next_waypoint_n(&ref, _lat, _lon, _out, NUM_POINTS) == 0);
+
+			err_max = 0.0f;
+
+			for (unsigned i = 0; i < NUM_POINTS; i++) {
+				float bearing = get_bearing_to_next_waypoint(test_refs[r][0], test_refs[r][1], _lat[i], _lon[i]);
+				err_max = fmaxf(err_max, fabsf(_wrap_pi(bearing - _out[i])));
+			}
+
+			ut_assert("bearing_n error too large", err_max < 1e-5f);
+		}
+	}
+
+	return true;
+}
+
+bool GeoTest::benchmark(void)
+{
+	struct map_projection_reference_s ref;
+	map_projection_init(&ref, test_refs[0][0], test_refs[0][1]);
+
+	/* typical mission extent */
+	generate_points(test_refs[0][0], test_refs[0][1], 0.05);
+
+	hrt_abstime t0 = hrt_absolute_time();
+
+	for (unsigned run = 0; run < NUM_RUNS; run++) {
+		for (unsigned i = 0; i < NUM_POINTS; i++) {
+			map_projection_project(&ref, _lat[i], _lon[i], &_x[i], &_y[i]);
+		}
+	}
+
+	hrt_abstime t1 = hrt_absolute_time();
+
+	for (unsigned run = 0; run < NUM_RUNS; run++) {
+		map_projection_project_n_fast(&ref, _lat, _lon, _x, _y, NUM_POINTS);
+	}
+
+	hrt_abstime t2 = hrt_absolute_time();
+
+	for (unsigned run = 0; run < NUM_RUNS; run++) {
+		for (unsigned i = 0; i < NUM_POINTS; i++) {
+			_out[i] = get_distance_to_next_waypoint(test_refs[0][0], test_refs[0][1], _lat[i], _lon[i]);
+		}
+	}
+
+	hrt_abstime t3 = hrt_absolute_time();
+
+	for (unsigned run = 0; run < NUM_RUNS; run++) {
+		get_distance_to_next_waypoint_n(&ref, _lat, _lon, _out, NUM_POINTS);
+	}
+
+	hrt_abstime t4 = hrt_absolute_time();
+
+	for (unsigned run = 0; run < NUM_RUNS; run++) {
+		for (unsigned i = 0; i < NUM_POINTS; i++) {
+			_out[i] = get_bearing_to_next_waypoint(test_refs[0][0], test_refs[0][1], _lat[i], _lon[i]);
+		}
+	}
+
+	hrt_abstime t5 = hrt_absolute_time();
+
+	for (unsigned run = 0; run < NUM_RUNS; run++) {
+		get_bearing_to_next_waypoint_n(&ref, _lat, _lon, _out, NUM_POINTS);
+	}
+
+	hrt_abstime t6 = hrt_absolute_time();
+
+	const double n = NUM_RUNS * NUM_POINTS;
+	PX4_INFO("map_projection_project:          %.3f us/point", (double)(t1 - t0) / n);
+	PX4_INFO("map_projection_project_n_fast:   %.3f us/point", (double)(t2 - t1) / n);
+	PX4_INFO("get_distance_to_next_waypoint:   %.3f us/point", (double)(t3 - t2) / n);
+	PX4_INFO("get_distance_to_next_waypoint_n: %.3f us/point", (double)(t4 - t3) / n);
+	PX4_INFO("get_bearing_to_next_waypoint:    %.3f us/point", (double)(t5 - t4) / n);
+	PX4_INFO("get_bearing_to_next_waypoint_n:  %.3f us/point", (double)(t6 - t5) / n);
+
+	return true;
+}
+
+bool GeoTest::run_tests(void)
+{
+	ut_run_test(project_batch_check);
+	ut_run_test(waypoint_batch_check);
+	ut_run_test(benchmark);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_geo, GeoTest)
@@ -0,0 +1,342 @@
+#include <unit_test/unit_test.h>
+
+#include <drivers/drv_hrt.h>
+#include <geo/geo.h>
+#include <geofence/geofence_zones.h>
+#include <px4_log.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+class GeofenceTest : public UnitTest
+{
+public:
+	virtual bool run_tests(void);
+
+private:
+#ifdef __PX4_NUTTX
+	static constexpr unsigned MAX_TEST_VERTICES = 2000;
+#else
+	static constexpr unsigned MAX_TEST_VERTICES = 10000;
+#endif
+	static constexpr unsigned NUM_QUERIES = 1000;
+
+	bool single_polygon_check();
+	bool multi_zone_check();
+	bool breach_prediction_check();
+	bool scaling_benchmark();
+
+	/* star shaped random polygons around the test location, zone 0 is a large inclusion zone */
+	void generate_zones(unsigned num_zones, unsigned vertices_per_zone);
+	bool brute_force_inside(double lat, double lon);
+	void generate_queries();
+
+	GeofenceZones _zones;
+
+	/* vertex offsets to the test location in degrees */
+	float _lat[MAX_TEST_VERTICES];
+	float _lon[MAX_TEST_VERTICES];
+	unsigned _zone_start[GeofenceZones::MAX_ZONES + 1];
+	uint8_t _zone_type[GeofenceZones::MAX_ZONES];
+	unsigned _num_zones;
+
+	double _query_lat[NUM_QUERIES];
+	double _query_lon[NUM_QUERIES];
+};
+
+static constexpr double test_lat = 47.397742;
+static constexpr double test_lon = 8.545594;
+
+static double rand_uniform()
+{
+	return (double)rand() / RAND_MAX;
+}
+
+void GeofenceTest::generate_zones(unsigned num_zones, unsigned vertices_per_zone)
+{
+	srand(42);
+
+	_zones.clear();
+	_num_zones = num_zones;
+	unsigned v = 0;
+
+	for (unsigned z = 0; z < num_zones; z++) {
+		const bool outer = (z == 0);
+		const double center_lat = outer ? 0.0 : 0.05 * (rand_uniform() - 0.5);
+		const double center_lon = outer ? 0.0 : 0.07 * (rand_uniform() - 0.5);
+		const double radius = outer ? 0.04 : 0.002 + 0.008 * rand_uniform();
+
+		_zone_type[z] = (outer || rand() % 3 == 0) ? GeofenceZones::ZONE_INCLUSION : GeofenceZones::ZONE_EXCLUSION;
+		_zone_start[z] = v;
+		_zones.begin_zone((GeofenceZones::ZoneType)_zone_type[z]);
+
+		for (unsigned i = 0; i < vertices_per_zone; i++, v++) {
+			const double angle = 2.0 * M_PI * i / vertices_per_zone;
+			const double r = radius * (0.6 + 0.4 * rand_uniform());
+			_lat[v] = center_lat + r * cos(angle);
+			_lon[v] = center_lon + r * sin(angle) / cos(test_lat * M_DEG_TO_RAD);
+			_zones.add_vertex(test_lat + _lat[v], test_lon + _lon[v]);
+		}
+
+		_zones.end_zone();
+	}
+
+	_zone_start[num_zones] = v;
+}
+
+void GeofenceTest::generate_queries()
+{
+	for (unsigned i = 0; i < NUM_QUERIES; i++) {
+		_query_lat[i] = test_lat + 0.1 * (rand_uniform() - 0.5);
+		_query_lon[i] = test_lon + 0.15 * (rand_uniform() - 0.5);
+	}
+}
+
+bool GeofenceTest::brute_force_inside(double lat, double lon)
+{
+	lat -= test_lat;
+	lon -= test_lon;
+
+	bool included = false;
+	bool excluded = false;
+	bool have_inclusion = false;
+
+	for (unsigned z = 0; z < _num_zones; z++) {
+		/* PNPOLY, as the previous single polygon geofence */
+		bool c = false;
+
+		for (unsigned i = _zone_start[z], j = _zone_start[z + 1] - 1; i < _zone_start[z + 1]; j = i++) {
+			if ((_lon[i] >= lon) != (_lon[j] >= lon) &&
+			    (lat <= (_lat[j] - _lat[i]) * (lon - _lon[i]) / (_lon[j] - _lon[i]) + _lat[i])) {
+				c = !c;
+			}
+		}
+
+		if (_zone_type[z] == GeofenceZones::ZONE_INCLUSION) {
+			have_inclusion = true;
+			included |= c;
+
+		} else {
+			excluded |= c;
+		}
+	}
+
+	return (included || !have_inclusion) && !excluded;
+}
+
+bool GeofenceTest::single_polygon_check()
+{
+	_zones.clear();
+	ut_assert("empty zones accept everything", _zones.inside(test_lat, test_lon));
+
+	/* square of about 222 m around the test location */
+	_zones.begin_zone(GeofenceZones::ZONE_INCLUSION);
+	_zones.add_vertex(test_lat - 0.001, test_lon - 0.0015);
+	_zones.add_vertex(test_lat + 0.001, test_lon - 0.0015);
+	_zones.add_vertex(test_lat + 0.001, test_lon + 0.0015);
+	_zones.add_vertex(test_lat - 0.001, test_lon + 0.0015);
+	ut_assert("zone complete", _zones.end_zone() == 0);
+	ut_assert("build", _zones.build() == 0);
+
+	ut_assert("center inside", _zones.inside(test_lat, test_lon));
+	ut_assert("north outside", !_zones.inside(test_lat + 0.002, test_lon));
+	ut_assert("east outside", !_zones.inside(test_lat, test_lon + 0.003));
+
+	float dist = _zones.distance_to_boundary(test_lat, test_lon, 1000.0f);
+	ut_assert("distance to the closest (north/south) edge", fabsf(dist - 111.2f) < 1.0f);
+
+	dist = _zones.distance_to_boundary(test_lat + 0.01, test_lon, 100.0f);
+	ut_assert("distance capped at the search radius", fabsf(dist - 100.0f) < 0.001f);
+
+	/* a zone with less than 3 vertices is rejected */
+	_zones.begin_zone(GeofenceZones::ZONE_EXCLUSION);
+	_zones.add_vertex(test_lat, test_lon);
+	_zones.add_vertex(test_lat + 0.001, test_lon);
+	ut_assert("degenerate zone dropped", _zones.end_zone() != 0);
+	ut_compare("zone count", _zones.zone_count(), 1);
+
+	return true;
+}
+
+bool GeofenceTest::multi_zone_check()
+{
+	generate_zones(20, 100);
+	ut_assert("build", _zones.build() == 0);
+	generate_queries();
+
+	unsigned mismatches = 0;
+
+	for (unsigned i = 0; i < NUM_QUERIES; i++) {
+		if (_zones.inside(_query_lat[i], _query_lon[i]) != brute_force_inside(_query_lat[i], _query_lon[i])) {
+			/* the index works on projected straight edges, the reference on lat/lon straight
+			 * edges, which may only disagree right at the boundary */
+			if (_zones.distance_to_boundary(_query_lat[i], _query_lon[i], 10.0f) > 0.5f) {
+				mismatches++;
+			}
+		}
+	}
+
+	ut_compare("containment differs from brute force", mismatches, 0);
+
+	return true;
+}
+
+bool GeofenceTest::breach_prediction_check()
+{
+	generate_zones(20, 100);
+	ut_assert("build", _zones.build() == 0);
+	generate_queries();
+
+	static constexpr unsigned NUM_SAMPLES = 400;
+	const struct map_projection_reference_s &ref = _zones.reference();
+	unsigned mismatches = 0;
+
+	for (unsigned i = 0; i + 1 < NUM_QUERIES; i++) {
+		float x0, y0, x1, y1;
+		map_projection_project(&ref, _query_lat[i], _query_lon[i], &x0, &y0);
+		map_projection_project(&ref, _query_lat[i + 1], _query_lon[i + 1], &x1, &y1);
+
+		/* shorten to a look-ahead like path of up to 500 m */
+		const float length = sqrtf((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0));
+
+		if (length > 500.0f) {
+			x1 = x0 + (x1 - x0) * 500.0f / length;
+			y1 = y0 + (y1 - y0) * 500.0f / length;
+		}
+
+		const float t = _zones.first_breach_local(x0, y0, x1, y1);
+
+		/* reference: walk along the path */
+		float t_walk = -1.0f;
+
+		for (unsigned k = 0; k <= NUM_SAMPLES; k++) {
+			const float tk = (float)k / NUM_SAMPLES;
+
+			if (!_zones.inside_local(x0 + tk * (x1 - x0), y0 + tk * (y1 - y0))) {
+				t_walk = tk;
+				break;
+			}
+		}
+
+		/* the walk can step over short excursions, but never find a breach before the exact one */
+		if (t_walk >= 0.0f && (t < 0.0f || t > t_walk + 1e-4f)) {
+			mismatches++;
+		}
+
+		/* and right after the exact breach the path is outside */
+		const float t_after = t + 1e-4f;
+
+		if (t > 0.0f && t_after <= 1.0f && _zones.inside_local(x0 + t_after * (x1 - x0), y0 + t_after * (y1 - y0))) {
+			mismatches++;
+		}
+	}
+
+	ut_compare("first breach differs from walking the path", mismatches, 0);
+
+	/* straight out of the outer inclusion zone */
+	_zones.clear();
+	_zones.begin_zone(GeofenceZones::ZONE_INCLUSION);
+	_zones.add_vertex(test_lat - 0.001, test_lon - 0.0015);
+	_zones.add_vertex(test_lat + 0.001, test_lon - 0.0015);
+	_zones.add_vertex(test_lat + 0.001, test_lon + 0.0015);
+	_zones.add_vertex(test_lat - 0.001, test_lon + 0.0015);
+	_zones.end_zone();
+	ut_assert("build", _zones.build() == 0);
+
+	const float t = _zones.first_breach(test_lat, test_lon, test_lat + 0.002, test_lon);
+	ut_assert("breach half way to the north", fabsf(t - 0.5f) < 0.01f);
+	ut_assert("no breach inside", _zones.first_breach(test_lat, test_lon, test_lat + 0.0005, test_lon) < 0.0f);
+
+	return true;
+}
+
+bool GeofenceTest::scaling_benchmark()
+{
+	static const unsigned zone_counts[] = { 1, 10, 20, 50 };
+	static const unsigned vertex_counts[] = { 16, 100, 200, 200 };
+
+	for (unsigned k = 0; k < sizeof(zone_counts) / sizeof(zone_counts[0]); k++) {
+		if (zone_counts[k] * vertex_counts[k] > MAX_TEST_VERTICES) {
+			continue;
+		}
+
+		generate_zones(zone_counts[k], vertex_counts[k]);
+
+		hrt_abstime t0 = hrt_absolute_time();
+		ut_assert("build", _zones.build() == 0);
+		hrt_abstime t1 = hrt_absolute_time();
+
+		generate_queries();
+
+		unsigned num_inside = 0;
+		unsigned num_inside_brute_force = 0;
+		hrt_abstime t2 = hrt_absolute_time();
+
+		for (unsigned i = 0; i < NUM_QUERIES; i++) {
+			num_inside += _zones.inside(_query_lat[i], _query_lon[i]);
+		}
+
+		hrt_abstime t3 = hrt_absolute_time();
+
+		for (unsigned i = 0; i < NUM_QUERIES; i++) {
+			num_inside_brute_force += brute_force_inside(_query_lat[i], _query_lon[i]);
+		}
+
+		hrt_abstime t4 = hrt_absolute_time();
+
+		for (unsigned i = 0; i < NUM_QUERIES; i++) {
+			_zones.distance_to_boundary(_query_lat[i], _query_lon[i], 500.0f);
+		}
+
+		hrt_abstime t5 = hrt_absolute_time();
+
+		/* 5 s look-ahead at 10 m/s, only the queries are timed */
+		unsigned num_breaches = 0;
+		hrt_abstime path_time = 0;
+
+		for (unsigned i = 0; i + 1 < NUM_QUERIES; i++) {
+			const float bearing = get_bearing_to_next_waypoint(_query_lat[i], _query_lon[i], _query_lat[i + 1],
+					      _query_lon[i + 1]);
+			double lat, lon;
+			waypoint_from_heading_and_distance(_query_lat[i], _query_lon[i], bearing, 50.0f, &lat, &lon);
+			hrt_abstime t_start = hrt_absolute_time();
+			num_breaches += _zones.first_breach(_query_lat[i], _query_lon[i], lat, lon) >= 0.0f;
+			path_time += hrt_absolute_time() - t_start;
+		}
+
+		hrt_abstime t6 = hrt_absolute_time();
+
+		/* full mission legs */
+		for (unsigned i = 0; i + 1 < NUM_QUERIES; i++) {
+			num_breaches += _zones.first_breach(_query_lat[i], _query_lon[i], _query_lat[i + 1], _query_lon[i + 1]) >= 0.0f;
+		}
+
+		hrt_abstime t7 = hrt_absolute_time();
+
+		PX4_INFO("%2u zones, %5u vertices: build %llu us, inside %.2f us (brute force %.2f us), distance %.2f us",
+			 _zones.zone_count(), _zones.vertex_count(), (unsigned long long)(t1 - t0),
+			 (double)(t3 - t2) / NUM_QUERIES, (double)(t4 - t3) / NUM_QUERIES, (double)(t5 - t4) / NUM_QUERIES);
+		PX4_INFO("%u of %u queries inside (brute force %u)", num_inside, NUM_QUERIES, num_inside_brute_force);
+		PX4_INFO("breach prediction: 50 m path %.2f us, leg between queries %.2f us, %u breaches",
+			 (double)path_time / NUM_QUERIES, (double)(t7 - t6) / NUM_QUERIES, num_breaches);
+	}
+
+	_zones.clear();
+
+	return true;
+}
+
+bool GeofenceTest::run_tests(void)
+{
+	ut_run_test(single_polygon_check);
+	ut_run_test(multi_zone_check);
+	ut_run_test(breach_prediction_check);
+	ut_run_test(scaling_benchmark);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_geofence, GeofenceTest)
@@ -38,19 +38,375 @@
  */
 
 #include <px4_defines.h>
+#include <px4_posix.h>
 #include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <drivers/drv_hrt.h>
 #include "systemlib/err.h"
 #include "systemlib/param/param.h"
+#include <crc32.h>
 #include "tests_main.h"
 
 #define PARAM_MAGIC1 12345678
 #define PARAM_MAGIC2 0xa5a5a5a5
 
+/* size of a typical saved parameter file */
+#define PARAM_BENCH_COUNT 600
+#define PARAM_BENCH_RUNS 5
+#define PARAM_BENCH_FILE PX4_ROOTFSDIR"/fs/microsd/param_bench.bson"
+#define PARAM_BACKUP_FILE PX4_ROOTFSDIR"/fs/microsd/param_backup.bson"
+
 /**
  * @group Testing
  */
 PARAM_DEFINE_INT32(TEST_PARAMS, 12345678);
 
+/**
+ * @group Testing
+ */
+PARAM_DEFINE_INT32(TEST_HASH_A, 0);
+
+/**
+ * @group Testing
+ */
+PARAM_DEFINE_FLOAT(TEST_HASH_B, 0.0f);
+
+/**
+ * @group Testing
+ */
+PARAM_DEFINE_INT32(TEST_HASH_C, 0);
+
+/**
+ * param_hash_check() as computed by a GCS over its parameter cache.
+ */
+static uint32_t
+param_hash_full(void)
+{
+	uint32_t hash = 0;
+
+	for (unsigned i = 0; i < param_count(); i++) {
+		param_t p = param_for_index(i);
+
+		if (!param_used(p)) {
+			continue;
+		}
+
+		const char *name = param_name(p);
+		int32_t val = 0;
+		param_get(p, &val);
+		hash = crc32part((const uint8_t *)name, strlen(name), hash);
+		hash = crc32part((const uint8_t *)&val, param_size(p), hash);
+	}
+
+	return hash;
+}
+
+/**
+ * Check the incrementally maintained parameter hash against a full
+ * recomputation over a sequence of sets and resets.
+ */
+static int
+param_hash_test(void)
+{
+	const char *names[] = { "TEST_PARAMS", "TEST_HASH_A", "TEST_HASH_B" };
+	const unsigned num_names = sizeof(names) / sizeof(names[0]);
+	param_t params[sizeof(names) / sizeof(names[0])];
+	int result = 0;
+
+	for (unsigned i = 0; i < num_names; i++) {
+		params[i] = param_find(names[i]);
+
+		if (params[i] == PARAM_INVALID) {
+			warnx("%s not found", names[i]);
+			return 1;
+		}
+	}
+
+	for (unsigned step = 0; step < 64 && result == 0; step++) {
+		param_t p = params[step % num_names];
+
+		if (step % 5 == 4) {
+			param_reset(p);
+
+		} else {
+			int32_t val = (int32_t)(step * 2654435761u);
+			param_set_no_notification(p, &val);
+		}
+
+		/* a newly used param changes the set of hashed params */
+		if (step == 32 && param_find("TEST_HASH_C") == PARAM_INVALID) {
+			warnx("TEST_HASH_C not found");
+			result = 1;
+		}
+
+		uint32_t hash = param_hash_check();
+		uint32_t expected = param_hash_full();
+
+		if (hash != expected) {
+			warnx("step %u: param hash 0x%08x, expected 0x%08x", step, hash, expected);
+			result = 1;
+		}
+	}
+
+	for (unsigned i = 0; i < num_names; i++) {
+		param_reset(params[i]);
+	}
+
+	if (result == 0 && param_hash_check() != param_hash_full()) {
+		warnx("param hash wrong after reset");
+		result = 1;
+	}
+
+	/* what a GCS heartbeat check costs */
+	hrt_abstime t0 = hrt_absolute_time();
+	uint32_t hash = 0;
+
+	for (unsigned i = 0; i < 100; i++) {
+		hash += param_hash_check();
+	}
+
+	hrt_abstime t1 = hrt_absolute_time();
+
+	warnx("param hash check %.3f us (0x%08x)", (double)(t1 - t0) / 100.0, hash);
+
+	return result;
+}
+
+/**
+ * Check the used index mapping against a walk over all params and time what
+ * a full parameter download by index costs.
+ */
+static int
+param_used_index_test(void)
+{
+	unsigned used_count = 0;
+
+	for (unsigned i = 0; i < param_count(); i++) {
+		param_t p = param_for_index(i);
+
+		if (!param_used(p)) {
+			if (param_get_used_index(p) != -1) {
+				warnx("unused parameter %s has a used index", param_name(p));
+				return 1;
+			}
+
+			continue;
+		}
+
+		if (param_get_used_index(p) != (int)used_count || param_for_used_index(used_count) != p) {
+			warnx("used index of %s wrong: %d, expected %u", param_name(p), param_get_used_index(p), used_count);
+			return 1;
+		}
+
+		used_count++;
+	}
+
+	if (param_count_used() != used_count || param_for_used_index(used_count) != PARAM_INVALID) {
+		warnx("used count %u, expected %u", param_count_used(), used_count);
+		return 1;
+	}
+
+	/* what MavlinkParametersManager does for every PARAM_VALUE */
+	hrt_abstime t0 = hrt_absolute_time();
+	int sum = 0;
+
+	for (unsigned i = 0; i < used_count; i++) {
+		param_t p = param_for_used_index(i);
+		sum += param_get_used_index(p) + param_count_used();
+	}
+
+	hrt_abstime t1 = hrt_absolute_time();
+
+	warnx("%u used params: download index lookups %.3f ms (%d)", used_count, (double)(t1 - t0) / 1e3, sum);
+
+	return 0;
+}
+
+/**
+ * Check that the modification epochs select exactly the params changed since
+ * a given epoch, as used for the delta download over MAVLink.
+ */
+static int
+param_epoch_test(void)
+{
+	param_t a = param_find("TEST_HASH_A");
+	param_t b = param_find("TEST_HASH_B");
+
+	if (a == PARAM_INVALID || b == PARAM_INVALID) {
+		warnx("epoch test parameters not found");
+		return 1;
+	}
+
+	int32_t val = 1;
+	float fval = 1.0f;
+	param_set_no_notification(a, &val);
+	param_set_no_notification(b, &fval);
+
+	const uint32_t epoch = param_epoch();
+
+	if (param_get_epoch(b) != epoch || param_get_epoch(a) >= epoch) {
+		warnx("epochs %u/%u, current %u", param_get_epoch(a), param_get_epoch(b), epoch);
+		return 1;
+	}
+
+	/* caches from other boots have a different nonce in the high bits */
+	if (!param_epoch_current_boot(epoch) || param_epoch_current_boot(0) ||
+	    param_epoch_current_boot(epoch + 1) || param_epoch_current_boot(epoch ^ 0x80000000u)) {
+		warnx("epoch %u not recognized as the current boot", epoch);
+		return 1;
+	}
+
+	/* setting the same value is not a modification */
+	param_set_no_notification(a, &val);
+
+	if (param_epoch() != epoch) {
+		warnx("epoch advanced without a change");
+		return 1;
+	}
+
+	val = 2;
+	param_set_no_notification(a, &val);
+
+	unsigned modified = 0;
+
+	for (unsigned i = 0; i < param_count(); i++) {
+		if (param_get_epoch(param_for_index(i)) > epoch) {
+			modified++;
+		}
+	}
+
+	if (modified != 1 || param_get_epoch(a) != param_epoch()) {
+		warnx("%u params modified since %u, expected 1", modified, epoch);
+		return 1;
+	}
+
+	param_reset(a);
+	param_reset(b);
+
+	if (param_get_epoch(b) != param_epoch() || param_epoch() != epoch + 3) {
+		warnx("reset did not advance the epoch");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int
+param_export_file(const char *filename)
+{
+	int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	int result = param_export(fd, false);
+	close(fd);
+	return result;
+}
+
+/**
+ * Time param_load() and param_import() of a file as written at boot with
+ * PARAM_BENCH_COUNT saved parameters.
+ */
+static int
+param_load_benchmark(void)
+{
+	int result = 1;
+	int fd;
+	unsigned num_params = param_count();
+
+	if (num_params > PARAM_BENCH_COUNT) {
+		num_params = PARAM_BENCH_COUNT;
+	}
+
+	/* keep the current values to restore them afterwards */
+	if (param_export_file(PARAM_BACKUP_FILE) != 0) {
+		warnx("failed to back up parameters");
+		return 1;
+	}
+
+	/* setting a parameter to its current value makes it a saved one without changing it */
+	for (unsigned i = 0; i < num_params; i++) {
+		param_t p = param_for_index(i);
+		union param_value_u val;
+
+		if (param_type(p) == PARAM_TYPE_INT32 || param_type(p) == PARAM_TYPE_FLOAT) {
+			param_get(p, &val);
+			param_set_no_notification(p, &val);
+		}
+	}
+
+	if (param_export_file(PARAM_BENCH_FILE) != 0) {
+		warnx("failed to write %s", PARAM_BENCH_FILE);
+		goto out;
+	}
+
+	fd = open(PARAM_BENCH_FILE, O_RDONLY);
+
+	if (fd < 0) {
+		warnx("failed to open %s", PARAM_BENCH_FILE);
+		goto out;
+	}
+
+	hrt_abstime time_load = 0;
+	hrt_abstime time_import = 0;
+
+	for (int run = 0; run < PARAM_BENCH_RUNS; run++) {
+		/* at boot: load into an empty parameter store */
+		lseek(fd, 0, SEEK_SET);
+		hrt_abstime t0 = hrt_absolute_time();
+		int ret = param_load(fd);
+		time_load += hrt_absolute_time() - t0;
+
+		/* param import: all parameters already have a saved value */
+		lseek(fd, 0, SEEK_SET);
+		t0 = hrt_absolute_time();
+		ret |= param_import(fd);
+		time_import += hrt_absolute_time() - t0;
+
+		if (ret != 0) {
+			warnx("param_load failed");
+			close(fd);
+			goto out;
+		}
+	}
+
+	close(fd);
+
+	warnx("%u params: param_load %.2f ms, param_import %.2f ms", num_params,
+	      (double)time_load / PARAM_BENCH_RUNS / 1e3, (double)time_import / PARAM_BENCH_RUNS / 1e3);
+
+	for (unsigned i = 0; i < num_params; i++) {
+		param_t p = param_for_index(i);
+
+		if ((param_type(p) == PARAM_TYPE_INT32 || param_type(p) == PARAM_TYPE_FLOAT) && param_value_is_default(p)) {
+			warnx("parameter %s not loaded", param_name(p));
+			goto out;
+		}
+	}
+
+	result = 0;
+
+out:
+	fd = open(PARAM_BACKUP_FILE, O_RDONLY);
+
+	if (fd < 0 || param_load(fd) != 0) {
+		warnx("failed to restore parameters");
+		result = 1;
+	}
+
+	if (fd >= 0) {
+		close(fd);
+	}
+
+	unlink(PARAM_BENCH_FILE);
+	unlink(PARAM_BACKUP_FILE);
+
+	return result;
+}
+
 int
 test_param(int argc, char *argv[])
 {
@@ -104,6 +460,22 @@ test_param(int argc, char *argv[])
 		return 1;
 	}
 
+	if (param_used_index_test() != 0) {
+		return 1;
+	}
+
+	if (param_hash_test() != 0) {
+		return 1;
+	}
+
+	if (param_epoch_test() != 0) {
+		return 1;
+	}
+
+	if (param_load_benchmark() != 0) {
+		return 1;
+	}
+
 	warnx("parameter test PASS");
 
 	return 0;
@@ -0,0 +1,308 @@
+#include <unit_test/unit_test.h>
+
+#include <drivers/drv_hrt.h>
+#include <terrain_database/terrain_database.h>
+#include <px4_defines.h>
+#include <px4_log.h>
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TERRAIN_TEST_DIR PX4_ROOTFSDIR"/fs/microsd/terrain_test"
+
+class TerrainTest : public UnitTest
+{
+public:
+	virtual bool run_tests(void);
+
+private:
+	/* 30 arc second DEM in tiles of 16 x 16 cells, like the generator defaults for SRTM30 */
+	static constexpr unsigned SAMPLES_PER_DEGREE = 120;
+	static constexpr unsigned TILE_SIZE = 16;
+	static constexpr unsigned TILES_PER_SIDE = (SAMPLES_PER_DEGREE + TILE_SIZE - 1) / TILE_SIZE;
+
+	bool write_tiles();
+	bool accuracy_check();
+	bool missing_data_check();
+	bool flight_benchmark();
+	bool remove_tiles();
+
+	bool write_file(int lat_deg, int lon_deg);
+	float fly(TerrainDatabase &terrain, bool prefetch, bool load, unsigned &answered, unsigned &num_queries);
+
+	static float terrain_model(double lat, double lon);
+};
+
+/* survey pattern followed by a transit into the neighbouring degree square */
+static const double flight_path[][2] = {
+	{ 47.30, 8.60 },
+	{ 47.30, 8.90 },
+	{ 47.32, 8.90 },
+	{ 47.32, 8.60 },
+	{ 47.34, 8.60 },
+	{ 47.34, 8.90 },
+	{ 47.36, 8.90 },
+	{ 47.36, 8.60 },
+	{ 47.50, 9.40 },
+	{ 47.30, 8.60 },
+};
+
+static const int test_squares[][2] = {
+	{ 47, 8 },
+	{ 47, 9 },
+};
+
+float TerrainTest::terrain_model(double lat, double lon)
+{
+	/* hills with a wavelength of about 20 DEM samples */
+	return 600.0f + 300.0f * (float)(sin(lat * 20.0) * cos(lon * 15.0)) + 50.0f * (float)(lat - 47.0);
+}
+
+bool TerrainTest::write_file(int lat_deg, int lon_deg)
+{
+	char path[128];
+	snprintf(path, sizeof(path), TERRAIN_TEST_DIR"/N%02dE%03d.dat", lat_deg, lon_deg);
+
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	/* same layout as written by Tools/generate_terrain_tiles.py */
+	struct {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t tile_size;
+		int16_t lat_deg;
+		int16_t lon_deg;
+		uint16_t samples_per_degree;
+		uint16_t tiles_per_side;
+	} header = { 0x52545850, 1, TILE_SIZE, (int16_t)lat_deg, (int16_t)lon_deg, SAMPLES_PER_DEGREE, TILES_PER_SIDE };
+
+	bool ok = write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header);
+
+	int16_t heights[(TILE_SIZE + 1) * (TILE_SIZE + 1)];
+
+	for (unsigned tile_row = 0; ok && tile_row < TILES_PER_SIDE; tile_row++) {
+		for (unsigned tile_col = 0; ok && tile_col < TILES_PER_SIDE; tile_col++) {
+			for (unsigned r = 0; r <= TILE_SIZE; r++) {
+				for (unsigned c = 0; c <= TILE_SIZE; c++) {
+					const double lat = lat_deg + (double)(tile_row * TILE_SIZE + r) / SAMPLES_PER_DEGREE;
+					const double lon = lon_deg + (double)(tile_col * TILE_SIZE + c) / SAMPLES_PER_DEGREE;
+					heights[r * (TILE_SIZE + 1) + c] = (int16_t)roundf(terrain_model(lat, lon));
+				}
+			}
+
+			ok = write(fd, heights, sizeof(heights)) == (ssize_t)sizeof(heights);
+		}
+	}
+
+	close(fd);
+	return ok;
+}
+
+bool TerrainTest::write_tiles(void)
+{
+	mkdir(TERRAIN_TEST_DIR, 0777);
+
+	for (unsigned i = 0; i < sizeof(test_squares) / sizeof(test_squares[0]); i++) {
+		ut_assert("write terrain file", write_file(test_squares[i][0], test_squares[i][1]));
+	}
+
+	return true;
+}
+
+bool TerrainTest::accuracy_check(void)
+{
+	TerrainDatabase terrain;
+	ut_assert("init", terrain.init(TERRAIN_TEST_DIR, 4) == 0);
+
+	float err_max = 0.0f;
+	double err_sq = 0.0;
+	const unsigned n = 2000;
+
+	srand(1);
+
+	for (unsigned i = 0; i < n; i++) {
+		const double lat = 47.0 + (double)rand() / RAND_MAX;
+		const double lon = 8.0 + 2.0 * (double)rand() / RAND_MAX;
+		float height;
+
+		ut_assert("height lookup failed", terrain.height(lat, lon, height));
+
+		const float err = fabsf(height - terrain_model(lat, lon));
+		err_max = fmaxf(err_max, err);
+		err_sq += err * err;
+	}
+
+	PX4_INFO("interpolation error: max %.2f m, rms %.2f m", (double)err_max, sqrt(err_sq / n));
+
+	/* curvature of the model between samples plus rounding to whole meters */
+	ut_assert("interpolation error too large", err_max < 5.0f && err_sq / n < 1.0);
+
+	/* grid points must be exact up to rounding, including the shared edge of two squares */
+	float height;
+	ut_assert("edge lookup", terrain.height(47.5, 9.0, height));
+	ut_assert("edge height", fabsf(height - terrain_model(47.5, 9.0)) < 0.51f);
+
+	/* the path is sampled at the DEM resolution, peaks between samples may be cut a little */
+	float height_max;
+	ut_assert("max height", terrain.max_height_on_path(47.30, 8.60, 47.36, 8.90, height_max));
+
+	for (unsigned k = 0; k <= 10; k++) {
+		ut_assert("height sample", terrain.height(47.30 + k * 0.006, 8.60 + k * 0.03, height));
+		ut_assert("max height below sample", height_max > height - 1.0f);
+	}
+
+	return true;
+}
+
+bool TerrainTest::missing_data_check(void)
+{
+	TerrainDatabase terrain;
+
+	ut_assert("missing directory accepted", terrain.init(TERRAIN_TEST_DIR"/none") != 0);
+	ut_assert("disabled", !terrain.enabled());
+
+	float height;
+	ut_assert("lookup without data", !terrain.height(47.3, 8.6, height));
+
+	ut_assert("init", terrain.init(TERRAIN_TEST_DIR, 4) == 0);
+	ut_assert("lookup outside of the data", !terrain.height(-33.9, 151.2, height));
+	ut_assert("invalid position", !terrain.height(NAN, 8.6, height));
+
+	/* non blocking lookups only answer from the cache */
+	ut_assert("lookup from empty cache", !terrain.height(47.3, 8.6, height, false));
+	ut_assert("blocking lookup", terrain.height(47.3, 8.6, height, true));
+	ut_assert("lookup from cache", terrain.height(47.3, 8.6, height, false));
+
+	/* a non blocking path query hands the missing tiles to the work queue */
+	float height_max;
+	ut_assert("path from empty cache", !terrain.max_height_on_path(47.40, 8.70, 47.42, 8.72, height_max, false));
+
+	for (unsigned i = 0; i < 100 && !terrain.max_height_on_path(47.40, 8.70, 47.42, 8.72, height_max, false); i++) {
+		usleep(10000);
+	}
+
+	ut_assert("path loaded by the work queue", terrain.max_height_on_path(47.40, 8.70, 47.42, 8.72, height_max, false));
+
+	return true;
+}
+
+float TerrainTest::fly(TerrainDatabase &terrain, bool prefetch, bool load, unsigned &answered,
+			 unsigned &num_queries)
+{
+	/* about 20 m/s queried at 10 Hz */
+	const double step = 2.0 / 111e3;
+	const unsigned num_legs = sizeof(flight_path) / sizeof(flight_path[0]) - 1;
+	hrt_abstime time_queries = 0;
+
+	answered = 0;
+	num_queries = 0;
+
+	for (unsigned leg = 0; leg < num_legs; leg++) {
+		const double *from = flight_path[leg];
+		const double *to = flight_path[leg + 1];
+
+		if (prefetch && leg + 2 < sizeof(flight_path) / sizeof(flight_path[0])) {
+			/* what navigator does when a mission item becomes current, the first leg is flown without */
+			terrain.prefetch(to[0], to[1], flight_path[leg + 2][0], flight_path[leg + 2][1]);
+		}
+
+		const double length = sqrt((to[0] - from[0]) * (to[0] - from[0]) + (to[1] - from[1]) * (to[1] - from[1]));
+		const unsigned num_steps = (unsigned)(length / step);
+
+		for (unsigned k = 0; k < num_steps; k++) {
+			const double t = (double)k / num_steps;
+			float height;
+
+			if (prefetch && k % 50 == 0) {
+				/* top up every 5 s along the rest of the leg */
+				terrain.prefetch(from[0] + t * (to[0] - from[0]), from[1] + t * (to[1] - from[1]), to[0], to[1]);
+			}
+
+			hrt_abstime t0 = hrt_absolute_time();
+			answered += terrain.height(from[0] + t * (to[0] - from[0]), from[1] + t * (to[1] - from[1]), height, load);
+			time_queries += hrt_absolute_time() - t0;
+			num_queries++;
+		}
+	}
+
+	return num_queries > 0 ? (float)time_queries / num_queries : 0.0f;
+}
+
+bool TerrainTest::flight_benchmark(void)
+{
+	unsigned answered;
+	unsigned num_queries;
+
+	{
+		TerrainDatabase terrain;
+		ut_assert("init", terrain.init(TERRAIN_TEST_DIR, 8) == 0);
+
+		const float latency = fly(terrain, false, true, answered, num_queries);
+
+		PX4_INFO("blocking lookups: %u queries, %.3f us/query, %.2f%% hits, %u tile loads",
+			 num_queries, (double)latency, 100.0 * terrain.hits() / terrain.queries(),
+			 (unsigned)terrain.loads());
+
+		ut_assert("all lookups answered", answered == num_queries);
+		ut_assert("hit rate too low", terrain.hits() > terrain.queries() * 99 / 100);
+	}
+
+	{
+		TerrainDatabase terrain;
+		ut_assert("init", terrain.init(TERRAIN_TEST_DIR, 8) == 0);
+
+		const float latency = fly(terrain, false, false, answered, num_queries);
+
+		PX4_INFO("non blocking lookups: %.3f us/query, %.2f%% answered", (double)latency,
+			 100.0 * answered / num_queries);
+	}
+
+	{
+		TerrainDatabase terrain;
+		ut_assert("init", terrain.init(TERRAIN_TEST_DIR, 8) == 0);
+
+		const float latency = fly(terrain, true, false, answered, num_queries);
+
+		PX4_INFO("non blocking lookups with prefetch: %.3f us/query, %.2f%% answered, %u tile loads",
+			 (double)latency, 100.0 * answered / num_queries, (unsigned)terrain.loads());
+
+		ut_assert("prefetch misses tiles", answered > num_queries * 99 / 100);
+	}
+
+	return true;
+}
+
+bool TerrainTest::remove_tiles(void)
+{
+	char path[128];
+
+	for (unsigned i = 0; i < sizeof(test_squares) / sizeof(test_squares[0]); i++) {
+		snprintf(path, sizeof(path), TERRAIN_TEST_DIR"/N%02dE%03d.dat", test_squares[i][0], test_squares[i][1]);
+		unlink(path);
+	}
+
+	rmdir(TERRAIN_TEST_DIR);
+	return true;
+}
+
+bool TerrainTest::run_tests(void)
+{
+	ut_run_test(write_tiles);
+	ut_run_test(accuracy_check);
+	ut_run_test(missing_data_check);
+	ut_run_test(flight_benchmark);
+	ut_run_test(remove_tiles);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_terrain, TerrainTest)
@@ -85,11 +85,13 @@ const struct {
 	{"uart_baudchange",	test_uart_baudchange,	OPT_NOJIGTEST},
 #else
 	{"rc",			rc_tests_main,	0},
+	{"flashfs",		test_flashfs,	0},
 #endif /* __PX4_NUTTX */
 
 	/* external tests */
 	{"commander",		commander_tests_main,	0},
 	{"controllib",		controllib_test_main,	0},
+	{"fw_pos_control_l1",	fw_pos_control_l1_tests_main,	0},
 	{"mc_pos_control",	mc_pos_control_tests_main,	0},
 	//{"mavlink",		mavlink_tests_main,	0}, // TODO: fix mavlink_tests
 	{"sf0x",		sf0x_tests_main,	0},
@@ -105,6 +107,8 @@ const struct {
 	{"file",		test_file,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"file2",		test_file2,	OPT_NOJIGTEST},
 	{"float",		test_float,	0},
+	{"geo",			test_geo,	0},
+	{"geofence",		test_geofence,	0},
 	{"gpio",		test_gpio,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"hott_telemetry",	test_hott_telemetry,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"hrt",			test_hrt,	OPT_NOJIGTEST | OPT_NOALLTEST},
@@ -120,6 +124,7 @@ const struct {
 	{"rc",			test_rc,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"servo",		test_servo,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"sleep",		test_sleep,	OPT_NOJIGTEST},
+	{"terrain",		test_terrain,	0},
 	{"tone",		test_tone,	0},
 	{"uart_console",	test_uart_console,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"uart_loopback",	test_uart_loopback,	OPT_NOJIGTEST | OPT_NOALLTEST},
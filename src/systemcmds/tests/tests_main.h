@@ -60,7 +60,10 @@ extern int	test_conv(int argc, char *argv[]);
 extern int	test_dataman(int argc, char *argv[]);
 extern int	test_file(int argc, char *argv[]);
 extern int	test_file2(int argc, char *argv[]);
+extern int	test_flashfs(int argc, char *argv[]);
 extern int	test_float(int argc, char *argv[]);
+extern int	test_geo(int argc, char *argv[]);
+extern int	test_geofence(int argc, char *argv[]);
 extern int	test_gpio(int argc, char *argv[]);
 extern int	test_hott_telemetry(int argc, char *argv[]);
 extern int	test_hrt(int argc, char *argv[]);
@@ -79,6 +82,7 @@ extern int	test_rc(int argc, char *argv[]);
 extern int	test_sensors(int argc, char *argv[]);
 extern int	test_servo(int argc, char *argv[]);
 extern int	test_sleep(int argc, char *argv[]);
+extern int	test_terrain(int argc, char *argv[]);
 extern int	test_time(int argc, char *argv[]);
 extern int	test_tone(int argc, char *argv[]);
 extern int	test_uart_baudchange(int argc, char *argv[]);
@@ -93,6 +97,7 @@ extern int controllib_test_main(int argc, char *argv[]);
 extern int uorb_tests_main(int argc, char *argv[]);
 extern int rc_tests_main(int argc, char *argv[]);
 extern int sf0x_tests_main(int argc, char *argv[]);
+extern int fw_pos_control_l1_tests_main(int argc, char *argv[]);
 extern int mc_pos_control_tests_main(int argc, char *argv[]);
 
 